@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2023  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -37,6 +37,10 @@ public:
   /**
    * @brief Checks if a graph is connected (i.e. there is a path between every pair of vertices).
    *
+   * The connected components of the graph are computed by the first call, then kept up to date
+   * as nodes and edges are added to the graph, so further calls are immediate. They are only
+   * computed again after a deletion.
+   *
    * @param graph The graph to check.
    * @return bool True if the graph is connected, false otherwise.
    **/
@@ -53,6 +57,8 @@ public:
   /**
    * @brief Gets the number of connected components in the graph.
    *
+   * As for isConnected, the connected components are maintained between the calls.
+   *
    * @param graph The graph in which to count the number of connected components.
    * @return uint The number of connected componments.
    **/
@@ -61,6 +67,10 @@ public:
   /**
    * @brief Computes the set of connected components.
    *
+   * The components are ordered by their first node in the graph, which is also the first node
+   * of each component. The other nodes of a component are in breadth first order, or in the order
+   * of the graph when the components of a large graph are computed in parallel.
+   *
    * @param graph The graph on which to compute connected components.
    * @return The components that were found as vectors of nodes.
    **/
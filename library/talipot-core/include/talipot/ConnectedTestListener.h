@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -18,6 +18,7 @@
 
 #include <talipot/Graph.h>
 #include <talipot/Observable.h>
+#include <talipot/UnionFind.h>
 
 namespace tlp {
 
@@ -32,5 +33,40 @@ public:
   flat_hash_map<const Graph *, bool> resultsBuffer;
 };
 
+class ConnectedComponentsListener : public Observable {
+public:
+  // override of Observable::treatEvent to update the connected components of a graph
+  // when nodes or edges are added to it, or to remove them when some are deleted.
+  void treatEvent(const Event &) override;
+
+  /**
+   * @brief The connected components of a graph, as a partition of slots given to its nodes.
+   *
+   * The slots are found from the ids of the nodes rather than from their positions, which are
+   * changed by Graph::sortElts without sending any event. When the ids are dense, as in a root
+   * graph, they are the slots and the ids lower than the size of the partition which are not
+   * the ones of nodes of the graph stay alone in their sets. Otherwise, as in a small subgraph
+   * of a large graph, the nodes are given consecutive slots.
+   **/
+  struct Components {
+    UnionFind sets;
+    flat_hash_map<uint, uint> slots;
+    bool sparse = false;
+
+    uint slot(node n) const {
+      return sparse ? slots.at(n.id) : n.id;
+    }
+
+    void merge(node n1, node n2) {
+      sets.merge(slot(n1), slot(n2));
+    }
+  };
+
+  /**
+   * @brief Stored connected components of graphs.
+   **/
+  flat_hash_map<const Graph *, Components> componentsBuffer;
+};
+
 }
 #endif // TALIPOT_CONNECTED_TEST_LISTENER_H
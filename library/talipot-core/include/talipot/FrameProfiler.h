@@ -0,0 +1,177 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_FRAME_PROFILER_H
+#define TALIPOT_FRAME_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+/**
+ * @brief The timing of a stage of a profiled frame.
+ **/
+struct TLP_SCOPE ProfiledStage {
+  std::string name;
+  /**
+   * @brief The start of the stage, in microseconds since the start of its frame.
+   **/
+  double start = 0;
+  /**
+   * @brief The duration of the stage, in microseconds.
+   **/
+  double duration = 0;
+  /**
+   * @brief The number of elements (entities, nodes, edges, labels, bytes, ...)
+   * processed during the stage.
+   **/
+  uint nbElements = 0;
+};
+
+/**
+ * @brief The timings of a profiled frame and of its stages.
+ **/
+struct TLP_SCOPE ProfiledFrame {
+  uint id = 0;
+  std::string name;
+  /**
+   * @brief The start of the frame, in microseconds since the profiler creation.
+   **/
+  double start = 0;
+  /**
+   * @brief The duration of the frame, in microseconds.
+   **/
+  double duration = 0;
+  std::vector<ProfiledStage> stages;
+};
+
+/**
+ * @brief Records the CPU time spent in the different stages of the rendering frames.
+ *
+ * The profiler is always compiled but disabled by default, when disabled the cost of
+ * an instrumented stage is reduced to the test of an atomic flag. When enabled, the last
+ * frames are kept in a ring buffer whose capacity can be configured.
+ *
+ * A frame is delimited by calls to beginFrame() and endFrame(), the stages of the frame
+ * being timed using a StageTimer. Frames can be nested (a scene drawn while drawing
+ * another one), the stages are always recorded in the innermost frame and the stages
+ * timed outside of any frame are ignored.
+ *
+ * @code
+ * FrameProfiler::beginFrame("main scene");
+ * {
+ *   FrameProfiler::StageTimer timer("LOD computation");
+ *   ...
+ *   timer.setNbElements(nbEntities);
+ * }
+ * FrameProfiler::endFrame();
+ * FrameProfiler::saveChromeTrace("frames.json");
+ * @endcode
+ **/
+class TLP_SCOPE FrameProfiler {
+public:
+  /**
+   * @brief Times a stage from its creation to its destruction.
+   **/
+  class TLP_SCOPE StageTimer {
+  public:
+    explicit StageTimer(const char *name);
+    ~StageTimer();
+
+    void setNbElements(uint nbElements) {
+      this->nbElements = nbElements;
+    }
+
+    void addElements(uint nbElements) {
+      this->nbElements += nbElements;
+    }
+
+    /**
+     * @brief Ends the stage before the destruction of the timer.
+     **/
+    void stop();
+
+  private:
+    const char *name;
+    bool active;
+    std::chrono::steady_clock::time_point startTime;
+    uint nbElements;
+  };
+
+  /**
+   * @brief Enables or disables the recording of the frames.
+   **/
+  static void setEnabled(bool enabled);
+
+  static bool isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sets the maximum number of frames kept, the oldest ones being dropped first.
+   **/
+  static void setCapacity(uint nbFrames);
+
+  static uint capacity();
+
+  /**
+   * @brief Starts a new frame, does nothing if the profiler is disabled.
+   **/
+  static void beginFrame(const std::string &name);
+
+  /**
+   * @brief Ends the innermost frame and stores it in the ring buffer,
+   * does nothing if the profiler is disabled.
+   **/
+  static void endFrame();
+
+  /**
+   * @brief Returns the recorded frames, from the oldest to the newest one.
+   **/
+  static std::vector<ProfiledFrame> frames();
+
+  static uint numberOfFrames();
+
+  /**
+   * @brief Drops all the recorded frames.
+   **/
+  static void clear();
+
+  /**
+   * @brief Writes the recorded frames in the Chrome trace event JSON format,
+   * which can be loaded in chrome://tracing or https://ui.perfetto.dev.
+   **/
+  static void writeChromeTrace(std::ostream &os);
+
+  /**
+   * @brief Saves the recorded frames in a Chrome trace event JSON file.
+   *
+   * @return false if the file cannot be written.
+   **/
+  static bool saveChromeTrace(const std::string &filename);
+
+private:
+  static void addStage(const char *name, std::chrono::steady_clock::time_point startTime,
+                       std::chrono::steady_clock::time_point endTime, uint nbElements);
+
+  static std::atomic<bool> enabled;
+};
+}
+
+#endif // TALIPOT_FRAME_PROFILER_H
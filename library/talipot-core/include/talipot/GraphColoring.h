@@ -0,0 +1,117 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_GRAPH_COLORING_H
+#define TALIPOT_GRAPH_COLORING_H
+
+#include <vector>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+class Graph;
+
+/**
+ * @brief Computes a coloring of the nodes of a graph, two adjacent nodes always having different
+ * colors, so the nodes of a color form an independent set.
+ *
+ * The nodes are colored greedily in a priority ordering, each one taking the smallest color
+ * not used by its neighbours colored before it. In parallel, the coloring is speculative,
+ * see A. H. Gebremedhin and F. Manne, "Scalable parallel graph coloring algorithms",
+ * Concurrency: Practice and Experience (2000): the nodes are colored concurrently from
+ * the possibly outdated colors of their neighbours, then a node having the same color as
+ * a neighbour of higher priority is colored again in the next round, until there are no more
+ * conflicts. The sequential coloring in the largest degree first ordering is the one of
+ * the Welsh and Powell algorithm.
+ *
+ * The edges are considered as undirected and the loops are ignored. The nodes are identified
+ * by their positions in the graph.
+ *
+ * @code
+ * GraphColoring coloring(graph);
+ * coloring.run(coloring.largestDegreeFirstOrdering());
+ *
+ * for (const auto &independentSet : coloring.independentSets()) {
+ *   // process the nodes of independentSet in parallel
+ *   ...
+ * }
+ * @endcode
+ **/
+class TLP_SCOPE GraphColoring {
+public:
+  /**
+   * @brief Builds the adjacency used by the coloring.
+   *
+   * @param graph the graph to color
+   **/
+  GraphColoring(const Graph *graph);
+
+  /**
+   * @brief Returns the positions of the nodes sorted in descending order of their degrees,
+   * the nodes of the same degree in descending order of their ids.
+   * The degrees are the ones of the graph, the loops included, as in the ordering
+   * of Welsh and Powell.
+   **/
+  std::vector<uint> largestDegreeFirstOrdering() const;
+
+  /**
+   * @brief Colors the nodes.
+   *
+   * @param ordering the positions of the nodes in priority order, the graph order if empty
+   * @param parallel if false, the nodes are colored sequentially and the coloring only
+   * depends on the ordering, else it may depend on the scheduling of the threads
+   * @return the number of colors used
+   **/
+  uint run(const std::vector<uint> &ordering = {}, bool parallel = true);
+
+  uint numberOfColors() const {
+    return nbColors;
+  }
+
+  // the color, in [0, numberOfColors()[, of the node at position n
+  uint color(uint n) const {
+    return colors[n];
+  }
+
+  const std::vector<uint> &getColors() const {
+    return colors;
+  }
+
+  // the number of rounds of the last run, 1 if it had no conflicts to resolve
+  uint numberOfRounds() const {
+    return nbRounds;
+  }
+
+  /**
+   * @brief Returns the positions of the nodes of each color, in priority order.
+   **/
+  std::vector<std::vector<uint>> independentSets() const;
+
+private:
+  // the adjacency of the nodes in compressed sparse row format
+  std::vector<uint> adjStart;
+  std::vector<uint> adjNodes;
+  // the degrees of the nodes, loops included, and their ids
+  // which break the ties of the degree ordering
+  std::vector<uint> degrees;
+  std::vector<uint> nodeIds;
+
+  std::vector<uint> colors;
+  std::vector<uint> ordering;
+  uint nbColors;
+  uint nbRounds;
+};
+}
+
+#endif // TALIPOT_GRAPH_COLORING_H
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2023  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -32,6 +32,14 @@ class PluginProgress;
  * see http://en.wikipedia.org/wiki/Average_path_length for more details
  */
 TLP_SCOPE double averagePathLength(const Graph *g);
+/*
+ * return an estimation of the average path length of a graph,
+ * computed from the shortest distances of nbSamples randomly chosen nodes to all the other nodes.
+ * If errorBound is not null, it is set to the half width of the 95% confidence interval
+ * of the estimation. The exact value is returned if nbSamples is not lower than
+ * the number of nodes.
+ */
+TLP_SCOPE double averagePathLength(const Graph *g, uint nbSamples, double *errorBound = nullptr);
 /*
  * return the clustering coefficient of a graph
  * as the average of the local clustering coefficients
@@ -44,10 +52,34 @@ TLP_SCOPE double averageClusteringCoefficient(const Graph *);
  * that is the proportion of edges between the nodes within its neighbourhood
  * divided by the number of edges that could possibly exist between them.
  * This quantifies how close its neighbors are to being a clique.
+ * The neighbourhood of a node is made of the nodes at a distance of at most maxDepth,
+ * the node itself excepted, the edges being considered as undirected.
+ * For the default maxDepth of 1, the coefficients are computed from the triangles
+ * of the graph (see countTriangles function).
  * see http://en.wikipedia.org/wiki/Clustering_coefficient for more details
  */
 TLP_SCOPE void clusteringCoefficient(const Graph *g, tlp::NodeVectorProperty<double> &result,
                                      uint maxDepth = 1);
+/*
+ * return the number of triangles of a graph, its edges being considered as undirected,
+ * its self loops and its multiple edges being ignored.
+ * If nodeTriangles is not null, it is filled with the number of triangles containing each node,
+ * and if edgeTriangles is not null, with the number of triangles containing each edge,
+ * also known as its support; the multiple edges between two nodes have the same support
+ * and the self loops have none.
+ * The triangles are enumerated in parallel from their node of lowest degree,
+ * by intersecting sorted lists of neighbours, so the complexity is o(m^1.5), m = |E|.
+ */
+TLP_SCOPE uint64_t countTriangles(const Graph *graph,
+                                  tlp::NodeVectorProperty<uint64_t> *nodeTriangles = nullptr,
+                                  tlp::EdgeVectorProperty<uint> *edgeTriangles = nullptr);
+/*
+ * return the transitivity, or global clustering coefficient, of a graph,
+ * that is three times its number of triangles divided by its number of
+ * connected triples of nodes (see countTriangles function).
+ * see http://en.wikipedia.org/wiki/Clustering_coefficient for more details.
+ */
+TLP_SCOPE double transitivity(const Graph *graph);
 /*
  * assign to each node of a graph its (in/ou/inout) degree.
  * The weighted degree of a node is the sum of weights of
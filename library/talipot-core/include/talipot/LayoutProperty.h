@@ -113,6 +113,20 @@ public:
    **/
   void scale(const Vec3f &scaleFactors, Iterator<node> *itNodes, Iterator<edge> *itEdges);
 
+  /**
+   * Sets at once the positions of the nodes of a graph and the bends of its edges.
+   * The observers are held during the update and the bounding boxes are computed again
+   * only when requested, instead of being updated for each element.
+   *
+   * @param nodesCoords the positions of the nodes, in the order of the graph nodes
+   * @param edgesBends the bends of the edges, in the order of the graph edges,
+   * the bends are not modified if empty
+   * @param subgraph If not null, only sets the layout of that subgraph
+   **/
+  void setValues(const std::vector<Coord> &nodesCoords,
+                 const std::vector<std::vector<Coord>> &edgesBends,
+                 const Graph *subgraph = nullptr);
+
   /**
    * Rotates the layout around the X-axis according to an angle in degrees.
    *
@@ -0,0 +1,111 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_LINK_ANALYSIS_H
+#define TALIPOT_LINK_ANALYSIS_H
+
+#include <vector>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+class Graph;
+class NumericProperty;
+class PluginProgress;
+
+/**
+ * @brief Computes link analysis measures of the nodes of a graph, as PageRank or the eigenvector
+ * centrality, by power iteration.
+ *
+ * The links to each node are stored in a compressed sparse row snapshot of the graph, and the
+ * measures are pulled along them: the new value of a node is the sum of the values of the nodes
+ * linking to it, so the nodes can be updated in parallel without synchronization. The iterations
+ * stop when the L1 norm of the change of the values is lower than a tolerance.
+ *
+ * Several PageRank computations, with different damping factors or teleport vectors, can be run
+ * in a single traversal of the links, their values being interleaved for each node.
+ * The nodes are identified by their positions in the graph.
+ *
+ * @code
+ * LinkAnalysis linkAnalysis(graph);
+ * std::vector<std::vector<double>> ranks;
+ * linkAnalysis.pageRank({0.85, 0.5}, {{}, {}}, ranks);
+ * @endcode
+ **/
+class TLP_SCOPE LinkAnalysis {
+public:
+  /**
+   * @brief Builds the snapshot of the links of a graph.
+   *
+   * @param graph the graph to analyze
+   * @param directed if false, each edge links each of its ends to the other one
+   * @param weight if not null, the weights of the edges, else all the edges weigh 1
+   **/
+  LinkAnalysis(const Graph *graph, bool directed = true, const NumericProperty *weight = nullptr);
+
+  /**
+   * @brief Computes the PageRank of the nodes for several damping factors and teleport vectors.
+   *
+   * The rank of a node is (1 - d) * t + d * s, where d is the damping factor, t the value of
+   * the node in the teleport vector and s the sum of the ranks of the nodes linking to it divided
+   * by their weighted out degrees. The rank of the nodes without out links is not redistributed.
+   *
+   * @param dampings the damping factors, in ]0, 1[, of the computations
+   * @param teleports the teleport vectors of the computations, indexed by node position. They are
+   * normalized to a sum of 1, and an empty vector is uniform. It is a personalized PageRank when
+   * the teleport vector is concentrated on some seed nodes.
+   * @param ranks the computed ranks, indexed by computation then by node position
+   * @param tolerance the L1 norm of the change of the ranks under which a computation stops
+   * @param maxIterations the maximum number of iterations
+   * @param progress if not null, used to report the progression and to stop the computations
+   * @return the number of iterations run
+   **/
+  uint pageRank(const std::vector<double> &dampings,
+                const std::vector<std::vector<double>> &teleports,
+                std::vector<std::vector<double>> &ranks, double tolerance = 1e-9,
+                uint maxIterations = 1000, PluginProgress *progress = nullptr) const;
+
+  /**
+   * @brief Computes the eigenvector centrality of the nodes.
+   *
+   * It is the dominant eigenvector of the (weighted) adjacency matrix, the centrality of a node
+   * being proportional to the sum of the centralities of the nodes linking to it. It is computed
+   * by power iteration on the adjacency matrix shifted by the identity, which has the same
+   * eigenvectors and converges on bipartite graphs too. The centralities have a L2 norm of 1.
+   *
+   * @param centralities the computed centralities, indexed by node position
+   * @param tolerance the L1 norm of the change of the centralities under which the computation
+   * stops
+   * @param maxIterations the maximum number of iterations
+   * @param progress if not null, used to report the progression and to stop the computation
+   * @return the number of iterations run
+   **/
+  uint eigenvectorCentrality(std::vector<double> &centralities, double tolerance = 1e-9,
+                             uint maxIterations = 1000, PluginProgress *progress = nullptr) const;
+
+private:
+  template <bool weighted>
+  void pull(const std::vector<double> &values, std::vector<double> &sums, uint nbColumns) const;
+
+  // the links to the nodes in compressed sparse row format
+  std::vector<uint> adjStart;
+  std::vector<uint> adjNodes;
+  // empty if the edges are not weighted
+  std::vector<double> adjWeights;
+  // the inverse of the weighted out degrees of the nodes, 0 for the nodes without out links
+  std::vector<double> invOutDegrees;
+};
+}
+
+#endif // TALIPOT_LINK_ANALYSIS_H
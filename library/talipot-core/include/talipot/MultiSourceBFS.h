@@ -0,0 +1,132 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_MULTI_SOURCE_BFS_H
+#define TALIPOT_MULTI_SOURCE_BFS_H
+
+#include <cstdint>
+#include <vector>
+
+#include <talipot/config.h>
+#include <talipot/GraphTools.h>
+
+namespace tlp {
+
+class Graph;
+class PluginProgress;
+
+/**
+ * @brief Computes the unweighted distances from a set of source nodes to the other nodes
+ * of a graph, by running 64 breadth first searches at once.
+ *
+ * The searches of a batch of 64 sources share their traversals of the graph: each node stores
+ * in a 64 bits word the sources which have reached it, and the words of the nodes of the current
+ * frontiers are propagated to their neighbours by bitwise or. The frontiers are kept in lists and,
+ * unless a frontier is large, so are the nodes it reaches, so a level of a long and thin graph only
+ * visits the edges of its frontier. The batches are processed in parallel, each thread reusing
+ * its own words.
+ *
+ * The distances themselves are not stored, only their sums and maximum for each source, and their
+ * sums for each target node. The nodes are identified by their positions in the graph.
+ *
+ * When the sources are a random sample of the nodes, the averages of the distances to a target
+ * node estimate its average distance to the other nodes, see
+ * D. Eppstein and J. Wang, "Fast approximation of centrality", J. Graph Algorithms Appl. (2004).
+ *
+ * @code
+ * MultiSourceBFS bfs(graph);
+ * bfs.run();
+ *
+ * for (uint i = 0; i < graph->numberOfNodes(); ++i) {
+ *   uint eccentricity = bfs.eccentricity(i);
+ *   ...
+ * }
+ * @endcode
+ **/
+class TLP_SCOPE MultiSourceBFS {
+public:
+  /**
+   * @brief Builds the adjacency used by the searches.
+   *
+   * @param graph the graph to traverse
+   * @param direction the direction in which the edges are followed from the sources
+   **/
+  MultiSourceBFS(const Graph *graph, EdgeType direction = EdgeType::UNDIRECTED);
+
+  /**
+   * @brief Runs the searches from some sources.
+   *
+   * @param sources the positions of the source nodes, all the nodes if empty
+   * @param progress if not null, used to report the progression and to stop the searches
+   * @return false if the searches were stopped
+   **/
+  bool run(const std::vector<uint> &sources = {}, PluginProgress *progress = nullptr);
+
+  /**
+   * @brief Returns the positions of nbSources distinct nodes chosen at random among nbNodes.
+   **/
+  static std::vector<uint> randomSources(uint nbNodes, uint nbSources);
+
+  uint numberOfSources() const {
+    return sources.size();
+  }
+
+  uint source(uint i) const {
+    return sources[i];
+  }
+
+  // the maximum distance from the i-th source to a node it reaches
+  uint eccentricity(uint i) const {
+    return eccentricities[i];
+  }
+
+  // the sum of the distances from the i-th source to the nodes it reaches
+  uint64_t sourceDistancesSum(uint i) const {
+    return sourceSums[i];
+  }
+
+  // the number of nodes reached by the i-th source, itself excepted
+  uint nbReachedNodes(uint i) const {
+    return sourceNbReached[i];
+  }
+
+  // the sum of the distances to the node at position n from the sources reaching it
+  uint64_t targetDistancesSum(uint n) const {
+    return targetSums[n];
+  }
+
+  // the number of sources reaching the node at position n, itself excepted
+  uint nbReachingSources(uint n) const {
+    return targetNbReaching[n];
+  }
+
+private:
+  // the words and the frontier of a batch of searches
+  struct BatchSearch;
+
+  void runBatch(uint batch, BatchSearch &search);
+
+  // the adjacency of the nodes in compressed sparse row format
+  std::vector<uint> adjStart;
+  std::vector<uint> adjNodes;
+
+  std::vector<uint> sources;
+  std::vector<uint> eccentricities;
+  std::vector<uint64_t> sourceSums;
+  std::vector<uint> sourceNbReached;
+  std::vector<uint64_t> targetSums;
+  std::vector<uint> targetNbReaching;
+};
+}
+
+#endif // TALIPOT_MULTI_SOURCE_BFS_H
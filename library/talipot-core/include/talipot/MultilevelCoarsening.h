@@ -0,0 +1,129 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_MULTILEVEL_COARSENING_H
+#define TALIPOT_MULTILEVEL_COARSENING_H
+
+#include <vector>
+
+#include <talipot/Coord.h>
+#include <talipot/Edge.h>
+
+namespace tlp {
+
+class Graph;
+class LayoutProperty;
+class NumericProperty;
+class BooleanProperty;
+
+/**
+ * @brief A hierarchy of successively coarsened versions of a graph, used by the
+ * multilevel modes of the force directed layouts.
+ *
+ * Each level is a graph stored in flat arrays indexed by its node numbers, the nodes
+ * of the finest level being numbered by their position in the original graph.
+ * A coarser level is built by merging the pairs of nodes of a greedy heavy edge
+ * matching, the weights of the merged nodes and edges being summed and the position of
+ * a coarse node being the barycenter of its fine nodes. Once a coarse level has been
+ * laid out, its positions are prolonged to the next finer level, which is then refined.
+ *
+ * @code
+ * MultilevelCoarsening coarsening(graph, layout);
+ * coarsening.coarsen();
+ *
+ * for (uint i = coarsening.numberOfLevels(); i-- > 0;) {
+ *   if (i < coarsening.numberOfLevels() - 1) {
+ *     coarsening.prolong(i);
+ *   }
+ *   // lay out coarsening.level(i)
+ * }
+ * @endcode
+ **/
+class TLP_SCOPE MultilevelCoarsening {
+public:
+  struct Level {
+    std::vector<Coord> positions;
+    std::vector<double> weights;
+    // the fixed nodes are never merged nor moved by the prolongation
+    std::vector<bool> fixed;
+    // the adjacency of the nodes in compressed sparse row format
+    std::vector<uint> adjStart;
+    std::vector<uint> adjNodes;
+    std::vector<double> adjWeights;
+    // the edge of each adjacency, only filled for the finest level
+    std::vector<edge> adjEdges;
+    // the node of the next coarser level containing each node
+    std::vector<uint> coarseNodes;
+
+    uint numberOfNodes() const {
+      return positions.size();
+    }
+
+    uint degree(uint u) const {
+      return adjStart[u + 1] - adjStart[u];
+    }
+  };
+
+  /**
+   * @brief Builds the finest level of a graph, its self loops being ignored.
+   *
+   * @param graph the graph to coarsen
+   * @param layout the initial positions of the nodes, the origin if null
+   * @param weights the weights of the nodes and of the edges, 1 if null
+   * @param fixedNodes the nodes which are never merged nor moved, none if null
+   **/
+  MultilevelCoarsening(const Graph *graph, const LayoutProperty *layout = nullptr,
+                       const NumericProperty *weights = nullptr,
+                       const BooleanProperty *fixedNodes = nullptr);
+
+  /**
+   * @brief Adds coarser levels until the coarsest one has at most minNbNodes nodes,
+   * or until a matching no longer reduces enough the number of nodes.
+   *
+   * @param minNbNodes the number of nodes under which the coarsening stops
+   * @param maxRatio the maximum ratio between the numbers of nodes of a coarse level
+   * and of its finer level
+   * @return the number of levels
+   **/
+  uint coarsen(uint minNbNodes = 64, double maxRatio = 0.8);
+
+  /**
+   * @brief Places the nodes of a level around the node of the next coarser level
+   * containing them, in the direction of their offset from the barycenter of the nodes
+   * merged with them, at a tenth of the average edge length of the coarser level.
+   *
+   * @param level the index of the level to update, the finest one being 0
+   * @param dim 2 or 3, the number of dimensions of the layout
+   **/
+  void prolong(uint level, uint dim = 2);
+
+  uint numberOfLevels() const {
+    return levels.size();
+  }
+
+  Level &level(uint i) {
+    return levels[i];
+  }
+
+  const Level &level(uint i) const {
+    return levels[i];
+  }
+
+private:
+  bool coarsenLevel(Level &fine, Level &coarse, double maxRatio) const;
+
+  std::vector<Level> levels;
+};
+}
+
+#endif // TALIPOT_MULTILEVEL_COARSENING_H
@@ -0,0 +1,131 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_UNION_FIND_H
+#define TALIPOT_UNION_FIND_H
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+/**
+ * @brief A partition of the integers 0 to n - 1 into disjoint sets, which can be merged.
+ *
+ * Each set is identified by one of its elements, its representative. The sets are merged
+ * by size and the paths to the representatives are halved when searched, so a sequence of
+ * operations runs in almost linear time. The elements are usually the positions of the
+ * nodes or of the edges of a graph.
+ *
+ * @code
+ * UnionFind components(graph->numberOfNodes());
+ *
+ * for (auto e : graph->edges()) {
+ *   const auto &[src, tgt] = graph->ends(e);
+ *   components.merge(graph->nodePos(src), graph->nodePos(tgt));
+ * }
+ * @endcode
+ **/
+class UnionFind {
+public:
+  UnionFind(uint nbElements = 0) {
+    reset(nbElements);
+  }
+
+  /**
+   * @brief Puts each of the nbElements elements alone in its set.
+   **/
+  void reset(uint nbElements) {
+    parents.resize(nbElements);
+    std::iota(parents.begin(), parents.end(), 0);
+    sizes.assign(nbElements, 1);
+    nbSets = nbElements;
+  }
+
+  /**
+   * @brief Adds an element alone in its set, and returns it.
+   **/
+  uint addElement() {
+    uint i = parents.size();
+    parents.push_back(i);
+    sizes.push_back(1);
+    ++nbSets;
+    return i;
+  }
+
+  /**
+   * @brief Returns the representative of the set of an element.
+   **/
+  uint find(uint i) {
+    while (parents[i] != i) {
+      parents[i] = parents[parents[i]];
+      i = parents[i];
+    }
+
+    return i;
+  }
+
+  /**
+   * @brief Merges the sets of two elements.
+   *
+   * @return the representative of the merged set, which is the one of the largest of the two
+   * sets
+   **/
+  uint merge(uint i, uint j) {
+    i = find(i);
+    j = find(j);
+
+    if (i == j) {
+      return i;
+    }
+
+    if (sizes[i] < sizes[j]) {
+      std::swap(i, j);
+    }
+
+    parents[j] = i;
+    sizes[i] += sizes[j];
+    --nbSets;
+    return i;
+  }
+
+  bool sameSet(uint i, uint j) {
+    return find(i) == find(j);
+  }
+
+  /**
+   * @brief Returns the number of elements of the set of an element.
+   **/
+  uint setSize(uint i) {
+    return sizes[find(i)];
+  }
+
+  uint numberOfElements() const {
+    return parents.size();
+  }
+
+  uint numberOfSets() const {
+    return nbSets;
+  }
+
+private:
+  std::vector<uint> parents;
+  std::vector<uint> sizes;
+  uint nbSets = 0;
+};
+}
+
+#endif // TALIPOT_UNION_FIND_H
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2024  The Talipot developers
+ * Copyright (C) 2024-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -40,6 +40,7 @@
 //
 
 #define flat_hash_map gtl::flat_hash_map
+#define flat_hash_set gtl::flat_hash_set
 #define node_hash_map gtl::node_hash_map
 
 // The hash_combine function from the boost library
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -18,6 +18,7 @@
 #include <talipot/ConnectedTestListener.h>
 #include <talipot/MutableContainer.h>
 #include <talipot/StableIterator.h>
+#include <talipot/VectorProperty.h>
 
 using namespace std;
 using namespace tlp;
@@ -127,51 +128,60 @@ static void makeBiconnectedDFS(Graph *graph, vector<edge> &addedEdges) {
 }
 
 //=================================================================
-bool biconnectedTest(const Graph *graph, node v, MutableContainer<uint> &low,
-                     MutableContainer<uint> &dfsNumber, MutableContainer<node> &supergraph,
-                     uint &count) {
-  uint vDfs = count++;
-  dfsNumber.set(v.id, vDfs);
-  low.set(v.id, vDfs);
-
-  for (auto w : graph->getInOutNodes(v)) {
-
-    if (dfsNumber.get(w.id) == UINT_MAX) {
-      if (vDfs == 1) {
-        if (count != 2) {
+// checks that a depth first search from the first node reaches all the nodes
+// and finds no articulation point, with an explicit dfs stack so the depth of the
+// search is not limited by the call stack
+static bool biconnectedTest(const Graph *graph) {
+  // the dfs numbers of the nodes, starting at 1, 0 for the unvisited ones
+  NodeVectorProperty<uint> dfsNumber(graph);
+  NodeVectorProperty<uint> low(graph);
+  dfsNumber.setAll(0);
+  // the nodes of the current dfs path, with the position of their next incident edge
+  vector<pair<node, uint>> dfsStack;
+  node root = graph->nodes()[0];
+  uint count = 1;
+  uint nbRootChildren = 0;
+  dfsNumber[root] = low[root] = count;
+  dfsStack.emplace_back(root, 0);
+
+  while (!dfsStack.empty()) {
+    auto &[v, i] = dfsStack.back();
+    const vector<edge> &incidence = graph->incidence(v);
+
+    if (i < incidence.size()) {
+      node w = graph->opposite(incidence[i++], v);
+
+      if (dfsNumber[w] == 0) {
+        // the root is an articulation point if it has several children
+        if (v == root && ++nbRootChildren > 1) {
           return false;
         }
+
+        dfsNumber[w] = low[w] = ++count;
+        dfsStack.emplace_back(w, 0);
+      } else if (dfsStack.size() == 1 || dfsStack[dfsStack.size() - 2].first != w) {
+        low[v] = std::min(low[v], dfsNumber[w]);
       }
+    } else {
+      node w = v;
+      dfsStack.pop_back();
 
-      supergraph.set(w.id, v);
+      if (!dfsStack.empty()) {
+        node father = dfsStack.back().first;
 
-      if (!biconnectedTest(graph, w, low, dfsNumber, supergraph, count)) {
-        return false;
-      }
+        if (father != root) {
+          // father is an articulation point if no node below w goes above it
+          if (low[w] >= dfsNumber[father]) {
+            return false;
+          }
 
-      if (vDfs != 1) {
-        if (low.get(w.id) >= dfsNumber.get(v.id)) {
-          return false;
-        } else {
-          low.set(v.id, std::min(low.get(v.id), low.get(w.id)));
+          low[father] = std::min(low[father], low[w]);
         }
       }
-    } else if (supergraph.get(v.id) != w) {
-      low.set(v.id, std::min(low.get(v.id), dfsNumber.get(w.id)));
     }
   }
 
-  return true;
-}
-//=================================================================
-static bool biconnectedTest(const Graph *graph) {
-  MutableContainer<uint> low;
-  MutableContainer<uint> dfsNumber;
-  dfsNumber.setAll(UINT_MAX);
-  MutableContainer<node> supergraph;
-  uint count = 1;
-  return (biconnectedTest(graph, graph->nodes()[0], low, dfsNumber, supergraph, count) &&
-          (count == graph->numberOfNodes() + 1));
+  return count == graph->numberOfNodes();
 }
 //=================================================================
 bool BiconnectedTest::isBiconnected(const tlp::Graph *graph) {
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2023  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -11,47 +11,157 @@
  *
  */
 
+#include <atomic>
+
 #include <talipot/ConnectedTest.h>
 #include <talipot/ConnectedTestListener.h>
+#include <talipot/ParallelTools.h>
 #include <talipot/VectorProperty.h>
 
 using namespace std;
 using namespace tlp;
 //=================================================================
-static ConnectedTestListener instance;
+static ConnectedComponentsListener instance;
+// the minimum number of nodes for which the components are computed in parallel
+static const uint PARALLEL_MIN_NODES = 50000;
 //=================================================================
-bool ConnectedTest::isConnected(const tlp::Graph *const graph) {
-  if (instance.resultsBuffer.find(graph) != instance.resultsBuffer.end()) {
-    return instance.resultsBuffer[graph];
+static bool computeInParallel(const Graph *graph) {
+  return TLP_NB_THREADS > 1 && graph->numberOfNodes() >= PARALLEL_MIN_NODES;
+}
+//=================================================================
+// returns the root of the tree of i in a concurrent union-find forest,
+// halving the path to it
+static uint concurrentFind(vector<uint> &parents, uint i) {
+  uint parent = atomic_ref<uint>(parents[i]).load(memory_order_relaxed);
+
+  while (parent != i) {
+    uint grandParent = atomic_ref<uint>(parents[parent]).load(memory_order_relaxed);
+    // the grand parent is still an ancestor if another thread changed the parent in between
+    atomic_ref<uint>(parents[i]).compare_exchange_weak(parent, grandParent, memory_order_relaxed);
+    i = parent;
+    parent = atomic_ref<uint>(parents[i]).load(memory_order_relaxed);
+  }
+
+  return i;
+}
+//=================================================================
+// computes in parallel, for each node position, the position of the first node of its component.
+// The edges are processed concurrently in a union-find forest, in the manner of Shiloach and
+// Vishkin: a root is only hooked to a smaller one, with an atomic compare and swap, so the root
+// of each tree is its first node and no cycle can be created
+static vector<uint> parallelComponentRoots(const Graph *graph) {
+  uint nbNodes = graph->numberOfNodes();
+  const vector<edge> &edges = graph->edges();
+  vector<uint> parents(nbNodes);
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) { parents[i] = i; });
+
+  TLP_PARALLEL_MAP_INDICES(edges.size(), [&](uint i) {
+    const auto &[src, tgt] = graph->ends(edges[i]);
+    uint u = graph->nodePos(src);
+    uint v = graph->nodePos(tgt);
+
+    while (true) {
+      u = concurrentFind(parents, u);
+      v = concurrentFind(parents, v);
+
+      if (u == v) {
+        break;
+      }
+
+      if (u < v) {
+        std::swap(u, v);
+      }
+
+      // fails if another thread has hooked u in the meantime
+      uint expected = u;
+
+      if (atomic_ref<uint>(parents[u]).compare_exchange_strong(expected, v, memory_order_relaxed)) {
+        break;
+      }
+    }
+  });
+
+  vector<uint> roots(nbNodes);
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) { roots[i] = concurrentFind(parents, i); });
+  return roots;
+}
+//=================================================================
+// returns the number of connected components of a graph, which are computed when first needed
+// then updated by the listener
+static uint graphNbComponents(const Graph *graph) {
+  auto it = instance.componentsBuffer.find(graph);
+
+  if (it == instance.componentsBuffer.end()) {
+    const vector<node> &nodes = graph->nodes();
+    uint nbIds = 0;
+
+    for (auto n : nodes) {
+      nbIds = std::max(nbIds, n.id + 1);
+    }
+
+    ConnectedComponentsListener::Components &components = instance.componentsBuffer[graph];
+    // the partition must not be much larger than the graph, as for a small subgraph
+    // of a large graph
+    components.sparse = nbIds > 2 * nodes.size();
+
+    if (components.sparse) {
+      components.sets.reset(nodes.size());
+      components.slots.reserve(nodes.size());
+
+      for (uint i = 0; i < nodes.size(); ++i) {
+        components.slots[nodes[i].id] = i;
+      }
+    } else {
+      components.sets.reset(nbIds);
+    }
+
+    if (computeInParallel(graph)) {
+      vector<uint> roots = parallelComponentRoots(graph);
+
+      for (uint i = 0; i < roots.size(); ++i) {
+        components.merge(nodes[i], nodes[roots[i]]);
+      }
+    } else {
+      for (auto e : graph->edges()) {
+        const auto &[src, tgt] = graph->ends(e);
+        components.merge(src, tgt);
+      }
+    }
+
+    graph->addListener(instance);
+    it = instance.componentsBuffer.find(graph);
   }
 
+  // the slots which are not the ones of nodes of the graph are alone in their sets
+  const UnionFind &sets = it->second.sets;
+  return sets.numberOfSets() - (sets.numberOfElements() - graph->numberOfNodes());
+}
+//=================================================================
+bool ConnectedTest::isConnected(const tlp::Graph *const graph) {
   if (graph->isEmpty()) {
     return true;
   }
 
   // graph cannot be connected with that configuration
-  if (graph->numberOfEdges() < graph->numberOfNodes() - 1) {
+  if (!instance.componentsBuffer.contains(graph) &&
+      graph->numberOfEdges() < graph->numberOfNodes() - 1) {
     return false;
   }
 
-  graph->addListener(instance);
-  return instance.resultsBuffer[graph] = (graph->bfs().size() == graph->numberOfNodes());
+  return graphNbComponents(graph) == 1;
 }
 //=================================================================
 vector<edge> ConnectedTest::makeConnected(Graph *graph) {
   vector<edge> addedEdges;
   if (!isConnected(graph)) {
-    graph->removeListener(instance);
-    instance.resultsBuffer.erase(graph);
     auto components = computeConnectedComponents(graph);
     for (uint i = 1; i < components.size(); ++i) {
       addedEdges.push_back(graph->addEdge(components[i - 1][0], components[i][0]));
     }
-    graph->addListener(instance);
   }
 
   assert(isConnected(graph));
-  instance.resultsBuffer[graph] = true;
   return addedEdges;
 }
 //=================================================================
@@ -59,24 +169,54 @@ uint ConnectedTest::numberOfConnectedComponents(const tlp::Graph *const graph) {
   if (graph->isEmpty()) {
     return 0u;
   }
-  graph->removeListener(instance);
-  uint result = computeConnectedComponents(graph).size();
-  graph->addListener(instance);
-  return result;
+  return graphNbComponents(graph);
 }
 //======================================================================
 vector<vector<node>> ConnectedTest::computeConnectedComponents(const tlp::Graph *graph) {
   vector<vector<node>> components;
+
+  if (computeInParallel(graph)) {
+    // the nodes of each component are in the order of the graph
+    const vector<node> &nodes = graph->nodes();
+    vector<uint> roots = parallelComponentRoots(graph);
+    vector<uint> componentIndices(nodes.size());
+
+    for (uint i = 0; i < nodes.size(); ++i) {
+      if (roots[i] == i) {
+        componentIndices[i] = components.size();
+        components.emplace_back();
+      }
+
+      components[componentIndices[roots[i]]].push_back(nodes[i]);
+    }
+
+    return components;
+  }
+
   auto visited = NodeVectorProperty<bool>(graph);
   visited.setAll(false);
-  // do a bfs traversal for each node
+  // do a bfs traversal for each node, the visited nodes are shared by all
+  // the traversals so the components are computed in linear time
   for (auto n : graph->nodes()) {
     // check if curNode has been already visited
     if (!visited[n]) {
       // add a new component by doing a bfs traversal from this node
-      components.push_back(graph->bfs(n));
-      for (auto nc : components.back()) {
-        visited[nc] = true;
+      components.emplace_back();
+      vector<node> &component = components.back();
+      visited[n] = true;
+      component.push_back(n);
+
+      for (uint i = 0; i < component.size(); ++i) {
+        node current = component[i];
+
+        for (auto e : graph->incidence(current)) {
+          node neigh = graph->opposite(e, current);
+
+          if (!visited[neigh]) {
+            visited[neigh] = true;
+            component.push_back(neigh);
+          }
+        }
       }
     }
   }
@@ -85,40 +225,62 @@ vector<vector<node>> ConnectedTest::computeConnectedComponents(const tlp::Graph
 //=================================================================
 
 // algorithm implementation adapted from https://cp-algorithms.com/graph/bridge-searching.html
+// with an explicit dfs stack, so the depth of the search is not limited by the call stack
 vector<edge> ConnectedTest::computeBridges(const Graph *graph) {
   auto visited = NodeVectorProperty<bool>(graph);
   auto tin = NodeVectorProperty<uint>(graph);
   auto low = NodeVectorProperty<uint>(graph);
   uint timer = 0;
   vector<edge> bridges;
-
-  function<void(node, node)> dfsBridges = [&](node n, node p) {
-    visited[n] = true;
-    tin[n] = low[n] = timer++;
-    for (edge e : graph->incidence(n)) {
-      node m = graph->opposite(e, n);
-      if (m == p) {
-        continue;
-      }
-      if (visited[m]) {
-        low[n] = min(low[n], tin[m]);
-      } else {
-        dfsBridges(m, n);
-        low[n] = min(low[n], low[m]);
-        if (low[m] > tin[n]) {
-          bridges.push_back(e);
-        }
-      }
-    }
-  };
+  // the nodes of the current dfs path, with the position of their next incident edge
+  vector<pair<node, uint>> dfsStack;
 
   visited.setAll(false);
   tin.setAll(-1);
   low.setAll(-1);
 
-  for (auto n : graph->nodes()) {
-    if (!visited[n]) {
-      dfsBridges(n, node());
+  for (auto root : graph->nodes()) {
+    if (visited[root]) {
+      continue;
+    }
+
+    visited[root] = true;
+    tin[root] = low[root] = timer++;
+    dfsStack.emplace_back(root, 0);
+
+    while (!dfsStack.empty()) {
+      auto &[n, i] = dfsStack.back();
+      const vector<edge> &incidence = graph->incidence(n);
+
+      if (i < incidence.size()) {
+        node m = graph->opposite(incidence[i++], n);
+
+        // skip the edges to the parent node
+        if (dfsStack.size() > 1 && m == dfsStack[dfsStack.size() - 2].first) {
+          continue;
+        }
+
+        if (visited[m]) {
+          low[n] = min(low[n], tin[m]);
+        } else {
+          visited[m] = true;
+          tin[m] = low[m] = timer++;
+          dfsStack.emplace_back(m, 0);
+        }
+      } else {
+        node m = n;
+        dfsStack.pop_back();
+
+        if (!dfsStack.empty()) {
+          auto &[p, j] = dfsStack.back();
+          low[p] = min(low[p], low[m]);
+
+          if (low[m] > tin[p]) {
+            // the edge followed from p to m
+            bridges.push_back(graph->incidence(p)[j - 1]);
+          }
+        }
+      }
     }
   }
 
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2023  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -65,3 +65,97 @@ void ConnectedTestListener::treatEvent(const Event &evt) {
     }
   }
 }
+
+// adds a node alone in its component, and returns false if its id is too large
+// for the ids to be the slots of the partition anymore
+static bool addNode(ConnectedComponentsListener::Components &components, const Graph *graph,
+                    node n) {
+  UnionFind &sets = components.sets;
+
+  if (components.sparse) {
+    components.slots[n.id] = sets.addElement();
+    return true;
+  }
+
+  if (n.id >= 2 * graph->numberOfNodes()) {
+    return false;
+  }
+
+  while (sets.numberOfElements() <= n.id) {
+    sets.addElement();
+  }
+
+  return true;
+}
+
+void ConnectedComponentsListener::treatEvent(const Event &evt) {
+  const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt);
+
+  if (gEvt) {
+    Graph *graph = gEvt->getGraph();
+    auto it = componentsBuffer.find(graph);
+
+    if (it == componentsBuffer.end()) {
+      return;
+    }
+
+    Components &components = it->second;
+    bool upToDate = true;
+
+    switch (gEvt->getType()) {
+    case GraphEventType::TLP_ADD_NODE:
+      upToDate = addNode(components, graph, gEvt->getNode());
+      break;
+
+    case GraphEventType::TLP_ADD_NODES:
+
+      for (auto n : gEvt->getNodes()) {
+        if (!addNode(components, graph, n)) {
+          upToDate = false;
+          break;
+        }
+      }
+
+      break;
+
+    case GraphEventType::TLP_ADD_EDGE: {
+      const auto &[src, tgt] = graph->ends(gEvt->getEdge());
+      components.merge(src, tgt);
+      break;
+    }
+
+    case GraphEventType::TLP_ADD_EDGES:
+
+      for (auto e : gEvt->getEdges()) {
+        const auto &[src, tgt] = graph->ends(e);
+        components.merge(src, tgt);
+      }
+
+      break;
+
+    case GraphEventType::TLP_DEL_NODE:
+    case GraphEventType::TLP_DEL_EDGE:
+    case GraphEventType::TLP_AFTER_SET_ENDS:
+      // a deletion may split a component
+      upToDate = false;
+      break;
+
+    default:
+      // we don't care about other events
+      break;
+    }
+
+    // the components will be computed again when needed
+    if (!upToDate) {
+      graph->removeListener(this);
+      componentsBuffer.erase(it);
+    }
+  } else {
+
+    auto *graph = static_cast<Graph *>(evt.sender());
+
+    if (evt.type() == EventType::TLP_DELETE) {
+      componentsBuffer.erase(graph);
+    }
+  }
+}
@@ -0,0 +1,262 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/FrameProfiler.h>
+#include <talipot/TlpTools.h>
+
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace tlp {
+
+atomic<bool> FrameProfiler::enabled(false);
+
+namespace {
+
+struct OpenedFrame {
+  ProfiledFrame frame;
+  steady_clock::time_point startTime;
+};
+
+// the profiler state, only accessed under the lock of its mutex
+struct ProfilerState {
+  mutex lock;
+  const steady_clock::time_point creationTime = steady_clock::now();
+  uint capacity = 256;
+  uint nbFrames = 0;
+  // index of the oldest frame in the ring buffer
+  uint firstFrame = 0;
+  uint nextFrameId = 0;
+  vector<ProfiledFrame> ringBuffer;
+  vector<OpenedFrame> openedFrames;
+};
+
+ProfilerState &profilerState() {
+  static ProfilerState state;
+  return state;
+}
+
+// returns the recorded frames from the oldest to the newest, the lock must be held
+vector<ProfiledFrame> orderedFrames(const ProfilerState &state) {
+  vector<ProfiledFrame> result;
+  result.reserve(state.nbFrames);
+
+  for (uint i = 0; i < state.nbFrames; ++i) {
+    result.push_back(state.ringBuffer[(state.firstFrame + i) % state.nbFrames]);
+  }
+
+  return result;
+}
+
+double microseconds(steady_clock::duration duration) {
+  return duration_cast<nanoseconds>(duration).count() / 1000.0;
+}
+
+void writeJsonString(ostream &os, const string &str) {
+  os << '"';
+
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << ' ';
+    } else {
+      os << c;
+    }
+  }
+
+  os << '"';
+}
+
+void writeTraceEvent(ostream &os, const string &name, const char *category, double start,
+                     double duration, const ProfiledFrame &frame, const uint *nbElements) {
+  os << "{\"name\":";
+  writeJsonString(os, name);
+  // the times are in microseconds, with the default precision they would be rounded
+  // to six significant digits after one second of tracing
+  ios_base::fmtflags flags = os.flags();
+  streamsize precision = os.precision();
+  os << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << fixed
+     << setprecision(3) << start << ",\"dur\":" << duration;
+  os.flags(flags);
+  os.precision(precision);
+  os << ",\"args\":{\"frame\":" << frame.id;
+
+  if (nbElements) {
+    os << ",\"elements\":" << *nbElements;
+  }
+
+  os << "}}";
+}
+}
+
+FrameProfiler::StageTimer::StageTimer(const char *name)
+    : name(name), active(FrameProfiler::isEnabled()), nbElements(0) {
+  if (active) {
+    startTime = steady_clock::now();
+  }
+}
+
+FrameProfiler::StageTimer::~StageTimer() {
+  stop();
+}
+
+void FrameProfiler::StageTimer::stop() {
+  if (active) {
+    FrameProfiler::addStage(name, startTime, steady_clock::now(), nbElements);
+    active = false;
+  }
+}
+
+void FrameProfiler::setEnabled(bool enabled) {
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+  FrameProfiler::enabled.store(enabled, memory_order_relaxed);
+
+  if (!enabled) {
+    // the frames being drawn will not be ended
+    state.openedFrames.clear();
+  }
+}
+
+void FrameProfiler::setCapacity(uint nbFrames) {
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+  // the frames are read under the same lock, so none can be ended in between
+  vector<ProfiledFrame> recordedFrames = orderedFrames(state);
+  state.capacity = max(1u, nbFrames);
+  // keep the newest frames
+  uint nbKept = min(uint(recordedFrames.size()), state.capacity);
+  state.ringBuffer.assign(make_move_iterator(recordedFrames.end() - nbKept),
+                          make_move_iterator(recordedFrames.end()));
+  state.nbFrames = nbKept;
+  state.firstFrame = 0;
+}
+
+uint FrameProfiler::capacity() {
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+  return state.capacity;
+}
+
+void FrameProfiler::beginFrame(const string &name) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+  OpenedFrame openedFrame;
+  openedFrame.startTime = steady_clock::now();
+  openedFrame.frame.id = state.nextFrameId++;
+  openedFrame.frame.name = name;
+  openedFrame.frame.start = microseconds(openedFrame.startTime - state.creationTime);
+  state.openedFrames.push_back(std::move(openedFrame));
+}
+
+void FrameProfiler::endFrame() {
+  // no frame is opened while the profiler is disabled
+  if (!isEnabled()) {
+    return;
+  }
+
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+
+  if (state.openedFrames.empty()) {
+    return;
+  }
+
+  ProfiledFrame frame = std::move(state.openedFrames.back().frame);
+  frame.duration = microseconds(steady_clock::now() - state.openedFrames.back().startTime);
+  state.openedFrames.pop_back();
+
+  if (state.nbFrames < state.capacity) {
+    state.ringBuffer.push_back(std::move(frame));
+    ++state.nbFrames;
+  } else {
+    // overwrite the oldest frame
+    state.ringBuffer[state.firstFrame] = std::move(frame);
+    state.firstFrame = (state.firstFrame + 1) % state.capacity;
+  }
+}
+
+void FrameProfiler::addStage(const char *name, steady_clock::time_point startTime,
+                             steady_clock::time_point endTime, uint nbElements) {
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+
+  if (state.openedFrames.empty()) {
+    return;
+  }
+
+  OpenedFrame &openedFrame = state.openedFrames.back();
+  openedFrame.frame.stages.push_back({name, microseconds(startTime - openedFrame.startTime),
+                                      microseconds(endTime - startTime), nbElements});
+}
+
+vector<ProfiledFrame> FrameProfiler::frames() {
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+  return orderedFrames(state);
+}
+
+uint FrameProfiler::numberOfFrames() {
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+  return state.nbFrames;
+}
+
+void FrameProfiler::clear() {
+  ProfilerState &state = profilerState();
+  lock_guard<mutex> guard(state.lock);
+  state.ringBuffer.clear();
+  state.nbFrames = 0;
+  state.firstFrame = 0;
+}
+
+void FrameProfiler::writeChromeTrace(ostream &os) {
+  os << "{\"traceEvents\":[";
+  bool first = true;
+
+  for (const auto &frame : frames()) {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    writeTraceEvent(os, frame.name, "frame", frame.start, frame.duration, frame, nullptr);
+
+    for (const auto &stage : frame.stages) {
+      os << ",\n";
+      writeTraceEvent(os, stage.name, "stage", frame.start + stage.start, stage.duration, frame,
+                      &stage.nbElements);
+    }
+  }
+
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool FrameProfiler::saveChromeTrace(const string &filename) {
+  unique_ptr<ostream> os(getOutputFileStream(filename));
+
+  if (!os->good()) {
+    return false;
+  }
+
+  writeChromeTrace(*os);
+  return os->good();
+}
+}
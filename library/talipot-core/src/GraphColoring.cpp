@@ -0,0 +1,199 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <numeric>
+
+#include <talipot/GraphColoring.h>
+#include <talipot/Graph.h>
+#include <talipot/ParallelTools.h>
+
+using namespace std;
+using namespace tlp;
+
+GraphColoring::GraphColoring(const Graph *graph) : nbColors(0), nbRounds(0) {
+  uint nbNodes = graph->numberOfNodes();
+  adjStart.assign(nbNodes + 1, 0);
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    if (src != tgt) {
+      ++adjStart[graph->nodePos(src) + 1];
+      ++adjStart[graph->nodePos(tgt) + 1];
+    }
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    adjStart[i + 1] += adjStart[i];
+  }
+
+  adjNodes.resize(adjStart[nbNodes]);
+  vector<uint> next(adjStart.begin(), adjStart.end() - 1);
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    if (src != tgt) {
+      uint srcPos = graph->nodePos(src);
+      uint tgtPos = graph->nodePos(tgt);
+      adjNodes[next[srcPos]++] = tgtPos;
+      adjNodes[next[tgtPos]++] = srcPos;
+    }
+  }
+
+  degrees.reserve(nbNodes);
+  nodeIds.reserve(nbNodes);
+
+  for (auto n : graph->nodes()) {
+    degrees.push_back(graph->deg(n));
+    nodeIds.push_back(n.id);
+  }
+}
+
+vector<uint> GraphColoring::largestDegreeFirstOrdering() const {
+  vector<uint> result(adjStart.size() - 1);
+  std::iota(result.begin(), result.end(), 0);
+  std::sort(result.begin(), result.end(), [&](uint u, uint v) {
+    uint du = degrees[u], dv = degrees[v];
+    return du == dv ? nodeIds[u] > nodeIds[v] : du > dv;
+  });
+  return result;
+}
+
+uint GraphColoring::run(const vector<uint> &nodesOrdering, bool parallel) {
+  uint nbNodes = adjStart.size() - 1;
+
+  if (nodesOrdering.empty()) {
+    ordering.resize(nbNodes);
+    std::iota(ordering.begin(), ordering.end(), 0);
+  } else {
+    ordering = nodesOrdering;
+  }
+
+  colors.assign(nbNodes, UINT_MAX);
+  nbColors = nbRounds = 0;
+
+  if (nbNodes == 0) {
+    return 0;
+  }
+
+  uint maxDeg = 0;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    maxDeg = std::max(maxDeg, adjStart[i + 1] - adjStart[i]);
+  }
+
+  // the nodes to color are split in a chunk per thread, and the colors used by the neighbours
+  // of the node being colored are marked with a stamp in a buffer of each chunk.
+  // A node of degree d always has a free color in [0, d]
+  uint nbChunks = parallel ? TLP_NB_THREADS : 1;
+  vector<vector<uint>> chunkMarks(nbChunks);
+  vector<uint> chunkStamps(nbChunks, 0);
+
+  // the neighbours may be colored concurrently, so their colors are read atomically
+  auto colorNode = [&](uint n, uint chunk) {
+    vector<uint> &marks = chunkMarks[chunk];
+
+    if (marks.empty()) {
+      marks.assign(maxDeg + 1, 0);
+    }
+
+    uint stamp = ++chunkStamps[chunk];
+
+    for (uint i = adjStart[n]; i < adjStart[n + 1]; ++i) {
+      uint color = atomic_ref<uint>(colors[adjNodes[i]]).load(memory_order_relaxed);
+
+      if (color <= maxDeg) {
+        marks[color] = stamp;
+      }
+    }
+
+    uint color = 0;
+
+    while (marks[color] == stamp) {
+      ++color;
+    }
+
+    atomic_ref<uint>(colors[n]).store(color, memory_order_relaxed);
+  };
+
+  if (!parallel) {
+    nbRounds = 1;
+
+    for (auto n : ordering) {
+      colorNode(n, 0);
+    }
+  } else {
+    vector<uint> ranks(nbNodes);
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) { ranks[ordering[i]] = i; });
+
+    vector<uint> toColor = ordering;
+    vector<uint8_t> conflicts;
+
+    while (!toColor.empty()) {
+      ++nbRounds;
+
+      uint nbToColor = toColor.size();
+      uint chunkSize = (nbToColor + nbChunks - 1) / nbChunks;
+
+      TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+        for (uint i = c * chunkSize; i < std::min(nbToColor, (c + 1) * chunkSize); ++i) {
+          colorNode(toColor[i], c);
+        }
+      });
+
+      // a node having the color of a neighbour of higher priority is colored again
+      conflicts.assign(toColor.size(), 0);
+
+      TLP_PARALLEL_MAP_INDICES(toColor.size(), [&](uint i) {
+        uint n = toColor[i];
+
+        for (uint j = adjStart[n]; j < adjStart[n + 1]; ++j) {
+          uint neighbour = adjNodes[j];
+
+          if (colors[neighbour] == colors[n] && ranks[neighbour] < ranks[n]) {
+            conflicts[i] = 1;
+            break;
+          }
+        }
+      });
+
+      uint nbConflicts = 0;
+
+      for (uint i = 0; i < toColor.size(); ++i) {
+        if (conflicts[i]) {
+          toColor[nbConflicts++] = toColor[i];
+        }
+      }
+
+      toColor.resize(nbConflicts);
+    }
+  }
+
+  nbColors = *std::max_element(colors.begin(), colors.end()) + 1;
+  return nbColors;
+}
+
+vector<vector<uint>> GraphColoring::independentSets() const {
+  vector<vector<uint>> sets(nbColors);
+
+  for (auto n : ordering) {
+    sets[colors[n]].push_back(n);
+  }
+
+  return sets;
+}
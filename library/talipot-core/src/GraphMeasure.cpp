@@ -11,8 +11,13 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
 #include <talipot/Dijkstra.h>
 #include <talipot/GraphMeasure.h>
+#include <talipot/MultiSourceBFS.h>
 
 using namespace std;
 using namespace tlp;
@@ -73,45 +78,60 @@ double tlp::maxDistance(const Graph *graph, node n, tlp::NodeVectorProperty<doub
   return 0.;
 }
 //================================================================
-// Warning the algorithm is not optimal
 double tlp::averagePathLength(const Graph *graph) {
+  uint nbNodes = graph->numberOfNodes();
+
+  if (nbNodes < 2) {
+    return 0;
+  }
+
+  MultiSourceBFS bfs(graph);
+  bfs.run();
   double result = 0;
 
+  for (uint i = 0; i < nbNodes; ++i) {
+    result += bfs.sourceDistancesSum(i);
+  }
+
+  return result / (nbNodes * (nbNodes - 1.));
+}
+//================================================================
+double tlp::averagePathLength(const Graph *graph, uint nbSamples, double *errorBound) {
   uint nbNodes = graph->numberOfNodes();
 
-  if (nbNodes < 2) {
-    return result;
+  if (errorBound) {
+    *errorBound = 0;
   }
 
-  TLP_PARALLEL_MAP_NODES(graph, [&](node n) {
-    tlp::NodeVectorProperty<uint> distance(graph);
-    maxDistance(graph, n, distance, EdgeType::UNDIRECTED);
+  if (nbSamples >= nbNodes || nbNodes < 2) {
+    return averagePathLength(graph);
+  }
 
-    double tmp = 0;
+  MultiSourceBFS bfs(graph);
+  bfs.run(MultiSourceBFS::randomSources(nbNodes, nbSamples));
+  // the average of the distances from each sampled node to all the other nodes
+  double sum = 0, sumOfSquares = 0;
 
-    for (auto nn : graph->nodes()) {
-      if (nn == n) {
-        continue;
-      }
-      uint d = distance[nn];
-      if (d != UINT_MAX) {
-        tmp += d;
-      }
-    }
+  for (uint i = 0; i < nbSamples; ++i) {
+    double average = bfs.sourceDistancesSum(i) / (nbNodes - 1.);
+    sum += average;
+    sumOfSquares += average * average;
+  }
 
-    TLP_LOCK_SECTION(SUMPATH) {
-      result += tmp;
-    }
-    TLP_UNLOCK_SECTION(SUMPATH);
-  });
+  double mean = sum / nbSamples;
 
-  result /= (nbNodes * (nbNodes - 1.));
-  return result;
+  if (errorBound && nbSamples > 1) {
+    // the half width of the 95% confidence interval of the mean
+    double variance = std::max(0.0, (sumOfSquares - nbSamples * mean * mean) / (nbSamples - 1));
+    *errorBound = 1.96 * sqrt(variance / nbSamples);
+  }
+
+  return mean;
 }
 //================================================================
 double tlp::averageClusteringCoefficient(const Graph *graph) {
   tlp::NodeVectorProperty<double> clusters(graph);
-  tlp::clusteringCoefficient(graph, clusters, UINT_MAX);
+  tlp::clusteringCoefficient(graph, clusters);
   uint nbNodes = graph->numberOfNodes();
   double sum = 0;
 
@@ -138,26 +158,259 @@ uint tlp::minDegree(const Graph *graph) {
   return mindeg;
 }
 //=================================================
+namespace {
+// The adjacency of a graph in compressed sparse row format, without its self loops
+// and its multiple edges, the nodes being numbered by increasing degree.
+// The neighbours of each node are sorted, so its neighbours of higher degree
+// are at the end of its list.
+struct SimpleAdjacency {
+  // the number of each node, indexed by its position in the graph
+  vector<uint> ranks;
+  vector<uint> start;
+  vector<uint> neighbours;
+  // the position in the neighbours of a node of its first neighbour of higher degree
+  vector<uint> higherStart;
+
+  SimpleAdjacency(const Graph *graph) {
+    uint nbNodes = graph->numberOfNodes();
+    vector<uint> degrees(nbNodes, 0);
+    vector<pair<uint, uint>> ends;
+    ends.reserve(graph->numberOfEdges());
+
+    for (auto e : graph->edges()) {
+      const auto &[src, tgt] = graph->ends(e);
+
+      if (src != tgt) {
+        uint srcPos = graph->nodePos(src);
+        uint tgtPos = graph->nodePos(tgt);
+        ends.emplace_back(srcPos, tgtPos);
+        ++degrees[srcPos];
+        ++degrees[tgtPos];
+      }
+    }
+
+    vector<uint> order(nbNodes);
+    iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint i, uint j) { return degrees[i] < degrees[j]; });
+    ranks.resize(nbNodes);
+    vector<uint> multiStart(nbNodes + 1, 0);
+
+    for (uint i = 0; i < nbNodes; ++i) {
+      ranks[order[i]] = i;
+      multiStart[i + 1] = multiStart[i] + degrees[order[i]];
+    }
+
+    vector<uint> multiNeighbours(multiStart[nbNodes]);
+    vector<uint> next(multiStart.begin(), multiStart.end() - 1);
+
+    for (const auto &[srcPos, tgtPos] : ends) {
+      uint u = ranks[srcPos];
+      uint v = ranks[tgtPos];
+      multiNeighbours[next[u]++] = v;
+      multiNeighbours[next[v]++] = u;
+    }
+
+    // sort the neighbours of each node and remove the duplicates
+    vector<uint> nbNeighbours(nbNodes);
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint u) {
+      auto begin = multiNeighbours.begin() + multiStart[u];
+      auto end = multiNeighbours.begin() + multiStart[u + 1];
+      std::sort(begin, end);
+      nbNeighbours[u] = std::unique(begin, end) - begin;
+    });
+
+    start.resize(nbNodes + 1);
+    start[0] = 0;
+
+    for (uint u = 0; u < nbNodes; ++u) {
+      start[u + 1] = start[u] + nbNeighbours[u];
+    }
+
+    neighbours.resize(start[nbNodes]);
+    higherStart.resize(nbNodes);
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint u) {
+      auto first = multiNeighbours.begin() + multiStart[u];
+      auto last = std::copy(first, first + nbNeighbours[u], neighbours.begin() + start[u]);
+      higherStart[u] = std::upper_bound(last - nbNeighbours[u], last, u) - neighbours.begin();
+    });
+  }
+
+  uint numberOfNodes() const {
+    return ranks.size();
+  }
+
+  uint degree(uint u) const {
+    return start[u + 1] - start[u];
+  }
+
+  // the position of v in the neighbours of u, which must be one of them
+  uint neighbourPos(uint u, uint v) const {
+    auto begin = neighbours.begin() + start[u];
+    return std::lower_bound(begin, neighbours.begin() + start[u + 1], v) - neighbours.begin();
+  }
+};
+
+// Each triangle u < v < w is found once, from its node of lowest degree u, by merging the
+// neighbours of u after v with the neighbours of v after v, so that the lists to intersect
+// have less than sqrt(2m) elements. The nodes are processed in parallel.
+// nodeTriangles is indexed by node number and edgeTriangles by neighbour position,
+// the number of triangles of a pair of neighbours u < v being stored at the position of v
+// in the neighbours of u.
+uint64_t enumerateTriangles(const SimpleAdjacency &adjacency, vector<uint64_t> *nodeTriangles,
+                            vector<uint> *edgeTriangles) {
+  const vector<uint> &neighbours = adjacency.neighbours;
+  uint nbNodes = adjacency.numberOfNodes();
+  uint64_t nbTriangles = 0;
+
+  if (nodeTriangles) {
+    nodeTriangles->assign(nbNodes, 0);
+  }
+
+  if (edgeTriangles) {
+    edgeTriangles->assign(neighbours.size(), 0);
+  }
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint u) {
+    uint end = adjacency.start[u + 1];
+    uint64_t nbUTriangles = 0;
+
+    for (uint i = adjacency.higherStart[u]; i < end; ++i) {
+      uint v = neighbours[i];
+      uint vEnd = adjacency.start[v + 1];
+      uint j = i + 1;
+      uint k = adjacency.higherStart[v];
+
+      while (j < end && k < vEnd) {
+        if (neighbours[j] < neighbours[k]) {
+          ++j;
+        } else if (neighbours[k] < neighbours[j]) {
+          ++k;
+        } else {
+          ++nbUTriangles;
+
+          if (nodeTriangles) {
+            atomic_ref<uint64_t>((*nodeTriangles)[v]).fetch_add(1, memory_order_relaxed);
+            atomic_ref<uint64_t>((*nodeTriangles)[neighbours[j]])
+                .fetch_add(1, memory_order_relaxed);
+          }
+
+          if (edgeTriangles) {
+            atomic_ref<uint>((*edgeTriangles)[i]).fetch_add(1, memory_order_relaxed);
+            atomic_ref<uint>((*edgeTriangles)[j]).fetch_add(1, memory_order_relaxed);
+            atomic_ref<uint>((*edgeTriangles)[k]).fetch_add(1, memory_order_relaxed);
+          }
+
+          ++j;
+          ++k;
+        }
+      }
+    }
+
+    if (nodeTriangles) {
+      atomic_ref<uint64_t>((*nodeTriangles)[u]).fetch_add(nbUTriangles, memory_order_relaxed);
+    }
+
+    atomic_ref<uint64_t>(nbTriangles).fetch_add(nbUTriangles, memory_order_relaxed);
+  });
+
+  return nbTriangles;
+}
+}
+//=================================================
+uint64_t tlp::countTriangles(const Graph *graph, tlp::NodeVectorProperty<uint64_t> *nodeTriangles,
+                             tlp::EdgeVectorProperty<uint> *edgeTriangles) {
+  SimpleAdjacency adjacency(graph);
+  vector<uint64_t> trianglesByRank;
+  vector<uint> trianglesByNeighbour;
+  uint64_t nbTriangles = enumerateTriangles(adjacency, nodeTriangles ? &trianglesByRank : nullptr,
+                                            edgeTriangles ? &trianglesByNeighbour : nullptr);
+
+  if (nodeTriangles) {
+    TLP_PARALLEL_MAP_INDICES(graph->numberOfNodes(), [&](uint i) {
+      (*nodeTriangles)[i] = trianglesByRank[adjacency.ranks[i]];
+    });
+  }
+
+  if (edgeTriangles) {
+    // the multiple edges between two nodes have the same number of triangles
+    TLP_PARALLEL_MAP_EDGES(graph, [&](edge e) {
+      const auto &[src, tgt] = graph->ends(e);
+      uint u = adjacency.ranks[graph->nodePos(src)];
+      uint v = adjacency.ranks[graph->nodePos(tgt)];
+
+      if (u == v) {
+        (*edgeTriangles)[e] = 0;
+      } else {
+        (*edgeTriangles)[e] = trianglesByNeighbour[adjacency.neighbourPos(min(u, v), max(u, v))];
+      }
+    });
+  }
+
+  return nbTriangles;
+}
+//=================================================
+double tlp::transitivity(const Graph *graph) {
+  SimpleAdjacency adjacency(graph);
+  double nbTriples = 0;
+
+  for (uint u = 0; u < adjacency.numberOfNodes(); ++u) {
+    double deg = adjacency.degree(u);
+    nbTriples += deg * (deg - 1) / 2;
+  }
+
+  if (nbTriples == 0) {
+    return 0;
+  }
+
+  return 3 * enumerateTriangles(adjacency, nullptr, nullptr) / nbTriples;
+}
+//=================================================
 void tlp::clusteringCoefficient(const Graph *graph, tlp::NodeVectorProperty<double> &clusters,
                                 uint maxDepth) {
+  if (maxDepth <= 1) {
+    SimpleAdjacency adjacency(graph);
+    vector<uint64_t> nodeTriangles;
+    enumerateTriangles(adjacency, &nodeTriangles, nullptr);
+
+    TLP_PARALLEL_MAP_INDICES(graph->numberOfNodes(), [&](uint i) {
+      uint u = adjacency.ranks[i];
+      double deg = adjacency.degree(u);
+      clusters[i] = deg > 1 ? nodeTriangles[u] / (deg * (deg - 1) / 2) : 0;
+    });
+
+    return;
+  }
+
+  // the neighbours are deduplicated so that the multiple edges are counted once
+  SimpleAdjacency adjacency(graph);
+
+  TLP_PARALLEL_MAP_NODES_AND_INDICES(graph, [&](node n, uint i) {
+    set<uint> reachables;
+
+    for (auto r : reachableNodes(graph, n, maxDepth)) {
+      reachables.insert(adjacency.ranks[graph->nodePos(r)]);
+    }
+
+    // each pair of linked reachable nodes is counted from both of its ends
+    double nbEdges = 0;
 
-  TLP_PARALLEL_MAP_NODES(graph, [&](node n) {
-    set<node> reachables = reachableNodes(graph, n, maxDepth);
-    double nbEdges = graph->deg(n);
     for (const auto r : reachables) {
-      for (auto e : graph->incidence(r)) {
-        auto [eSrc, eTgt] = graph->ends(e);
-        if (reachables.contains(eSrc) && reachables.contains(eTgt)) {
+      for (uint j = adjacency.start[r]; j < adjacency.start[r + 1]; ++j) {
+        if (reachables.contains(adjacency.neighbours[j])) {
           ++nbEdges;
         }
       }
     }
 
-    double nbNodes = reachables.size() + 1;
+    double nbNodes = reachables.size();
+
     if (nbNodes > 1) {
-      clusters[n] = nbEdges / ((nbNodes * (nbNodes - 1)) / 2);
+      clusters[i] = nbEdges / (nbNodes * (nbNodes - 1));
     } else {
-      clusters[n] = 0;
+      clusters[i] = 0;
     }
   });
 }
@@ -18,6 +18,7 @@
 #include <talipot/Ordering.h>
 #include <talipot/Dijkstra.h>
 #include <talipot/GraphMeasure.h>
+#include <talipot/MultiSourceBFS.h>
 #include <talipot/TreeTest.h>
 #ifndef NDEBUG
 #include <talipot/AcyclicTest.h>
@@ -152,25 +153,19 @@ vector<vector<node>> computeCanonicalOrdering(PlanarConMap *carte, std::vector<e
 //======================================================================
 std::vector<node> computeGraphCenters(Graph *graph) {
   assert(ConnectedTest::isConnected(graph));
-  tlp::NodeVectorProperty<uint> dist(graph);
+  MultiSourceBFS bfs(graph);
+  bfs.run();
+  uint nbNodes = graph->numberOfNodes();
   uint minD = UINT_MAX;
 
-  TLP_PARALLEL_MAP_NODES(graph, [&](node n) {
-    tlp::NodeVectorProperty<uint> tmp(graph);
-    uint maxD = tlp::maxDistance(graph, n, tmp, EdgeType::UNDIRECTED);
-    dist[n] = maxD;
-    TLP_LOCK_SECTION(COMPUTE_MIN) {
-      if (minD > maxD) {
-        minD = maxD;
-      }
-    }
-    TLP_UNLOCK_SECTION(COMPUTE_MIN);
-  });
+  for (uint i = 0; i < nbNodes; ++i) {
+    minD = std::min(minD, bfs.eccentricity(i));
+  }
 
   vector<node> result;
-  for (auto n : graph->nodes()) {
-    if (dist[n] == minD) {
-      result.push_back(n);
+  for (uint i = 0; i < nbNodes; ++i) {
+    if (bfs.eccentricity(i) == minD) {
+      result.push_back(graph->nodes()[i]);
     }
   }
 
@@ -230,6 +230,44 @@ void LayoutProperty::scale(const tlp::Vec3f &v, const Graph *sg) {
   scale(v, sg->getNodes(), sg->getEdges());
 }
 //=================================================================================
+void LayoutProperty::setValues(const vector<Coord> &nodesCoords,
+                               const vector<vector<Coord>> &edgesBends, const Graph *sg) {
+  if (sg == nullptr) {
+    sg = graph;
+  }
+
+  assert(sg == graph || graph->isDescendantGraph(sg));
+  assert(nodesCoords.size() == sg->numberOfNodes());
+  assert(edgesBends.empty() || edgesBends.size() == sg->numberOfEdges());
+
+  Observable::holdObservers();
+
+  // invalidate the previously existing min/max computation
+  resetBoundingBox();
+
+  const vector<node> &nodes = sg->nodes();
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    // minimize computation time
+    LayoutMinMaxProperty::setNodeValue(nodes[i], nodesCoords[i]);
+  }
+
+  if (!edgesBends.empty()) {
+    const vector<edge> &edges = sg->edges();
+
+    for (uint i = 0; i < edges.size(); ++i) {
+      if (edgesBends[i] != getEdgeValue(edges[i])) {
+        // count the edges with bends and observe the graph once there is one,
+        // for the bends to be reversed with their edge
+        updateEdgeValue(edges[i], edgesBends[i]);
+        LayoutMinMaxProperty::setEdgeValue(edges[i], edgesBends[i]);
+      }
+    }
+  }
+
+  Observable::unholdObservers();
+}
+//=================================================================================
 void LayoutProperty::translate(const tlp::Vec3f &v, Iterator<node> *itN, Iterator<edge> *itE) {
 
   // nothing to do if it is the null vector
@@ -0,0 +1,239 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <cmath>
+#include <numeric>
+
+#include <talipot/LinkAnalysis.h>
+#include <talipot/Graph.h>
+#include <talipot/NumericProperty.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/PluginProgress.h>
+
+using namespace std;
+using namespace tlp;
+
+LinkAnalysis::LinkAnalysis(const Graph *graph, bool directed, const NumericProperty *weight) {
+  uint nbNodes = graph->numberOfNodes();
+  const vector<edge> &edges = graph->edges();
+  vector<double> outDegrees(nbNodes, 0);
+  adjStart.assign(nbNodes + 1, 0);
+
+  for (auto e : edges) {
+    const auto &[src, tgt] = graph->ends(e);
+    ++adjStart[graph->nodePos(tgt) + 1];
+
+    if (!directed) {
+      ++adjStart[graph->nodePos(src) + 1];
+    }
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    adjStart[i + 1] += adjStart[i];
+  }
+
+  adjNodes.resize(adjStart[nbNodes]);
+
+  if (weight) {
+    adjWeights.resize(adjStart[nbNodes]);
+  }
+
+  vector<uint> next(adjStart.begin(), adjStart.end() - 1);
+
+  for (auto e : edges) {
+    const auto &[src, tgt] = graph->ends(e);
+    uint srcPos = graph->nodePos(src);
+    uint tgtPos = graph->nodePos(tgt);
+    double w = weight ? weight->getEdgeDoubleValue(e) : 1;
+
+    if (weight) {
+      adjWeights[next[tgtPos]] = w;
+    }
+
+    adjNodes[next[tgtPos]++] = srcPos;
+    outDegrees[srcPos] += w;
+
+    if (!directed) {
+      if (weight) {
+        adjWeights[next[srcPos]] = w;
+      }
+
+      adjNodes[next[srcPos]++] = tgtPos;
+      outDegrees[tgtPos] += w;
+    }
+  }
+
+  invOutDegrees.resize(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    invOutDegrees[i] = outDegrees[i] > 0 ? 1 / outDegrees[i] : 0;
+  }
+}
+
+// sets the sums of the values of the nodes linking to each node, for each of the interleaved
+// columns of values. The columns are contiguous in the inner loop, so it can be vectorized
+template <bool weighted>
+void LinkAnalysis::pull(const vector<double> &values, vector<double> &sums, uint nbColumns) const {
+  TLP_PARALLEL_MAP_INDICES(invOutDegrees.size(), [&](uint n) {
+    double *sum = &sums[size_t(n) * nbColumns];
+    std::fill(sum, sum + nbColumns, 0.0);
+
+    for (uint i = adjStart[n]; i < adjStart[n + 1]; ++i) {
+      const double *value = &values[size_t(adjNodes[i]) * nbColumns];
+
+      if constexpr (weighted) {
+        double w = adjWeights[i];
+
+        for (uint j = 0; j < nbColumns; ++j) {
+          sum[j] += w * value[j];
+        }
+      } else {
+        for (uint j = 0; j < nbColumns; ++j) {
+          sum[j] += value[j];
+        }
+      }
+    }
+  });
+}
+
+uint LinkAnalysis::pageRank(const vector<double> &dampings, const vector<vector<double>> &teleports,
+                            vector<vector<double>> &ranks, double tolerance, uint maxIterations,
+                            PluginProgress *progress) const {
+  uint nbNodes = invOutDegrees.size();
+  uint nbColumns = dampings.size();
+  assert(teleports.size() == nbColumns);
+  ranks.assign(nbColumns, vector<double>(nbNodes, 0));
+
+  if (nbNodes == 0 || nbColumns == 0) {
+    return 0;
+  }
+
+  // the interleaved teleport vectors, scaled by 1 - d, and the ranks
+  vector<double> teleport(size_t(nbNodes) * nbColumns);
+  vector<double> rank(teleport.size());
+
+  for (uint j = 0; j < nbColumns; ++j) {
+    double sum = teleports[j].empty()
+                     ? 0
+                     : std::accumulate(teleports[j].begin(), teleports[j].end(), 0.0);
+
+    for (uint n = 0; n < nbNodes; ++n) {
+      double t = sum > 0 ? teleports[j][n] / sum : 1. / nbNodes;
+      rank[size_t(n) * nbColumns + j] = t;
+      teleport[size_t(n) * nbColumns + j] = (1 - dampings[j]) * t;
+    }
+  }
+
+  vector<double> contributions(rank.size());
+  vector<double> sums(rank.size());
+  // the residuals of each column computed by each thread
+  vector<double> residuals(size_t(TLP_NB_THREADS) * nbColumns);
+  uint iteration = 0;
+
+  while (iteration < maxIterations) {
+    ++iteration;
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint n) {
+      for (uint j = 0; j < nbColumns; ++j) {
+        contributions[size_t(n) * nbColumns + j] = rank[size_t(n) * nbColumns + j] *
+                                                   invOutDegrees[n];
+      }
+    });
+
+    if (adjWeights.empty()) {
+      pull<false>(contributions, sums, nbColumns);
+    } else {
+      pull<true>(contributions, sums, nbColumns);
+    }
+
+    std::fill(residuals.begin(), residuals.end(), 0);
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint n) {
+      double *residual = &residuals[size_t(ThreadManager::getThreadNumber()) * nbColumns];
+
+      for (uint j = 0; j < nbColumns; ++j) {
+        size_t i = size_t(n) * nbColumns + j;
+        double newRank = teleport[i] + dampings[j] * sums[i];
+        residual[j] += std::abs(newRank - rank[i]);
+        rank[i] = newRank;
+      }
+    });
+
+    bool converged = true;
+
+    for (uint j = 0; j < nbColumns && converged; ++j) {
+      double residual = 0;
+
+      for (uint t = 0; t < TLP_NB_THREADS; ++t) {
+        residual += residuals[t * nbColumns + j];
+      }
+
+      converged = residual < tolerance;
+    }
+
+    if (converged || (progress && progress->progress(iteration, maxIterations) !=
+                                      ProgressState::TLP_CONTINUE)) {
+      break;
+    }
+  }
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint n) {
+    for (uint j = 0; j < nbColumns; ++j) {
+      ranks[j][n] = rank[size_t(n) * nbColumns + j];
+    }
+  });
+
+  return iteration;
+}
+
+uint LinkAnalysis::eigenvectorCentrality(vector<double> &centralities, double tolerance,
+                                         uint maxIterations, PluginProgress *progress) const {
+  uint nbNodes = invOutDegrees.size();
+  centralities.assign(nbNodes, nbNodes ? 1 / sqrt(double(nbNodes)) : 0);
+  vector<double> sums(nbNodes);
+  uint iteration = 0;
+
+  while (iteration < maxIterations) {
+    ++iteration;
+
+    if (adjWeights.empty()) {
+      pull<false>(centralities, sums, 1);
+    } else {
+      pull<true>(centralities, sums, 1);
+    }
+
+    // the shift by the identity
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint n) { sums[n] += centralities[n]; });
+
+    double norm = sqrt(std::inner_product(sums.begin(), sums.end(), sums.begin(), 0.0));
+
+    if (norm == 0) {
+      break;
+    }
+
+    double residual = 0;
+
+    for (uint n = 0; n < nbNodes; ++n) {
+      double centrality = sums[n] / norm;
+      residual += std::abs(centrality - centralities[n]);
+      centralities[n] = centrality;
+    }
+
+    if (residual < tolerance || (progress && progress->progress(iteration, maxIterations) !=
+                                                 ProgressState::TLP_CONTINUE)) {
+      break;
+    }
+  }
+
+  return iteration;
+}
@@ -0,0 +1,262 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <atomic>
+#include <bit>
+#include <numeric>
+
+#include <talipot/MultiSourceBFS.h>
+#include <talipot/Graph.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/PluginProgress.h>
+#include <talipot/TlpTools.h>
+
+using namespace std;
+using namespace tlp;
+
+// the number of sources of a batch, i.e. of bits of a word
+static const uint BATCH_SIZE = 64;
+
+struct MultiSourceBFS::BatchSearch {
+  // for each node, the sources which have reached it, the ones of the current frontier
+  // and the ones reaching it from the frontier
+  vector<uint64_t> seen, visit, next;
+  // the nodes of the current frontier, and the ones reached from it
+  vector<uint> frontier, reached;
+  // the sums of the distances to each node and its numbers of reaching sources
+  // for the batches of the thread, added up at the end of the searches
+  vector<uint64_t> targetSums;
+  vector<uint> targetNbReaching;
+};
+
+MultiSourceBFS::MultiSourceBFS(const Graph *graph, EdgeType direction) {
+  uint nbNodes = graph->numberOfNodes();
+  adjStart.assign(nbNodes + 1, 0);
+
+  // a search goes from the source to the target of an edge if directed,
+  // and from its target to its source if inversely directed
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    if (src != tgt) {
+      if (direction != EdgeType::INV_DIRECTED) {
+        ++adjStart[graph->nodePos(src) + 1];
+      }
+
+      if (direction != EdgeType::DIRECTED) {
+        ++adjStart[graph->nodePos(tgt) + 1];
+      }
+    }
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    adjStart[i + 1] += adjStart[i];
+  }
+
+  adjNodes.resize(adjStart[nbNodes]);
+  vector<uint> next(adjStart.begin(), adjStart.end() - 1);
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    if (src != tgt) {
+      uint srcPos = graph->nodePos(src);
+      uint tgtPos = graph->nodePos(tgt);
+
+      if (direction != EdgeType::INV_DIRECTED) {
+        adjNodes[next[srcPos]++] = tgtPos;
+      }
+
+      if (direction != EdgeType::DIRECTED) {
+        adjNodes[next[tgtPos]++] = srcPos;
+      }
+    }
+  }
+}
+
+bool MultiSourceBFS::run(const vector<uint> &sourceNodes, PluginProgress *progress) {
+  uint nbNodes = adjStart.size() - 1;
+
+  if (sourceNodes.empty()) {
+    sources.resize(nbNodes);
+    iota(sources.begin(), sources.end(), 0);
+  } else {
+    sources = sourceNodes;
+  }
+
+  uint nbSources = sources.size();
+  eccentricities.assign(nbSources, 0);
+  sourceSums.assign(nbSources, 0);
+  sourceNbReached.assign(nbSources, 0);
+  targetSums.assign(nbNodes, 0);
+  targetNbReaching.assign(nbNodes, 0);
+
+  uint nbBatches = (nbSources + BATCH_SIZE - 1) / BATCH_SIZE;
+  // the searches of each thread, which are reset by the batches they run
+  vector<BatchSearch> searches(TLP_NB_THREADS);
+  atomic_uint nbTreatedBatches = 0;
+  atomic_bool stop = false;
+
+  TLP_PARALLEL_MAP_INDICES(nbBatches, [&](uint batch) {
+    if (stop.load()) {
+      return;
+    }
+
+    uint threadNumber = ThreadManager::getThreadNumber();
+    BatchSearch &search = searches[threadNumber];
+
+    if (search.seen.empty()) {
+      search.seen.resize(nbNodes);
+      search.visit.resize(nbNodes);
+      search.next.resize(nbNodes);
+      search.targetSums.resize(nbNodes);
+      search.targetNbReaching.resize(nbNodes);
+    }
+
+    runBatch(batch, search);
+    ++nbTreatedBatches;
+
+    if (progress && threadNumber == 0 &&
+        progress->progress(nbTreatedBatches.load(), nbBatches) != ProgressState::TLP_CONTINUE) {
+      stop = true;
+    }
+  });
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint n) {
+    for (const auto &search : searches) {
+      if (!search.seen.empty()) {
+        targetSums[n] += search.targetSums[n];
+        targetNbReaching[n] += search.targetNbReaching[n];
+      }
+    }
+  });
+
+  return !stop.load();
+}
+
+void MultiSourceBFS::runBatch(uint batch, BatchSearch &search) {
+  vector<uint64_t> &seen = search.seen, &visit = search.visit, &next = search.next;
+  vector<uint> &frontier = search.frontier, &reached = search.reached;
+  uint nbNodes = adjStart.size() - 1;
+  uint first = batch * BATCH_SIZE;
+  uint nbBatchSources = std::min<uint>(BATCH_SIZE, sources.size() - first);
+  // the words of visit and next are left null by the previous batch
+  std::fill(seen.begin(), seen.end(), 0);
+  frontier.clear();
+  uint nbFrontierEdges = 0;
+
+  for (uint i = 0; i < nbBatchSources; ++i) {
+    uint n = sources[first + i];
+    uint64_t bit = uint64_t(1) << i;
+
+    if (!visit[n]) {
+      frontier.push_back(n);
+      nbFrontierEdges += adjStart[n + 1] - adjStart[n];
+    }
+
+    seen[n] |= bit;
+    visit[n] |= bit;
+  }
+
+  uint64_t batchSums[BATCH_SIZE] = {};
+  uint batchNbReached[BATCH_SIZE] = {};
+  uint batchEccentricities[BATCH_SIZE] = {};
+
+  for (uint64_t distance = 1;; ++distance) {
+    // the nodes reached from a frontier having less edges than the graph has nodes are listed,
+    // else all the nodes are scanned
+    bool sparse = nbFrontierEdges < nbNodes;
+    reached.clear();
+
+    // propagate the sources of the frontier nodes to their neighbours
+    for (uint n : frontier) {
+      uint64_t sourcesN = visit[n];
+      visit[n] = 0;
+
+      for (uint i = adjStart[n]; i < adjStart[n + 1]; ++i) {
+        uint m = adjNodes[i];
+
+        if (sparse && !next[m]) {
+          reached.push_back(m);
+        }
+
+        next[m] |= sourcesN;
+      }
+    }
+
+    // the new frontier of each source is made of the nodes it has not reached before
+    uint64_t reachingSources = 0;
+    frontier.clear();
+    nbFrontierEdges = 0;
+
+    auto updateNode = [&](uint n) {
+      uint64_t newSources = next[n] & ~seen[n];
+      next[n] = 0;
+
+      if (newSources) {
+        visit[n] = newSources;
+        frontier.push_back(n);
+        nbFrontierEdges += adjStart[n + 1] - adjStart[n];
+        seen[n] |= newSources;
+        reachingSources |= newSources;
+        uint nbNewSources = popcount(newSources);
+        search.targetSums[n] += distance * nbNewSources;
+        search.targetNbReaching[n] += nbNewSources;
+
+        for (; newSources; newSources &= newSources - 1) {
+          uint i = countr_zero(newSources);
+          batchSums[i] += distance;
+          ++batchNbReached[i];
+        }
+      }
+    };
+
+    if (sparse) {
+      for (uint n : reached) {
+        updateNode(n);
+      }
+    } else {
+      for (uint n = 0; n < nbNodes; ++n) {
+        updateNode(n);
+      }
+    }
+
+    if (!reachingSources) {
+      break;
+    }
+
+    for (; reachingSources; reachingSources &= reachingSources - 1) {
+      batchEccentricities[countr_zero(reachingSources)] = distance;
+    }
+  }
+
+  for (uint i = 0; i < nbBatchSources; ++i) {
+    eccentricities[first + i] = batchEccentricities[i];
+    sourceSums[first + i] = batchSums[i];
+    sourceNbReached[first + i] = batchNbReached[i];
+  }
+}
+
+vector<uint> MultiSourceBFS::randomSources(uint nbNodes, uint nbSources) {
+  vector<uint> nodes(nbNodes);
+  iota(nodes.begin(), nodes.end(), 0);
+  nbSources = std::min(nbSources, nbNodes);
+
+  // a partial Fisher-Yates shuffle
+  for (uint i = 0; i < nbSources; ++i) {
+    std::swap(nodes[i], nodes[i + randomNumber(nbNodes - i - 1)]);
+  }
+
+  nodes.resize(nbSources);
+  return nodes;
+}
@@ -0,0 +1,284 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <climits>
+#include <cmath>
+
+#include <talipot/MultilevelCoarsening.h>
+#include <talipot/Graph.h>
+#include <talipot/LayoutProperty.h>
+#include <talipot/NumericProperty.h>
+#include <talipot/BooleanProperty.h>
+#include <talipot/ParallelTools.h>
+
+using namespace std;
+using namespace tlp;
+
+static double distance(const Coord &pos1, const Coord &pos2, uint dim) {
+  double dist = 0.0;
+
+  for (uint d = 0; d < dim; ++d) {
+    double diff = pos1[d] - pos2[d];
+    dist += diff * diff;
+  }
+
+  return sqrt(dist);
+}
+
+MultilevelCoarsening::MultilevelCoarsening(const Graph *graph, const LayoutProperty *layout,
+                                           const NumericProperty *weights,
+                                           const BooleanProperty *fixedNodes)
+    : levels(1) {
+  Level &level = levels[0];
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+  level.positions.assign(nbNodes, Coord(0, 0, 0));
+  level.weights.assign(nbNodes, 1.0);
+  level.fixed.assign(nbNodes, false);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    if (layout) {
+      level.positions[i] = layout->getNodeValue(nodes[i]);
+    }
+
+    if (weights) {
+      level.weights[i] = weights->getNodeDoubleValue(nodes[i]);
+    }
+
+    if (fixedNodes && fixedNodes->getNodeValue(nodes[i])) {
+      level.fixed[i] = true;
+    }
+  }
+
+  // self loops are ignored as they do not link distinct nodes
+  level.adjStart.assign(nbNodes + 1, 0);
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    if (src != tgt) {
+      ++level.adjStart[graph->nodePos(src) + 1];
+      ++level.adjStart[graph->nodePos(tgt) + 1];
+    }
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    level.adjStart[i + 1] += level.adjStart[i];
+  }
+
+  uint nbAdjs = level.adjStart[nbNodes];
+  level.adjNodes.resize(nbAdjs);
+  level.adjWeights.resize(nbAdjs);
+  level.adjEdges.resize(nbAdjs);
+  vector<uint> next(level.adjStart.begin(), level.adjStart.end() - 1);
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    if (src != tgt) {
+      uint srcPos = graph->nodePos(src);
+      uint tgtPos = graph->nodePos(tgt);
+      double weight = weights ? weights->getEdgeDoubleValue(e) : 1.0;
+      level.adjNodes[next[srcPos]] = tgtPos;
+      level.adjWeights[next[srcPos]] = weight;
+      level.adjEdges[next[srcPos]++] = e;
+      level.adjNodes[next[tgtPos]] = srcPos;
+      level.adjWeights[next[tgtPos]] = weight;
+      level.adjEdges[next[tgtPos]++] = e;
+    }
+  }
+}
+
+uint MultilevelCoarsening::coarsen(uint minNbNodes, double maxRatio) {
+  while (levels.back().numberOfNodes() > minNbNodes) {
+    Level coarse;
+
+    if (!coarsenLevel(levels.back(), coarse, maxRatio)) {
+      break;
+    }
+
+    levels.push_back(std::move(coarse));
+  }
+
+  return levels.size();
+}
+
+bool MultilevelCoarsening::coarsenLevel(Level &fine, Level &coarse, double maxRatio) const {
+  uint nbNodes = fine.numberOfNodes();
+  fine.coarseNodes.assign(nbNodes, UINT_MAX);
+  uint nbCoarseNodes = 0;
+
+  for (uint u = 0; u < nbNodes; ++u) {
+    if (fine.coarseNodes[u] != UINT_MAX) {
+      continue;
+    }
+
+    uint mate = UINT_MAX;
+
+    if (!fine.fixed[u]) {
+      // prefer heavy edges between light nodes
+      double bestScore = 0.0;
+
+      for (uint i = fine.adjStart[u]; i < fine.adjStart[u + 1]; ++i) {
+        uint v = fine.adjNodes[i];
+
+        if (fine.coarseNodes[v] != UINT_MAX || fine.fixed[v]) {
+          continue;
+        }
+
+        double score = fine.adjWeights[i] / (fine.weights[u] * fine.weights[v]);
+
+        if (score > bestScore) {
+          bestScore = score;
+          mate = v;
+        }
+      }
+    }
+
+    fine.coarseNodes[u] = nbCoarseNodes;
+
+    if (mate != UINT_MAX) {
+      fine.coarseNodes[mate] = nbCoarseNodes;
+    }
+
+    ++nbCoarseNodes;
+  }
+
+  if (nbCoarseNodes > maxRatio * nbNodes) {
+    return false;
+  }
+
+  // the coarse nodes are placed at the barycenter of their fine nodes
+  coarse.positions.assign(nbCoarseNodes, Coord(0, 0, 0));
+  coarse.weights.assign(nbCoarseNodes, 0.0);
+  coarse.fixed.assign(nbCoarseNodes, false);
+  vector<uint> nbFineNodes(nbCoarseNodes, 0);
+
+  for (uint u = 0; u < nbNodes; ++u) {
+    uint cu = fine.coarseNodes[u];
+    coarse.positions[cu] += fine.positions[u];
+    coarse.weights[cu] += fine.weights[u];
+    coarse.fixed[cu] = fine.fixed[u];
+    ++nbFineNodes[cu];
+  }
+
+  for (uint cu = 0; cu < nbCoarseNodes; ++cu) {
+    coarse.positions[cu] /= nbFineNodes[cu];
+  }
+
+  // merge the edges between the same coarse nodes
+  vector<uint> firstFineNode(nbCoarseNodes + 1, 0);
+
+  for (uint cu = 0; cu < nbCoarseNodes; ++cu) {
+    firstFineNode[cu + 1] = firstFineNode[cu] + nbFineNodes[cu];
+  }
+
+  vector<uint> sortedFineNodes(nbNodes);
+  vector<uint> next(firstFineNode.begin(), firstFineNode.end() - 1);
+
+  for (uint u = 0; u < nbNodes; ++u) {
+    sortedFineNodes[next[fine.coarseNodes[u]]++] = u;
+  }
+
+  coarse.adjStart.assign(nbCoarseNodes + 1, 0);
+  coarse.adjNodes.clear();
+  coarse.adjWeights.clear();
+  vector<uint> slot(nbCoarseNodes, UINT_MAX);
+
+  for (uint cu = 0; cu < nbCoarseNodes; ++cu) {
+    uint first = coarse.adjNodes.size();
+
+    for (uint i = firstFineNode[cu]; i < firstFineNode[cu + 1]; ++i) {
+      uint u = sortedFineNodes[i];
+
+      for (uint j = fine.adjStart[u]; j < fine.adjStart[u + 1]; ++j) {
+        uint cv = fine.coarseNodes[fine.adjNodes[j]];
+
+        if (cv == cu) {
+          continue;
+        }
+
+        if (slot[cv] == UINT_MAX) {
+          slot[cv] = coarse.adjNodes.size();
+          coarse.adjNodes.push_back(cv);
+          coarse.adjWeights.push_back(0.0);
+        }
+
+        coarse.adjWeights[slot[cv]] += fine.adjWeights[j];
+      }
+    }
+
+    for (uint i = first; i < coarse.adjNodes.size(); ++i) {
+      slot[coarse.adjNodes[i]] = UINT_MAX;
+    }
+
+    coarse.adjStart[cu + 1] = coarse.adjNodes.size();
+  }
+
+  return true;
+}
+
+void MultilevelCoarsening::prolong(uint levelIndex, uint dim) {
+  const Level &coarse = levels[levelIndex + 1];
+  Level &fine = levels[levelIndex];
+  uint nbCoarseNodes = coarse.numberOfNodes();
+  // the barycenters of the fine nodes are the positions of the coarse nodes
+  // before the layout of the coarse level
+  vector<Coord> initialPositions(nbCoarseNodes, Coord(0, 0, 0));
+  vector<uint> nbFineNodes(nbCoarseNodes, 0);
+
+  for (uint u = 0; u < fine.numberOfNodes(); ++u) {
+    initialPositions[fine.coarseNodes[u]] += fine.positions[u];
+    ++nbFineNodes[fine.coarseNodes[u]];
+  }
+
+  double edgeLength = 0.0;
+
+  for (uint cu = 0; cu < nbCoarseNodes; ++cu) {
+    initialPositions[cu] /= nbFineNodes[cu];
+
+    for (uint i = coarse.adjStart[cu]; i < coarse.adjStart[cu + 1]; ++i) {
+      edgeLength += distance(coarse.positions[cu], coarse.positions[coarse.adjNodes[i]], dim);
+    }
+  }
+
+  if (!coarse.adjNodes.empty()) {
+    edgeLength /= coarse.adjNodes.size();
+  }
+
+  double radius = (edgeLength > 0.0 ? edgeLength : 1.0) / 10;
+
+  TLP_PARALLEL_MAP_INDICES(fine.numberOfNodes(), [&](uint u) {
+    if (fine.fixed[u]) {
+      return;
+    }
+
+    uint cu = fine.coarseNodes[u];
+    Coord offset = fine.positions[u] - initialPositions[cu];
+
+    if (nbFineNodes[cu] == 1) {
+      offset.fill(0);
+    } else if (distance(offset, Coord(0, 0, 0), dim) == 0.0) {
+      // coincident initial positions, use an arbitrary direction
+      offset = Coord(u % 2 ? 1 : -1, (u / 2) % 2 ? 1 : -1, dim == 3 ? 1 : 0);
+    }
+
+    double length = distance(offset, Coord(0, 0, 0), dim);
+
+    if (length > 0.0) {
+      offset *= radius / length;
+    }
+
+    fine.positions[u] = coarse.positions[cu] + offset;
+  });
+}
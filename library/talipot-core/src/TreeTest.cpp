@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -14,7 +14,6 @@
 #include <talipot/BooleanProperty.h>
 #include <talipot/ConnectedTest.h>
 #include <talipot/TreeTest.h>
-#include <talipot/AcyclicTest.h>
 #include <talipot/GraphTools.h>
 
 using namespace std;
@@ -68,7 +67,7 @@ static bool treeTest(const Graph *graph) {
     return false;
   }
 
-  bool rootNodeFound = false;
+  node root;
 
   for (auto tmp : graph->nodes()) {
     if (graph->indeg(tmp) > 1) {
@@ -76,15 +75,35 @@ static bool treeTest(const Graph *graph) {
     }
 
     if (graph->indeg(tmp) == 0) {
-      if (rootNodeFound) {
+      if (root.isValid()) {
         return false;
       } else {
-        rootNodeFound = true;
+        root = tmp;
+      }
+    }
+  }
+
+  // with n - 1 edges and a single root, the graph is a tree
+  // if and only if all its nodes can be reached from the root
+  NodeVectorProperty<bool> visited(graph);
+  visited.setAll(false);
+  visited[root] = true;
+  vector<node> toVisit = {root};
+
+  for (uint i = 0; i < toVisit.size(); ++i) {
+    node n = toVisit[i];
+
+    for (auto e : graph->incidence(n)) {
+      const auto &[src, tgt] = graph->ends(e);
+
+      if (src == n && !visited[tgt]) {
+        visited[tgt] = true;
+        toVisit.push_back(tgt);
       }
     }
   }
 
-  return AcyclicTest::acyclicTest(graph);
+  return toVisit.size() == graph->numberOfNodes();
 }
 //====================================================================
 bool TreeTest::isTree(const tlp::Graph *graph) {
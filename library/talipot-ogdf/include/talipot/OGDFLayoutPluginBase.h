@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -46,9 +46,14 @@ protected:
 
   void transposeLayoutVertically();
 
+  // the conversion of the graph, only valid during a call to run
   TalipotToOGDF *tlpToOGDF;
   ogdf::LayoutModule *ogdfLayoutAlgo;
   ogdf::SimpleCCPacker *simpleCCPacker;
+
+private:
+  bool importEdgeBends;
+  std::shared_ptr<TalipotToOGDF> conversion;
 };
 }
 #endif // TALIPOT_OGDF_LAYOUT_PLUGIN_BASE_H
\ No newline at end of file
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -20,17 +20,35 @@
 
 #include <ogdf/basic/GraphAttributes.h>
 
-#include <talipot/hash.h>
+#include <memory>
 #include <vector>
 
 namespace tlp {
 class NumericProperty;
 class SizeProperty;
+class LayoutProperty;
 
 class TLP_OGDF_SCOPE TalipotToOGDF {
 public:
   TalipotToOGDF(Graph *g, bool importEdgeBends = true);
 
+  /**
+   * @brief Returns a conversion of a graph whose attributes are synchronized with
+   * its "viewLayout" and "viewSize" properties.
+   *
+   * The conversion of the last converted graph is kept and reused by the next call
+   * for the same graph, until the topology of the graph changes, so that OGDF
+   * algorithms run in sequence on a graph only convert it once.
+   * A new conversion is returned if the kept one is still in use.
+   **/
+  static std::shared_ptr<TalipotToOGDF> getConversion(Graph *g, bool importEdgeBends = true);
+
+  /**
+   * @brief Resets the attributes of the OGDF graph, then copies the positions, sizes
+   * and optionally the bends of the elements of the Talipot graph.
+   **/
+  void synchronize(bool importEdgeBends = true);
+
   Graph *getTalipotGraph() {
     return talipotGraph;
   }
@@ -44,11 +62,12 @@ public:
   }
 
   ogdf::node getOGDFGraphNode(node nTlp) {
-    return ogdfNodes[nTlp];
+    return ogdfNodes[talipotGraph->nodePos(nTlp)];
   }
 
+  // returns nullptr for the edges removed by makeOGDFGraphSimple
   ogdf::edge getOGDFGraphEdge(edge eTlp) {
-    return ogdfEdges[eTlp];
+    return ogdfEdges[talipotGraph->edgePos(eTlp)];
   }
 
   void makeOGDFGraphSimple();
@@ -57,6 +76,8 @@ public:
 
   Coord getNodeCoordFromOGDFGraphAttr(node n);
   std::vector<Coord> getEdgeCoordFromOGDFGraphAttr(edge e);
+  // copies at once the positions and bends computed by an OGDF algorithm
+  void copyOGDFLayoutToTlp(LayoutProperty *layout);
 
   void copyTlpNumericPropertyToOGDFEdgeLength(NumericProperty *);
   void copyTlpNumericPropertyToOGDFNodeWeight(NumericProperty *);
@@ -64,10 +85,16 @@ public:
 
 private:
   Graph *talipotGraph;
-  flat_hash_map<node, ogdf::node> ogdfNodes;
-  flat_hash_map<edge, ogdf::edge> ogdfEdges;
+  // the Talipot elements in the order of their conversion
+  std::vector<node> tlpNodes;
+  std::vector<edge> tlpEdges;
+  // the OGDF elements indexed by the positions of the Talipot elements
+  std::vector<ogdf::node> ogdfNodes;
+  std::vector<ogdf::edge> ogdfEdges;
   ogdf::Graph ogdfGraph;
   ogdf::GraphAttributes ogdfGraphAttributes;
+  // true if edges have been removed from the OGDF graph
+  bool simplified;
 };
 }
 #endif // TALIPOT_TALIPOT_TO_OGDF_H
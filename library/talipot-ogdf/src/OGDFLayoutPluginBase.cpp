@@ -24,15 +24,10 @@ using namespace tlp;
 OGDFLayoutPluginBase::OGDFLayoutPluginBase(const PluginContext *context,
                                            ogdf::LayoutModule *ogdfLayoutAlgo, bool importEdgeBends)
     : LayoutAlgorithm(context), tlpToOGDF(nullptr), ogdfLayoutAlgo(ogdfLayoutAlgo),
-      simpleCCPacker(ogdfLayoutAlgo ? new ogdf::SimpleCCPacker(ogdfLayoutAlgo) : nullptr) {
-  // convert Tulip Graph to OGDF Graph including attributes
-  if (graph) {
-    tlpToOGDF = new TalipotToOGDF(graph, importEdgeBends);
-  }
-}
+      simpleCCPacker(ogdfLayoutAlgo ? new ogdf::SimpleCCPacker(ogdfLayoutAlgo) : nullptr),
+      importEdgeBends(importEdgeBends) {}
 
 OGDFLayoutPluginBase::~OGDFLayoutPluginBase() {
-  delete tlpToOGDF;
   delete simpleCCPacker;
 }
 
@@ -43,6 +38,10 @@ bool OGDFLayoutPluginBase::run() {
     pluginProgress->showStops(false);
   }
 
+  // convert Talipot Graph to OGDF Graph including attributes,
+  // the conversion is reused if the graph has not changed since the last call
+  conversion = TalipotToOGDF::getConversion(graph, importEdgeBends);
+  tlpToOGDF = conversion.get();
   ogdf::GraphAttributes &gAttributes = tlpToOGDF->getOGDFGraphAttr();
 
   beforeCall();
@@ -91,24 +90,21 @@ bool OGDFLayoutPluginBase::run() {
     }
 
     pluginProgress->setError(std::string("Error\n") + msg);
+    conversion.reset();
+    tlpToOGDF = nullptr;
     return false;
   }
 
-  // retrieve nodes coordinates computed by the OGDF Layout Algorithm
-  // and store them in the Tulip Layout Property
-  for (auto n : graph->nodes()) {
-    Coord nodeCoord = tlpToOGDF->getNodeCoordFromOGDFGraphAttr(n);
-    (*result)[n] = nodeCoord;
-  }
-
-  // same operation as above but with edges
-  for (auto e : graph->edges()) {
-    vector<Coord> edgeCoord = tlpToOGDF->getEdgeCoordFromOGDFGraphAttr(e);
-    (*result)[e] = edgeCoord;
-  }
+  // retrieve nodes coordinates and edges bends computed by the OGDF Layout Algorithm
+  // and store them in the Talipot Layout Property
+  tlpToOGDF->copyOGDFLayoutToTlp(result);
 
   afterCall();
 
+  // release the conversion so that it can be reused by the next call
+  conversion.reset();
+  tlpToOGDF = nullptr;
+
   return true;
 }
 
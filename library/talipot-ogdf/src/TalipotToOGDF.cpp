@@ -17,52 +17,145 @@
 #include <talipot/NumericProperty.h>
 #include <talipot/SimpleTest.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace tlp;
 
-TalipotToOGDF::TalipotToOGDF(Graph *g, bool importEdgeBends) : talipotGraph(g) {
-
-  // needed to initialize some ogdfAttributes fields
-  long attributes =
-      // x, y, width, height fields
-      ogdf::GraphAttributes::nodeGraphics |
-      // bends field
-      ogdf::GraphAttributes::edgeGraphics |
-      // doubleWeight field
-      ogdf::GraphAttributes::edgeDoubleWeight |
-      // weight field
-      ogdf::GraphAttributes::nodeWeight |
-      // z coordinate
-      ogdf::GraphAttributes::threeD |
-      // required attributes for some OGDF algorithms
-      ogdf::GraphAttributes::nodeStyle | ogdf::GraphAttributes::edgeStyle |
-      ogdf::GraphAttributes::edgeType | ogdf::GraphAttributes::nodeType;
-
-  ogdfGraphAttributes = ogdf::GraphAttributes(ogdfGraph, attributes);
+// needed to initialize some ogdfAttributes fields
+static const long ATTRIBUTES =
+    // x, y, width, height fields
+    ogdf::GraphAttributes::nodeGraphics |
+    // bends field
+    ogdf::GraphAttributes::edgeGraphics |
+    // doubleWeight field
+    ogdf::GraphAttributes::edgeDoubleWeight |
+    // weight field
+    ogdf::GraphAttributes::nodeWeight |
+    // z coordinate
+    ogdf::GraphAttributes::threeD |
+    // required attributes for some OGDF algorithms
+    ogdf::GraphAttributes::nodeStyle | ogdf::GraphAttributes::edgeStyle |
+    ogdf::GraphAttributes::edgeType | ogdf::GraphAttributes::nodeType;
+
+// keeps the conversion of the last converted graph
+// and drops it as soon as the topology of that graph changes.
+// It is shared by the plugins which may run in different threads, so it is accessed
+// with its lock held, which is recursive as creating a conversion may send graph events
+class ConversionCache : public Observable {
+public:
+  Graph *graph = nullptr;
+  shared_ptr<TalipotToOGDF> conversion;
+  recursive_mutex lock;
+
+  void set(Graph *g, const shared_ptr<TalipotToOGDF> &c) {
+    clear();
+    graph = g;
+    conversion = c;
+    graph->addListener(this);
+  }
+
+  void clear() {
+    if (graph) {
+      graph->removeListener(this);
+      graph = nullptr;
+      conversion.reset();
+    }
+  }
+
+  // override of Observable::treatEvent to drop the conversion if its graph is modified
+  void treatEvent(const Event &evt) override {
+    lock_guard<recursive_mutex> guard(lock);
+    const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt);
+
+    if (gEvt) {
+      switch (gEvt->getType()) {
+      case GraphEventType::TLP_ADD_NODE:
+      case GraphEventType::TLP_DEL_NODE:
+      case GraphEventType::TLP_ADD_EDGE:
+      case GraphEventType::TLP_DEL_EDGE:
+      case GraphEventType::TLP_REVERSE_EDGE:
+      case GraphEventType::TLP_BEFORE_SET_ENDS:
+      case GraphEventType::TLP_ADD_NODES:
+      case GraphEventType::TLP_ADD_EDGES:
+        clear();
+        break;
+
+      default:
+        // we don't care about other events
+        break;
+      }
+    } else if (evt.type() == EventType::TLP_DELETE) {
+      // the graph is being deleted
+      graph = nullptr;
+      conversion.reset();
+    }
+  }
+};
+
+static ConversionCache conversionCache;
+
+TalipotToOGDF::TalipotToOGDF(Graph *g, bool importEdgeBends)
+    : talipotGraph(g), tlpNodes(g->nodes()), tlpEdges(g->edges()), simplified(false) {
+  ogdfNodes.reserve(talipotGraph->numberOfNodes());
+  ogdfEdges.reserve(talipotGraph->numberOfEdges());
+
+  for (uint i = 0; i < talipotGraph->numberOfNodes(); ++i) {
+    ogdfNodes.push_back(ogdfGraph.newNode());
+  }
+
+  for (auto eTlp : talipotGraph->edges()) {
+    const auto &[srcTlp, tgtTlp] = talipotGraph->ends(eTlp);
+    ogdfEdges.push_back(ogdfGraph.newEdge(ogdfNodes[talipotGraph->nodePos(srcTlp)],
+                                          ogdfNodes[talipotGraph->nodePos(tgtTlp)]));
+  }
+
+  synchronize(importEdgeBends);
+}
+
+shared_ptr<TalipotToOGDF> TalipotToOGDF::getConversion(Graph *g, bool importEdgeBends) {
+  // the kept conversion is not shared while another algorithm uses it,
+  // and sortElts reorders the elements without sending any event
+  lock_guard<recursive_mutex> guard(conversionCache.lock);
+  const auto &cached = conversionCache.conversion;
+
+  if (conversionCache.graph == g && cached.use_count() == 1 && !cached->simplified &&
+      cached->tlpNodes == g->nodes() && cached->tlpEdges == g->edges()) {
+    cached->synchronize(importEdgeBends);
+    return cached;
+  }
+
+  auto conversion = make_shared<TalipotToOGDF>(g, importEdgeBends);
+  conversionCache.set(g, conversion);
+  return conversion;
+}
+
+void TalipotToOGDF::synchronize(bool importEdgeBends) {
+  // the attributes modified by a previous algorithm are reset
+  ogdfGraphAttributes = ogdf::GraphAttributes(ogdfGraph, ATTRIBUTES);
 
   SizeProperty *sizeProp = talipotGraph->getSizeProperty("viewSize");
   LayoutProperty *layoutProp = talipotGraph->getLayoutProperty("viewLayout");
+  const vector<node> &nodes = talipotGraph->nodes();
 
-  for (auto nTlp : talipotGraph->nodes()) {
-    ogdf::node nOGDF = ogdfGraph.newNode();
-    ogdfNodes[nTlp] = nOGDF;
-    const Coord &c = (*layoutProp)[nTlp];
+  for (uint i = 0; i < nodes.size(); ++i) {
+    ogdf::node nOGDF = ogdfNodes[i];
+    const Coord &c = layoutProp->getNodeValue(nodes[i]);
     ogdfGraphAttributes.x(nOGDF) = c.getX();
     ogdfGraphAttributes.y(nOGDF) = c.getY();
     ogdfGraphAttributes.z(nOGDF) = c.getZ();
-    const Size &s = (*sizeProp)[nTlp];
+    const Size &s = sizeProp->getNodeValue(nodes[i]);
     ogdfGraphAttributes.width(nOGDF) = s.getW();
     ogdfGraphAttributes.height(nOGDF) = s.getH();
   }
 
-  for (auto eTlp : talipotGraph->edges()) {
-    const auto &[srcTlp, tgtTlp] = talipotGraph->ends(eTlp);
-    ogdf::edge eOGDF = ogdfGraph.newEdge(ogdfNodes[srcTlp], ogdfNodes[tgtTlp]);
-    ogdfEdges[eTlp] = eOGDF;
+  const vector<edge> &edges = talipotGraph->edges();
 
-    if (importEdgeBends) {
+  for (uint i = 0; i < edges.size(); ++i) {
+    ogdf::edge eOGDF = ogdfEdges[i];
 
-      const vector<Coord> &v = (*layoutProp)[eTlp];
+    if (importEdgeBends) {
+      const vector<Coord> &v = layoutProp->getEdgeValue(edges[i]);
       ogdf::DPolyline bends;
 
       for (const auto &coord : v) {
@@ -77,7 +170,7 @@ TalipotToOGDF::TalipotToOGDF(Graph *g, bool importEdgeBends) : talipotGraph(g) {
 }
 
 Coord TalipotToOGDF::getNodeCoordFromOGDFGraphAttr(node nTlp) {
-  ogdf::node n = ogdfNodes[nTlp];
+  ogdf::node n = getOGDFGraphNode(nTlp);
 
   double x = ogdfGraphAttributes.x(n);
   double y = ogdfGraphAttributes.y(n);
@@ -88,10 +181,9 @@ Coord TalipotToOGDF::getNodeCoordFromOGDFGraphAttr(node nTlp) {
 
 vector<Coord> TalipotToOGDF::getEdgeCoordFromOGDFGraphAttr(edge eTlp) {
   vector<Coord> v;
-  if (ogdfEdges.contains(eTlp)) {
-
-    ogdf::edge e = ogdfEdges[eTlp];
+  ogdf::edge e = getOGDFGraphEdge(eTlp);
 
+  if (e != nullptr) {
     for (const auto &bend : ogdfGraphAttributes.bends(e)) {
       v.push_back(Coord(bend.m_x, bend.m_y));
     }
@@ -99,13 +191,40 @@ vector<Coord> TalipotToOGDF::getEdgeCoordFromOGDFGraphAttr(edge eTlp) {
   return v;
 }
 
+void TalipotToOGDF::copyOGDFLayoutToTlp(LayoutProperty *layout) {
+  bool threeD = ogdfGraphAttributes.has(ogdf::GraphAttributes::threeD);
+  vector<Coord> nodesCoords(ogdfNodes.size());
+
+  for (uint i = 0; i < ogdfNodes.size(); ++i) {
+    ogdf::node n = ogdfNodes[i];
+    nodesCoords[i] = Coord(ogdfGraphAttributes.x(n), ogdfGraphAttributes.y(n),
+                           threeD ? ogdfGraphAttributes.z(n) : 0);
+  }
+
+  vector<vector<Coord>> edgesBends(ogdfEdges.size());
+
+  for (uint i = 0; i < ogdfEdges.size(); ++i) {
+    if (ogdfEdges[i] != nullptr) {
+      for (const auto &bend : ogdfGraphAttributes.bends(ogdfEdges[i])) {
+        edgesBends[i].push_back(Coord(bend.m_x, bend.m_y));
+      }
+    }
+  }
+
+  layout->setValues(nodesCoords, edgesBends, talipotGraph);
+}
+
 void TalipotToOGDF::copyTlpNumericPropertyToOGDFEdgeLength(NumericProperty *metric) {
   if (!metric) {
     return;
   }
 
   for (auto eTlp : talipotGraph->edges()) {
-    ogdfGraphAttributes.doubleWeight(ogdfEdges[eTlp]) = metric->getEdgeDoubleValue(eTlp);
+    ogdf::edge eOGDF = getOGDFGraphEdge(eTlp);
+
+    if (eOGDF != nullptr) {
+      ogdfGraphAttributes.doubleWeight(eOGDF) = metric->getEdgeDoubleValue(eTlp);
+    }
   }
 }
 
@@ -116,19 +235,21 @@ void TalipotToOGDF::copyTlpNodeSizeToOGDF(SizeProperty *size) {
 
   for (auto nTlp : talipotGraph->nodes()) {
     const Size &s = (*size)[nTlp];
-    ogdf::node nOGDF = ogdfNodes[nTlp];
+    ogdf::node nOGDF = getOGDFGraphNode(nTlp);
     ogdfGraphAttributes.width(nOGDF) = s.getW();
     ogdfGraphAttributes.height(nOGDF) = s.getH();
   }
 
   for (auto eTlp : talipotGraph->edges()) {
+    ogdf::edge eOGDF = getOGDFGraphEdge(eTlp);
+
+    if (eOGDF == nullptr) {
+      continue;
+    }
+
     const auto &[srcTlp, tgtTlp] = talipotGraph->ends(eTlp);
-    ogdf::node srcOGDF = ogdfNodes[srcTlp];
     const Size &sSrc = (*size)[srcTlp];
-    ogdf::node tgtOGDF = ogdfNodes[tgtTlp];
     const Size &sTgt = (*size)[tgtTlp];
-
-    ogdf::edge eOGDF = ogdfEdges[eTlp];
     ogdfGraphAttributes.doubleWeight(eOGDF) =
         ogdfGraphAttributes.doubleWeight(eOGDF) + sSrc.getW() / 2. + sTgt.getW() / 2. - 1.;
   }
@@ -140,7 +261,7 @@ void TalipotToOGDF::copyTlpNumericPropertyToOGDFNodeWeight(NumericProperty *metr
   }
 
   for (auto nTlp : talipotGraph->nodes()) {
-    ogdfGraphAttributes.weight(ogdfNodes[nTlp]) = int(metric->getNodeDoubleValue(nTlp));
+    ogdfGraphAttributes.weight(getOGDFGraphNode(nTlp)) = int(metric->getNodeDoubleValue(nTlp));
   }
 }
 
@@ -148,17 +269,21 @@ void TalipotToOGDF::makeOGDFGraphSimple() {
   auto [loops, parallelEdges] = SimpleTest::getLoopsAndParallelEdges(talipotGraph);
 
   for (auto e : loops) {
-    ogdfGraph.delEdge(ogdfEdges[e]);
-    ogdfEdges.erase(e);
+    uint ePos = talipotGraph->edgePos(e);
+    ogdfGraph.delEdge(ogdfEdges[ePos]);
+    ogdfEdges[ePos] = nullptr;
+    simplified = true;
   }
 
   for (auto e : parallelEdges) {
     auto [src, tgt] = talipotGraph->ends(e);
     auto ee = talipotGraph->existEdge(src, tgt, false);
+    uint ePos = talipotGraph->edgePos(e);
     // an edge can be a loop and a parallel one
-    if (ogdfEdges.contains(e)) {
-      ogdfGraph.delEdge(ogdfEdges[e]);
-      ogdfEdges[e] = ogdfEdges[ee];
+    if (ogdfEdges[ePos] != nullptr) {
+      ogdfGraph.delEdge(ogdfEdges[ePos]);
+      ogdfEdges[ePos] = getOGDFGraphEdge(ee);
+      simplified = true;
     }
   }
 }
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -12,6 +12,7 @@
  */
 
 #include <talipot/GlGlyphRenderer.h>
+#include <talipot/FrameProfiler.h>
 #include <talipot/GlGraphInputData.h>
 #include <talipot/GlGraphRenderingParameters.h>
 #include <talipot/GlShaderProgram.h>
@@ -115,6 +116,9 @@ void GlGlyphRenderer::endRendering() {
     return;
   }
 
+  FrameProfiler::StageTimer timer("glyphs rendering");
+  timer.setNbElements(_nodeGlyphsToRender.size() + _edgeExtremityGlyphsToRender.size());
+
   if (!_selectionBox.get()) {
     _selectionBox.reset(new GlBox(Coord(0, 0, 0), Size(1, 1, 1), Color(0, 0, 255, 255),
                                   Color(0, 255, 0, 255), false, true));
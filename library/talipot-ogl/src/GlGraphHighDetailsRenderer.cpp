@@ -17,6 +17,7 @@
 #include <talipot/GlGraphRenderingParameters.h>
 #include <talipot/GlGlyphRenderer.h>
 #include <talipot/OpenGlConfigManager.h>
+#include <talipot/FrameProfiler.h>
 
 using namespace std;
 
@@ -180,6 +181,7 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
     lodCalculator->setScene(*fakeScene);
   }
 
+  FrameProfiler::StageTimer lodTimer("graph LOD computation");
   lodCalculator->clear();
 
   if (!selectionDrawActivate) {
@@ -207,6 +209,9 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
   }
 
   LayersLODVector &layersLODVector = lodCalculator->getResult();
+  lodTimer.setNbElements(layersLODVector[0].nodesLODVector.size() +
+                         layersLODVector[0].edgesLODVector.size());
+  lodTimer.stop();
 
   auto *vertexArrayManager = inputData->glVertexArrayManager();
   bool vertexArrayManagerActivated = vertexArrayManager->isActivated();
@@ -224,10 +229,16 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
 
   // VertexArrayManager update
   if (vertexArrayManager->haveToCompute()) {
+    FrameProfiler::StageTimer arraysTimer("vertex arrays computation");
+    arraysTimer.setNbElements(graph->numberOfNodes() + graph->numberOfEdges());
     visitGraph(vertexArrayManager, true);
     vertexArrayManager->setHaveToComputeAll(false);
   }
 
+  FrameProfiler::StageTimer elementsTimer("graph elements rendering");
+  elementsTimer.setNbElements(layersLODVector[0].nodesLODVector.size() +
+                              layersLODVector[0].edgesLODVector.size());
+
   BooleanProperty *filteringProperty =
       inputData->renderingParameters()->getDisplayFilteringProperty();
   NumericProperty *metric = inputData->renderingParameters()->getElementOrderingProperty();
@@ -466,6 +477,8 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
     glDepthMask(GL_TRUE);
   }
 
+  elementsTimer.stop();
+
   if (!selectionDrawActivate) {
     if (vertexArrayManagerActivated) {
       if (inputData->renderingParameters()->isEdgeFrontDisplay()) {
@@ -494,6 +507,7 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
   }
 
   if (!labelDensityAtZero) {
+    FrameProfiler::StageTimer labelsTimer("labels rendering");
     glPushAttrib(GL_ALL_ATTRIB_BITS);
     glDisable(GL_LIGHTING);
     glDepthFunc(GL_ALWAYS);
@@ -507,6 +521,8 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
     drawLabelsForComplexEntities(false, &occlusionTest, layersLODVector[0]);
 
     glPopAttrib();
+    // the labels which have not been hidden by the occlusion test
+    labelsTimer.setNbElements(occlusionTest.data.size());
   }
 
   selectionDrawActivate = false;
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -11,6 +11,7 @@
  *
  */
 
+#include <talipot/FrameProfiler.h>
 #include <talipot/OpenGlConfigManager.h>
 #include <talipot/GlXMLTools.h>
 #include <talipot/GlCPULODCalculator.h>
@@ -136,11 +137,14 @@ void GlScene::draw() {
 
   inDraw = true;
 
+  FrameProfiler::beginFrame("GlScene::draw");
+
   initGlParameters();
 
   /**********************************************************************
   LOD Compute
   **********************************************************************/
+  FrameProfiler::StageTimer lodTimer("LOD computation");
   lodCalculator->clear();
   lodCalculator->setRenderingEntitiesFlag(RenderingAll);
 
@@ -157,6 +161,14 @@ void GlScene::draw() {
   LayersLODVector &layersLODVector = lodCalculator->getResult();
   BoundingBox sceneBoundingBox = lodCalculator->getSceneBoundingBox();
 
+  for (const auto &layerLODUnit : layersLODVector) {
+    lodTimer.addElements(layerLODUnit.entitiesLODVector.size());
+  }
+
+  lodTimer.stop();
+
+  FrameProfiler::StageTimer entitiesTimer("entities rendering");
+
   Camera *camera;
   // Iterate on Camera
   Camera *oldCamera = nullptr;
@@ -178,6 +190,7 @@ void GlScene::draw() {
 
         glStencilFunc(GL_LEQUAL, it.entity->getStencil(), 0xFFFF);
         it.entity->draw(it.lod, camera);
+        entitiesTimer.addElements(1);
       }
     } else {
 
@@ -206,12 +219,18 @@ void GlScene::draw() {
         glStencilFunc(GL_LEQUAL, entity->getStencil(), 0xFFFF);
         entity->draw(it.entity->lod, camera);
       }
+
+      entitiesTimer.addElements(entitiesSet.size());
     }
   }
 
+  entitiesTimer.stop();
+
   inDraw = false;
 
   OpenGlConfigManager::deactivateAntiAliasing();
+
+  FrameProfiler::endFrame();
 }
 
 /******************************************************************************
@@ -15,6 +15,7 @@
 
 #include <talipot/OpenGlConfigManager.h>
 #include <talipot/GlVertexArrayManager.h>
+#include <talipot/FrameProfiler.h>
 #include <talipot/GlEdge.h>
 #include <talipot/GlNode.h>
 #include <talipot/Curves.h>
@@ -329,6 +330,14 @@ void GlVertexArrayManager::endRendering() {
 
   isBegin = false;
 
+  // counts the rendered vertices indices
+  FrameProfiler::StageTimer renderingTimer("vertex arrays rendering");
+  renderingTimer.setNbElements(
+      linesRenderingIndicesArray.size() + linesSelectedRenderingIndicesArray.size() +
+      quadsRenderingIndicesArray.size() + quadsSelectedRenderingIndicesArray.size() +
+      pointsNodesRenderingIndexArray.size() + pointsNodesSelectedRenderingIndexArray.size() +
+      pointsEdgesRenderingIndexArray.size() + pointsEdgesSelectedRenderingIndexArray.size());
+
   static bool canUseVBO = OpenGlConfigManager::hasVertexBufferObject();
 
   if (canUseVBO && quadsVerticesVBO == 0) {
@@ -341,7 +350,13 @@ void GlVertexArrayManager::endRendering() {
     glGenBuffers(1, &quadsOutlineColorsVBO);
   }
 
+  // counts the uploaded bytes
+  FrameProfiler::StageTimer uploadTimer("buffers upload");
+
   if (canUseVBO && verticesUploadNeeded) {
+    uploadTimer.addElements(
+        (pointsCoordsArray.size() + linesCoordsArray.size() + quadsCoordsArray.size()) * 3 *
+        sizeof(float));
     if (!pointsCoordsArray.empty()) {
       glBindBuffer(GL_ARRAY_BUFFER, pointsVerticesVBO);
       glBufferData(GL_ARRAY_BUFFER, pointsCoordsArray.size() * 3 * sizeof(float),
@@ -368,6 +383,9 @@ void GlVertexArrayManager::endRendering() {
   }
 
   if (canUseVBO && colorsUploadNeeded) {
+    uploadTimer.addElements((pointsColorsArray.size() + linesColorsArray.size() +
+                             quadsColorsArray.size() + quadsOutlineColorsArray.size()) *
+                            4 * sizeof(unsigned char));
     if (!pointsColorsArray.empty()) {
       glBindBuffer(GL_ARRAY_BUFFER, pointsColorsVBO);
       glBufferData(GL_ARRAY_BUFFER, pointsColorsArray.size() * 4 * sizeof(unsigned char),
@@ -400,6 +418,8 @@ void GlVertexArrayManager::endRendering() {
     colorsUploadNeeded = false;
   }
 
+  uploadTimer.stop();
+
   glDisable(GL_LIGHTING);
   glDisable(GL_CULL_FACE);
   glDepthFunc(GL_LEQUAL);
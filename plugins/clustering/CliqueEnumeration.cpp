@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -13,14 +13,69 @@
 
 #include "CliqueEnumeration.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
 #include <talipot/SimpleTest.h>
 #include <talipot/Graph.h>
+#include <talipot/GraphParallelTools.h>
+#include <talipot/PluginProgress.h>
 
 PLUGIN(CliqueEnumeration)
 
 using namespace tlp;
 using namespace std;
 
+//================================================================================
+// the sets of vertices of a search are bitsets over the later or the earlier neighbours
+static uint nbWords(uint nbBits) {
+  return (nbBits + 63) / 64;
+}
+
+static bool isEmpty(const vector<uint64_t> &bits) {
+  for (auto word : bits) {
+    if (word) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static uint intersectionSize(const vector<uint64_t> &bits, const uint64_t *otherBits) {
+  uint size = 0;
+
+  for (uint i = 0; i < bits.size(); ++i) {
+    size += popcount(bits[i] & otherBits[i]);
+  }
+
+  return size;
+}
+
+// calls f on the indices of the set bits
+template <typename F>
+static void forEachBit(const vector<uint64_t> &bits, const F &f) {
+  for (uint i = 0; i < bits.size(); ++i) {
+    for (uint64_t word = bits[i]; word; word &= word - 1) {
+      f(i * 64 + countr_zero(word));
+    }
+  }
+}
+
+//================================================================================
+struct CliqueEnumeration::VertexSearch {
+  // the neighbours of the vertex after it in the degeneracy ordering, which can extend
+  // its cliques, and the ones before it, whose cliques have already been found
+  vector<uint> later, earlier;
+  uint nbLaterWords, nbEarlierWords;
+  // for each later neighbour, its adjacency in the later and in the earlier neighbours
+  vector<uint64_t> laterAdj, laterEarlierAdj;
+  // for each earlier neighbour, its adjacency in the later neighbours
+  vector<uint64_t> earlierLaterAdj;
+  vector<vector<uint>> *cliques;
+};
+
 //================================================================================
 CliqueEnumeration::CliqueEnumeration(tlp::PluginContext *context)
     : Algorithm(context), minsize(0), cliqueid(0) {
@@ -29,132 +84,214 @@ CliqueEnumeration::CliqueEnumeration(tlp::PluginContext *context)
 }
 
 //================================================================================
-void CliqueEnumeration::addClique(const vector<node> &clique) {
-  stringstream ss;
-  ss << "clique_" << cliqueid++;
-  graph->inducedSubGraph(clique, graph, ss.str());
-}
-//================================================================================
-void CliqueEnumeration::getNeighborhood(const node u, set<node> &neigh) {
-  neigh.clear();
-  for (auto v : graph->getInOutNodes(u)) {
-    neigh.insert(v);
+// Bron-Kerbosch with pivoting: P is the set of the vertices which can extend the clique R,
+// XL and XE the sets of the later and earlier neighbours which can also extend it but whose
+// cliques have already been found. The pivot is the vertex of P, XL or XE with the most
+// neighbours in P, so its neighbours in P do not need to be tried first.
+void CliqueEnumeration::maxCliquePivot(VertexSearch &search, vector<uint64_t> &P,
+                                       vector<uint64_t> &XL, vector<uint64_t> &XE,
+                                       vector<uint> &R) {
+  if (isEmpty(P)) {
+    if (isEmpty(XL) && isEmpty(XE) && R.size() >= minsize) {
+      search.cliques->push_back(R);
+    }
+
+    return;
   }
-}
-//================================================================================
-node CliqueEnumeration::choosePivot(const set<node> &C) {
-  node pivot;
+
+  if (R.size() + intersectionSize(P, P.data()) < minsize) {
+    return;
+  }
+
+  const uint64_t *pivotAdj = nullptr;
   uint maxinter = 0;
 
-  for (auto c : C) {
-    uint inter = 0;
-    for (auto v : graph->getInOutNodes(c)) {
-      if (C.contains(v)) {
-        inter++;
-      }
+  auto chooseLater = [&](uint a) {
+    const uint64_t *adj = &search.laterAdj[size_t(a) * search.nbLaterWords];
+    uint inter = intersectionSize(P, adj);
+
+    if (!pivotAdj || inter > maxinter) {
+      pivotAdj = adj;
+      maxinter = inter;
     }
+  };
+
+  forEachBit(P, chooseLater);
+  forEachBit(XL, chooseLater);
+  forEachBit(XE, [&](uint c) {
+    const uint64_t *adj = &search.earlierLaterAdj[size_t(c) * search.nbLaterWords];
+    uint inter = intersectionSize(P, adj);
 
-    if (inter >= maxinter) {
-      pivot = c;
+    if (inter > maxinter) {
+      pivotAdj = adj;
+      maxinter = inter;
     }
+  });
+
+  vector<uint64_t> tovisit(P.size());
+
+  for (uint i = 0; i < P.size(); ++i) {
+    tovisit[i] = P[i] & ~pivotAdj[i];
   }
 
-  return pivot;
+  vector<uint64_t> newP(P.size()), newXL(XL.size()), newXE(XE.size());
+
+  forEachBit(tovisit, [&](uint a) {
+    const uint64_t *adj = &search.laterAdj[size_t(a) * search.nbLaterWords];
+    const uint64_t *earlierAdj = &search.laterEarlierAdj[size_t(a) * search.nbEarlierWords];
+
+    for (uint i = 0; i < P.size(); ++i) {
+      newP[i] = P[i] & adj[i];
+      newXL[i] = XL[i] & adj[i];
+    }
+
+    for (uint i = 0; i < XE.size(); ++i) {
+      newXE[i] = XE[i] & earlierAdj[i];
+    }
+
+    R.push_back(search.later[a]);
+    maxCliquePivot(search, newP, newXL, newXE, R);
+    R.pop_back();
+    P[a / 64] &= ~(uint64_t(1) << (a % 64));
+    XL[a / 64] |= uint64_t(1) << (a % 64);
+  });
 }
 
 //================================================================================
-void CliqueEnumeration::maxCliquePivot(set<node> &P, const vector<node> &R, set<node> &X) {
+// finds the maximal cliques whose first vertex in the degeneracy ordering is the vertex
+// at the given position. localIndices must map all the vertices to UINT_MAX,
+// it is used to index the neighbours of the vertex
+void CliqueEnumeration::searchVertex(uint v, const vector<uint> &ranks,
+                                     vector<uint> &localIndices, vector<vector<uint>> &cliques) {
+  VertexSearch search;
+  search.cliques = &cliques;
 
-  set<node> C(P);
-  C.insert(X.begin(), X.end());
+  for (uint i = adjStart[v]; i < laterStart[v]; ++i) {
+    localIndices[adjNodes[i]] = search.earlier.size();
+    search.earlier.push_back(adjNodes[i]);
+  }
 
-  if (C.empty()) {
-    if (R.size() >= minsize) {
-      addClique(R);
-    }
-  } else {
-    tlp::node p = choosePivot(C);
-    set<node> neighp;
-    getNeighborhood(p, neighp);
-    set<node> tovisit;
-
-    for (auto v : P) {
-      if (!neighp.contains(v)) {
-        tovisit.insert(v);
+  for (uint i = laterStart[v]; i < adjStart[v + 1]; ++i) {
+    localIndices[adjNodes[i]] = search.later.size();
+    search.later.push_back(adjNodes[i]);
+  }
+
+  uint nbLater = search.later.size();
+  uint nbEarlier = search.earlier.size();
+  search.nbLaterWords = nbWords(nbLater);
+  search.nbEarlierWords = nbWords(nbEarlier);
+  search.laterAdj.assign(size_t(nbLater) * search.nbLaterWords, 0);
+  search.laterEarlierAdj.assign(size_t(nbLater) * search.nbEarlierWords, 0);
+  search.earlierLaterAdj.assign(size_t(nbEarlier) * search.nbLaterWords, 0);
+
+  // an edge is found from its end of lower rank, whose neighbours of higher ranks are at most
+  // as many as the degeneracy, so this costs O(degeneracy * deg(v)):
+  // the edges between the later neighbours are read from the later neighbours of each one
+  for (uint a = 0; a < nbLater; ++a) {
+    uint u = search.later[a];
+
+    for (uint i = laterStart[u]; i < adjStart[u + 1]; ++i) {
+      uint b = localIndices[adjNodes[i]];
+
+      // a neighbour of v after u is after v
+      if (b != UINT_MAX) {
+        search.laterAdj[size_t(a) * search.nbLaterWords + b / 64] |= uint64_t(1) << (b % 64);
+        search.laterAdj[size_t(b) * search.nbLaterWords + a / 64] |= uint64_t(1) << (a % 64);
       }
     }
+  }
 
-    for (auto v : tovisit) {
-      set<node> neighx;
-      getNeighborhood(v, neighx);
-      set<node> newP;
-      set_intersection(P.begin(), P.end(), neighx.begin(), neighx.end(),
-                       inserter(newP, newP.begin()));
-      vector<node> newR(R);
-      newR.push_back(v);
-      set<node> newX;
-      set_intersection(X.begin(), X.end(), neighx.begin(), neighx.end(),
-                       inserter(newX, newX.begin()));
-      maxCliquePivot(newP, newR, newX);
-      P.erase(v);
-      X.insert(v);
+  // and the edges between the earlier and the later neighbours from the earlier ones
+  for (uint c = 0; c < nbEarlier; ++c) {
+    uint w = search.earlier[c];
+
+    for (uint i = laterStart[w]; i < adjStart[w + 1]; ++i) {
+      uint u = adjNodes[i];
+      uint a = localIndices[u];
+
+      if (a != UINT_MAX && ranks[u] > ranks[v]) {
+        search.laterEarlierAdj[size_t(a) * search.nbEarlierWords + c / 64] |= uint64_t(1)
+                                                                              << (c % 64);
+        search.earlierLaterAdj[size_t(c) * search.nbLaterWords + a / 64] |= uint64_t(1)
+                                                                            << (a % 64);
+      }
     }
   }
+
+  for (uint i = adjStart[v]; i < adjStart[v + 1]; ++i) {
+    localIndices[adjNodes[i]] = UINT_MAX;
+  }
+
+  vector<uint64_t> P(search.nbLaterWords, 0), XL(search.nbLaterWords, 0),
+      XE(search.nbEarlierWords, 0);
+
+  for (uint a = 0; a < nbLater; ++a) {
+    P[a / 64] |= uint64_t(1) << (a % 64);
+  }
+
+  for (uint c = 0; c < nbEarlier; ++c) {
+    XE[c / 64] |= uint64_t(1) << (c % 64);
+  }
+
+  vector<uint> R(1, v);
+  maxCliquePivot(search, P, XL, XE, R);
 }
-//================================================================================
 
 //================================================================================
-struct DegreeOrderingElem {
-  DegreeOrderingElem() : deg(0) {}
-  DegreeOrderingElem(tlp::node n, uint deg) : n(n), deg(deg) {}
-  bool operator==(const DegreeOrderingElem &b) const {
-    return n == b.n;
+// the ordering of the nodes obtained by removing repeatedly a node of minimum degree,
+// computed with the bucket algorithm of Batagelj and Zaversnik
+void CliqueEnumeration::getDegenerateOrdering(vector<uint> &ordering) {
+  uint nbNodes = adjStart.size() - 1;
+  vector<uint> degrees(nbNodes);
+  uint maxDeg = 0;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    degrees[i] = adjStart[i + 1] - adjStart[i];
+    maxDeg = std::max(maxDeg, degrees[i]);
   }
-  bool operator!=(const DegreeOrderingElem &b) const {
-    return n != b.n;
+
+  // the nodes are sorted by their current degree, binStart giving
+  // the position of the first node of each degree
+  vector<uint> binStart(maxDeg + 2, 0);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    ++binStart[degrees[i] + 1];
   }
-  tlp::node n;
-  uint deg;
-};
 
-//================================================================================
-struct LessDegreeOrdering {
-  bool operator()(const DegreeOrderingElem *u, const DegreeOrderingElem *v) const {
-    if (u->deg == v->deg) {
-      return u->n.id < v->n.id;
-    }
+  for (uint d = 0; d <= maxDeg; ++d) {
+    binStart[d + 1] += binStart[d];
+  }
 
-    return u->deg < v->deg;
+  ordering.resize(nbNodes);
+  vector<uint> positions(nbNodes);
+  vector<uint> next(binStart.begin(), binStart.end() - 1);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    positions[i] = next[degrees[i]]++;
+    ordering[positions[i]] = i;
   }
-};
-//================================================================================
-void CliqueEnumeration::getDegenerateOrdering(vector<node> &ordering) {
-  ordering.clear();
-  tlp::Graph *sub = graph->addCloneSubGraph();
-  flat_hash_map<tlp::node, DegreeOrderingElem *> degrees;
-  set<DegreeOrderingElem *, LessDegreeOrdering> sortednodes;
-  for (auto n : sub->nodes()) {
-    auto *elem = new DegreeOrderingElem(n, sub->deg(n));
-    degrees[n] = elem;
-    sortednodes.insert(elem);
-  }
-
-  while (!sortednodes.empty()) {
-    auto it = sortednodes.begin();
-    node n = (*it)->n;
-    ordering.push_back(n);
-    delete (*it);
-    sortednodes.erase(it);
-    for (auto v : sub->getInOutNodes(n)) {
-      DegreeOrderingElem *elem = degrees.find(v)->second;
-      sortednodes.erase(elem);
-      elem->deg = elem->deg - 1;
-      sortednodes.insert(elem);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    uint u = ordering[i];
+
+    for (uint j = adjStart[u]; j < adjStart[u + 1]; ++j) {
+      uint w = adjNodes[j];
+
+      if (degrees[w] > degrees[u]) {
+        // move w to the start of its bucket, which then belongs to the lower degree
+        uint degW = degrees[w];
+        uint posW = positions[w];
+        uint posStart = binStart[degW];
+        uint first = ordering[posStart];
+        ordering[posW] = first;
+        positions[first] = posW;
+        ordering[posStart] = w;
+        positions[w] = posStart;
+        ++binStart[degW];
+        --degrees[w];
+      }
     }
-    sub->delNode(n);
   }
-
-  graph->delSubGraph(sub);
 }
 
 //================================================================================
@@ -163,31 +300,96 @@ bool CliqueEnumeration::run() {
     dataSet->get("minimum size", minsize);
   }
 
-  vector<node> ordering;
+  uint nbNodes = graph->numberOfNodes();
+  adjStart.assign(nbNodes + 1, 0);
+
+  TLP_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) { adjStart[i + 1] = graph->deg(n); });
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    adjStart[i + 1] += adjStart[i];
+  }
+
+  adjNodes.resize(adjStart[nbNodes]);
+
+  TLP_PARALLEL_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) {
+    uint pos = adjStart[i];
+
+    for (auto e : graph->incidence(n)) {
+      adjNodes[pos++] = graph->nodePos(graph->opposite(e, n));
+    }
+  });
+
+  vector<uint> ordering;
   getDegenerateOrdering(ordering);
+  vector<uint> ranks(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    ranks[ordering[i]] = i;
+  }
+
+  // the neighbours of each node are split between the ones before and after it
+  // in the degeneracy ordering, keeping their order
+  laterStart.resize(nbNodes);
 
-  for (uint i = 0; i < ordering.size(); ++i) {
-    set<node> neighu;
-    getNeighborhood(ordering[i], neighu);
-    set<node> P, X;
-    vector<node> R;
-    R.push_back(ordering[i]);
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    laterStart[i] = std::stable_partition(adjNodes.begin() + adjStart[i],
+                                          adjNodes.begin() + adjStart[i + 1],
+                                          [&](uint w) { return ranks[w] < ranks[i]; }) -
+                    adjNodes.begin();
+  });
 
-    for (uint j = 0; j <= i; ++j) {
-      if (neighu.contains(ordering[j])) {
-        X.insert(ordering[j]);
+  // the cliques found from each vertex, in the degeneracy ordering.
+  // The vertices have very different costs, so each thread takes the next one to search
+  // when it is done with the previous one
+  vector<vector<vector<uint>>> cliques(nbNodes);
+  atomic_uint nextVertex = 0;
+  atomic_bool stop = false;
+  // the progress, reported by the first thread every percent of the searched vertices
+  atomic_uint nbSearched = 0;
+  uint progressStep = std::max(1u, nbNodes / 100);
+
+  TLP_PARALLEL_MAP_INDICES(TLP_NB_THREADS, [&](uint) {
+    vector<uint> localIndices(nbNodes, UINT_MAX);
+    bool reportProgress = pluginProgress && ThreadManager::getThreadNumber() == 0;
+    uint nextProgress = 0;
+
+    for (uint i = nextVertex++; i < nbNodes && !stop.load(); i = nextVertex++) {
+      searchVertex(ordering[i], ranks, localIndices, cliques[i]);
+      uint nbDone = ++nbSearched;
+
+      if (reportProgress && nbDone >= nextProgress) {
+        nextProgress = nbDone + progressStep;
+
+        if (pluginProgress->progress(nbDone, nbNodes) != ProgressState::TLP_CONTINUE) {
+          stop = true;
+        }
       }
     }
+  });
+
+  if (stop.load() && pluginProgress->state() == ProgressState::TLP_CANCEL) {
+    return false;
+  }
+
+  // create all the subgraphs at the end, the observers being notified once
+  const vector<node> &nodes = graph->nodes();
+  vector<node> clique;
+  Observable::holdObservers();
+
+  for (const auto &vertexCliques : cliques) {
+    for (const auto &positions : vertexCliques) {
+      clique.clear();
 
-    for (uint j = i + 1; j < ordering.size(); ++j) {
-      if (neighu.contains(ordering[j])) {
-        P.insert(ordering[j]);
+      for (auto pos : positions) {
+        clique.push_back(nodes[pos]);
       }
-    }
 
-    maxCliquePivot(P, R, X);
+      graph->inducedSubGraph(clique, graph, "clique_" + to_string(cliqueid++));
+    }
   }
 
+  Observable::unholdObservers();
+
   if (dataSet != nullptr) {
     dataSet->set("#cliques created", cliqueid);
   }
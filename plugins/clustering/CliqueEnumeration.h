@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -14,8 +14,8 @@
 #ifndef CLIQUE_ENUMERATION_H
 #define CLIQUE_ENUMERATION_H
 
+#include <cstdint>
 #include <string>
-#include <set>
 #include <vector>
 
 #include <talipot/Algorithm.h>
@@ -34,6 +34,8 @@
  *  <b>HISTORY</b>
  *
  *
+ * - 2026 Version 1.1: pivoting over bitsets of the neighbourhoods in degeneracy order,
+ *   with the vertices processed in parallel.
  * - 2017 Version 1.0 (Bruno Pinaud): moved to Tulip trunk and clean the code a bit.
  * - 2013 Version 0.1: Initial release
  *  by François Queyroi, LaBRI, University Bordeaux I, France
@@ -48,12 +50,22 @@
  */
 class CliqueEnumeration : public tlp::Algorithm {
 
-  void addClique(const std::vector<tlp::node> &);
+  // the search for the maximal cliques containing a vertex and the vertices after it
+  // in the degeneracy ordering
+  struct VertexSearch;
 
-  void getDegenerateOrdering(std::vector<tlp::node> &);
-  void getNeighborhood(const tlp::node, std::set<tlp::node> &);
-  tlp::node choosePivot(const std::set<tlp::node> &);
-  void maxCliquePivot(std::set<tlp::node> &, const std::vector<tlp::node> &, std::set<tlp::node> &);
+  void getDegenerateOrdering(std::vector<uint> &);
+  void searchVertex(uint, const std::vector<uint> &, std::vector<uint> &,
+                    std::vector<std::vector<uint>> &);
+  void maxCliquePivot(VertexSearch &, std::vector<uint64_t> &, std::vector<uint64_t> &,
+                      std::vector<uint64_t> &, std::vector<uint> &);
+
+  // the adjacency of the nodes, by position, in compressed sparse row format
+  std::vector<uint> adjStart;
+  std::vector<uint> adjNodes;
+  // the position in the adjacency of each node of its first neighbour after it
+  // in the degeneracy ordering
+  std::vector<uint> laterStart;
 
   uint minsize;
   unsigned cliqueid;
@@ -67,7 +79,7 @@ public:
       "Listing All Maximal Cliques in Sparse Graphs in Near-optimal Time, "
       "Experimental Algorithms, Springer, "
       "2011",
-      "1.0", "Clustering")
+      "1.1", "Clustering")
 
   CliqueEnumeration(tlp::PluginContext *);
   bool run() override;
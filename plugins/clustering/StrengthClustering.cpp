@@ -11,6 +11,13 @@
  *
  */
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+
+#include <talipot/UnionFind.h>
+
 #include "StrengthClustering.h"
 
 using namespace std;
@@ -21,156 +28,280 @@ PLUGIN(StrengthClustering)
 //================================================================================
 StrengthClustering::~StrengthClustering() = default;
 //==============================================================================
-double StrengthClustering::computeMQValue(const vector<unordered_set<node>> &partition, Graph *sg) {
+// an edge is never removed from the partitioned graph when one of its ends has degree 1
+static bool isRemovable(const Graph *graph, const node src, const node tgt) {
+  return graph->deg(src) > 1 && graph->deg(tgt) > 1;
+}
+//==============================================================================
+/**
+ * The MQ value of a partition of the nodes of a graph, updated when two clusters are merged.
+ *
+ * MQ is the average edge density of the clusters minus the average edge density
+ * between the pairs of clusters. The clusters store their number of internal edges
+ * and their number of edges with each other cluster, so a merge only visits
+ * the clusters linked to the smallest of the two merged ones. For each cluster linked
+ * to many others is also kept the sum, over the clusters linked to it,
+ * of the number of edges between them divided by the size of the other cluster,
+ * as computing it would visit all these clusters.
+ */
+class MQPartition {
+public:
+  MQPartition(const Graph *graph)
+      : nodeClusters(graph->numberOfNodes()), clusters(graph->numberOfNodes()),
+        sizes(graph->numberOfNodes(), 1), nbInternalEdges(graph->numberOfNodes(), 0),
+        nbExternalEdges(graph->numberOfNodes()), isHeavy(graph->numberOfNodes(), false),
+        externalDensities(graph->numberOfNodes(), 0) {
+    iota(clusters.begin(), clusters.end(), 0);
 
-  vector<uint> nbIntraEdges(partition.size(), 0);
+    for (auto e : graph->edges()) {
+      const auto &[src, tgt] = graph->ends(e);
+      uint srcPos = graph->nodePos(src);
+      uint tgtPos = graph->nodePos(tgt);
+      ++nbExternalEdges[srcPos][tgtPos];
+      ++nbExternalEdges[tgtPos][srcPos];
+    }
+
+    // each pair of nodes is a pair of clusters of size 1
+    negative = graph->numberOfEdges();
+    minHeavyNbLinks = std::max(uint(sqrt(2.0 * graph->numberOfEdges())), 16u);
 
-  map<pair<uint, uint>, uint> nbExtraEdges;
+    for (uint c = 0; c < nbExternalEdges.size(); ++c) {
+      checkHeavy(c);
+    }
+  }
 
-  MutableContainer<uint> clusterId;
+  double value() const {
+    uint nbClusters = nodeClusters.numberOfSets();
+    double result = positive / double(nbClusters);
 
-  uint i = 0;
-  for (const auto &p : partition) {
-    for (auto n : p) {
-      clusterId.set(n.id, i);
+    if (nbClusters > 1) {
+      return result - negative / (double(nbClusters) * double(nbClusters - 1) / 2.0);
     }
-    ++i;
+
+    return result - negative;
   }
 
-  for (auto e : sg->edges()) {
-    auto [src, tgt] = sg->ends(e);
+  // merges the clusters of the nodes at positions u and v
+  void merge(uint u, uint v) {
+    uint ru = nodeClusters.find(u);
+    uint rv = nodeClusters.find(v);
 
-    if (src.id >= tgt.id) {
-      std::swap(src, tgt);
+    if (ru == rv) {
+      return;
     }
 
-    uint srcClustId = clusterId.get(src.id);
-    uint tgtClustId = clusterId.get(tgt.id);
+    uint cu = clusters[ru];
+    uint cv = clusters[rv];
 
-    if (srcClustId == tgtClustId) {
-      nbIntraEdges[srcClustId] += 1;
-    } else {
-      pair pp = {srcClustId, tgtClustId};
+    // the data of the merged cluster are the ones of the cluster linked to more clusters
+    if (nbExternalEdges[cu].size() < nbExternalEdges[cv].size()) {
+      std::swap(cu, cv);
+    }
 
-      if (nbExtraEdges.contains(pp)) {
-        nbExtraEdges[pp] += 1;
-      } else {
-        nbExtraEdges[pp] = 1;
+    uint nbEdgesBetween = nbExternalEdges[cu][cv];
+    double weightU = 1.0 / sizes[cu];
+    double weightV = 1.0 / sizes[cv];
+    double weight = 1.0 / (sizes[cu] + sizes[cv]);
+    double densityU = externalDensity(cu) - nbEdgesBetween * weightV;
+    double densityV = externalDensity(cv) - nbEdgesBetween * weightU;
+
+    negative += weight * (densityU + densityV) - weightU * densityU - weightV * densityV -
+                nbEdgesBetween * weightU * weightV;
+    positive -= internalDensity(cu) + internalDensity(cv);
+
+    // update the densities of the clusters linked to many others
+    uint nbHeavy = 0;
+
+    for (uint c : heavyClusters) {
+      // the density of cu is computed below
+      if (c == cv || (c != cu && nbExternalEdges[c].size() < minHeavyNbLinks / 2)) {
+        isHeavy[c] = false;
+        continue;
       }
-    }
-  }
 
-  double positive = 0;
+      if (c != cu) {
+        const flat_hash_map<uint, uint> &external = nbExternalEdges[c];
+        auto itU = external.find(cu);
+        auto itV = external.find(cv);
+        uint nbU = itU == external.end() ? 0 : itU->second;
+        uint nbV = itV == external.end() ? 0 : itV->second;
+        externalDensities[c] += (nbU + nbV) * weight - nbU * weightU - nbV * weightV;
+      }
 
-  for (uint i = 0; i < partition.size(); ++i) {
-    if (partition[i].size() > 1) {
-      positive +=
-          2.0 * double(nbIntraEdges[i]) / double(partition[i].size() * (partition[i].size() - 1));
+      heavyClusters[nbHeavy++] = c;
     }
-  }
 
-  positive /= double(partition.size());
+    heavyClusters.resize(nbHeavy);
 
-  double negative = 0;
+    // move the links of cv to cu
+    flat_hash_map<uint, uint> &external = nbExternalEdges[cu];
+    external.erase(cv);
 
-  for (const auto &[pp, val] : nbExtraEdges) {
-    if (!partition[pp.first].empty() && !partition[pp.second].empty()) {
-      negative += double(val) / double(partition[pp.first].size() * partition[pp.second].size());
+    for (const auto &[c, nbEdges] : nbExternalEdges[cv]) {
+      if (c != cu) {
+        external[c] += nbEdges;
+        flat_hash_map<uint, uint> &external2 = nbExternalEdges[c];
+        external2.erase(cv);
+        external2[cu] += nbEdges;
+      }
     }
+
+    flat_hash_map<uint, uint>().swap(nbExternalEdges[cv]);
+    clusters[nodeClusters.merge(ru, rv)] = cu;
+    sizes[cu] += sizes[cv];
+    nbInternalEdges[cu] += nbInternalEdges[cv] + nbEdgesBetween;
+    externalDensities[cu] = densityU + densityV;
+    positive += internalDensity(cu);
+    checkHeavy(cu);
   }
 
-  if (partition.size() > 1) {
-    negative /= double(partition.size() * (partition.size() - 1)) / 2.0;
+private:
+  double internalDensity(uint c) const {
+    double size = sizes[c];
+    return size > 1 ? 2.0 * nbInternalEdges[c] / (size * (size - 1)) : 0.;
   }
 
-  double result = positive - negative;
-  return result;
-}
+  double externalDensity(uint c) const {
+    if (isHeavy[c]) {
+      return externalDensities[c];
+    }
 
-//==============================================================================
-void StrengthClustering::computeNodePartition(double threshold,
-                                              vector<unordered_set<node>> &result) {
-  Graph *tmpGraph = graph->addCloneSubGraph();
+    double density = 0;
 
-  for (auto e : graph->edges()) {
-    if ((*values)[e] < threshold) {
-      const auto &[src, tgt] = graph->ends(e);
+    for (const auto &[c2, nbEdges] : nbExternalEdges[c]) {
+      density += double(nbEdges) / sizes[c2];
+    }
 
-      if (graph->deg(src) > 1 && graph->deg(tgt) > 1) {
-        tmpGraph->delEdge(e);
-      }
+    return density;
+  }
+
+  void checkHeavy(uint c) {
+    if (!isHeavy[c] && nbExternalEdges[c].size() >= minHeavyNbLinks) {
+      externalDensities[c] = externalDensity(c);
+      isHeavy[c] = true;
+      heavyClusters.push_back(c);
     }
   }
 
-  // Select SubGraph singleton in graph
-  unordered_set<node> singleton;
+  UnionFind nodeClusters;
+  // the cluster of each representative of nodeClusters
+  std::vector<uint> clusters;
+  std::vector<uint> sizes;
+  std::vector<uint> nbInternalEdges;
+  // the number of edges between a cluster and each cluster linked to it
+  std::vector<flat_hash_map<uint, uint>> nbExternalEdges;
+  // the clusters linked to at least minHeavyNbLinks clusters,
+  // for which externalDensities is up to date
+  std::vector<uint> heavyClusters;
+  std::vector<bool> isHeavy;
+  std::vector<double> externalDensities;
+  uint minHeavyNbLinks;
+  double positive = 0;
+  double negative = 0;
+};
+//==============================================================================
+vector<uint> StrengthClustering::computeNodePartition(double threshold) {
+  uint nbNodes = graph->numberOfNodes();
+  UnionFind components(nbNodes);
+  vector<bool> singleton(nbNodes, true);
 
-  for (auto n : tmpGraph->nodes()) {
-    if (tmpGraph->deg(n) == 0) {
-      singleton.insert(n);
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    if ((*values)[e] >= threshold || !isRemovable(graph, src, tgt)) {
+      uint srcPos = graph->nodePos(src);
+      uint tgtPos = graph->nodePos(tgt);
+      components.merge(srcPos, tgtPos);
+      singleton[srcPos] = singleton[tgtPos] = false;
     }
   }
 
   // restore edges to reconnect singleton by computing induced subgraph
   for (auto e : graph->edges()) {
     const auto &[src, tgt] = graph->ends(e);
+    uint srcPos = graph->nodePos(src);
+    uint tgtPos = graph->nodePos(tgt);
 
-    if (singleton.contains(src) && singleton.contains(tgt)) {
-      tmpGraph->addEdge(e);
+    if (singleton[srcPos] && singleton[tgtPos]) {
+      components.merge(srcPos, tgtPos);
     }
   }
 
-  // Extract connected component
-  DoubleProperty connected(tmpGraph);
-  string errMsg;
-  tmpGraph->applyPropertyAlgorithm("Connected Components", &connected, errMsg);
+  // the clusters are numbered in the order of their first node
+  vector<uint> clusterIndex(nbNodes, UINT_MAX);
+  vector<uint> result(nbNodes);
+  uint nbClusters = 0;
 
-  // Compute the node partition
-  int index = 0;
-  flat_hash_map<double, int> resultIndex;
+  for (uint i = 0; i < nbNodes; ++i) {
+    uint root = components.find(i);
 
-  for (auto n : tmpGraph->nodes()) {
-    double val = connected[n];
-
-    if (resultIndex.contains(val)) {
-      result[resultIndex[val]].insert(n);
-    } else {
-      unordered_set<node> tmp;
-      result.push_back(tmp);
-      resultIndex[val] = index;
-      result[index].insert(n);
-      ++index;
+    if (clusterIndex[root] == UINT_MAX) {
+      clusterIndex[root] = nbClusters++;
     }
+
+    result[i] = clusterIndex[root];
   }
 
-  graph->delAllSubGraphs(tmpGraph);
+  return result;
 }
 //==============================================================================
-double StrengthClustering::findBestThreshold(int numberOfSteps, bool &stopped) {
+double StrengthClustering::findBestThreshold(bool &stopped) {
+  // the nodes are merged into clusters by adding the removable edges by decreasing value,
+  // each distinct value being a threshold whose partition is evaluated.
+  // The singletons of a threshold are not reconnected here, as the partitions
+  // would no longer be obtained by merging clusters.
+  MQPartition partition(graph);
+  vector<pair<uint, uint>> removableEnds;
+  vector<double> removableValues;
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+    uint srcPos = graph->nodePos(src);
+    uint tgtPos = graph->nodePos(tgt);
+
+    if (isRemovable(graph, src, tgt)) {
+      removableEnds.emplace_back(srcPos, tgtPos);
+      removableValues.push_back((*values)[e]);
+    } else {
+      partition.merge(srcPos, tgtPos);
+    }
+  }
+
+  vector<uint> order(removableValues.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(),
+              [&](uint i, uint j) { return removableValues[i] > removableValues[j]; });
+
   double maxMQ = -2;
   double threshold = values->getEdgeMin(graph);
-  double deltaThreshold =
-      (values->getEdgeMax(graph) - values->getEdgeMin(graph)) / double(numberOfSteps);
-  int steps = 0;
-
-  for (double i = values->getEdgeMin(graph); i < values->getEdgeMax(graph); i += deltaThreshold) {
-    vector<unordered_set<node>> tmp;
-    computeNodePartition(i, tmp);
+  uint nbRemovableEdges = order.size();
+  uint progressStep = std::max(nbRemovableEdges / 10, 1u);
+  uint nextProgress = progressStep;
 
-    if (pluginProgress && ((++steps % (numberOfSteps / 10)) == 0)) {
-      pluginProgress->progress(steps, numberOfSteps);
+  for (uint i = 0; i < nbRemovableEdges;) {
+    double value = removableValues[order[i]];
 
-      if ((stopped = (pluginProgress->state() != ProgressState::TLP_CONTINUE))) {
-        return threshold;
-      }
+    for (; i < nbRemovableEdges && removableValues[order[i]] == value; ++i) {
+      const auto &[src, tgt] = removableEnds[order[i]];
+      partition.merge(src, tgt);
     }
 
-    double mq = computeMQValue(tmp, graph);
+    // the lowest threshold is kept for equal values
+    double mq = partition.value();
 
-    if (mq > maxMQ) {
-      threshold = i;
+    if (mq >= maxMQ) {
+      threshold = value;
       maxMQ = mq;
     }
+
+    if (pluginProgress && i >= nextProgress) {
+      nextProgress = i + progressStep;
+      pluginProgress->progress(i, nbRemovableEdges);
+
+      if ((stopped = (pluginProgress->state() != ProgressState::TLP_CONTINUE))) {
+        return threshold;
+      }
+    }
   }
 
   return threshold;
@@ -233,26 +364,23 @@ bool StrengthClustering::run() {
   }
 
   bool stopped = false;
-  const uint NB_TEST = 100;
 
   if (pluginProgress) {
     pluginProgress->setComment("Partitioning nodes...");
-    pluginProgress->progress(0, NB_TEST + 1);
+    pluginProgress->progress(0, 1);
   }
 
-  double threshold = findBestThreshold(NB_TEST, stopped);
+  double threshold = findBestThreshold(stopped);
 
   if (stopped) {
     return pluginProgress->state() != ProgressState::TLP_CANCEL;
   }
 
-  vector<unordered_set<node>> tmp;
-  computeNodePartition(threshold, tmp);
+  vector<uint> partition = computeNodePartition(threshold);
+  const vector<node> &nodes = graph->nodes();
 
-  for (uint i = 0; i < tmp.size(); ++i) {
-    for (auto n : tmp[i]) {
-      (*result)[n] = i;
-    }
+  for (uint i = 0; i < nodes.size(); ++i) {
+    (*result)[nodes[i]] = partition[i];
   }
 
   delete values;
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -15,15 +15,15 @@
 #define STRENGTH_CLUSTERING_H
 
 #include <string>
-#include <unordered_set>
 #include <vector>
-#include <talipot/hash.h>
 #include <talipot/PluginHeaders.h>
 
 /**
  * This plugin performs a single-linkage clustering.
  * The similarity measure used here is the Strength Metric computed on edges.
- * The best threshold is found using MQ Quality Measure.
+ * The best threshold is found using MQ Quality Measure,
+ * which is evaluated for each distinct value of the metric in a single sweep
+ * over the edges sorted by decreasing value.
  * See :
  *
  * Y. Chiricota, F. Jourdan and G. Melancon, G. \n
@@ -47,9 +47,9 @@ public:
   bool check(std::string &) override;
 
 private:
-  void computeNodePartition(double threshold, std::vector<std::unordered_set<tlp::node>> &);
-  double computeMQValue(const std::vector<std::unordered_set<tlp::node>> &partition, tlp::Graph *);
-  double findBestThreshold(int numberOfSteps, bool &stopped);
+  // returns the cluster of each node, according to its position in graph
+  std::vector<uint> computeNodePartition(double threshold);
+  double findBestThreshold(bool &stopped);
   tlp::DoubleProperty *values;
 };
 
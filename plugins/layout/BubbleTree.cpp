@@ -28,8 +28,17 @@ struct greaterRadius {
   }
 };
 
-double BubbleTree::computeRelativePosition(tlp::node n,
-                                           NodeVectorProperty<Vec5d> &relativePosition) {
+// the enclosing circles of the last tree laid out in incremental mode
+static SubtreeCache<SubtreeBubble> incrementalSubtrees;
+
+double BubbleTree::computeRelativePosition(tlp::node n) {
+  SubtreeBubble &subtree = (*subtrees)[n];
+
+  if (incremental && subtrees->isUpToDate(n)) {
+    return subtree.radius;
+  }
+
+  subtrees->setUpToDate(n);
 
   Size tmpSizeFather = (*nodeSize)[n];
   tmpSizeFather[2] = 0.; // remove z-coordinates because the drawing is 2D
@@ -48,8 +57,8 @@ double BubbleTree::computeRelativePosition(tlp::node n,
   /*
    * Initialize node position
    */
-  relativePosition[n][0] = 0.;
-  tlp::Vec5d &rPos = relativePosition[n];
+  tlp::Vec5d &rPos = subtree.relativePosition;
+  rPos[0] = 0.;
   rPos[1] = 0.;
 
   /*
@@ -60,7 +69,7 @@ double BubbleTree::computeRelativePosition(tlp::node n,
     rPos[3] = 0.;
     Size tmpSizeNode = (*nodeSize)[n];
     tmpSizeNode[2] = 0.;
-    return (rPos[4] = tmpSizeNode.norm() / 2.);
+    return (subtree.radius = rPos[4] = tmpSizeNode.norm() / 2.);
   }
 
   /*
@@ -78,7 +87,7 @@ double BubbleTree::computeRelativePosition(tlp::node n,
 
   for (uint i = 1; itN->hasNext(); ++i) {
     node itn = itN->next();
-    realCircleRadius[i] = computeRelativePosition(itn, relativePosition);
+    realCircleRadius[i] = computeRelativePosition(itn);
     sumRadius += realCircleRadius[i];
   }
 
@@ -195,16 +204,15 @@ double BubbleTree::computeRelativePosition(tlp::node n,
 
   for (uint i = 1; i < Nc; ++i) {
     node itn = itN->next();
-    relativePosition[itn][0] = circles[i][0] - circleH[0];
-    relativePosition[itn][1] = circles[i][1] - circleH[1];
+    (*subtrees)[itn].relativePosition[0] = circles[i][0] - circleH[0];
+    (*subtrees)[itn].relativePosition[1] = circles[i][1] - circleH[1];
   }
 
   delete itN;
-  return circleH.radius;
+  return subtree.radius = circleH.radius;
 }
 
 void BubbleTree::calcLayout2(tlp::node n, tlp::Vec5d &nrPos,
-                             NodeVectorProperty<Vec5d> &relativePosition,
                              const tlp::Vec3d &enclosingCircleCenter,
                              const tlp::Vec3d &originNodePosition) {
   /*
@@ -271,20 +279,20 @@ void BubbleTree::calcLayout2(tlp::node n, tlp::Vec5d &nrPos,
 
   while (it->hasNext()) {
     node itn = it->next();
-    tlp::Vec5d &rPos = relativePosition[itn];
+    tlp::Vec5d &rPos = (*subtrees)[itn].relativePosition;
     Vec3d newpos;
     newpos[0] = rPos[0];
     newpos[1] = rPos[1];
     newpos[2] = 0.;
     newpos = rot1 * newpos[0] + rot2 * newpos[1];
     newpos += enclosingCircleCenter;
-    calcLayout2(itn, rPos, relativePosition, newpos, enclosingCircleCenter + zeta);
+    calcLayout2(itn, rPos, newpos, enclosingCircleCenter + zeta);
   }
 
   delete it;
 }
 
-void BubbleTree::calcLayout(tlp::node n, NodeVectorProperty<Vec5d> &relativePosition) {
+void BubbleTree::calcLayout(tlp::node n) {
   /*
    * Make the recursive call, to place the children of n.
    */
@@ -292,19 +300,19 @@ void BubbleTree::calcLayout(tlp::node n, NodeVectorProperty<Vec5d> &relativePosi
   Iterator<node> *it = tree->getOutNodes(n);
 
   if (it->hasNext()) {
-    tlp::Vec5d &nPos = relativePosition[n];
+    tlp::Vec5d &nPos = (*subtrees)[n].relativePosition;
     double nPos2 = nPos[2];
     double nPos3 = nPos[3];
 
     while (it->hasNext()) {
       node itn = it->next();
       Vec3d origin, tmp;
-      tlp::Vec5d &rPos = relativePosition[itn];
+      tlp::Vec5d &rPos = (*subtrees)[itn].relativePosition;
       origin[0] = rPos[0] - nPos2;
       origin[1] = rPos[1] - nPos3;
       origin[2] = 0.;
       tmp.fill(0.);
-      calcLayout2(itn, rPos, relativePosition, origin, tmp);
+      calcLayout2(itn, rPos, origin, tmp);
     }
   }
 
@@ -314,11 +322,16 @@ void BubbleTree::calcLayout(tlp::node n, NodeVectorProperty<Vec5d> &relativePosi
 static constexpr std::string_view paramHelp[] = {
     // Complexity
     "This parameter enables to choose the complexity of the algorithm."
-    "If true, the complexity is O(n.log(n)), if false it is O(n)."};
+    "If true, the complexity is O(n.log(n)), if false it is O(n).",
+
+    // incremental
+    "If true, the enclosing circles of the subtrees are kept until the next run on the same "
+    "tree, which then only computes again the subtrees modified in between and their ancestors."};
 
 BubbleTree::BubbleTree(const tlp::PluginContext *context) : LayoutAlgorithm(context) {
   addNodeSizePropertyParameter(this);
   addInParameter<bool>("complexity", paramHelp[0].data(), "true");
+  addInParameter<bool>("incremental", paramHelp[1].data(), "false");
   addDependency("Connected Components Packing", "1.0");
   addDependency("Circular", "1.1");
 }
@@ -369,6 +382,12 @@ bool BubbleTree::run() {
     nAlgo = true;
   }
 
+  incremental = false;
+
+  if (dataSet != nullptr) {
+    dataSet->get("incremental", incremental);
+  }
+
   result->setAllEdgeValue(vector<Coord>(0));
 
   if (pluginProgress) {
@@ -390,9 +409,14 @@ bool BubbleTree::run() {
 
   node startNode = tree->getSource();
   assert(startNode.isValid());
-  NodeVectorProperty<Vec5d> relativePosition(graph);
-  computeRelativePosition(startNode, relativePosition);
-  calcLayout(startNode, relativePosition);
+  // the enclosing circles can only be kept when the graph is a tree,
+  // the spanning tree of another graph being deleted after each run
+  incremental = incremental && tree == graph;
+  SubtreeCache<SubtreeBubble> localSubtrees;
+  subtrees = incremental ? &incrementalSubtrees : &localSubtrees;
+  subtrees->prepare(tree, startNode, {nodeSize}, nAlgo ? "nlogn" : "n");
+  computeRelativePosition(startNode);
+  calcLayout(startNode);
 
   TreeTest::cleanComputedTree(graph, tree);
 
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -16,6 +16,15 @@
 
 #include <talipot/PluginHeaders.h>
 
+#include "SubtreeCache.h"
+
+struct SubtreeBubble {
+  // the position of the node relatively to its father and the center of its enclosing circle
+  tlp::Vec5d relativePosition;
+  // the radius of the enclosing circle of the subtree
+  double radius = 0;
+};
+
 /** This plug-in implement the bubble tree drawing algorithm
  *  first published as:
  *
@@ -31,6 +40,9 @@
  *  The algorithm can manage nodes of different size. The SizeProperty "viewSize"
  *  is used by default if no parameters are given to the plug-in.
  *  The parameter is (SizeProperty*) "node size".
+ *  In incremental mode, the enclosing circles of the subtrees are kept between two runs
+ *  on the same tree, so that only the subtrees modified in between and their ancestors
+ *  are computed again.
  *
  *
  *
@@ -49,13 +61,12 @@ public:
   bool run() override;
 
 private:
-  double computeRelativePosition(tlp::node n,
-                                 tlp::NodeVectorProperty<tlp::Vec5d> &relativePosition);
-  void calcLayout(tlp::node n, tlp::NodeVectorProperty<tlp::Vec5d> &relativePosition);
-  void calcLayout2(tlp::node n, tlp::Vec5d &nrPos,
-                   tlp::NodeVectorProperty<tlp::Vec5d> &relativePosition, const tlp::Vec3d &,
-                   const tlp::Vec3d &);
+  double computeRelativePosition(tlp::node n);
+  void calcLayout(tlp::node n);
+  void calcLayout2(tlp::node n, tlp::Vec5d &nrPos, const tlp::Vec3d &, const tlp::Vec3d &);
   tlp::Graph *tree;
+  SubtreeCache<SubtreeBubble> *subtrees;
+  bool incremental;
   tlp::SizeProperty *nodeSize;
   bool nAlgo;
 };
@@ -12,6 +12,7 @@
  */
 
 #include <talipot/DrawingTools.h>
+#include <talipot/ParallelTools.h>
 
 #include "ConnectedComponentsPacking.h"
 #include "rectanglePackingFonctions.h"
@@ -23,7 +24,7 @@ using namespace tlp;
 PLUGIN(ConnectedComponentsPacking)
 
 const float spacing = 8;
-#define COMPLEXITY "auto;n5;n4logn;n4;n3logn;n3;n2logn;n2;nlogn;n;"
+#define COMPLEXITY "auto;n5;n4logn;n4;n3logn;n3;n2logn;n2;nlogn;n;shelves;"
 
 static constexpr std::string_view paramHelp[] = {
     // coordinates
@@ -33,7 +34,9 @@ static constexpr std::string_view paramHelp[] = {
     "Input rotation of nodes around the z-axis.",
 
     // complexity
-    "Complexity of the algorithm.<br> n is the number of connected components in the graph."};
+    "Complexity of the algorithm.<br> n is the number of connected components in the graph. "
+    "<b>shelves</b> packs the components on shelves in O(n log n), and is used by <b>auto</b> "
+    "from 1000 components."};
 
 //====================================================================
 ConnectedComponentsPacking::ConnectedComponentsPacking(const tlp::PluginContext *context)
@@ -44,7 +47,8 @@ ConnectedComponentsPacking::ConnectedComponentsPacking(const tlp::PluginContext
   addInParameter<StringCollection>(
       "complexity", paramHelp[2].data(), COMPLEXITY, true,
       "<b>auto</b> <br> <b>n5</b> <br> <b>n4logn</b> <br> <b>n4</b> <br> <b>n3logn</b> <br> "
-      "<b>n3</b> <br> <b>n2logn</b> <br> <b>n2</b> <br> <b>nlogn</b> <br> <b>n</b>");
+      "<b>n3</b> <br> <b>n2logn</b> <br> <b>n2</b> <br> <b>nlogn</b> <br> <b>n</b> <br> "
+      "<b>shelves</b>");
 }
 //====================================================================
 bool ConnectedComponentsPacking::run() {
@@ -84,35 +88,32 @@ bool ConnectedComponentsPacking::run() {
   // compute the connected components
   auto ccNodes = ConnectedTest::computeConnectedComponents(graph);
 
-  vector<Rectangle<float>> rectangles;
-  rectangles.resize(ccNodes.size());
-  std::vector<std::vector<edge>> ccEdges;
-  ccEdges.resize(ccNodes.size());
+  vector<uint> nodeComponent(graph->numberOfNodes());
 
   for (uint i = 0; i < ccNodes.size(); ++i) {
-    std::vector<edge> &edges = ccEdges[i];
-    MutableContainer<bool> visited;
-    visited.setAll(false);
-    const std::vector<node> &nodes = ccNodes[i];
-    uint nbNodes = nodes.size();
-
-    for (uint j = 0; j < nbNodes; ++j) {
-      for (auto e : graph->incidence(nodes[j])) {
-        if (!visited.get(e.id)) {
-          visited.set(e.id, true);
-          edges.push_back(e);
-        }
-      }
+    for (auto n : ccNodes[i]) {
+      nodeComponent[graph->nodePos(n)] = i;
     }
+  }
+
+  std::vector<std::vector<edge>> ccEdges(ccNodes.size());
+
+  for (auto e : graph->edges()) {
+    ccEdges[nodeComponent[graph->nodePos(graph->source(e))]].push_back(e);
+  }
 
-    BoundingBox tmp = tlp::computeBoundingBox(graph, nodes, edges, layout, size, rotation);
+  vector<Rectangle<float>> rectangles(ccNodes.size());
+
+  TLP_PARALLEL_MAP_INDICES(ccNodes.size(), [&](uint i) {
+    BoundingBox tmp =
+        tlp::computeBoundingBox(graph, ccNodes[i], ccEdges[i], layout, size, rotation);
     Rectangle<float> &tmpRec = rectangles[i];
     tmpRec[1][0] = tmp[1][0] + spacing;
     tmpRec[1][1] = tmp[1][1] + spacing;
     tmpRec[0][0] = tmp[0][0] + spacing;
     tmpRec[0][1] = tmp[0][1] + spacing;
     assert(tmpRec.isValid());
-  }
+  });
 
   if (complexity == "auto") {
     if (rectangles.size() < 25) {
@@ -129,30 +130,42 @@ bool ConnectedComponentsPacking::run() {
       complexity = "n2logn";
     } else if (rectangles.size() < 1000) {
       complexity = "n2";
-    } else if (rectangles.size() < 5000) {
-      complexity = "nlogn";
     } else {
-      complexity = "n";
+      complexity = "shelves";
     }
   }
 
   vector<Rectangle<float>> rectanglesBackup(rectangles);
-  if (!RectanglePackingLimitRectangles(rectangles, complexity.c_str(), pluginProgress)) {
+
+  if (complexity == "shelves") {
+    RectanglePackingShelves(rectangles);
+  } else if (!RectanglePackingLimitRectangles(rectangles, complexity.c_str(), pluginProgress)) {
     return pluginProgress ? pluginProgress->state() != ProgressState::TLP_CANCEL : false;
   }
 
-  for (auto n : graph->nodes()) {
-    (*result)[n] = (*layout)[n];
+  vector<Coord> moves(ccNodes.size());
+
+  for (uint i = 0; i < ccNodes.size(); ++i) {
+    moves[i] = Coord(rectangles[i][0][0] - rectanglesBackup[i][0][0],
+                     rectangles[i][0][1] - rectanglesBackup[i][0][1], 0);
   }
 
-  for (auto e : graph->edges()) {
-    (*result)[e] = (*layout)[e];
+  // translate all the components in a single pass over the graph elements
+  const vector<node> &nodes = graph->nodes();
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    result->setNodeValue(nodes[i], (*layout)[nodes[i]] + moves[nodeComponent[i]]);
   }
 
-  for (uint i = 0; i < ccNodes.size(); ++i) {
-    Coord move(rectangles[i][0][0] - rectanglesBackup[i][0][0],
-               rectangles[i][0][1] - rectanglesBackup[i][0][1], 0);
-    result->translate(move, stlIterator(ccNodes[i]), stlIterator(ccEdges[i]));
+  for (auto e : graph->edges()) {
+    vector<Coord> bends = layout->getEdgeValue(e);
+    const Coord &move = moves[nodeComponent[graph->nodePos(graph->source(e))]];
+
+    for (auto &bend : bends) {
+      bend += move;
+    }
+
+    result->setEdgeValue(e, bends);
   }
 
   return true;
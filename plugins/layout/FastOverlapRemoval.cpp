@@ -11,9 +11,14 @@
  *
  */
 
+#include <atomic>
+#include <cfloat>
+
 #include <libvpsc/generate-constraints.h>
 #include <libvpsc/remove_rectangle_overlap.h>
 
+#include <talipot/UnionFind.h>
+
 #include "FastOverlapRemoval.h"
 
 using namespace std;
@@ -65,10 +70,153 @@ FastOverlapRemoval::FastOverlapRemoval(const tlp::PluginContext *context)
   addInParameter<double>("y border", paramHelp[6].data(), "0.0");
 }
 
+// the overlaps shallower than that are due to rounding errors
+static constexpr double OVERLAP_TOLERANCE = 1e-6;
+// the number of merges of clusters after which all the overlaps are removed at once
+static constexpr uint MAX_NB_ROUNDS = 32;
+static constexpr uint MIN_CELLS_PER_THREAD = 256;
+
+enum OverlapRemovalType { XY = 0, X, Y };
+
+static bool overlap(const vpsc::Rectangle &r1, const vpsc::Rectangle &r2) {
+  return r1.getMinX() + OVERLAP_TOLERANCE < r2.getMaxX() &&
+         r2.getMinX() + OVERLAP_TOLERANCE < r1.getMaxX() &&
+         r1.getMinY() + OVERLAP_TOLERANCE < r2.getMaxY() &&
+         r2.getMinY() + OVERLAP_TOLERANCE < r1.getMaxY();
+}
+
+/**
+ * Returns the pairs of overlapping rectangles. The rectangles are registered
+ * in the cells of a uniform grid they intersect, so only the rectangles
+ * sharing a cell are tested against each other.
+ */
+static vector<pair<uint, uint>> findOverlaps(const vector<vpsc::Rectangle> &rects) {
+  uint nbRects = rects.size();
+
+  if (nbRects == 0) {
+    return {};
+  }
+
+  double minX = DBL_MAX, minY = DBL_MAX, maxX = -DBL_MAX, maxY = -DBL_MAX;
+  double sumSizes = 0;
+
+  for (const auto &r : rects) {
+    minX = std::min(minX, r.getMinX());
+    minY = std::min(minY, r.getMinY());
+    maxX = std::max(maxX, r.getMaxX());
+    maxY = std::max(maxY, r.getMaxY());
+    sumSizes += std::max(r.width(), r.height());
+  }
+
+  // the cells have the average size of the rectangles,
+  // but there are at most a few cells per rectangle
+  double cellSize = std::max(sumSizes / nbRects, sqrt((maxX - minX) * (maxY - minY) / nbRects));
+
+  if (!(cellSize > 0)) {
+    cellSize = 1.0;
+  }
+
+  uint nbCols, nbRows;
+
+  while (true) {
+    nbCols = uint((maxX - minX) / cellSize) + 1;
+    nbRows = uint((maxY - minY) / cellSize) + 1;
+
+    if (double(nbCols) * nbRows <= 4.0 * nbRects) {
+      break;
+    }
+
+    cellSize *= 2;
+  }
+
+  auto col = [&](double x) { return std::min(nbCols - 1, uint((x - minX) / cellSize)); };
+  auto row = [&](double y) { return std::min(nbRows - 1, uint((y - minY) / cellSize)); };
+
+  // the rectangles of each cell in compressed sparse row format
+  uint nbCells = nbCols * nbRows;
+  vector<uint> cellStart(nbCells + 1, 0);
+
+  for (const auto &r : rects) {
+    for (uint j = row(r.getMinY()); j <= row(r.getMaxY()); ++j) {
+      for (uint i = col(r.getMinX()); i <= col(r.getMaxX()); ++i) {
+        ++cellStart[j * nbCols + i + 1];
+      }
+    }
+  }
+
+  for (uint c = 0; c < nbCells; ++c) {
+    cellStart[c + 1] += cellStart[c];
+  }
+
+  vector<uint> cellRects(cellStart[nbCells]);
+  vector<uint> next(cellStart.begin(), cellStart.end() - 1);
+
+  for (uint k = 0; k < nbRects; ++k) {
+    const vpsc::Rectangle &r = rects[k];
+
+    for (uint j = row(r.getMinY()); j <= row(r.getMaxY()); ++j) {
+      for (uint i = col(r.getMinX()); i <= col(r.getMaxX()); ++i) {
+        cellRects[next[j * nbCols + i]++] = k;
+      }
+    }
+  }
+
+  // each chunk of cells collects its own overlaps
+  uint nbChunks = std::max(1u, std::min(uint(TLP_NB_THREADS), nbCells / MIN_CELLS_PER_THREAD));
+  uint chunkSize = (nbCells + nbChunks - 1) / nbChunks;
+  vector<vector<pair<uint, uint>>> chunkOverlaps(nbChunks);
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint chunk) {
+    for (uint c = chunk * chunkSize; c < std::min(nbCells, (chunk + 1) * chunkSize); ++c) {
+      for (uint i = cellStart[c]; i < cellStart[c + 1]; ++i) {
+        const vpsc::Rectangle &r1 = rects[cellRects[i]];
+
+        for (uint j = i + 1; j < cellStart[c + 1]; ++j) {
+          const vpsc::Rectangle &r2 = rects[cellRects[j]];
+
+          // a pair sharing several cells is only reported by the cell
+          // containing the lower corner of their intersection
+          if (overlap(r1, r2) &&
+              row(std::max(r1.getMinY(), r2.getMinY())) * nbCols +
+                      col(std::max(r1.getMinX(), r2.getMinX())) ==
+                  c) {
+            chunkOverlaps[chunk].emplace_back(cellRects[i], cellRects[j]);
+          }
+        }
+      }
+    }
+  });
+
+  vector<pair<uint, uint>> overlaps;
+
+  for (const auto &pairs : chunkOverlaps) {
+    overlaps.insert(overlaps.end(), pairs.begin(), pairs.end());
+  }
+
+  return overlaps;
+}
+
+static void removeOverlaps(uint type, vector<vpsc::Rectangle> &rects, double xBorder,
+                           double yBorder) {
+  if (type == XY) {
+    removeRectangleOverlap(rects.size(), rects.data(), xBorder, yBorder);
+  } else if (type == X) {
+    removeRectangleOverlapX(rects.size(), rects.data(), xBorder, yBorder);
+  } else {
+    removeRectangleOverlapY(rects.size(), rects.data(), yBorder);
+  }
+}
+
 /**
  * The following function transfers the node set into vpsc rectangles
  * and runs fast overlap removal.  This vpsc code was a port of Dwyer
  * used in the InkScape Open Source Software.
+ *
+ * Instead of generating the constraints between all the rectangles,
+ * the rectangles are gathered in clusters of overlapping ones, which
+ * are processed independently and concurrently. When the rectangles
+ * moved in a cluster overlap other ones, their clusters are merged
+ * and processed again, until no overlap remains.
  */
 bool FastOverlapRemoval::run() {
   if (pluginProgress) {
@@ -125,12 +273,33 @@ bool FastOverlapRemoval::run() {
     (*result)[e] = (*viewLayout)[e];
   }
 
-  NodeVectorProperty<vpsc::Rectangle> nodeRectangles(graph);
+  uint type = stringCollection.getCurrent();
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+
+  if (nbNodes == 0) {
+    return true;
+  }
+
+  // each pass starts from the centres computed by the previous one
+  vector<Coord> centres(nbNodes);
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    const Coord &pos = (*viewLayout)[nodes[i]];
+    centres[i] = Coord(pos.getX(), pos.getY());
+  });
+
+  vector<vpsc::Rectangle> initialRects(nbNodes);
+  vector<vpsc::Rectangle> rects;
+  UnionFind overlapClusters;
+  vector<uint> clusterIndices(nbNodes);
+
   for (float passIndex = 1; passIndex <= nbPasses; ++passIndex) {
     // initialization
-    TLP_PARALLEL_MAP_NODES(graph, [&](node curNode) {
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      node curNode = nodes[i];
       Size sz = (*viewSize)[curNode] * passIndex / float(nbPasses);
-      const Coord &pos = (*viewLayout)[curNode];
+      const Coord &pos = centres[i];
       double curRot = (*viewRot)[curNode];
       Size rotSize = Size(sz.getW() * fabs(cos(curRot * M_PI / 180.0)) +
                               sz.getH() * fabs(sin(curRot * M_PI / 180.0)),
@@ -142,25 +311,99 @@ bool FastOverlapRemoval::run() {
       double minX = pos.getX() - rotSize.getW() / 2.0;
       double minY = pos.getY() - rotSize.getH() / 2.0;
 
-      nodeRectangles[curNode] = vpsc::Rectangle(minX, maxX, minY, maxY, xBorder, yBorder);
+      initialRects[i] = vpsc::Rectangle(minX, maxX, minY, maxY, xBorder, yBorder);
     });
 
-    size_t nbNodes = graph->numberOfNodes();
+    rects = initialRects;
+    overlapClusters.reset(nbNodes);
+    atomic<uint> nbProcessedNodes = 0;
 
-    // actually apply fast overlap removal
-    if (stringCollection.getCurrentString() == "X-Y") {
-      removeRectangleOverlap(nbNodes, nodeRectangles.data(), xBorder, yBorder);
-    } else if (stringCollection.getCurrentString() == "X") {
-      removeRectangleOverlapX(nbNodes, nodeRectangles.data(), xBorder, yBorder);
-    } else {
-      removeRectangleOverlapY(nbNodes, nodeRectangles.data(), yBorder);
-    }
+    for (uint round = 0;; ++round) {
+      // merge the clusters of the overlapping rectangles
+      vector<uint> mergedClusters;
 
-    for (auto n : graph->nodes()) {
-      Coord newPos = Coord(nodeRectangles[n].getCentreX(), nodeRectangles[n].getCentreY());
-      (*LayoutAlgorithm::result)[n] = newPos;
+      for (auto [i, j] : findOverlaps(rects)) {
+        if (!overlapClusters.sameSet(i, j)) {
+          mergedClusters.push_back(overlapClusters.merge(i, j));
+        }
+      }
+
+      if (mergedClusters.empty()) {
+        break;
+      }
+
+      uint maxClusterSize = 0;
+
+      for (uint &c : mergedClusters) {
+        c = overlapClusters.find(c);
+        maxClusterSize = std::max(maxClusterSize, overlapClusters.setSize(c));
+      }
+
+      if (round == MAX_NB_ROUNDS || 2 * maxClusterSize > nbNodes) {
+        // the overlaps spread over most of the graph,
+        // so remove all of them at once
+        rects = initialRects;
+        removeOverlaps(type, rects, xBorder, yBorder);
+        break;
+      }
+
+      // the merged clusters are processed again from the initial rectangles
+      vector<vector<uint>> clusters;
+      clusterIndices.assign(nbNodes, UINT_MAX);
+
+      for (uint c : mergedClusters) {
+        if (clusterIndices[c] == UINT_MAX) {
+          clusterIndices[c] = clusters.size();
+          clusters.emplace_back();
+          clusters.back().reserve(overlapClusters.setSize(c));
+        }
+      }
+
+      for (uint i = 0; i < nbNodes; ++i) {
+        uint c = clusterIndices[overlapClusters.find(i)];
+
+        if (c != UINT_MAX) {
+          clusters[c].push_back(i);
+        }
+      }
+
+      // the biggest clusters first to balance the load of the threads
+      std::sort(clusters.begin(), clusters.end(),
+                [](const auto &c1, const auto &c2) { return c1.size() > c2.size(); });
+
+      TLP_PARALLEL_MAP_INDICES(clusters.size(), [&](uint c) {
+        const vector<uint> &cluster = clusters[c];
+        vector<vpsc::Rectangle> clusterRects;
+        clusterRects.reserve(cluster.size());
+
+        for (uint i : cluster) {
+          clusterRects.push_back(initialRects[i]);
+        }
+
+        removeOverlaps(type, clusterRects, xBorder, yBorder);
+
+        for (uint k = 0; k < cluster.size(); ++k) {
+          rects[cluster[k]] = clusterRects[k];
+        }
+
+        nbProcessedNodes += cluster.size();
+
+        if (pluginProgress && ThreadManager::getThreadNumber() == 0) {
+          pluginProgress->progress(uint(passIndex - 1) * nbNodes +
+                                       std::min(nbNodes, nbProcessedNodes.load()),
+                                   nbPasses * nbNodes);
+        }
+      });
     }
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      centres[i] = Coord(rects[i].getCentreX(), rects[i].getCentreY());
+    });
   }
 
+  // the centres are in the order of the nodes of graph, which may be a subgraph
+  // of the graph of result
+  result->setValues(centres, {}, graph);
+
   return true;
 } // end run
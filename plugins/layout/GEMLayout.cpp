@@ -37,7 +37,12 @@ static constexpr std::string_view paramHelp[] = {
     // max iterations
     "This parameter allows to choose the number of iterations. The default value of 0 corresponds "
     "to (3 * nb_nodes * nb_nodes) if the graph has more than 100 nodes."
-    " For smaller graph, the number of iterations is set to 30 000."};
+    " For smaller graph, the number of iterations is set to 30 000.",
+
+    // multilevel
+    "If true, the graph is first coarsened by successive matchings of its nodes, then the layout "
+    "of the coarsest graph is refined on each finer graph. This converges faster on large "
+    "graphs."};
 
 /*
  * GEM3D Constants
@@ -78,19 +83,21 @@ GEMLayout::GEMLayout(const tlp::PluginContext *context)
       i_maxiter(IMAXITERDEF), a_maxiter(AMAXITERDEF), i_gravity(IGRAVITYDEF),
       a_gravity(AGRAVITYDEF), i_oscillation(IOSCILLATIONDEF), a_oscillation(AOSCILLATIONDEF),
       i_rotation(IROTATIONDEF), a_rotation(AROTATIONDEF), i_shake(ISHAKEDEF), a_shake(ASHAKEDEF),
-      _dim(2), _nbNodes(0), _useLength(false), metric(nullptr), fixedNodes(nullptr), max_iter(0) {
+      _dim(2), _nbNodes(0), _useLength(false), _edgeLength(EDGELENGTH), metric(nullptr),
+      fixedNodes(nullptr), max_iter(0), _level(nullptr), _finestLevel(true) {
   addInParameter<bool>("3D layout", paramHelp[0].data(), "false");
   addInParameter<NumericProperty *>("edge length", paramHelp[1].data(), "", false);
   addInParameter<LayoutProperty>("initial layout", paramHelp[2].data(), "", false);
   addInParameter<BooleanProperty>("unmovable nodes", paramHelp[3].data(), "", false);
   addInParameter<uint>("max iterations", paramHelp[4].data(), "0");
+  addInParameter<bool>("multilevel", paramHelp[5].data(), "false");
   addDependency("Connected Components Packing", "1.0");
 }
 //=========================================================
 GEMLayout::~GEMLayout() = default;
 //=========================================================
 uint GEMLayout::select() {
-  return randomNumber(graph->numberOfNodes() - 1);
+  return randomNumber(_nbNodes - 1);
 }
 //=========================================================
 void GEMLayout::vertexdata_init(const float starttemp) {
@@ -108,9 +115,50 @@ void GEMLayout::vertexdata_init(const float starttemp) {
 }
 //=========================================================
 void GEMLayout::updateLayout() {
-  for (uint i = 0; i < graph->numberOfNodes(); ++i) {
-    //    tlp::warning() << "pos up ==> :" << _particules[i].pos << endl;
-    result->setNodeValue(_particules[i].n, _particules[i].pos);
+  // the nodes of the coarse levels are not nodes of the graph
+  if (!_finestLevel) {
+    return;
+  }
+
+  const vector<node> &nodes = graph->nodes();
+
+  for (uint i = 0; i < _nbNodes; ++i) {
+    result->setNodeValue(nodes[i], _particules[i].pos);
+  }
+}
+//=========================================================
+void GEMLayout::initParticules(bool finest) {
+  _finestLevel = finest;
+  _nbNodes = _level->numberOfNodes();
+  _particules.resize(_nbNodes);
+  const vector<node> &nodes = graph->nodes();
+
+  for (uint i = 0; i < _nbNodes; ++i) {
+    _particules[i] = GEMparticule(finest ? float(graph->deg(nodes[i])) : float(_level->degree(i)));
+    _particules[i].id = i;
+    _particules[i].pos = _level->positions[i];
+  }
+}
+//=========================================================
+/*
+ * scale the layout of a coarse level around its center
+ * to the area expected for its finer level
+ */
+void GEMLayout::expandLevel(MultilevelCoarsening::Level &coarse, uint nbFineNodes) const {
+  uint nbNodes = coarse.numberOfNodes();
+  float scale = pow(float(nbFineNodes) / nbNodes, 1.f / _dim);
+  Coord center;
+
+  for (const auto &pos : coarse.positions) {
+    center += pos;
+  }
+
+  center /= float(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    if (!coarse.fixed[i]) {
+      coarse.positions[i] = center + (coarse.positions[i] - center) * scale;
+    }
   }
 }
 //=========================================================
@@ -123,7 +171,6 @@ Coord GEMLayout::computeForces(uint v, float shake, float gravity, bool testPlac
   Coord force;
   Coord vPos = _particules[v].pos;
   float vMass = _particules[v].mass;
-  node vNode = _particules[v].n;
 
   // Init force in a random position
   for (uint cnt = 0; cnt < _dim; ++cnt) {
@@ -155,26 +202,12 @@ Coord GEMLayout::computeForces(uint v, float shake, float gravity, bool testPlac
     }
   }
 
-  // attractive forces
-  for (auto e : graph->incidence(vNode)) {
-    node uNode = graph->opposite(e, vNode);
-
-    if (uNode == vNode) {
-      // nothing to do if it is a self loop
-      continue;
-    }
-
-    const GEMparticule &gemQ = _particules[graph->nodePos(uNode)];
+  // attractive forces, the self loops are not in the adjacency of the level
+  for (uint i = _level->adjStart[v]; i < _level->adjStart[v + 1]; ++i) {
+    const GEMparticule &gemQ = _particules[_level->adjNodes[i]];
 
     if (!testPlaced || gemQ.in > 0) { // test whether the node is already placed
-      float edgeLength;
-
-      if (_useLength) {
-        edgeLength = float(metric->getEdgeDoubleValue(e));
-      } else {
-        edgeLength = EDGELENGTH;
-      }
-
+      float edgeLength = this->edgeLength(i);
       Coord d = vPos - gemQ.pos;
       float n = d.norm() / vMass;
       n = std::min(n, MAXATTRACT); //   1048576L
@@ -184,7 +217,19 @@ Coord GEMLayout::computeForces(uint v, float shake, float gravity, bool testPlac
   return force;
 }
 //==========================================================================
-void GEMLayout::insert() {
+/*
+ * length of the edge of the i-th adjacency of the current level,
+ * only the edges of the finest level have their own length
+ */
+float GEMLayout::edgeLength(uint i) const {
+  if (_useLength && !_level->adjEdges.empty()) {
+    return float(metric->getEdgeDoubleValue(_level->adjEdges[i]));
+  }
+
+  return _edgeLength;
+}
+//==========================================================================
+void GEMLayout::insert(uint v) {
   int startNode;
 
   this->vertexdata_init(i_starttemp);
@@ -193,9 +238,6 @@ void GEMLayout::insert() {
   _rotation = i_rotation;
   _maxtemp = i_maxtemp;
 
-  node nCenter = graphCenterHeuristic(graph);
-  uint v = _particules[graph->nodePos(nCenter)].id;
-
   for (uint i = 0; i < _nbNodes; ++i) {
     _particules[i].in = 0;
   }
@@ -225,21 +267,16 @@ void GEMLayout::insert() {
 
     //
     _particules[v].in = 1;
-    node vNode = _particules[v].n;
 
-    // nothing to do if vNode is a fixed node
-    if (fixedNodes && (*fixedNodes)[vNode]) {
+    // nothing to do if v is a fixed node
+    if (_level->fixed[v]) {
       continue;
     }
 
     // remove one to non-visited nodes
-    for (auto uNode : graph->getInOutNodes(vNode)) {
-      if (uNode == vNode) {
-        // nothing to do if it is a self loop
-        continue;
-      }
+    for (uint j = _level->adjStart[v]; j < _level->adjStart[v + 1]; ++j) {
+      GEMparticule &gemQ = _particules[_level->adjNodes[j]];
 
-      GEMparticule &gemQ = _particules[graph->nodePos(uNode)];
       if (gemQ.in <= 0) {
         --gemQ.in;
       }
@@ -250,13 +287,10 @@ void GEMLayout::insert() {
 
     if (startNode >= 0) {
       int d = 0;
-      for (auto uNode : graph->getInOutNodes(vNode)) {
-        if (uNode == vNode) {
-          // nothing to do if it a self loop
-          continue;
-        }
 
-        GEMparticule &gemQ = _particules[graph->nodePos(uNode)];
+      for (uint j = _level->adjStart[v]; j < _level->adjStart[v + 1]; ++j) {
+        GEMparticule &gemQ = _particules[_level->adjNodes[j]];
+
         if (gemQ.in > 0) {
           gemP.pos += gemQ.pos;
           ++d;
@@ -309,10 +343,9 @@ void GEMLayout::displace(uint v, Coord imp) {
 void GEMLayout::a_round() {
   for (uint i = 0; i < _nbNodes; ++i) {
     uint v = this->select();
-    node vNode = _particules[v].n;
 
-    // nothing to do if vNode is a fixed node
-    if (fixedNodes && (*fixedNodes)[vNode]) {
+    // nothing to do if v is a fixed node
+    if (_level->fixed[v]) {
       continue;
     }
 
@@ -322,7 +355,7 @@ void GEMLayout::a_round() {
   }
 }
 //============================================================================
-void GEMLayout::arrange() {
+void GEMLayout::arrange(const float starttemp) {
   float stop_temperature;
 
   double maxEdgeLength;
@@ -335,7 +368,7 @@ void GEMLayout::arrange() {
 
   maxEdgeLength *= maxEdgeLength;
 
-  this->vertexdata_init(a_starttemp);
+  this->vertexdata_init(starttemp);
 
   _oscillation = a_oscillation;
   _rotation = a_rotation;
@@ -391,10 +424,12 @@ bool GEMLayout::run() {
 
   /* Handle parameters */
   metric = nullptr;
+  fixedNodes = nullptr;
   LayoutProperty *layout = graph->getLayoutProperty("viewLayout");
 
   bool is3D = false;
   bool initLayout = false;
+  bool multilevel = false;
   _useLength = false;
   max_iter = 0;
 
@@ -402,6 +437,7 @@ bool GEMLayout::run() {
     dataSet->get("3D layout", is3D);
     _useLength = dataSet->get("edge length", metric) && metric != nullptr;
     dataSet->get("max iterations", max_iter);
+    dataSet->get("multilevel", multilevel);
     initLayout = !dataSet->get("initial layout", layout);
 
     if (initLayout) {
@@ -415,49 +451,83 @@ bool GEMLayout::run() {
     _dim = 2;
   }
 
-  _nbNodes = graph->numberOfNodes();
-
   // no bends
   result->setAllEdgeValue(vector<Coord>(0));
 
   // initialize a random sequence according the given seed
   tlp::initRandomSequence();
 
-  if (max_iter == 0) {
-    max_iter = std::max(a_maxiter * _nbNodes * _nbNodes, MIN_ITER);
-  }
+  _edgeLength = EDGELENGTH;
 
-  _particules.resize(_nbNodes);
-  /* Max Edge to scale actual edges length to preferres length */
-  uint i = 0;
-  for (auto n : graph->nodes()) {
-    _particules[i] = GEMparticule(float(graph->deg(n)));
-    _particules[i].n = n;
-    _particules[i].id = i;
+  if (_useLength && graph->numberOfEdges() > 0) {
+    double sum = 0;
 
-    if (!initLayout && layout != nullptr) {
-      _particules[i].pos = (*layout)[n];
-    } else {
-      _particules[i].pos.fill(0);
+    for (auto e : graph->edges()) {
+      sum += metric->getEdgeDoubleValue(e);
     }
 
-    ++i;
+    _edgeLength = float(sum / graph->numberOfEdges());
   }
 
-  if (initLayout && layout != nullptr) {
-    if (i_finaltemp < i_starttemp) {
-      this->insert();
-    }
+  MultilevelCoarsening coarsening(graph, initLayout ? nullptr : layout, nullptr, fixedNodes);
+
+  if (multilevel) {
+    coarsening.coarsen();
   }
 
-  if ((pluginProgress->state() == ProgressState::TLP_CONTINUE) && (a_finaltemp < a_starttemp)) {
-    this->arrange();
+  uint nbLevels = coarsening.numberOfLevels();
+  bool insertion =
+      initLayout && layout != nullptr && i_finaltemp < i_starttemp && !graph->isEmpty();
+  uint center = 0;
+
+  if (insertion) {
+    // the insertion starts from the node of the coarsest level containing the graph center
+    center = graph->nodePos(graphCenterHeuristic(graph));
+
+    for (uint l = 0; l + 1 < nbLevels; ++l) {
+      center = coarsening.level(l).coarseNodes[center];
+    }
   }
 
-  if (pluginProgress->state() != ProgressState::TLP_CANCEL) {
-    updateLayout();
+  uint maxIter = max_iter;
+
+  for (uint l = nbLevels; l-- > 0;) {
+    _level = &coarsening.level(l);
+
+    if (l < nbLevels - 1) {
+      expandLevel(coarsening.level(l + 1), _level->numberOfNodes());
+      coarsening.prolong(l, _dim);
+    }
+
+    initParticules(l == 0);
+
+    if (maxIter == 0) {
+      max_iter = std::max(a_maxiter * _nbNodes * _nbNodes, MIN_ITER);
+    }
+
+    if (insertion && l == nbLevels - 1) {
+      this->insert(center);
+    }
+
+    // the finer levels start from the layout of their coarser level,
+    // so they are only rearranged with a lower temperature
+    float starttemp = l == nbLevels - 1 ? a_starttemp : i_starttemp;
+
+    if ((pluginProgress->state() == ProgressState::TLP_CONTINUE) && (a_finaltemp < starttemp)) {
+      this->arrange(starttemp);
+    }
+
+    if (pluginProgress->state() == ProgressState::TLP_CANCEL) {
+      return false;
+    }
+
+    for (uint i = 0; i < _nbNodes; ++i) {
+      _level->positions[i] = _particules[i].pos;
+    }
   }
 
-  return pluginProgress->state() != ProgressState::TLP_CANCEL;
+  updateLayout();
+
+  return true;
 }
 //=========================================================
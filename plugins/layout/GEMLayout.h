@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2023  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include <talipot/PluginHeaders.h>
+#include <talipot/MultilevelCoarsening.h>
 
 /// An implementation of a spring-embedder layout.
 /** This plugin is an implementation of the GEM-2d layout
@@ -60,6 +61,11 @@
  * it merges the 3D stuff and removes the use of integers (new CPU do not
  * require it anymore).
  *
+ * \note In multilevel mode, the graph is first coarsened by successive
+ * matchings of its nodes, the coarsest graph being laid out with the
+ * insertion and arrangement phases, then each finer graph is initialized
+ * from the layout of its coarser graph and only rearranged.
+ *
  *  \author David Duke, University of Bath, UK: Email: D.Duke@bath.ac.uk
  *  \author David Auber,University of Bordeaux, FR: Email: david.auber@labri.fr
  *  Version 0.1: 23 July 2001.
@@ -80,9 +86,9 @@ public:
 
 private:
   tlp::Coord computeForces(uint v, float shake, float gravity, bool testPlaced);
+  float edgeLength(uint i) const;
 
   struct GEMparticule {
-    tlp::node n;
     tlp::Coord pos; // position
     int in;
     tlp::Coord imp; // impulse
@@ -105,12 +111,15 @@ private:
 
   uint select();
   void vertexdata_init(const float starttemp);
-  void insert();
+  void insert(uint v);
   void displace(uint v, tlp::Coord imp);
   void a_round();
-  void arrange();
+  void arrange(const float starttemp);
   void updateLayout();
 
+  void initParticules(bool finest);
+  void expandLevel(tlp::MultilevelCoarsening::Level &coarse, uint nbFineNodes) const;
+
   std::vector<GEMparticule> _particules;
   std::vector<int> _map; // for random selection
 
@@ -154,11 +163,15 @@ private:
   const float a_shake;
 
   uint _dim;                        // 2 or 3;
-  uint _nbNodes;                    // number of nodes in the graph
+  uint _nbNodes;                    // number of nodes in the current level
   bool _useLength;                  // if we manage edge length
+  float _edgeLength;                // the length of the edges of the coarse levels
   tlp::NumericProperty *metric;     // metric for edge length
   tlp::BooleanProperty *fixedNodes; // selection of not movable nodes
   uint max_iter;                    // the max number of iterations
+  // the graph being laid out, one of the levels of the coarsening in multilevel mode
+  tlp::MultilevelCoarsening::Level *_level;
+  bool _finestLevel;
 };
 
 #endif // GEM_LAYOUT_H
@@ -11,6 +11,10 @@
  *
  */
 
+#include <random>
+
+#include <talipot/ParallelTools.h>
+
 #include "Grip.h"
 #include "Distances.h"
 
@@ -19,13 +23,20 @@ using namespace tlp;
 
 static constexpr std::string_view paramHelp[] = {
     // 3D
-    "If true the layout is in 3D else it is computed in 2D"};
+    "If true the layout is in 3D else it is computed in 2D",
+
+    // parallel
+    "If true, the nodes of each level of the filtration are placed concurrently against the "
+    "positions of the previous ones, and the refinement rounds are computed in parallel. The "
+    "layout then differs from the sequential one, where the nodes of a level are placed one after "
+    "the other."};
 
 //======================================================
 Grip::Grip(const tlp::PluginContext *context)
     : LayoutAlgorithm(context), misf(nullptr), edgeLength(0), level(0), currentGraph(nullptr),
-      _dim(0) {
+      _dim(0), parallel(false) {
   addInParameter<bool>("3D layout", paramHelp[0].data(), "false");
+  addInParameter<bool>("parallel", paramHelp[1].data(), "false");
   addDependency("Connected Components Packing", "1.0");
 }
 Grip::~Grip() = default;
@@ -90,6 +101,14 @@ void Grip::computeCurrentGraphLayout() {
     init();
     firstNodesPlacement();
     placement();
+
+    const vector<node> &nodes = currentGraph->nodes();
+
+    for (uint i = 0; i < nodes.size(); ++i) {
+      (*result)[nodes[i]] = positions[i];
+    }
+
+    misf = nullptr;
   }
 }
 //======================================================
@@ -100,6 +119,8 @@ bool Grip::run() {
     if (!dataSet->get("3D layout", is3D)) {
       is3D = false;
     }
+
+    dataSet->get("parallel", parallel);
   }
 
   if (is3D) {
@@ -147,20 +168,21 @@ void Grip::computeOrdering() {
 
 //======================================================
 void Grip::firstNodesPlacement() {
-  node n1 = misf->ordering[0];
-  node n2 = misf->ordering[1];
-  node n3 = misf->ordering[2];
+  uint n1 = misf->ordering[0];
+  uint n2 = misf->ordering[1];
+  uint n3 = misf->ordering[2];
+  const vector<node> &nodes = currentGraph->nodes();
 
-  float d12 = getDist(currentGraph, n1, n2);
-  float d13 = getDist(currentGraph, n1, n3);
-  float d23 = getDist(currentGraph, n2, n3);
+  float d12 = getDist(currentGraph, nodes[n1], nodes[n2]);
+  float d13 = getDist(currentGraph, nodes[n1], nodes[n3]);
+  float d23 = getDist(currentGraph, nodes[n2], nodes[n3]);
 
-  (*result)[n1] = Coord(0, 0, 0);
-  (*result)[n2] = Coord(d12, 0, 0);
+  positions[n1] = Coord(0, 0, 0);
+  positions[n2] = Coord(d12, 0, 0);
 
   float x3 = (d13 * d13 - d23 * d23 + d12 * d12) / (d12 * 2.);
   float y3 = sqrt(d13 * d13 - x3 * x3);
-  (*result)[n3] = Coord(x3, y3, 0);
+  positions[n3] = Coord(x3, y3, 0);
 
   if (_dim == 2) {
     oldDisp[n1] = Coord(1., 0, 0);
@@ -168,18 +190,19 @@ void Grip::firstNodesPlacement() {
     oldDisp[n3] = Coord(x3 + 1., y3, 0);
   } else {
     Graph *g = currentGraph->addSubGraph();
-    g->addNode(n1);
-    g->addNode(n2);
-    g->addNode(n3);
+
+    for (uint n : {n1, n2, n3}) {
+      g->addNode(nodes[n]);
+      (*result)[nodes[n]] = positions[n];
+    }
+
     result->rotateX(3.14159 / 2. - (3.14159 * randomNumber(1)), g->getNodes(), g->getEdges());
     currentGraph->delSubGraph(g);
 
-    const Coord &c1 = (*result)[n1];
-    const Coord &c2 = (*result)[n2];
-    const Coord &c3 = (*result)[n3];
-    oldDisp[n1] = c1;
-    oldDisp[n2] = c2;
-    oldDisp[n3] = c3;
+    for (uint n : {n1, n2, n3}) {
+      positions[n] = (*result)[nodes[n]];
+      oldDisp[n] = positions[n];
+    }
   }
 
   neighbors[n1].push_back(n2);
@@ -220,91 +243,142 @@ void Grip::seeLayout(uint end) {
   cerr << "profondeur " << level << endl;
 
   for (uint i = 0; i <= end; ++i) {
-    node n = misf->ordering[i];
+    uint n = misf->ordering[i];
 
     for (uint j = 0; j < neighbors[n].size(); ++j) {
       cerr << "distance euclidienne "
-           << ((*result)[n] - (*result)[neighbors[n][j]]).norm() / edgeLength
+           << (positions[n] - positions[neighbors[n][j]]).norm() / edgeLength
            << " et distance dans le graphe " << neighbors_dist[n][j] << endl;
     }
   }
 }
 //======================================================
-void Grip::initialPlacement(uint start, uint end) {
-  for (uint i = start; i <= end; ++i) {
-    node currNode = misf->ordering[i];
-    misf->getNearest(currNode, neighbors[currNode], neighbors_dist[currNode], level,
-                     levelToNbNeighbors[level + 1]);
+template <typename NodeFunction>
+void Grip::mapNodes(uint start, uint end, const NodeFunction &nodeFunction) {
+  if (parallel) {
+    TLP_PARALLEL_MAP_INDICES(end - start + 1,
+                             [&](uint i) { nodeFunction(misf->ordering[start + i]); });
+  } else {
+    for (uint i = start; i <= end; ++i) {
+      nodeFunction(misf->ordering[i]);
+    }
   }
-
-  for (uint i = start; i <= end; ++i) {
-    node currNode = misf->ordering[i];
-    Coord c_tmp;
-    float nbConsidered = 0.;
-
-    for (uint j = 0; j < neighbors[currNode].size(); ++j) {
-      c_tmp += (*result)[neighbors[currNode][j]];
-      oldDisp[currNode] += oldDisp[neighbors[currNode][j]];
-      nbConsidered += 1.;
+}
+//======================================================
+void Grip::initialPlacement(uint start, uint end) {
+  uint nbNodes = end - start + 1;
+  uint nbNeighbors = levelToNbNeighbors[level + 1];
+  // each chunk of nodes uses its own buffers for the nearest neighbors searches
+  uint nbChunks = parallel ? std::max(1u, std::min(uint(TLP_NB_THREADS), nbNodes / 64)) : 1;
+  uint chunkSize = (nbNodes + nbChunks - 1) / nbChunks;
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    MISFiltering::NearestSearch search;
+    misf->initNearestSearch(search);
+
+    for (uint i = start + c * chunkSize; i < std::min(end + 1, start + (c + 1) * chunkSize);
+         ++i) {
+      uint currNode = misf->ordering[i];
+      misf->getNearest(currNode, neighbors[currNode], neighbors_dist[currNode], level,
+                       nbNeighbors, search);
     }
+  });
 
+  // randomNumber is not thread safe, so the random moves are drawn beforehand
+  vector<Coord> aleas(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
     double alpha = edgeLength / 6.0 * randomNumber();
-    Coord alea =
+    aleas[i] =
         Coord(alpha - (2. * alpha * randomNumber(1)), alpha - (2. * alpha * randomNumber(1)),
               (alpha - (2. * alpha * randomNumber(1))));
 
     if (_dim == 2) {
-      alea[2] = 0.;
+      aleas[i][2] = 0.;
+    }
+  }
+
+  // in parallel mode, the placed nodes only see the previous positions of their neighbors
+  vector<Coord> newPositions(nbNodes);
+  vector<Coord> newDisps(nbNodes);
+  vector<Coord> newOldDisps(nbNodes);
+  vector<double> newHeats(nbNodes);
+
+  auto placeNode = [&](uint i) {
+    uint currNode = misf->ordering[start + i];
+    Coord &c_tmp = newPositions[i];
+    Coord &nodeOldDisp = newOldDisps[i];
+    nodeOldDisp = oldDisp[currNode];
+    float nbConsidered = 0.;
+
+    for (uint n : neighbors[currNode]) {
+      c_tmp += positions[n];
+      nodeOldDisp += oldDisp[n];
+      nbConsidered += 1.;
     }
 
     c_tmp /= nbConsidered;
-    oldDisp[currNode] /= nbConsidered;
-    oldDisp[currNode] += alea;
-    c_tmp += alea;
-    (*result)[currNode] = c_tmp;
-    heat[currNode] = edgeLength / 6.0;
-    kk_local_reffinement(currNode);
+    nodeOldDisp /= nbConsidered;
+    nodeOldDisp += aleas[i];
+    c_tmp += aleas[i];
+    newHeats[i] = edgeLength / 6.0;
+
+    // local refinement
+    for (uint cpt = 6; cpt > 1; --cpt) {
+      newDisps[i] = kkDisplacement(currNode, c_tmp);
+      displace(c_tmp, newDisps[i], nodeOldDisp, newHeats[i]);
+    }
+  };
+
+  auto moveNode = [&](uint i) {
+    uint currNode = misf->ordering[start + i];
+    positions[currNode] = newPositions[i];
+    disp[currNode] = newDisps[i];
+    oldDisp[currNode] = newOldDisps[i];
+    heat[currNode] = newHeats[i];
+  };
+
+  if (parallel) {
+    TLP_PARALLEL_MAP_INDICES(nbNodes, placeNode);
+    TLP_PARALLEL_MAP_INDICES(nbNodes, moveNode);
+  } else {
+    for (uint i = 0; i < nbNodes; ++i) {
+      placeNode(i);
+      moveNode(i);
+    }
   }
 }
-
 //======================================================
-void Grip::kk_local_reffinement(node currNode) {
-  //  cerr << __PRETTY_FUNCTION__ << endl;
-  uint cpt = 6;
-
-  while (cpt > 1) {
-    disp[currNode] = Coord(0, 0, 0);
-    const Coord &c = (*result)[currNode];
-
-    for (uint j = 0; j < neighbors[currNode].size() /*&& j < 3*/; ++j) {
-      node n = neighbors[currNode][j];
-      const Coord &c_n = (*result)[n];
-      Coord c_tmp = c_n - c;
-      float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
-
-      if (_dim == 3) {
-        euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
-      }
+Coord Grip::kkDisplacement(uint currNode, const Coord &c) const {
+  Coord nodeDisp(0, 0, 0);
 
-      float th_dist = neighbors_dist[currNode][j];
-      c_tmp *= (euclidian_dist_sqr / (th_dist * th_dist * edgeLength * edgeLength)) - 1.;
-      disp[currNode] += c_tmp;
+  for (uint j = 0; j < neighbors[currNode].size(); ++j) {
+    const Coord &c_n = positions[neighbors[currNode][j]];
+    Coord c_tmp = c_n - c;
+    float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
+
+    if (_dim == 3) {
+      euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
     }
 
-    displace(currNode);
-    --cpt;
+    float th_dist = neighbors_dist[currNode][j];
+    c_tmp *= (euclidian_dist_sqr / (th_dist * th_dist * edgeLength * edgeLength)) - 1.;
+    nodeDisp += c_tmp;
   }
+
+  return nodeDisp;
 }
 //======================================================
-void Grip::displace(node n) {
-  updateLocalTemp(n);
-  float disp_norm = disp[n].norm();
+void Grip::displace(Coord &position, Coord &nodeDisp, Coord &nodeOldDisp,
+                    double &nodeHeat) const {
+  updateLocalTemp(nodeDisp, nodeOldDisp, nodeHeat);
+  float disp_norm = nodeDisp.norm();
 
   if (disp_norm > 1E-4) {
-    disp[n] /= disp_norm;
-    oldDisp[n] = disp[n];
-    disp[n] *= float(heat[n]);
-    (*result)[n] = (*result)[n] + disp[n];
+    nodeDisp /= disp_norm;
+    nodeOldDisp = nodeDisp;
+    nodeDisp *= float(nodeHeat);
+    position += nodeDisp;
   }
 }
 //======================================================
@@ -313,128 +387,120 @@ void Grip::kk_reffinement(uint start, uint end) {
   uint cpt = rounds(end, 0, 20, currentGraph->numberOfNodes(), 30) + 2;
 
   while (cpt >= 1) {
-    for (uint i = start; i <= end; ++i) {
-      node currNode = misf->ordering[i];
-      disp[currNode] = Coord(0, 0, 0);
-      const Coord &c = (*result)[currNode];
-
-      for (uint j = 0; j < neighbors[currNode].size(); ++j) {
-        node n = neighbors[currNode][j];
-        const Coord &c_n = (*result)[n];
-        Coord c_tmp = c_n - c;
-        float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
-
-        if (_dim == 3) {
-          euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
-        }
-
-        float th_dist = neighbors_dist[currNode][j];
-        c_tmp *= (euclidian_dist_sqr / (th_dist * th_dist * edgeLength * edgeLength)) - 1.;
-        disp[currNode] += c_tmp;
-      }
-    }
+    mapNodes(start, end, [&](uint currNode) {
+      disp[currNode] = kkDisplacement(currNode, positions[currNode]);
+    });
 
     // update node position
-    for (uint i = 0; i <= end; ++i) {
-      displace(misf->ordering[i]);
-    }
+    mapNodes(0, end, [&](uint n) { displace(positions[n], disp[n], oldDisp[n], heat[n]); });
 
     --cpt;
   }
 }
 //======================================================
-void Grip::fr_reffinement(uint start, uint end) {
-  // cerr << __PRETTY_FUNCTION__ << endl;
+Coord Grip::frDisplacement(uint currNode) {
+  const Coord &curCoord = positions[currNode];
+  Coord nodeDisp(0, 0, 0);
+
+  // attractive force calculation
+  for (uint n : misf->adjacentNodes(currNode)) {
+    const Coord &c_n = positions[n];
+    Coord c_tmp = c_n - curCoord;
+    float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
+
+    if (_dim == 3) {
+      euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
+    }
 
-  uint cpt = rounds(end, 0, 20, currentGraph->numberOfNodes(), 30) + 2;
+    c_tmp *= euclidian_dist_sqr / (edgeLength * edgeLength);
+    nodeDisp += c_tmp;
+  }
 
-  while (cpt >= 1) {
-    for (uint i = start; i <= end; ++i) {
-      node currNode = misf->ordering[i];
-      const Coord &curCoord = (*result)[currNode];
-      disp[currNode] = Coord(0, 0, 0);
-
-      // attractive force calculation
-      for (auto n : currentGraph->getInOutNodes(currNode)) {
-        const Coord &c_n = (*result)[n];
-        Coord c_tmp = c_n - curCoord;
-        float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
-
-        if (_dim == 3) {
-          euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
-        }
+  // repulsive force calculation
+  for (uint n : neighbors[currNode]) {
+    const Coord &c_n = positions[n];
+    Coord c_tmp = curCoord - c_n;
+    double euclidian_dist_sqr =
+        double(c_tmp[0]) * double(c_tmp[0]) + double(c_tmp[1]) * double(c_tmp[1]);
+
+    if (_dim == 3) {
+      euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
+    }
 
-        c_tmp *= euclidian_dist_sqr / (edgeLength * edgeLength);
-        disp[currNode] += c_tmp;
+    if (!(euclidian_dist_sqr > 1E-4)) {
+      if (parallel) {
+        // randomNumber is not thread safe, use a generator seeded by the pair of nodes
+        minstd_rand generator(currNode * 65599u + n + 1u);
+        uniform_real_distribution<double> random(0., 1.);
+        double alpha = 2.0 * random(generator);
+        c_tmp = Coord(alpha - (2. * alpha * random(generator)),
+                      alpha - (2. * alpha * random(generator)),
+                      alpha - (2. * alpha * random(generator)));
+      } else {
+        double alpha = randomNumber(2.0);
+        c_tmp =
+            Coord(alpha - (2. * alpha * randomNumber(1)), alpha - (2. * alpha * randomNumber(1)),
+                  alpha - (2. * alpha * randomNumber(1)));
       }
 
-      // repulsive force calculation
-      for (uint j = 0; j < neighbors[currNode].size(); ++j) {
-        node n = neighbors[currNode][j];
-        const Coord &c_n = (*result)[n];
-        Coord c_tmp = curCoord - c_n;
-        double euclidian_dist_sqr =
-            double(c_tmp[0]) * double(c_tmp[0]) + double(c_tmp[1]) * double(c_tmp[1]);
+      if (_dim == 2) {
+        c_tmp[2] = 0.;
+      }
 
-        if (_dim == 3) {
-          euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
-        }
+      euclidian_dist_sqr = 0.01;
+    }
 
-        if (!(euclidian_dist_sqr > 1E-4)) {
-          double alpha = randomNumber(2.0);
-          c_tmp =
-              Coord(alpha - (2. * alpha * randomNumber(1)), alpha - (2. * alpha * randomNumber(1)),
-                    alpha - (2. * alpha * randomNumber(1)));
+    c_tmp *= (0.05f * edgeLength * edgeLength) / float(euclidian_dist_sqr);
+    nodeDisp += c_tmp;
+  }
 
-          if (_dim == 2) {
-            c_tmp[2] = 0.;
-          }
+  return nodeDisp;
+}
+//======================================================
+void Grip::fr_reffinement(uint start, uint end) {
+  // cerr << __PRETTY_FUNCTION__ << endl;
 
-          euclidian_dist_sqr = 0.01;
-        }
+  uint cpt = rounds(end, 0, 20, currentGraph->numberOfNodes(), 30) + 2;
 
-        c_tmp *= (0.05f * edgeLength * edgeLength) / float(euclidian_dist_sqr);
-        disp[currNode] += c_tmp;
-      }
-    }
+  while (cpt >= 1) {
+    mapNodes(start, end, [&](uint currNode) { disp[currNode] = frDisplacement(currNode); });
 
     // update node position
-    for (uint i = 0; i <= end; ++i) {
-      displace(misf->ordering[i]);
-    }
+    mapNodes(0, end, [&](uint n) { displace(positions[n], disp[n], oldDisp[n], heat[n]); });
 
     --cpt;
   }
 }
 
 //======================================================
-void Grip::updateLocalTemp(node v) {
+void Grip::updateLocalTemp(const Coord &nodeDisp, const Coord &nodeOldDisp,
+                           double &nodeHeat) const {
   // cerr << __PRETTY_FUNCTION__ << endl;
-  float oldDisp_norm = oldDisp[v].norm();
-  float curDisp_norm = disp[v].norm();
+  float oldDisp_norm = nodeOldDisp.norm();
+  float curDisp_norm = nodeDisp.norm();
 
   if (curDisp_norm * oldDisp_norm > 1E-4) {
 
-    double scalar = disp[v].dotProduct(oldDisp[v]);
+    double scalar = nodeDisp.dotProduct(nodeOldDisp);
     double cos = scalar / (curDisp_norm * oldDisp_norm);
 
-    Coord tmp1 = oldDisp[v] / oldDisp_norm;
-    Coord tmp2 = disp[v] / curDisp_norm;
+    Coord tmp1 = nodeOldDisp / oldDisp_norm;
+    Coord tmp2 = nodeDisp / curDisp_norm;
 
     double sin = (tmp2 ^ tmp1).norm();
 
     double r = 6.;
     double o = 6.0;
 
-    heat[v] += cos * r * heat[v];
+    nodeHeat += cos * r * nodeHeat;
     /*
-    heat[v] = std::max(heat[v], 0.001);
-    heat[v] = std::min(heat[v], 2. * edgeLength/6.0);
+    nodeHeat = std::max(nodeHeat, 0.001);
+    nodeHeat = std::min(nodeHeat, 2. * edgeLength/6.0);
     */
-    heat[v] += sin * o * heat[v];
+    nodeHeat += sin * o * nodeHeat;
 
-    heat[v] = std::max(heat[v], edgeLength / 300.);
-    heat[v] = std::min(heat[v], edgeLength / 4.0);
+    nodeHeat = std::max(nodeHeat, edgeLength / 300.);
+    nodeHeat = std::min(nodeHeat, edgeLength / 4.0);
   }
 }
 //======================================================
@@ -455,8 +521,16 @@ void Grip::init() {
   edgeLength = 32.;
   level = 0;
 
-  double diam = sqrt(currentGraph->numberOfNodes());
-  for (auto n : currentGraph->nodes()) {
+  uint nbNodes = currentGraph->numberOfNodes();
+  double diam = sqrt(nbNodes);
+  positions.resize(nbNodes);
+  disp.assign(nbNodes, Coord(0, 0, 0));
+  oldDisp.assign(nbNodes, Coord(0, 0, 0));
+  heat.assign(nbNodes, edgeLength / 6.);
+  neighbors.assign(nbNodes, {});
+  neighbors_dist.assign(nbNodes, {});
+
+  for (uint i = 0; i < nbNodes; ++i) {
     Coord alea = Coord(diam - (2. * diam * randomNumber(1)), diam - (2. * diam * randomNumber(1)),
                        diam - (2. * diam * randomNumber(1)));
 
@@ -464,10 +538,7 @@ void Grip::init() {
       alea[2] = 0.;
     }
 
-    (*result)[n] = alea;
-    disp[n] = Coord(0, 0, 0);
-    oldDisp[n] = Coord(0, 0, 0);
-    heat[n] = edgeLength / 6.;
+    positions[i] = alea;
   }
 }
 //======================================================
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -58,13 +58,16 @@ private:
   void firstNodesPlacement();
   void placement();
   void initialPlacement(uint, uint);
-  void kk_local_reffinement(tlp::node);
   void kk_reffinement(uint, uint);
   void fr_reffinement(uint, uint);
-  void displace(tlp::node);
-  void updateLocalTemp(tlp::node);
+  tlp::Coord kkDisplacement(uint, const tlp::Coord &) const;
+  tlp::Coord frDisplacement(uint);
+  void displace(tlp::Coord &, tlp::Coord &, tlp::Coord &, double &) const;
+  void updateLocalTemp(const tlp::Coord &, const tlp::Coord &, double &) const;
   void init();
   void init_heat(uint);
+  template <typename NodeFunction>
+  void mapNodes(uint, uint, const NodeFunction &);
 
   void seeLayout(uint);
 
@@ -75,15 +78,18 @@ private:
   MISFiltering *misf;
   float edgeLength;
   int level;
-  flat_hash_map<tlp::node, std::vector<uint>> neighbors_dist;
-  flat_hash_map<tlp::node, std::vector<tlp::node>> neighbors;
+  // the nodes are identified by their position in currentGraph
+  std::vector<tlp::Coord> positions;
+  std::vector<std::vector<uint>> neighbors_dist;
+  std::vector<std::vector<uint>> neighbors;
   flat_hash_map<uint, uint> levelToNbNeighbors;
-  flat_hash_map<tlp::node, tlp::Coord> disp;
-  flat_hash_map<tlp::node, tlp::Coord> oldDisp;
-  flat_hash_map<tlp::node, double> heat;
-  flat_hash_map<tlp::node, double> oldCos;
+  std::vector<tlp::Coord> disp;
+  std::vector<tlp::Coord> oldDisp;
+  std::vector<double> heat;
 
   tlp::Graph *currentGraph;
   int _dim;
+  // if true the nodes of a level are placed and refined concurrently
+  bool parallel;
 };
 #endif // GRIP_H
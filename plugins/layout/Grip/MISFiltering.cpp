@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -11,142 +11,170 @@
  *
  */
 
+#include <climits>
+
 #include "MISFiltering.h"
 
 using namespace tlp;
 using namespace std;
 
-MISFiltering::MISFiltering(Graph *g) {
-  g_copy = g;
-  removedVisit.setAll(false);
-  removed.setAll(false);
-  attendedVisit.setAll(false);
-  visited.setAll(false);
+MISFiltering::MISFiltering(Graph *g) : level(0), nbNodes(g->numberOfNodes()) {
+  adjStart.reserve(nbNodes + 1);
+  adjNodes.reserve(2 * g->numberOfEdges());
+
+  for (auto n : g->nodes()) {
+    adjStart.push_back(adjNodes.size());
+
+    for (auto v : g->getInOutNodes(n)) {
+      adjNodes.push_back(g->nodePos(v));
+    }
+  }
+
+  adjStart.push_back(adjNodes.size());
+
+  removedVisit.assign(nbNodes, false);
+  removed.assign(nbNodes, false);
+  attendedVisit.assign(nbNodes, false);
+  visited.assign(nbNodes, false);
+  nodeDepth.assign(nbNodes, 0);
+  inNext.assign(nbNodes, false);
 }
 //========================================
 MISFiltering::~MISFiltering() = default;
 //========================================
 void MISFiltering::computeFiltering() {
-  node firstNode = g_copy->getOneNode();
+  uint firstNode = 0;
 
-  inLastVi.setAll(true);
+  inLastVi.assign(nbNodes, true);
+  levelToNodes.assign(1, vector<uint>(nbNodes));
 
-  for (auto n : g_copy->nodes()) {
-    levelToNodes[0].insert(n);
+  for (uint n = 0; n < nbNodes; ++n) {
+    levelToNodes[0][n] = n;
   }
 
   level = 1;
-  uint nb = g_copy->numberOfNodes();
+  uint nb = nbNodes;
 
   while (nb > 3) {
     nb = 0;
-    visited.setAll(false);
-    removedVisit.setAll(false);
-    attendedVisit.setAll(false);
-    attendedVisit.set(firstNode.id, true);
+    visited.assign(nbNodes, false);
+    removedVisit.assign(nbNodes, false);
+    attendedVisit.assign(nbNodes, false);
+    attendedVisit[firstNode] = true;
     toVisit.clear();
     toVisit.push_back(firstNode);
-    inCurVi.setAll(false);
-    inCurVi.set(firstNode.id, true);
+    inCurVi.assign(nbNodes, false);
+    inCurVi[firstNode] = true;
 
     uint depth = 2u << (level - 1u);
 
-    for (auto current : toVisit) {
-      if (removedVisit.get(current.id)) {
+    // toVisit grows while being visited
+    for (uint i = 0; i < toVisit.size(); ++i) {
+      uint current = toVisit[i];
+
+      if (removedVisit[current]) {
         continue;
       }
 
-      visited.set(current.id, true);
+      visited[current] = true;
       bfsDepth(current, depth);
     }
 
-    inLastVi.setAll(false);
+    levelToNodes.emplace_back();
 
-    for (uint id : inCurVi.findAll(true)) {
-      node n(id);
-      levelToNodes[level].insert(n);
-      inLastVi.set(n.id, true);
-      ++nb;
+    for (uint n = 0; n < nbNodes; ++n) {
+      inLastVi[n] = inCurVi[n];
+
+      if (inCurVi[n]) {
+        levelToNodes[level].push_back(n);
+        ++nb;
+      }
     }
 
     ++level;
-    inCurVi.setAll(false);
-    removed.setAll(false);
+    removed.assign(nbNodes, false);
   }
 
   updateVectors();
 }
 //========================================
-void MISFiltering::bfsDepth(node n, uint depth) {
-  vector<node> nextNodes;
-  flat_hash_map<node, uint> nodeDepth;
-  MutableContainer<bool> inNext;
-  inNext.setAll(false);
-  inNext.set(n.id, true);
+void MISFiltering::bfsDepth(uint n, uint depth) {
+  vector<uint> nextNodes;
+  inNext[n] = true;
   nextNodes.push_back(n);
-  nodeDepth[n] = 0;
 
   for (uint i = 0; i < nextNodes.size(); ++i) {
-    node current = nextNodes[i];
-    for (auto v : g_copy->getInOutNodes(current)) {
-      if (visited.get(v.id) || inNext.get(v.id)) {
+    uint current = nextNodes[i];
+
+    for (uint v : adjacentNodes(current)) {
+      if (visited[v] || inNext[v]) {
         continue;
       }
 
       if (nodeDepth[current] < depth - 1) {
-        inNext.set(v.id, true);
+        inNext[v] = true;
         nextNodes.push_back(v);
-        removed.set(v.id, true);
+        removed[v] = true;
+      }
+
+      if (nodeDepth[v] == 0) {
+        reached.push_back(v);
       }
 
       nodeDepth[v] = nodeDepth[current] + 1;
 
-      if (nodeDepth[v] == depth && inLastVi.get(v.id) && !removed.get(v.id)) {
-        if (!attendedVisit.get(v.id)) {
+      if (nodeDepth[v] == depth && inLastVi[v] && !removed[v]) {
+        if (!attendedVisit[v]) {
           toVisit.push_back(v);
-          attendedVisit.set(v.id, true);
-          inCurVi.set(v.id, true);
-        }
-      } else if (nodeDepth[v] != 0) {
-        if (attendedVisit.get(v.id)) {
-          removedVisit.set(v.id, true);
-          inCurVi.set(v.id, false);
-          removed.set(v.id, true);
+          attendedVisit[v] = true;
+          inCurVi[v] = true;
         }
+      } else if (attendedVisit[v]) {
+        removedVisit[v] = true;
+        inCurVi[v] = false;
+        removed[v] = true;
       }
     }
   }
+
+  // reset the buffers for the next search
+  for (uint v : nextNodes) {
+    inNext[v] = false;
+  }
+
+  for (uint v : reached) {
+    nodeDepth[v] = 0;
+  }
+
+  reached.clear();
 }
 //========================================
 void MISFiltering::updateVectors() {
-  ordering.resize(g_copy->numberOfNodes());
+  ordering.resize(nbNodes);
+  rank.resize(nbNodes);
 
   if (level == 1) {
-    uint curPos = 0;
-    for (auto n : g_copy->nodes()) {
-      ordering[curPos++] = n;
+    for (uint n = 0; n < nbNodes; ++n) {
+      ordering[n] = rank[n] = n;
     }
     return;
   }
 
-  MutableContainer<bool> considered;
-  considered.setAll(false);
+  vector<bool> considered(nbNodes, false);
   uint curPos = 0;
+  // the last level reached by the filtration is empty
+  levelToNodes.resize(level + 1);
 
   while (level + 1) {
-    auto it = levelToNodes[level].begin();
-
-    while (it != levelToNodes[level].end()) {
-      node n = *it;
-      ++it;
-
-      if (considered.get(n.id)) {
+    for (uint n : levelToNodes[level]) {
+      if (considered[n]) {
         continue;
       }
 
+      rank[n] = curPos;
       ordering[curPos] = n;
       ++curPos;
-      considered.set(n.id, true);
+      considered[n] = true;
     }
 
     if (level != 0) {
@@ -183,43 +211,42 @@ void MISFiltering::updateVectors() {
   }
 }
 //========================================
-void MISFiltering::getNearest(node n, vector<node> &neighbors, vector<uint> &neighbors_dist,
-                              uint level, uint nbNeighbors) {
-  vector<node> nextNodes;
-  MutableContainer<bool> alreadyTreated;
-  MutableContainer<bool> toTreat;
-  flat_hash_map<node, uint> nodeDepth;
+void MISFiltering::initNearestSearch(NearestSearch &search) const {
+  search.depth.assign(nbNodes, UINT_MAX);
+  search.nextNodes.clear();
+}
+//========================================
+void MISFiltering::getNearest(uint n, vector<uint> &neighbors, vector<uint> &neighbors_dist,
+                              uint level, uint nbNeighbors, NearestSearch &search) const {
+  vector<uint> &nextNodes = search.nextNodes;
+  vector<uint> &depth = search.depth;
   bool found = false;
   unsigned nbFound = 0;
 
+  // the nodes of the last level are the ones not registered in index
+  uint nbCandidates = level + 1 < index.size() ? index[level + 1] : nbNodes;
+
   neighbors_dist.clear();
   neighbors.clear();
-  nodeDepth[n] = 0;
-  alreadyTreated.setAll(false);
-  toTreat.setAll(false);
+  nextNodes.clear();
   nextNodes.push_back(n);
-  alreadyTreated.set(n.id, true);
-
-  for (uint i = 0; i < index[level + 1]; ++i) {
-    toTreat.set(ordering[i].id, true);
-  }
+  depth[n] = 0;
 
   for (uint i = 0; !found && i < nextNodes.size(); ++i) {
-    node current = nextNodes[i];
+    uint current = nextNodes[i];
 
-    for (auto v : g_copy->getInOutNodes(current)) {
+    for (uint v : adjacentNodes(current)) {
 
-      if (alreadyTreated.get(v.id)) {
+      if (depth[v] != UINT_MAX) {
         continue;
       }
 
-      alreadyTreated.set(v.id, true);
-      nodeDepth[v] = nodeDepth[current] + 1;
+      depth[v] = depth[current] + 1;
       nextNodes.push_back(v);
 
-      if (toTreat.get(v.id)) {
+      if (rank[v] < nbCandidates) {
         neighbors.push_back(v);
-        neighbors_dist.push_back(nodeDepth[v]);
+        neighbors_dist.push_back(depth[v]);
         ++nbFound;
       }
 
@@ -229,5 +256,10 @@ void MISFiltering::getNearest(node n, vector<node> &neighbors, vector<uint> &nei
       }
     }
   }
+
+  // reset the buffers for the next search
+  for (uint v : nextNodes) {
+    depth[v] = UINT_MAX;
+  }
 }
 //========================================
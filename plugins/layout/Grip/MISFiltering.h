@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -14,41 +14,71 @@
 #ifndef MIS_FILTERING_H
 #define MIS_FILTERING_H
 
-#include <talipot/hash.h>
-#include <unordered_set>
+#include <span>
+#include <vector>
 
 #include <talipot/PluginHeaders.h>
-#include <talipot/MutableContainer.h>
 
+/**
+ * Computes the maximal independent set filtration of a graph used by GRIP.
+ *
+ * The nodes are identified by their position in the graph, and the adjacency
+ * of the graph is copied once in flat arrays, so the filtration and the
+ * nearest neighbors searches never iterate over the graph itself.
+ */
 class MISFiltering {
 
 public:
   MISFiltering(tlp::Graph *);
   ~MISFiltering();
 
+  // buffers of a nearest neighbors search, a search can be run concurrently
+  // with other ones as long as it uses its own buffers
+  struct NearestSearch {
+    std::vector<uint> depth;
+    std::vector<uint> nextNodes;
+  };
+
   void computeFiltering();
-  void getNearest(tlp::node, std::vector<tlp::node> &, std::vector<uint> &, uint, uint = 3);
+  void initNearestSearch(NearestSearch &) const;
+  void getNearest(uint, std::vector<uint> &, std::vector<uint> &, uint, uint,
+                  NearestSearch &) const;
 
-  std::vector<tlp::node> ordering;
+  // Returns the positions of the neighbors of the node at the given position
+  std::span<const uint> adjacentNodes(uint n) const {
+    return {adjNodes.data() + adjStart[n], adjNodes.data() + adjStart[n + 1]};
+  }
+
+  // the positions of the nodes ordered by decreasing filtration level
+  std::vector<uint> ordering;
   std::vector<uint> index;
 
 private:
   uint level;
-  tlp::MutableContainer<bool> inLastVi;
-  tlp::MutableContainer<bool> inCurVi;
-  tlp::MutableContainer<bool> removed;
-  std::vector<uint> v_dist;
+  std::vector<bool> inLastVi;
+  std::vector<bool> inCurVi;
+  std::vector<bool> removed;
 
-  flat_hash_map<uint, std::unordered_set<tlp::node>> levelToNodes;
+  std::vector<std::vector<uint>> levelToNodes;
 
-  void bfsDepth(tlp::node, uint);
+  void bfsDepth(uint, uint);
   void updateVectors();
 
-  tlp::Graph *g_copy;
-  tlp::MutableContainer<bool> removedVisit;
-  tlp::MutableContainer<bool> attendedVisit;
-  tlp::MutableContainer<bool> visited;
+  uint nbNodes;
+  std::vector<uint> adjStart;
+  std::vector<uint> adjNodes;
+  // rank of each node in ordering
+  std::vector<uint> rank;
+
+  std::vector<bool> removedVisit;
+  std::vector<bool> attendedVisit;
+  std::vector<bool> visited;
+
+  std::vector<uint> toVisit;
 
-  std::vector<tlp::node> toVisit;
+  // buffers of bfsDepth
+  std::vector<uint> nodeDepth;
+  std::vector<bool> inNext;
+  std::vector<uint> reached;
 };
 #endif // MIS_FILTERING_H
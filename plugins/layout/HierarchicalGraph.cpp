@@ -71,84 +71,162 @@ inline uint HierarchicalGraph::degree(tlp::Graph *sg, tlp::node n, bool directed
   return directed ? sg->outdeg(n) : sg->indeg(n);
 }
 //================================================================================
-void HierarchicalGraph::twoLayerCrossReduction(tlp::Graph *sg, uint freeLayer) {
-  for (auto n : grid[freeLayer]) {
-    double sum = (*embedding)[n];
-    uint deg = 1;
-    for (auto itn : sg->getInOutNodes(n)) {
-      sum += (*embedding)[itn];
-      ++deg;
+// Do layer by layer sweep to reduce crossings in K-Layer graph
+void HierarchicalGraph::crossReduction(tlp::Graph *sg) {
+  // the sweeps work on flat arrays indexed by the positions of the nodes in graph,
+  // with an extra sink node linked to the nodes without out edges, itself included
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+  uint sink = nbNodes;
+  vector<double> positions(nbNodes + 1, 0);
+  vector<bool> isSink(nbNodes + 1, false);
+  vector<uint> sinkNodes;
+  vector<uint> adjStart(nbNodes + 2, 0);
+  vector<uint> outStart(nbNodes + 2, 0);
+
+  for (auto n : sg->nodes()) {
+    if (sg->outdeg(n) == 0) {
+      sinkNodes.push_back(graph->nodePos(n));
     }
-    (*embedding)[n] = sum / deg;
   }
-}
-//================================================================================
-// Set initial position using a DFS
-void HierarchicalGraph::initCross(tlp::Graph *sg, tlp::node n, tlp::MutableContainer<bool> &visited,
-                                  int id) {
-  if (visited.get(n.id)) {
-    return;
+
+  for (uint n : sinkNodes) {
+    isSink[n] = true;
   }
 
-  visited.set(n.id, true);
-  (*embedding)[n] = id;
-  for (auto it : sg->getOutNodes(n)) {
-    initCross(sg, it, visited, id + 1);
+  for (uint i = 0; i < nbNodes; ++i) {
+    positions[i] = (*embedding)[nodes[i]];
+    adjStart[i + 1] = adjStart[i] + graph->deg(nodes[i]) + isSink[i];
+    outStart[i + 1] = outStart[i] + (isSink[i] ? 1 : sg->outdeg(nodes[i]));
   }
-}
-//================================================================================
-// Do layer by layer sweep to reduce crossings in K-Layer graph
-void HierarchicalGraph::crossReduction(tlp::Graph *sg) {
 
-  node tmp = sg->addNode();
-  (*embedding)[tmp] = 0;
-  for (auto it : sg->nodes()) {
-    if (sg->outdeg(it) == 0) {
-      sg->addEdge(it, tmp);
+  sinkNodes.push_back(sink);
+  adjStart[sink + 1] = adjStart[sink] + sinkNodes.size() + 1;
+  outStart[sink + 1] = outStart[sink] + 1;
+  vector<uint> adjNodes(adjStart[sink + 1]);
+  vector<uint> outNodes(outStart[sink + 1]);
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    node n = nodes[i];
+    uint adj = adjStart[i];
+    uint out = outStart[i];
+
+    for (auto e : graph->incidence(n)) {
+      adjNodes[adj++] = graph->nodePos(graph->opposite(e, n));
+    }
+
+    for (auto e : sg->incidence(n)) {
+      if (sg->source(e) == n) {
+        outNodes[out++] = graph->nodePos(sg->target(e));
+      }
+    }
+
+    if (isSink[i]) {
+      adjNodes[adj] = sink;
+      outNodes[out] = sink;
+    }
+  });
+
+  std::copy(sinkNodes.begin(), sinkNodes.end(), adjNodes.begin() + adjStart[sink]);
+  adjNodes.back() = outNodes.back() = sink;
+
+  uint maxDepth = grid.size() + 1;
+  vector<vector<uint>> layers(maxDepth);
+
+  for (uint i = 0; i < grid.size(); ++i) {
+    for (auto n : grid[i]) {
+      layers[i].push_back(graph->nodePos(n));
     }
-  }
-  grid.push_back(vector<node>(1, tmp));
-  {
-    MutableContainer<bool> visited;
-    visited.setAll(false);
-    node root = sg->getSource();
-    initCross(sg, root, visited, 1);
   }
 
-  uint maxDepth = grid.size();
+  layers.back().push_back(sink);
 
-  for (uint i = 0; i < maxDepth; ++i) {
-    vector<node> &igrid = grid[i];
-    stable_sort(igrid.begin(), igrid.end(), lessNode);
+  // Set initial position using a DFS
+  {
+    vector<bool> visited(nbNodes + 1, false);
+    // the visited nodes and the index of their next out neighbor
+    vector<pair<uint, uint>> stack;
+    uint root = graph->nodePos(sg->getSource());
+    visited[root] = true;
+    positions[root] = 1;
+    stack.emplace_back(root, outStart[root]);
+
+    while (!stack.empty()) {
+      auto &[n, next] = stack.back();
+
+      if (next == outStart[n + 1]) {
+        stack.pop_back();
+        continue;
+      }
 
-    for (uint j = 0; j < igrid.size(); ++j) {
-      embedding->setNodeValue(igrid[j], j);
+      uint child = outNodes[next++];
+
+      if (!visited[child]) {
+        visited[child] = true;
+        positions[child] = positions[n] + 1;
+        stack.emplace_back(child, outStart[child]);
+      }
     }
   }
 
+  // the layers are disjoint so they are sorted concurrently
+  auto sortLayers = [&]() {
+    TLP_PARALLEL_MAP_INDICES(maxDepth, [&](uint i) {
+      vector<uint> &layer = layers[i];
+      stable_sort(layer.begin(), layer.end(),
+                  [&](uint n1, uint n2) { return positions[n1] < positions[n2]; });
+
+      for (uint j = 0; j < layer.size(); ++j) {
+        positions[layer[j]] = j;
+      }
+    });
+  };
+
+  // the nodes of a proper dag layer are not adjacent to each other,
+  // so the barycenters of a layer are computed concurrently
+  auto barycenters = [&](uint i) {
+    const vector<uint> &layer = layers[i];
+
+    TLP_PARALLEL_MAP_INDICES(layer.size(), [&](uint j) {
+      uint n = layer[j];
+      double sum = positions[n];
+
+      for (uint k = adjStart[n]; k < adjStart[n + 1]; ++k) {
+        sum += positions[adjNodes[k]];
+      }
+
+      positions[n] = sum / (adjStart[n + 1] - adjStart[n] + 1);
+    });
+  };
+
+  sortLayers();
+
   // Iterations of the sweeping
   for (uint a = 0; a < NB_UPDOWN_SWEEP; ++a) {
     // Up sweeping
     for (int i = maxDepth - 1; i >= 0; --i) {
-      twoLayerCrossReduction(graph, i);
+      barycenters(i);
     }
 
     // Down sweeping
     for (uint i = 0; i < maxDepth; ++i) {
-      twoLayerCrossReduction(graph, i);
+      barycenters(i);
     }
   }
 
-  for (uint i = 0; i < maxDepth; ++i) {
+  sortLayers();
+
+  for (uint i = 0; i < grid.size(); ++i) {
     vector<node> &igrid = grid[i];
-    stable_sort(igrid.begin(), igrid.end(), lessNode);
 
     for (uint j = 0; j < igrid.size(); ++j) {
-      embedding->setNodeValue(igrid[j], j);
+      igrid[j] = nodes[layers[i][j]];
     }
   }
 
-  sg->delNode(tmp, true);
+  for (uint i = 0; i < nbNodes; ++i) {
+    (*embedding)[nodes[i]] = positions[i];
+  }
 }
 //================================================================================
 void HierarchicalGraph::DagLevelSpanningTree(tlp::Graph *sg, tlp::DoubleProperty *embedding) {
@@ -325,7 +403,6 @@ bool HierarchicalGraph::run() {
     edgeLength = new IntegerProperty(mySGraph);
     tlp::makeProperDag(mySGraph, properAddedNodes, replacedEdges, edgeLength);
     // we compute metric for cross reduction
-    lessNode.metric = embedding.get();
     buildGrid(mySGraph);
     crossReduction(mySGraph);
     for (auto n : graph->nodes()) {
@@ -19,14 +19,6 @@
 
 #include <talipot/PluginHeaders.h>
 
-class LessThanNode2 {
-public:
-  tlp::DoubleProperty *metric;
-  bool operator()(tlp::node n1, tlp::node n2) const {
-    return ((*metric)[n1] < (*metric)[n2]);
-  }
-};
-
 /**
  * \file
  * \brief An implementation of hierarchical graph drawing algorithm
@@ -57,7 +49,6 @@ private:
   void DagLevelSpanningTree(tlp::Graph *sg, tlp::DoubleProperty *embedding);
   std::vector<std::vector<tlp::node>> grid;
   std::unique_ptr<tlp::DoubleProperty> embedding;
-  void twoLayerCrossReduction(tlp::Graph *sg, uint freeLayer);
   void crossReduction(tlp::Graph *sg);
   void computeEdgeBends(const tlp::Graph *mySGraph, tlp::LayoutProperty &tmpLayout,
                         const flat_hash_map<tlp::edge, tlp::edge> &replacedEdges,
@@ -66,9 +57,7 @@ private:
                         std::vector<tlp::SelfLoops> &listSelfLoops);
   void buildGrid(tlp::Graph *);
   uint degree(tlp::Graph *sg, tlp::node n, bool sense);
-  void initCross(tlp::Graph *sg, tlp::node n, tlp::MutableContainer<bool> &visited, int id);
 
-  LessThanNode2 lessNode;
   std::string orientation;
   float spacing;
   float nodeSpacing;
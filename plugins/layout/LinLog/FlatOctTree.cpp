@@ -0,0 +1,313 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/ParallelTools.h>
+
+#include "FlatOctTree.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+
+using namespace std;
+using namespace tlp;
+
+// minimum number of elements handled by a thread when building the tree
+static const uint MIN_ELEMENTS_PER_THREAD = 4096;
+
+void FlatOctTree::build(const vector<Coord> &positions, const vector<double> &weights, uint dim) {
+  _dim = dim;
+  _positions = &positions;
+  _weights = &weights;
+  _cells.clear();
+
+  sortElements(positions, weights);
+
+  uint nbElements = _sortedElements.size();
+
+  if (nbElements == 0) {
+    return;
+  }
+
+  Cell root;
+  root.width = _rootWidth;
+  root.first = 0;
+  root.last = nbElements;
+  root.nbChildren = 0;
+  _cells.push_back(root);
+
+  // the top of the tree is split sequentially until the ranges of elements
+  // are small enough to give some work to each thread
+  uint grain = max(MIN_ELEMENTS_PER_THREAD, nbElements / (8 * uint(TLP_NB_THREADS)));
+  vector<Subtree> subtrees;
+  buildTop(0, 0, nbElements, 0, grain, subtrees);
+  uint nbTopCells = _cells.size();
+
+  vector<vector<Cell>> subtreesCells(subtrees.size());
+
+  TLP_PARALLEL_MAP_INDICES(subtrees.size(), [&](uint i) {
+    const Subtree &subtree = subtrees[i];
+    vector<Cell> &cells = subtreesCells[i];
+    cells.push_back(_cells[subtree.cell]);
+    buildSubtree(cells, 0, subtree.first, subtree.last, subtree.depth);
+  });
+
+  // the root of a subtree replaces its top cell, the other cells are appended
+  vector<uint> offsets(subtrees.size());
+  uint nbCells = nbTopCells;
+
+  for (uint i = 0; i < subtrees.size(); ++i) {
+    offsets[i] = nbCells;
+    nbCells += subtreesCells[i].size() - 1;
+  }
+
+  _cells.resize(nbCells);
+
+  TLP_PARALLEL_MAP_INDICES(subtrees.size(), [&](uint i) {
+    const vector<Cell> &cells = subtreesCells[i];
+    uint offset = offsets[i];
+
+    for (uint j = 0; j < cells.size(); ++j) {
+      Cell &cell = _cells[j == 0 ? subtrees[i].cell : offset + j - 1];
+      cell = cells[j];
+
+      if (cell.nbChildren) {
+        cell.firstChild += offset - 1;
+      }
+    }
+  });
+
+  // children are always stored after their parent
+  for (uint i = nbTopCells; i-- > 0;) {
+    if (_cells[i].nbChildren) {
+      aggregateChildren(_cells, i);
+    }
+  }
+}
+
+void FlatOctTree::sortElements(const vector<Coord> &positions, const vector<double> &weights) {
+  _sortedElements.clear();
+  _ranks.assign(positions.size(), UINT_MAX);
+
+  for (uint i = 0; i < positions.size(); ++i) {
+    if (weights[i] != 0.0) {
+      _sortedElements.push_back(i);
+    }
+  }
+
+  uint nbElements = _sortedElements.size();
+  uint nbChunks =
+      std::max(1u, std::min(uint(TLP_NB_THREADS), nbElements / MIN_ELEMENTS_PER_THREAD));
+  uint chunkSize = (nbElements + nbChunks - 1) / nbChunks;
+
+  // compute minima and maxima of positions in each dimension
+  vector<Coord> chunksMin(nbChunks, Coord(FLT_MAX, FLT_MAX, FLT_MAX));
+  vector<Coord> chunksMax(nbChunks, Coord(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    for (uint i = c * chunkSize; i < std::min(nbElements, (c + 1) * chunkSize); ++i) {
+      const Coord &position = positions[_sortedElements[i]];
+
+      for (uint d = 0; d < 3; ++d) {
+        chunksMin[c][d] = std::min(position[d], chunksMin[c][d]);
+        chunksMax[c][d] = std::max(position[d], chunksMax[c][d]);
+      }
+    }
+  });
+
+  _minPos = Coord(0, 0, 0);
+  _maxPos = Coord(0, 0, 0);
+
+  if (nbElements) {
+    _minPos = chunksMin[0];
+    _maxPos = chunksMax[0];
+
+    for (uint c = 1; c < nbChunks; ++c) {
+      for (uint d = 0; d < 3; ++d) {
+        _minPos[d] = std::min(_minPos[d], chunksMin[c][d]);
+        _maxPos[d] = std::max(_maxPos[d], chunksMax[c][d]);
+      }
+    }
+  }
+
+  // provide additional space for moving nodes
+  _rootWidth = 0;
+
+  for (uint d = 0; d < 3; ++d) {
+    float posDiff = _maxPos[d] - _minPos[d];
+    _maxPos[d] += posDiff / 2;
+    _minPos[d] -= posDiff / 2;
+    _rootWidth = std::max(_rootWidth, double(_maxPos[d] - _minPos[d]));
+  }
+
+  // interleave the bits of the quantized coordinates
+  const uint64_t maxCoord = (uint64_t(1) << MAX_DEPTH) - 1;
+  double scale[3];
+
+  for (uint d = 0; d < 3; ++d) {
+    double width = _maxPos[d] - _minPos[d];
+    scale[d] = width > 0 ? (maxCoord + 1) / width : 0;
+  }
+
+  vector<pair<uint64_t, uint>> codes(nbElements);
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    for (uint i = c * chunkSize; i < std::min(nbElements, (c + 1) * chunkSize); ++i) {
+      uint element = _sortedElements[i];
+      const Coord &position = positions[element];
+      uint64_t quantized[3];
+
+      for (uint d = 0; d < _dim; ++d) {
+        quantized[d] = std::min(maxCoord, uint64_t((position[d] - _minPos[d]) * scale[d]));
+      }
+
+      uint64_t code = 0;
+
+      for (uint level = MAX_DEPTH; level-- > 0;) {
+        for (uint d = 0; d < _dim; ++d) {
+          code = (code << 1) | ((quantized[d] >> level) & 1);
+        }
+      }
+
+      codes[i] = {code, element};
+    }
+  });
+
+  // sort the chunks in parallel then merge them pairwise
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    sort(codes.begin() + std::min(nbElements, c * chunkSize),
+         codes.begin() + std::min(nbElements, (c + 1) * chunkSize));
+  });
+
+  for (uint width = chunkSize; width < nbElements; width *= 2) {
+    uint nbMerges = (nbElements + 2 * width - 1) / (2 * width);
+    TLP_PARALLEL_MAP_INDICES(nbMerges, [&](uint m) {
+      uint first = m * 2 * width;
+      uint middle = std::min(nbElements, first + width);
+      uint last = std::min(nbElements, first + 2 * width);
+      inplace_merge(codes.begin() + first, codes.begin() + middle, codes.begin() + last);
+    });
+  }
+
+  _codes.resize(nbElements);
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    for (uint i = c * chunkSize; i < std::min(nbElements, (c + 1) * chunkSize); ++i) {
+      _codes[i] = codes[i].first;
+      _sortedElements[i] = codes[i].second;
+      _ranks[codes[i].second] = i;
+    }
+  });
+}
+
+void FlatOctTree::buildTop(uint cell, uint first, uint last, uint depth, uint grain,
+                           vector<Subtree> &subtrees) {
+  if (last - first <= grain || depth == MAX_DEPTH || _codes[first] == _codes[last - 1]) {
+    subtrees.push_back({cell, first, last, depth});
+    return;
+  }
+
+  splitCell(_cells, cell, first, last, depth);
+
+  for (uint i = 0; i < _cells[cell].nbChildren; ++i) {
+    uint child = _cells[cell].firstChild + i;
+    buildTop(child, _cells[child].first, _cells[child].last, depth + 1, grain, subtrees);
+  }
+}
+
+void FlatOctTree::buildSubtree(vector<Cell> &cells, uint cell, uint first, uint last,
+                               uint depth) const {
+  if (last - first == 1 || depth == MAX_DEPTH || _codes[first] == _codes[last - 1]) {
+    initLeaf(cells[cell], first, last);
+    return;
+  }
+
+  splitCell(cells, cell, first, last, depth);
+
+  for (uint i = 0; i < cells[cell].nbChildren; ++i) {
+    uint child = cells[cell].firstChild + i;
+    buildSubtree(cells, child, cells[child].first, cells[child].last, depth + 1);
+  }
+
+  aggregateChildren(cells, cell);
+}
+
+void FlatOctTree::splitCell(vector<Cell> &cells, uint cell, uint first, uint last,
+                            uint depth) const {
+  uint shift = (MAX_DEPTH - 1 - depth) * _dim;
+  uint64_t mask = (uint64_t(1) << _dim) - 1;
+  double childWidth = cells[cell].width / 2;
+  uint firstChild = cells.size();
+  uint nbChildren = 0;
+
+  // the elements are sorted, so the elements of a child are contiguous
+  while (first < last) {
+    uint64_t digit = (_codes[first] >> shift) & mask;
+    auto sameChild = [&](uint64_t code) { return ((code >> shift) & mask) == digit; };
+    uint childLast =
+        partition_point(_codes.begin() + first, _codes.begin() + last, sameChild) - _codes.begin();
+    Cell child;
+    child.width = childWidth;
+    child.first = first;
+    child.last = childLast;
+    child.nbChildren = 0;
+    cells.push_back(child);
+    ++nbChildren;
+    first = childLast;
+  }
+
+  cells[cell].firstChild = firstChild;
+  cells[cell].nbChildren = nbChildren;
+}
+
+void FlatOctTree::initLeaf(Cell &cell, uint first, uint last) const {
+  double position[3] = {0, 0, 0};
+  double weight = 0;
+
+  for (uint i = first; i < last; ++i) {
+    uint element = _sortedElements[i];
+    double eltWeight = (*_weights)[element];
+    weight += eltWeight;
+
+    for (uint d = 0; d < 3; ++d) {
+      position[d] += eltWeight * (*_positions)[element][d];
+    }
+  }
+
+  cell.weight = weight;
+  cell.nbChildren = 0;
+
+  for (uint d = 0; d < 3; ++d) {
+    cell.position[d] = position[d] / weight;
+  }
+}
+
+void FlatOctTree::aggregateChildren(vector<Cell> &cells, uint cell) const {
+  double position[3] = {0, 0, 0};
+  double weight = 0;
+
+  for (uint i = 0; i < cells[cell].nbChildren; ++i) {
+    const Cell &child = cells[cells[cell].firstChild + i];
+    weight += child.weight;
+
+    for (uint d = 0; d < 3; ++d) {
+      position[d] += child.weight * child.position[d];
+    }
+  }
+
+  cells[cell].weight = weight;
+
+  for (uint d = 0; d < 3; ++d) {
+    cells[cell].position[d] = position[d] / weight;
+  }
+}
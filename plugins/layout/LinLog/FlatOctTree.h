@@ -0,0 +1,114 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef FLAT_OCT_TREE_H
+#define FLAT_OCT_TREE_H
+
+#include <talipot/Coord.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Octtree (or quadtree in 2D) stored in flat arrays, for elements with
+ * positions and weights given as vectors indexed by the element number.
+ *
+ * The tree is rebuilt from scratch in parallel: the elements are sorted
+ * according to the Morton code of their position, so the elements of a cell
+ * form a contiguous range of the sorted elements, then the top of the tree
+ * is split into subtrees built by different threads.
+ * Once built, the tree is read-only and can be traversed concurrently.
+ */
+class FlatOctTree {
+public:
+  struct Cell {
+    // barycenter of the contained elements
+    tlp::Coord position;
+    // total weight of the contained elements
+    double weight;
+    // maximum extension of the cell
+    double width;
+    // the children of a cell are stored contiguously
+    uint firstChild;
+    uint nbChildren;
+    // range of the contained elements in the sorted elements
+    uint first;
+    uint last;
+  };
+
+  /**
+   * Builds the tree for the elements with a non-zero weight.
+   *
+   * @param positions the positions of the elements
+   * @param weights   the weights of the elements
+   * @param dim       2 or 3, the number of dimensions used to split the cells
+   */
+  void build(const std::vector<tlp::Coord> &positions, const std::vector<double> &weights,
+             uint dim);
+
+  // Returns the cells, the root being the first one if the tree is not empty
+  const std::vector<Cell> &cells() const {
+    return _cells;
+  }
+
+  // Returns the elements sorted according to their Morton code
+  const std::vector<uint> &sortedElements() const {
+    return _sortedElements;
+  }
+
+  // Returns the rank of an element in the sorted elements, UINT_MAX for an element
+  // with a zero weight
+  uint rank(uint element) const {
+    return _ranks[element];
+  }
+
+  // Minimum and maximum coordinates of the cuboid containing the elements
+  const tlp::Coord &minPos() const {
+    return _minPos;
+  }
+
+  const tlp::Coord &maxPos() const {
+    return _maxPos;
+  }
+
+  static constexpr uint MAX_DEPTH = 20;
+
+private:
+  struct Subtree {
+    uint cell;
+    uint first;
+    uint last;
+    uint depth;
+  };
+
+  void sortElements(const std::vector<tlp::Coord> &positions, const std::vector<double> &weights);
+  void buildTop(uint cell, uint first, uint last, uint depth, uint grain,
+                std::vector<Subtree> &subtrees);
+  void buildSubtree(std::vector<Cell> &cells, uint cell, uint first, uint last, uint depth) const;
+  void splitCell(std::vector<Cell> &cells, uint cell, uint first, uint last, uint depth) const;
+  void initLeaf(Cell &cell, uint first, uint last) const;
+  void aggregateChildren(std::vector<Cell> &cells, uint cell) const;
+
+  uint _dim = 2;
+  tlp::Coord _minPos;
+  tlp::Coord _maxPos;
+  double _rootWidth = 0;
+  std::vector<Cell> _cells;
+  std::vector<uint> _sortedElements;
+  std::vector<uint64_t> _codes;
+  std::vector<uint> _ranks;
+  const std::vector<tlp::Coord> *_positions = nullptr;
+  const std::vector<double> *_weights = nullptr;
+};
+
+#endif // FLAT_OCT_TREE_H
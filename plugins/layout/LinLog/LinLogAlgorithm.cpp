@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -45,7 +45,18 @@ static constexpr std::string_view paramHelp[] = {
 
     // initial layout
     "The layout property used to compute the initial position of the graph elements. If none is "
-    "given the initial position will be computed by the algorithm."};
+    "given the initial position will be computed by the algorithm.",
+
+    // parallel
+    "If true, the displacements of all the nodes are computed in parallel at each iteration "
+    "against the positions of the previous one (Jacobi update), using an array-backed OctTree. "
+    "Else the nodes are moved one after the other (Gauss-Seidel update), which gives "
+    "reproducible results.",
+
+    // multilevel
+    "If true, the graph is first coarsened by successive matchings of its nodes, then the layout "
+    "of the coarsest graph is computed and refined on each finer graph. The parallel update "
+    "is used in this mode."};
 
 LinLogAlgorithm::LinLogAlgorithm(const tlp::PluginContext *context) : LayoutAlgorithm(context) {
   addInParameter<bool>("3D layout", paramHelp[0].data(), "false");
@@ -57,6 +68,8 @@ LinLogAlgorithm::LinLogAlgorithm(const tlp::PluginContext *context) : LayoutAlgo
   addInParameter<float>("gravitation factor", paramHelp[6].data(), "0.05");
   addInParameter<BooleanProperty>("skip nodes", paramHelp[7].data(), "", false);
   addInParameter<LayoutProperty>("initial layout", paramHelp[8].data(), "", false);
+  addInParameter<bool>("parallel", paramHelp[9].data(), "false");
+  addInParameter<bool>("multilevel", paramHelp[10].data(), "false");
 }
 
 LinLogAlgorithm::~LinLogAlgorithm() = default;
@@ -64,6 +77,8 @@ LinLogAlgorithm::~LinLogAlgorithm() = default;
 bool LinLogAlgorithm::run() {
   bool is3D = false;
   bool useOctTree = false;
+  bool parallel = false;
+  bool multilevel = false;
 
   uint max_iter = 100;
   tlp::NumericProperty *edgeWeight = nullptr;
@@ -83,6 +98,8 @@ bool LinLogAlgorithm::run() {
     dataSet->get("gravitation factor", gFac);
     dataSet->get("skip nodes", skipNodes);
     dataSet->get("initial layout", layout);
+    dataSet->get("parallel", parallel);
+    dataSet->get("multilevel", multilevel);
   }
 
   LinLogLayout linlog(graph, pluginProgress);
@@ -99,7 +116,8 @@ bool LinLogAlgorithm::run() {
   }
 
   // launches the lin log algorithm
-  linlog.initAlgo(result, edgeWeight, aExp, rExp, gFac, max_iter, is3D, useOctTree, skipNodes);
+  linlog.initAlgo(result, edgeWeight, aExp, rExp, gFac, max_iter, is3D, useOctTree, skipNodes,
+                  parallel, multilevel);
 
   return linlog.startAlgo();
 }
@@ -11,6 +11,8 @@
  *
  */
 
+#include <talipot/ParallelTools.h>
+
 #include "LinLogLayout.h"
 
 LinLogLayout::LinLogLayout(tlp::Graph *_graph, tlp::PluginProgress *_pluginProgress)
@@ -22,6 +24,8 @@ LinLogLayout::LinLogLayout(tlp::Graph *_graph, tlp::PluginProgress *_pluginProgr
   }
 
   useOctTree = true;
+  parallel = false;
+  multilevel = false;
 
   /** Exponent of the Euclidean distance in the repulsion energy. */
   repuExponent = 0.0;
@@ -38,7 +42,8 @@ LinLogLayout::LinLogLayout(tlp::Graph *_graph, tlp::PluginProgress *_pluginProgr
 bool LinLogLayout::initAlgo(tlp::LayoutProperty *_layout, tlp::NumericProperty *_weight,
                             double _attrExponent, double _repuExponent, double _gravFactor,
                             uint _max_iter, bool _is3D, bool _useOctTree,
-                            tlp::BooleanProperty *_skipNodes) {
+                            tlp::BooleanProperty *_skipNodes, bool _parallel,
+                            bool _multilevel) {
   // initializes with the current layout,
   // we might want to initialize it with a random layout too, not in this class
   layoutResult = _layout;
@@ -53,6 +58,8 @@ bool LinLogLayout::initAlgo(tlp::LayoutProperty *_layout, tlp::NumericProperty *
   repuExponent = _repuExponent;
   gravFactor = _gravFactor;
   useOctTree = _useOctTree;
+  parallel = _parallel;
+  multilevel = _multilevel;
 
   /* Handle parameters */
   _dim = (_is3D) ? 3 : 2;
@@ -74,6 +81,10 @@ bool LinLogLayout::initAlgo(tlp::LayoutProperty *_layout, tlp::NumericProperty *
 }
 
 bool LinLogLayout::startAlgo() {
+  if (parallel || multilevel) {
+    return minimizeEnergyParallel(max_iter);
+  }
+
   return useOctTree ? minimizeEnergy(max_iter) : minimizeEnergyNoTree(max_iter);
 }
 
@@ -489,6 +500,31 @@ void LinLogLayout::getDirection(node u, double *dir, OctTree *tree) {
   }
 }
 
+/**
+ * Updates the exponents of the energy model for an iteration:
+ * uses an energy model with few local minima during the first iterations,
+ * then gradually moves to the final energy model.
+ */
+void LinLogLayout::updateExponents(int step, int nrIterations, double finalAttrExponent,
+                                   double finalRepuExponent) {
+  if (nrIterations >= 50 && finalRepuExponent < 1.0) {
+    attrExponent = finalAttrExponent;
+    repuExponent = finalRepuExponent;
+
+    if (step <= 0.6 * nrIterations) {
+      // use energy model with few local minima
+      attrExponent += 1.1 * (1.0 - finalRepuExponent);
+      repuExponent += 0.9 * (1.0 - finalRepuExponent);
+    } else if (step <= 0.9 * nrIterations) {
+      // gradually move to final energy model
+      attrExponent +=
+          1.1 * (1.0 - finalRepuExponent) * (0.9 - (step / double(nrIterations))) / 0.3;
+      repuExponent +=
+          0.9 * (1.0 - finalRepuExponent) * (0.9 - (step / double(nrIterations))) / 0.3;
+    }
+  }
+}
+
 /**
  * Iteratively minimizes energy using the Barnes-Hut algorithm.
  * Starts from the positions in the parameter <code>positions</code>,
@@ -523,22 +559,7 @@ bool LinLogLayout::minimizeEnergyNoTree(int nrIterations) {
   for (int step = 1; step <= nrIterations; ++step) {
     computeBaryCenter();
 
-    if (nrIterations >= 50 && finalRepuExponent < 1.0) {
-      attrExponent = finalAttrExponent;
-      repuExponent = finalRepuExponent;
-
-      if (step <= 0.6 * nrIterations) {
-        // use energy model with few local minima
-        attrExponent += 1.1 * (1.0 - finalRepuExponent);
-        repuExponent += 0.9 * (1.0 - finalRepuExponent);
-      } else if (step <= 0.9 * nrIterations) {
-        // gradually move to final energy model
-        attrExponent +=
-            1.1 * (1.0 - finalRepuExponent) * (0.9 - (step / double(nrIterations))) / 0.3;
-        repuExponent +=
-            0.9 * (1.0 - finalRepuExponent) * (0.9 - (step / double(nrIterations))) / 0.3;
-      }
-    }
+    updateExponents(step, nrIterations, finalAttrExponent, finalRepuExponent);
 
     // move each node
     for (auto u : graph->nodes()) {
@@ -627,9 +648,7 @@ bool LinLogLayout::minimizeEnergy(int nrIterations) {
   double finalAttrExponent = attrExponent;
   double finalRepuExponent = repuExponent;
 
-  // compute initial energy
-  computeBaryCenter();
-  OctTree *octTree = buildOctTree();
+  OctTree *octTree = nullptr;
 
   // minimize energy
   double oldPos[3] = {0, 0, 0};
@@ -637,24 +656,10 @@ bool LinLogLayout::minimizeEnergy(int nrIterations) {
 
   for (int step = 1; step <= nrIterations; ++step) {
     computeBaryCenter();
+    delete octTree;
     octTree = buildOctTree();
 
-    if (nrIterations >= 50 && finalRepuExponent < 1.0) {
-      attrExponent = finalAttrExponent;
-      repuExponent = finalRepuExponent;
-
-      if (step <= 0.6 * nrIterations) {
-        // use energy model with few local minima
-        attrExponent += 1.1 * (1.0 - finalRepuExponent);
-        repuExponent += 0.9 * (1.0 - finalRepuExponent);
-      } else if (step <= 0.9 * nrIterations) {
-        // gradually move to final energy model
-        attrExponent +=
-            1.1 * (1.0 - finalRepuExponent) * (0.9 - (step / double(nrIterations))) / 0.3;
-        repuExponent +=
-            0.9 * (1.0 - finalRepuExponent) * (0.9 - (step / double(nrIterations))) / 0.3;
-      }
-    }
+    updateExponents(step, nrIterations, finalAttrExponent, finalRepuExponent);
 
     // move each node
     for (auto u : graph->nodes()) {
@@ -731,10 +736,12 @@ bool LinLogLayout::minimizeEnergy(int nrIterations) {
 
     if ((step * 100 / nrIterations) % 10 == 0 &&
         pluginProgress->progress(step, nrIterations) != ProgressState::TLP_CONTINUE) {
+      delete octTree;
       return pluginProgress->state() != ProgressState::TLP_CANCEL;
     }
   }
 
+  delete octTree;
   return true;
 }
 
@@ -828,3 +835,395 @@ OctTree *LinLogLayout::buildOctTree() {
   }
   return result;
 }
+
+void LinLogLayout::computeBaryCenter(const Level &level) {
+  double position[3] = {0.0, 0.0, 0.0};
+  double weightSum = 0.0;
+
+  for (uint u = 0; u < level.numberOfNodes(); ++u) {
+    weightSum += level.weights[u];
+
+    for (uint d = 0; d < _dim; ++d) {
+      position[d] += level.weights[u] * level.positions[u][d];
+    }
+  }
+
+  for (uint d = 0; d < _dim; ++d) {
+    baryCenter[d] = weightSum > 0.0 ? position[d] / weightSum : 0.0;
+  }
+}
+
+/**
+ * Minimizes energy by moving all the nodes at once at each iteration:
+ * the displacements of the nodes are computed in parallel against
+ * the positions of the previous iteration (Jacobi update), using
+ * an array-backed octtree rebuilt in parallel at each iteration.
+ * In multilevel mode, the graph is first coarsened by successive matchings
+ * of its nodes, the layout of the coarsest graph being then refined
+ * on each finer level with fewer iterations.
+ */
+bool LinLogLayout::minimizeEnergyParallel(int nrIterations) {
+  if (graph->numberOfNodes() <= 1) {
+    return true;
+  }
+
+  initEnergyFactors();
+
+  MultilevelCoarsening coarsening(graph, layoutResult, &linLogWeight, skipNodes);
+
+  if (multilevel) {
+    coarsening.coarsen();
+  }
+
+  int nbRefinements = std::max(10, nrIterations / 4);
+  uint nbLevels = coarsening.numberOfLevels();
+  int nrSteps = nrIterations + (nbLevels - 1) * nbRefinements;
+  int firstStep = 0;
+  bool result = true;
+
+  for (uint l = nbLevels; l-- > 0;) {
+    if (l < nbLevels - 1) {
+      coarsening.prolong(l, _dim);
+    }
+
+    int levelIterations = (l == nbLevels - 1) ? nrIterations : nbRefinements;
+    result = minimizeEnergy(coarsening.level(l), levelIterations, l == nbLevels - 1, firstStep,
+                            nrSteps);
+    firstStep += levelIterations;
+
+    if (pluginProgress->state() != ProgressState::TLP_CONTINUE) {
+      break;
+    }
+  }
+
+  if (pluginProgress->state() != ProgressState::TLP_CANCEL) {
+    const std::vector<node> &nodes = graph->nodes();
+    const Level &level = coarsening.level(0);
+
+    for (uint i = 0; i < nodes.size(); ++i) {
+      if (!level.fixed[i]) {
+        layoutResult->setNodeValue(nodes[i], level.positions[i]);
+      }
+    }
+  }
+
+  return result;
+}
+
+bool LinLogLayout::minimizeEnergy(Level &level, int nrIterations, bool anneal, int firstStep,
+                                  int nrSteps) {
+  double finalAttrExponent = attrExponent;
+  double finalRepuExponent = repuExponent;
+  FlatOctTree octTree;
+  std::vector<Coord> newPositions(level.numberOfNodes());
+
+  for (int step = 1; step <= nrIterations; ++step) {
+    computeBaryCenter(level);
+    octTree.build(level.positions, level.weights, _dim);
+
+    if (anneal) {
+      updateExponents(step, nrIterations, finalAttrExponent, finalRepuExponent);
+    }
+
+    // the tree and the positions are not modified while moving the nodes
+    TLP_PARALLEL_MAP_INDICES(level.numberOfNodes(), [&](uint u) {
+      newPositions[u] = level.fixed[u] ? level.positions[u] : moveNode(level, u, octTree);
+    });
+
+    level.positions.swap(newPositions);
+
+    int curStep = firstStep + step;
+
+    if ((curStep * 100 / nrSteps) % 10 == 0 &&
+        pluginProgress->progress(curStep, nrSteps) != ProgressState::TLP_CONTINUE) {
+      return pluginProgress->state() != ProgressState::TLP_CANCEL;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Computes the new position of a node, using the same line search
+ * than the sequential minimization.
+ */
+Coord LinLogLayout::moveNode(const Level &level, uint u, const FlatOctTree &tree) const {
+  double bestDir[3] = {0, 0, 0};
+  getDirection(level, u, bestDir, tree);
+
+  const Coord &oldPos = level.positions[u];
+  Coord pos = oldPos;
+  double bestEnergy = getEnergy(level, u, oldPos, tree);
+  int bestMultiple = 0;
+
+  for (uint d = 0; d < _dim; ++d) {
+    bestDir[d] /= 32;
+  }
+
+  for (int multiple = 32; multiple >= 1 && (bestMultiple == 0 || bestMultiple / 2 == multiple);
+       multiple /= 2) {
+    for (uint d = 0; d < _dim; ++d) {
+      pos[d] = oldPos[d] + bestDir[d] * multiple;
+    }
+
+    double curEnergy = getEnergy(level, u, pos, tree);
+
+    if (curEnergy < bestEnergy) {
+      bestEnergy = curEnergy;
+      bestMultiple = multiple;
+    }
+  }
+
+  for (int multiple = 64; multiple <= 128 && bestMultiple == multiple / 2; multiple *= 2) {
+    for (uint d = 0; d < _dim; ++d) {
+      pos[d] = oldPos[d] + bestDir[d] * multiple;
+    }
+
+    double curEnergy = getEnergy(level, u, pos, tree);
+
+    if (curEnergy < bestEnergy) {
+      bestEnergy = curEnergy;
+      bestMultiple = multiple;
+    }
+  }
+
+  for (uint d = 0; d < _dim; ++d) {
+    pos[d] = oldPos[d] + bestDir[d] * bestMultiple;
+  }
+
+  return pos;
+}
+
+/**
+ * Calls interaction(position, weight) for each node or group of nodes
+ * repulsing the node u located at pos, using the Barnes-Hut approximation.
+ * The contribution of u at its position in the tree is removed from the
+ * approximated cells containing it.
+ */
+template <typename Interaction>
+void LinLogLayout::forEachRepulsion(const Level &level, uint u, const Coord &pos,
+                                    const FlatOctTree &tree,
+                                    const Interaction &interaction) const {
+  const std::vector<FlatOctTree::Cell> &cells = tree.cells();
+
+  if (cells.empty()) {
+    return;
+  }
+
+  const std::vector<uint> &elements = tree.sortedElements();
+  uint rank = tree.rank(u);
+  double u_weight = level.weights[u];
+  const Coord &treePos = level.positions[u];
+
+  uint stack[8 * FlatOctTree::MAX_DEPTH + 1];
+  uint stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    const FlatOctTree::Cell &cell = cells[stack[--stackSize]];
+    bool containsU = cell.first <= rank && rank < cell.last;
+
+    if (cell.nbChildren == 0) {
+      if (cell.last - cell.first == 1) {
+        if (!containsU) {
+          interaction(cell.position, cell.weight);
+        }
+      } else {
+        for (uint i = cell.first; i < cell.last; ++i) {
+          if (elements[i] != u) {
+            interaction(level.positions[elements[i]], level.weights[elements[i]]);
+          }
+        }
+      }
+
+      continue;
+    }
+
+    if (getDist(pos, cell.position) < 2.0 * cell.width) {
+      for (uint i = 0; i < cell.nbChildren; ++i) {
+        stack[stackSize++] = cell.firstChild + i;
+      }
+
+      continue;
+    }
+
+    if (containsU) {
+      double weight = cell.weight - u_weight;
+
+      if (weight > 0.0) {
+        Coord position;
+
+        for (uint d = 0; d < 3; ++d) {
+          position[d] = (cell.weight * cell.position[d] - u_weight * treePos[d]) / weight;
+        }
+
+        interaction(position, weight);
+      }
+    } else {
+      interaction(cell.position, cell.weight);
+    }
+  }
+}
+
+double LinLogLayout::getRepulsionEnergy(const Level &level, uint u, const Coord &pos,
+                                        const FlatOctTree &tree) const {
+  double u_weight = level.weights[u];
+
+  if (u_weight == 0.0) {
+    return 0.0;
+  }
+
+  double energy = 0.0;
+
+  forEachRepulsion(level, u, pos, tree, [&](const Coord &position, double weight) {
+    double dist = getDist(pos, position);
+
+    if (dist == 0.0) {
+      return;
+    }
+
+    if (repuExponent == 0.0) {
+      energy -= repuFactor * u_weight * weight * log(dist);
+    } else {
+      energy -= repuFactor * u_weight * weight * pow(dist, repuExponent) / repuExponent;
+    }
+  });
+
+  return energy;
+}
+
+double LinLogLayout::getAttractionEnergy(const Level &level, uint u, const Coord &pos) const {
+  double energy = 0.0;
+
+  for (uint i = level.adjStart[u]; i < level.adjStart[u + 1]; ++i) {
+    double dist = getDist(pos, level.positions[level.adjNodes[i]]);
+
+    if (attrExponent == 0.0) {
+      energy += level.adjWeights[i] * log(dist);
+    } else {
+      energy += level.adjWeights[i] * pow(dist, attrExponent) / attrExponent;
+    }
+  }
+
+  return energy;
+}
+
+double LinLogLayout::getGravitationEnergy(const Level &level, uint u, const Coord &pos) const {
+  double dist = getDist(pos, baryCenter);
+
+  if (attrExponent == 0.0) {
+    return gravFactor * level.weights[u] * log(dist);
+  } else {
+    return gravFactor * level.weights[u] * pow(dist, attrExponent) / attrExponent;
+  }
+}
+
+double LinLogLayout::getEnergy(const Level &level, uint u, const Coord &pos,
+                               const FlatOctTree &tree) const {
+  return getRepulsionEnergy(level, u, pos, tree) + getAttractionEnergy(level, u, pos) +
+         getGravitationEnergy(level, u, pos);
+}
+
+double LinLogLayout::addRepulsionDir(const Level &level, uint u, double *dir,
+                                     const FlatOctTree &tree) const {
+  double u_weight = level.weights[u];
+
+  if (u_weight == 0.0) {
+    return 0.0;
+  }
+
+  const Coord &pos = level.positions[u];
+  double dir2 = 0.0;
+
+  forEachRepulsion(level, u, pos, tree, [&](const Coord &position, double weight) {
+    double dist = getDist(pos, position);
+
+    if (dist == 0.0) {
+      return;
+    }
+
+    double tmp = repuFactor * u_weight * weight * pow(dist, repuExponent - 2);
+
+    dir2 += tmp * fabs(repuExponent - 1);
+
+    for (uint d = 0; d < _dim; ++d) {
+      dir[d] -= (position[d] - pos[d]) * tmp;
+    }
+  });
+
+  return dir2;
+}
+
+double LinLogLayout::addAttractionDir(const Level &level, uint u, double *dir) const {
+  double dir2 = 0.0;
+  const Coord &pos = level.positions[u];
+
+  for (uint i = level.adjStart[u]; i < level.adjStart[u + 1]; ++i) {
+    const Coord &position = level.positions[level.adjNodes[i]];
+    double dist = getDist(pos, position);
+
+    if (dist == 0.0) {
+      continue;
+    }
+
+    double tmp = level.adjWeights[i] * pow(dist, attrExponent - 2);
+
+    dir2 += tmp * fabs(attrExponent - 1);
+
+    for (uint d = 0; d < _dim; ++d) {
+      dir[d] += (position[d] - pos[d]) * tmp;
+    }
+  }
+
+  return dir2;
+}
+
+double LinLogLayout::addGravitationDir(const Level &level, uint u, double *dir) const {
+  const Coord &pos = level.positions[u];
+  double dist = getDist(pos, baryCenter);
+  double tmp = gravFactor * repuFactor * level.weights[u] * pow(dist, attrExponent - 2);
+
+  for (uint d = 0; d < _dim; ++d) {
+    dir[d] += (baryCenter[d] - pos[d]) * tmp;
+  }
+
+  return tmp * fabs(attrExponent - 1.0);
+}
+
+void LinLogLayout::getDirection(const Level &level, uint u, double *dir,
+                                const FlatOctTree &tree) const {
+  for (uint d = 0; d < _dim; ++d) {
+    dir[d] = 0.0;
+  }
+
+  double dir2 = addRepulsionDir(level, u, dir, tree);
+  dir2 += addAttractionDir(level, u, dir);
+  dir2 += addGravitationDir(level, u, dir);
+
+  if (dir2 != 0.0) {
+    // normalize force vector with second derivation of energy
+    for (uint d = 0; d < _dim; ++d) {
+      dir[d] /= dir2;
+    }
+
+    // ensure that the length of dir is not greater
+    // than 1/16 of the octtree width
+    double scale = 1.0;
+
+    for (uint d = 0; d < _dim; ++d) {
+      double width = tree.maxPos()[d] - tree.minPos()[d];
+
+      if (width > 0.0) {
+        scale = std::min(scale, fabs(width / 16 / dir[d]));
+      }
+    }
+
+    for (uint d = 0; d < _dim; ++d) {
+      dir[d] *= scale;
+    }
+  } else {
+    for (uint d = 0; d < _dim; ++d) {
+      dir[d] = 0.0;
+    }
+  }
+}
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -15,7 +15,11 @@
 #define LIN_LOG_LAYOUT_H
 
 #include <talipot/PluginHeaders.h>
+#include <talipot/MultilevelCoarsening.h>
 #include "OctTree.h"
+#include "FlatOctTree.h"
+
+#include <vector>
 
 class LinLogLayout {
 
@@ -23,7 +27,8 @@ public:
   LinLogLayout(tlp::Graph *_graph, tlp::PluginProgress *pluginProgress);
   bool initAlgo(tlp::LayoutProperty *_layoutResult, tlp::NumericProperty *_weight,
                 double _attrExponent, double _repuExponent, double _gravFactor, uint _max_iter,
-                bool _is3D, bool _useOctTree, tlp::BooleanProperty *_skipNodes);
+                bool _is3D, bool _useOctTree, tlp::BooleanProperty *_skipNodes,
+                bool _parallel, bool _multilevel);
 
   bool startAlgo();
 
@@ -40,6 +45,11 @@ private:
   uint _nbNodes; // number of nodes in the graph
   uint max_iter; // the max number of iterations
   bool useOctTree;
+  // compute the displacements of all the nodes in parallel (Jacobi update)
+  // instead of moving them one after the other (Gauss-Seidel update)
+  bool parallel;
+  // lay out successively coarsened versions of the graph
+  bool multilevel;
 
   /** Factor for repulsion energy. */
   double repuFactor;
@@ -81,5 +91,32 @@ private:
   double getRepulsionEnergy(node u, OctTree *tree);
   double getEnergy(node u, OctTree *tree);
   void getDirection(node u, double *dir, OctTree *tree);
+
+  void updateExponents(int step, int nrIterations, double finalAttrExponent,
+                       double finalRepuExponent);
+
+  // the graph stored in flat arrays indexed by the node positions,
+  // used by the parallel and multilevel minimizations
+  using Level = tlp::MultilevelCoarsening::Level;
+
+  void computeBaryCenter(const Level &level);
+
+  bool minimizeEnergyParallel(int nrIterations);
+  bool minimizeEnergy(Level &level, int nrIterations, bool anneal, int firstStep,
+                      int nrSteps);
+  Coord moveNode(const Level &level, uint u, const FlatOctTree &tree) const;
+
+  template <typename Interaction>
+  void forEachRepulsion(const Level &level, uint u, const Coord &pos, const FlatOctTree &tree,
+                        const Interaction &interaction) const;
+  double getRepulsionEnergy(const Level &level, uint u, const Coord &pos,
+                            const FlatOctTree &tree) const;
+  double getAttractionEnergy(const Level &level, uint u, const Coord &pos) const;
+  double getGravitationEnergy(const Level &level, uint u, const Coord &pos) const;
+  double getEnergy(const Level &level, uint u, const Coord &pos, const FlatOctTree &tree) const;
+  double addRepulsionDir(const Level &level, uint u, double *dir, const FlatOctTree &tree) const;
+  double addAttractionDir(const Level &level, uint u, double *dir) const;
+  double addGravitationDir(const Level &level, uint u, double *dir) const;
+  void getDirection(const Level &level, uint u, double *dir, const FlatOctTree &tree) const;
 };
 #endif // LIN_LOG_LAYOUT_H
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2025  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -11,7 +11,10 @@
  *
  */
 
+#include <numeric>
+
 #include <talipot/ViewSettings.h>
+#include <talipot/ParallelTools.h>
 
 #include "SquarifiedTreeMap.h"
 
@@ -25,6 +28,10 @@ const double SEPARATION_Z = 10;
 const double DEFAULT_RATIO = 1.4;
 const int DEFAULT_WIDTH = 1024;
 const int DEFAULT_HEIGHT = 1024;
+// under these numbers of nodes, the layout of a tree or the computation of the sizes
+// of the nodes of a level of a tree are not worth being parallelized
+const uint MIN_PARALLEL_NB_NODES = 10000;
+const uint MIN_PARALLEL_LEVEL_SIZE = 10000;
 
 static constexpr std::string_view paramHelp[] = {
     // metric
@@ -105,31 +112,54 @@ bool SquarifiedTreeMap::run() {
     glyphResult = graph->getLocalIntegerProperty("viewShape");
   }
 
-  {
-    // change the glyph of all internal nodes to be a window
-    for (auto n : graph->nodes()) {
-      if (graph->outdeg(n) != 0) {
-        (*glyphResult)[n] = NodeShape::Window;
-      }
+  node root = graph->getSource();
+  computeNodesSize(root);
+  uint nbNodes = treeNodes.size();
+
+  // change the glyph of all internal nodes to be a window
+  for (uint i = 0; i < nbNodes; ++i) {
+    if (childrenStart[i] != childrenStart[i + 1]) {
+      (*glyphResult)[treeNodes[i]] = NodeShape::Window;
     }
   }
 
   Rectd initialSpace(0, 0, DEFAULT_WIDTH * aspectRatio, DEFAULT_HEIGHT);
 
-  node root = graph->getSource();
-  computeNodesSize(root);
-
+  nodesCoords.resize(nbNodes);
+  nodesSizes.resize(nbNodes);
   Vec2d center = initialSpace.center();
-  (*result)[root] = Coord(float(center[0]), float(center[1]), 0);
-  Size initialSpaceSize = {float(initialSpace.width()), float(initialSpace.height())};
-  (*sizeResult)[root] = initialSpaceSize;
-  vector<node> toTreat(orderedChildren(root));
+  nodesCoords[0] = Coord(float(center[0]), float(center[1]), 0);
+  nodesSizes[0] = {float(initialSpace.width()), float(initialSpace.height())};
+  vector<uint> toTreat(orderedChildren(0));
 
   if (!toTreat.empty()) {
+    // the rectangles of sibling subtrees are fixed before the layout of these subtrees,
+    // so once the large subtrees are laid out, the small ones remaining can be laid out
+    // independently of each other
+    vector<PendingSubtree> pending;
+    uint nbThreads = TLP_NB_THREADS;
+    pendingSubtrees = (nbThreads > 1 && nbNodes >= MIN_PARALLEL_NB_NODES) ? &pending : nullptr;
+    maxPendingNbNodes = nbNodes / (16 * nbThreads);
     Rectd tmp = adjustRectangle(initialSpace);
     squarify(toTreat, tmp, 1);
+    pendingSubtrees = nullptr;
+
+    TLP_PARALLEL_MAP_INDICES(pending.size(), [&](uint i) {
+      const PendingSubtree &subtree = pending[i];
+      squarify(orderedChildren(subtree.root), subtree.rectArea, subtree.depth);
+    });
   }
 
+  vector<Coord> coords(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    node n = treeNodes[i];
+    coords[graph->nodePos(n)] = nodesCoords[i];
+    (*sizeResult)[n] = nodesSizes[i];
+  }
+
+  result->setValues(coords, {}, graph);
+
   return true;
 }
 //====================================================================
@@ -149,14 +179,14 @@ tlp::Rectd SquarifiedTreeMap::adjustRectangle(const tlp::Rectd &r) const {
   return result;
 }
 //====================================================================
-void SquarifiedTreeMap::layoutRow(const std::vector<tlp::node> &row, const int depth,
+void SquarifiedTreeMap::layoutRow(const std::vector<uint> &row, const int depth,
                                   const tlp::Rectd &rectArea) {
   assert(rectArea.isValid());
   assert(!row.empty());
   double rowArea = 0;
 
   for (auto n : row) {
-    rowArea += nodesSize.get(n.id);
+    rowArea += nodesSize[n];
   }
 
   double sum = 0;
@@ -167,46 +197,38 @@ void SquarifiedTreeMap::layoutRow(const std::vector<tlp::node> &row, const int d
 
     if (rectArea.width() > rectArea.height()) {
       layoutRec[0][0] = rectArea[0][0] + (sum / rowArea) * dist[0];
-      layoutRec[1][0] = layoutRec[0][0] + (nodesSize.get(n.id) / rowArea) * dist[0];
+      layoutRec[1][0] = layoutRec[0][0] + (nodesSize[n] / rowArea) * dist[0];
     } else {
       layoutRec[0][1] = rectArea[0][1] + (sum / rowArea) * dist[1];
-      layoutRec[1][1] = layoutRec[0][1] + (nodesSize.get(n.id) / rowArea) * dist[1];
+      layoutRec[1][1] = layoutRec[0][1] + (nodesSize[n] / rowArea) * dist[1];
     }
 
     assert(layoutRec.isValid());
-    sum += nodesSize.get(n.id);
+    sum += nodesSize[n];
     Vec2d center = layoutRec.center();
-    (*result)[n] = Coord(float(center[0]), float(center[1]), float(depth * SEPARATION_Z));
-    (*sizeResult)[n] = Size(float(layoutRec.width()), float(layoutRec.height()), 0);
+    nodesCoords[n] = Coord(float(center[0]), float(center[1]), float(depth * SEPARATION_Z));
+    nodesSizes[n] = Size(float(layoutRec.width()), float(layoutRec.height()), 0);
 
-    if (graph->outdeg(n) > 0) {
-      vector<node> toTreat(orderedChildren(n));
+    if (childrenStart[n] != childrenStart[n + 1]) {
       Rectd newRec(adjustRectangle(layoutRec));
-      squarify(toTreat, newRec, depth + 1);
+
+      if (pendingSubtrees && subtreesNbNodes[n] <= maxPendingNbNodes) {
+        pendingSubtrees->push_back({n, newRec, depth + 1});
+      } else {
+        vector<uint> toTreat(orderedChildren(n));
+        squarify(toTreat, newRec, depth + 1);
+      }
     }
   }
 }
-//==================================================================
-class IsGreater {
-public:
-  IsGreater(const tlp::MutableContainer<double> &measure) : measure(measure) {}
-  bool operator()(const node a, const node b) const {
-    return measure.get(a.id) > measure.get(b.id);
-  }
-  const tlp::MutableContainer<double> &measure;
-};
 //======================================
-vector<node> SquarifiedTreeMap::orderedChildren(const tlp::node n) const {
+vector<uint> SquarifiedTreeMap::orderedChildren(uint n) const {
   // sort children of n and store it in result
   //======================================
-  vector<node> result(graph->outdeg(n));
-  // build a list of pair <node, size>
-  size_t i = 0;
-  for (auto child : graph->getOutNodes(n)) {
-    result[i++] = child;
-  }
-  IsGreater sortFunctor(nodesSize);
-  sort(result.begin(), result.end(), sortFunctor);
+  vector<uint> result(childrenStart[n + 1] - childrenStart[n]);
+  iota(result.begin(), result.end(), childrenStart[n]);
+  sort(result.begin(), result.end(),
+       [this](uint a, uint b) { return nodesSize[a] > nodesSize[b]; });
   return result;
 }
 //==========================================================
@@ -217,17 +239,17 @@ class Row {
 
 };
 */
-double SquarifiedTreeMap::evaluateRow(const std::vector<tlp::node> &row, tlp::node n, double width,
-                                      double length, double surface) {
+double SquarifiedTreeMap::evaluateRow(const std::vector<uint> &row, uint n, double width,
+                                      double length, double surface) const {
 
-  double sumOfNodesSurface = nodesSize.get(n.id);
+  double sumOfNodesSurface = nodesSize[n];
 
   for (auto nr : row) {
-    sumOfNodesSurface += nodesSize.get(nr.id);
+    sumOfNodesSurface += nodesSize[nr];
   }
 
   //====================
-  double size = nodesSize.get(n.id);
+  double size = nodesSize[n];
   // ratio is the aspect ratio of rectangle of the considered elements
   double nodeRectangleWidth = length * sumOfNodesSurface / surface;
   double nodeRectangleHeight = width * size / sumOfNodesSurface;
@@ -238,7 +260,7 @@ double SquarifiedTreeMap::evaluateRow(const std::vector<tlp::node> &row, tlp::no
   double sumratio = ratio;
 
   for (auto nr : row) {
-    double size = nodesSize.get(nr.id);
+    double size = nodesSize[nr];
     double nodeRectangleWidth = length * sumOfNodesSurface / surface;
     double nodeRectangleHeight = width * size / sumOfNodesSurface;
     double ratio = std::min(nodeRectangleHeight, nodeRectangleWidth) /
@@ -255,19 +277,19 @@ double SquarifiedTreeMap::evaluateRow(const std::vector<tlp::node> &row, tlp::no
 }
 
 //====================================================================
-void SquarifiedTreeMap::squarify(const std::vector<tlp::node> &toTreat, const tlp::Rectd &rectArea,
+void SquarifiedTreeMap::squarify(const std::vector<uint> &toTreat, const tlp::Rectd &rectArea,
                                  const int depth) {
   assert(rectArea.isValid());
   assert(!toTreat.empty());
 
-  vector<node> rowNodes;
-  vector<node> unTreated;
+  vector<uint> rowNodes;
+  vector<uint> unTreated;
   double unTreatedSurface = 0;
 
   double surface = 0;
 
   for (auto n : toTreat) {
-    surface += nodesSize.get(n.id);
+    surface += nodesSize[n];
   }
 
   auto it = toTreat.begin();
@@ -287,7 +309,7 @@ void SquarifiedTreeMap::squarify(const std::vector<tlp::node> &toTreat, const tl
       if (newRatio < ratio) { // we finish to build that row
         break;
         /*unTreated.push_back(*it);
-        unTreatedSurface += nodesSize.get(it->id);*/
+        unTreatedSurface += nodesSize[*it];*/
       } else {
         ratio = newRatio;
         rowNodes.push_back(*it); // add the node to the current row
@@ -300,7 +322,7 @@ void SquarifiedTreeMap::squarify(const std::vector<tlp::node> &toTreat, const tl
   // Compute measure on unTreated nodes to do a recursive call
   while (it != toTreat.end()) {
     unTreated.push_back(*it);
-    unTreatedSurface += nodesSize.get(it->id);
+    unTreatedSurface += nodesSize[*it];
     ++it;
   }
 
@@ -335,21 +357,76 @@ void SquarifiedTreeMap::squarify(const std::vector<tlp::node> &toTreat, const tl
   }
 }
 //====================================================================
-void SquarifiedTreeMap::computeNodesSize(const tlp::node n) {
+void SquarifiedTreeMap::computeNodesSize(const tlp::node root) {
+  uint nbNodes = graph->numberOfNodes();
+  treeNodes.clear();
+  treeNodes.reserve(nbNodes);
+  childrenStart.clear();
+  childrenStart.reserve(nbNodes + 1);
+  nodesSize.assign(nbNodes, 0.);
+  subtreesNbNodes.assign(nbNodes, 1);
+  // the nodes of each depth are contiguous in breadth first order
+  vector<uint> levelsStart(1, 0);
+  uint levelEnd = 1;
+  treeNodes.push_back(root);
+
+  for (uint i = 0; i < treeNodes.size(); ++i) {
+    if (i == levelEnd) {
+      levelsStart.push_back(i);
+      levelEnd = treeNodes.size();
+    }
 
-  if (graph->outdeg(n) == 0) { // the node is a leaf of the tree
-    double leafValue = metric ? metric->getNodeDoubleValue(n) : 1.;
+    node n = treeNodes[i];
+    childrenStart.push_back(treeNodes.size());
 
-    nodesSize.set(n.id, (leafValue > 0) ? leafValue : 1.);
-    return;
-  }
+    for (auto e : graph->incidence(n)) {
+      const auto &[src, child] = graph->ends(e);
+
+      if (src == n) {
+        treeNodes.push_back(child);
+      }
+    }
 
-  double internalNodeValue = 0.;
-  for (auto child : graph->getOutNodes(n)) {
-    computeNodesSize(child);
-    internalNodeValue += nodesSize.get(child.id);
+    if (childrenStart[i] == treeNodes.size()) { // the node is a leaf of the tree
+      double leafValue = metric ? metric->getNodeDoubleValue(n) : 1.;
+      nodesSize[i] = (leafValue > 0) ? leafValue : 1.;
+    }
   }
 
-  nodesSize.set(n.id, internalNodeValue);
+  childrenStart.push_back(treeNodes.size());
+  levelsStart.push_back(treeNodes.size());
+
+  // the size of an internal node is the sum of the sizes of its children,
+  // so the levels are processed from the deepest one
+  for (uint l = levelsStart.size() - 1; l-- > 0;) {
+    uint levelStart = levelsStart[l];
+    auto sumChildrenSizes = [&](uint i) {
+      i += levelStart;
+
+      if (childrenStart[i] == childrenStart[i + 1]) {
+        return;
+      }
+
+      double internalNodeValue = 0.;
+      uint nbSubtreeNodes = 1;
+
+      for (uint child = childrenStart[i]; child < childrenStart[i + 1]; ++child) {
+        internalNodeValue += nodesSize[child];
+        nbSubtreeNodes += subtreesNbNodes[child];
+      }
+
+      nodesSize[i] = internalNodeValue;
+      subtreesNbNodes[i] = nbSubtreeNodes;
+    };
+    uint levelSize = levelsStart[l + 1] - levelStart;
+
+    if (levelSize >= MIN_PARALLEL_LEVEL_SIZE) {
+      TLP_PARALLEL_MAP_INDICES(levelSize, sumChildrenSizes);
+    } else {
+      for (uint i = 0; i < levelSize; ++i) {
+        sumChildrenSizes(i);
+      }
+    }
+  }
 }
 //====================================================================
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -71,33 +71,53 @@ public:
   bool run() override;
 
 private:
+  // a subtree whose layout is computed once all the large subtrees are laid out
+  struct PendingSubtree {
+    uint root;
+    tlp::Rectd rectArea;
+    int depth;
+  };
+
   tlp::SizeProperty *sizeResult;
   tlp::NumericProperty *metric;
   tlp::IntegerProperty *glyphResult;
-  tlp::MutableContainer<double> nodesSize;
   bool shneidermanTreeMap;
   double aspectRatio;
+  // the nodes of the tree in breadth first order, the children of the i-th node
+  // being the nodes between childrenStart[i] and childrenStart[i + 1]
+  std::vector<tlp::node> treeNodes;
+  std::vector<uint> childrenStart;
+  // the size of each node, and the number of nodes of the subtree rooted in it
+  std::vector<double> nodesSize;
+  std::vector<uint> subtreesNbNodes;
+  // the rectangles of the nodes
+  std::vector<tlp::Coord> nodesCoords;
+  std::vector<tlp::Size> nodesSizes;
+  // when not null, the subtrees with at most maxPendingNbNodes nodes are not laid out
+  // during the recursion but stored here, to be laid out in parallel afterwards
+  std::vector<PendingSubtree> *pendingSubtrees;
+  uint maxPendingNbNodes;
   /**
    * return a measure quality of row in which one wants to add n
    * width is the width of the rectangle in which we create the row
    * length is the height of the rectangle in which on creates the row
    * surface is sum of size of elements what belongs to the rectangle
    */
-  double evaluateRow(const std::vector<tlp::node> &row, tlp::node n, double width, double length,
-                     double surface);
-  void layoutRow(const std::vector<tlp::node> &row, const int depth, const tlp::Rectd &rectArea);
-  void squarify(const std::vector<tlp::node> &toTreat, const tlp::Rectd &rectArea, const int depth);
+  double evaluateRow(const std::vector<uint> &row, uint n, double width, double length,
+                     double surface) const;
+  void layoutRow(const std::vector<uint> &row, const int depth, const tlp::Rectd &rectArea);
+  void squarify(const std::vector<uint> &toTreat, const tlp::Rectd &rectArea, const int depth);
   // change the rectangle to take into account space reserved for the drawing of borders and headers
   // the function currently fix adjust the size for the 2D windwows glyph.
   tlp::Rectd adjustRectangle(const tlp::Rectd &r) const;
   // return a vector containing children of n ordered in decreasing order of their size.
-  std::vector<tlp::node> orderedChildren(const tlp::node n) const;
+  std::vector<uint> orderedChildren(uint n) const;
   /**
-   * compute the size of each node in the tree
+   * flatten the tree rooted in root and compute the size of each node in the tree
    * the size is the sum of all the size of all leaves descendant of a node
    * in the tree.
    */
-  void computeNodesSize(tlp::node n);
+  void computeNodesSize(tlp::node root);
 };
 
 #endif // SQUARIFIED_TREE_MAP_H
@@ -0,0 +1,296 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef SUBTREE_CACHE_H
+#define SUBTREE_CACHE_H
+
+#include <climits>
+#include <string>
+#include <vector>
+
+#include <talipot/Graph.h>
+#include <talipot/PropertyInterface.h>
+
+/**
+ * Keeps the data computed by a tree layout for each subtree of the last laid out tree,
+ * so that a new run on the same tree only recomputes the subtrees modified in between,
+ * i.e. the modified nodes and the paths from them to the root.
+ *
+ * A node is considered as modified when its value of one of the observed properties
+ * (node sizes, edge lengths, ...) is set, and when its children, the edges to them or
+ * their order differ from the ones of the previous run. The data of a node are stored
+ * according to its id, the relative position of a node being written by the computation
+ * of its father.
+ * The tree is also flattened in breadth first order, for the top down passes of the layouts.
+ *
+ * The data whose size depends on the subtree, as the contours of the subtrees, are only kept
+ * while their total size is at most MAX_KEPT_SIZE_PER_NODE times the number of nodes
+ * of the tree, see reserve.
+ */
+template <typename SubtreeData>
+class SubtreeCache : public tlp::Observable {
+public:
+  static constexpr uint MAX_KEPT_SIZE_PER_NODE = 4;
+
+  /**
+   * Prepares the cache for a run on tree, the data of the previous run being dropped
+   * if they were computed on another tree, with other properties or parameters.
+   * The subtrees whose data can be reused are then the ones for which isUpToDate
+   * returns true.
+   */
+  void prepare(tlp::Graph *tree, tlp::node root,
+               const std::vector<tlp::PropertyInterface *> &properties,
+               const std::string &parameters) {
+    if (tree != graph || properties != observedProperties || parameters != cachedParameters) {
+      reset();
+      graph = tree;
+      observedProperties = properties;
+      cachedParameters = parameters;
+      graph->addListener(this);
+
+      for (auto *prop : observedProperties) {
+        prop->addListener(this);
+      }
+    }
+
+    uint maxId = 0;
+
+    for (auto n : graph->nodes()) {
+      maxId = std::max(maxId, n.id);
+    }
+
+    if (maxId >= data.size()) {
+      data.resize(maxId + 1);
+      parentEdges.resize(maxId + 1);
+      ranks.resize(maxId + 1, 0);
+      nbChildren.resize(maxId + 1, 0);
+      upToDate.resize(maxId + 1, false);
+      keptSizes.resize(maxId + 1, 0);
+    }
+
+    maxKeptSize = size_t(MAX_KEPT_SIZE_PER_NODE) * graph->numberOfNodes();
+
+    // the root is always computed again, as the layouts may handle it differently
+    // from the other nodes, and so is the previous one
+    if (previousRoot.isValid() && previousRoot.id < upToDate.size()) {
+      upToDate[previousRoot.id] = false;
+    }
+
+    upToDate[root.id] = false;
+    previousRoot = root;
+
+    // the children of each node are compared to the ones of the previous run,
+    // the nodes being collected in breadth first order
+    order.clear();
+    fathers.clear();
+    order.reserve(graph->numberOfNodes());
+    fathers.reserve(graph->numberOfNodes());
+    order.push_back(root);
+    fathers.push_back(UINT_MAX);
+    parentEdges[root.id] = tlp::edge();
+
+    for (uint i = 0; i < order.size(); ++i) {
+      tlp::node n = order[i];
+      uint rank = 0;
+
+      for (auto e : graph->incidence(n)) {
+        const auto &[src, child] = graph->ends(e);
+
+        if (src != n) {
+          continue;
+        }
+
+        if (parentEdges[child.id] != e || ranks[child.id] != rank) {
+          parentEdges[child.id] = e;
+          ranks[child.id] = rank;
+          upToDate[n.id] = false;
+        }
+
+        order.push_back(child);
+        fathers.push_back(i);
+        ++rank;
+      }
+
+      if (nbChildren[n.id] != rank) {
+        nbChildren[n.id] = rank;
+        upToDate[n.id] = false;
+      }
+    }
+
+    // a modified subtree invalidates all its ancestors
+    for (uint i = order.size(); i-- > 1;) {
+      if (!upToDate[order[i].id]) {
+        upToDate[order[fathers[i]].id] = false;
+      }
+    }
+  }
+
+  // the nodes of the tree in breadth first order, so each node comes after its father
+  const std::vector<tlp::node> &treeNodes() const {
+    return order;
+  }
+
+  // the index in treeNodes of the father of the i-th node, UINT_MAX for the root
+  uint father(uint i) const {
+    return fathers[i];
+  }
+
+  // the edge between a node and its father
+  tlp::edge parentEdge(tlp::node n) const {
+    return parentEdges[n.id];
+  }
+
+  bool isUpToDate(tlp::node n) const {
+    return upToDate[n.id];
+  }
+
+  // must be called once the data of the subtree rooted in n are computed
+  void setUpToDate(tlp::node n) {
+    upToDate[n.id] = true;
+  }
+
+  /**
+   * Returns whether data of the given size can be kept for the subtree rooted in n,
+   * replacing the ones previously kept for it. When it returns false, the caller must drop
+   * these data and not set the subtree up to date, so it is computed again by the next run.
+   * As the data of the subtrees are computed bottom up, the ones of the lowest subtrees
+   * are kept first, e.g. on a long chain whose contours sum to a quadratic size.
+   */
+  bool reserve(tlp::node n, size_t size) {
+    keptSize -= keptSizes[n.id];
+    keptSizes[n.id] = 0;
+
+    if (keptSize + size > maxKeptSize) {
+      return false;
+    }
+
+    keptSize += size;
+    keptSizes[n.id] = size;
+    return true;
+  }
+
+  SubtreeData &operator[](tlp::node n) {
+    return data[n.id];
+  }
+
+  // drops all the cached data
+  void reset() {
+    if (graph) {
+      graph->removeListener(this);
+    }
+
+    for (auto *prop : observedProperties) {
+      prop->removeListener(this);
+    }
+
+    graph = nullptr;
+    observedProperties.clear();
+    cachedParameters.clear();
+    data.clear();
+    parentEdges.clear();
+    ranks.clear();
+    nbChildren.clear();
+    upToDate.clear();
+    keptSizes.clear();
+    keptSize = 0;
+    previousRoot = tlp::node();
+    order.clear();
+    fathers.clear();
+  }
+
+  // override of Observable::treatEvent to record the modified nodes
+  void treatEvent(const tlp::Event &evt) override {
+    if (evt.type() == tlp::EventType::TLP_DELETE) {
+      // the tree or one of the properties is being deleted
+      if (evt.sender() == graph) {
+        graph = nullptr;
+      } else {
+        std::erase(observedProperties, evt.sender());
+      }
+
+      reset();
+      return;
+    }
+
+    if (const auto *gEvt = dynamic_cast<const tlp::GraphEvent *>(&evt)) {
+      switch (gEvt->getType()) {
+      case tlp::GraphEventType::TLP_ADD_NODE:
+      case tlp::GraphEventType::TLP_DEL_NODE:
+        // the id of a deleted node may be given to a new one
+        setModified(gEvt->getNode());
+        break;
+
+      case tlp::GraphEventType::TLP_ADD_NODES:
+        for (auto n : gEvt->getNodes()) {
+          setModified(n);
+        }
+        break;
+
+      default:
+        // the modifications of the children are found by prepare
+        break;
+      }
+    } else if (const auto *pEvt = dynamic_cast<const tlp::PropertyEvent *>(&evt)) {
+      switch (pEvt->getType()) {
+      case tlp::PropertyEventType::TLP_AFTER_SET_NODE_VALUE:
+        setModified(pEvt->getNode());
+        break;
+
+      case tlp::PropertyEventType::TLP_AFTER_SET_EDGE_VALUE: {
+        // the length of an edge only matters to the subtree of its source
+        tlp::edge e = pEvt->getEdge();
+
+        if (graph->isElement(e)) {
+          setModified(graph->source(e));
+        }
+        break;
+      }
+
+      case tlp::PropertyEventType::TLP_AFTER_SET_ALL_NODE_VALUE:
+      case tlp::PropertyEventType::TLP_AFTER_SET_ALL_EDGE_VALUE:
+        upToDate.assign(upToDate.size(), false);
+        break;
+
+      default:
+        break;
+      }
+    }
+  }
+
+private:
+  void setModified(tlp::node n) {
+    if (n.id < upToDate.size()) {
+      upToDate[n.id] = false;
+    }
+  }
+
+  tlp::Graph *graph = nullptr;
+  std::vector<tlp::PropertyInterface *> observedProperties;
+  std::string cachedParameters;
+  std::vector<SubtreeData> data;
+  // the data of the previous run, indexed by node id
+  std::vector<tlp::edge> parentEdges;
+  std::vector<uint> ranks;
+  std::vector<uint> nbChildren;
+  std::vector<bool> upToDate;
+  // the size of the data kept for each subtree, see reserve
+  std::vector<size_t> keptSizes;
+  size_t keptSize = 0;
+  size_t maxKeptSize = 0;
+  tlp::node previousRoot;
+  // the tree of the current run
+  std::vector<tlp::node> order;
+  std::vector<uint> fathers;
+};
+
+#endif // SUBTREE_CACHE_H
@@ -33,7 +33,12 @@ static constexpr std::string_view paramHelp[] = {
     "Indicates if the node bounding objects are boxes or bounding circles.",
 
     // compact layout
-    "Indicates if a compact layout is computed."};
+    "Indicates if a compact layout is computed.",
+
+    // incremental
+    "If true, the contours of the subtrees are kept until the next run on the same tree, "
+    "which then only places again the subtrees modified in between and their ancestors. "
+    "The kept contours are bounded by a few times the number of nodes."};
 //=============================================================================
 #define ORIENTATION "vertical;horizontal;"
 //=============================================================================
@@ -47,10 +52,14 @@ TreeReingoldAndTilfordExtended::TreeReingoldAndTilfordExtended(const tlp::Plugin
   addSpacingParameters(this);
   addInParameter<bool>("bounding circles", paramHelp[3].data(), "false");
   addInParameter<bool>("compact layout", paramHelp[4].data(), "true");
+  addInParameter<bool>("incremental", paramHelp[5].data(), "false");
 }
 //=============================================================================
 TreeReingoldAndTilfordExtended::~TreeReingoldAndTilfordExtended() = default;
 //=============================================================================
+// the contours of the last tree laid out in incremental mode
+static SubtreeCache<SubtreeContour> incrementalSubtrees;
+//=============================================================================
 double TreeReingoldAndTilfordExtended::calcDecal(const std::list<LR> &arbreG,
                                                  const std::list<LR> &arbreD) const {
   double decal = 0;
@@ -179,16 +188,39 @@ list<LR> *TreeReingoldAndTilfordExtended::mergeLRList(std::list<LR> *L, std::lis
   return L;
 }
 //=============================================================================
-list<LR> *TreeReingoldAndTilfordExtended::TreePlace(tlp::node n,
-                                                    flat_hash_map<tlp::node, double> *p) {
+void TreeReingoldAndTilfordExtended::keepContour(tlp::node n, const list<LR> &contour) {
+  SubtreeContour &subtree = (*subtrees)[n];
+
+  if (subtrees->reserve(n, contour.size())) {
+    subtree.contour.assign(contour.begin(), contour.end());
+    subtrees->setUpToDate(n);
+  } else {
+    // the subtree will be placed again by the next run
+    vector<LR>().swap(subtree.contour);
+  }
+}
+//=============================================================================
+list<LR> *TreeReingoldAndTilfordExtended::TreePlace(tlp::node n) {
+  SubtreeContour &subtree = (*subtrees)[n];
+
+  if (incremental && subtrees->isUpToDate(n)) {
+    // the kept contour is copied as it is modified by the merges
+    return new list<LR>(subtree.contour.begin(), subtree.contour.end());
+  }
+
   if (tree->outdeg(n) == 0) {
     auto *result = new list<LR>();
     LR tmpLR;
     tmpLR.L = -(*sizes)[n][0] / 2.;
     tmpLR.R = +(*sizes)[n][0] / 2.;
     tmpLR.size = 1;
-    (*p)[n] = 0;
+    subtree.pos = 0;
     result->push_front(tmpLR);
+
+    if (incremental) {
+      keepContour(n, *result);
+    }
+
     return (result);
   } else {
     Iterator<edge> *it;
@@ -199,7 +231,7 @@ list<LR> *TreeReingoldAndTilfordExtended::TreePlace(tlp::node n,
 
     list<LR> *leftTree, *rightTree;
     list<double> childPos;
-    leftTree = TreePlace(itn, p);
+    leftTree = TreePlace(itn);
     childPos.push_back(((*(leftTree->begin())).L + (*(leftTree->begin())).R) / 2.);
 
     if (useLength) {
@@ -217,7 +249,7 @@ list<LR> *TreeReingoldAndTilfordExtended::TreePlace(tlp::node n,
     while (it->hasNext()) {
       ite = it->next();
       itn = tree->target(ite);
-      rightTree = TreePlace(itn, p);
+      rightTree = TreePlace(itn);
 
       if (useLength) {
         int tmpLength;
@@ -261,87 +293,114 @@ list<LR> *TreeReingoldAndTilfordExtended::TreePlace(tlp::node n,
     auto itI = childPos.begin();
     for (edge ite : tree->getOutEdges(n)) {
       itn = tree->target(ite);
-      (*p)[itn] = *itI - posFather;
+      (*subtrees)[itn].pos = *itI - posFather;
       ++itI;
     }
     childPos.clear();
-    (*p)[n] = 0;
+    subtree.pos = 0;
+
+    if (incremental) {
+      keepContour(n, *leftTree);
+    }
+
     return (leftTree);
   }
 }
 //=============================================================================
-void TreeReingoldAndTilfordExtended::TreeLevelSizing(tlp::node n,
-                                                     flat_hash_map<int, double> &maxSize, int level,
-                                                     flat_hash_map<tlp::node, int> &levels) {
-  levels[n] = level;
-
-  if (maxSize.contains(level)) {
-    if (maxSize[level] < (*sizes)[n][1]) {
-      maxSize[level] = (*sizes)[n][1];
-    }
-  } else {
-    maxSize[level] = (*sizes)[n][1];
-  }
+void TreeReingoldAndTilfordExtended::TreeLevelSizing(flat_hash_map<int, double> &maxSize) {
+  const vector<node> &treeNodes = subtrees->treeNodes();
+  vector<int> levels(treeNodes.size(), 0);
 
-  if (useLength) {
-    for (edge ite : tree->getOutEdges(n)) {
-      node itn = tree->target(ite);
-      TreeLevelSizing(itn, maxSize, level + ((*lengthMetric)[ite]), levels);
+  for (uint i = 0; i < treeNodes.size(); ++i) {
+    node n = treeNodes[i];
+
+    if (i > 0) {
+      levels[i] = levels[subtrees->father(i)] +
+                  (useLength ? (*lengthMetric)[subtrees->parentEdge(n)] : 1);
     }
-  } else {
-    for (auto itn : tree->getOutNodes(n)) {
-      TreeLevelSizing(itn, maxSize, level + 1, levels);
+
+    auto it = maxSize.find(levels[i]);
+
+    if (it == maxSize.end()) {
+      maxSize[levels[i]] = (*sizes)[n][1];
+    } else if (it->second < (*sizes)[n][1]) {
+      it->second = (*sizes)[n][1];
     }
   }
 }
 //=============================================================================
-void TreeReingoldAndTilfordExtended::calcLayout(tlp::node n, flat_hash_map<tlp::node, double> *p,
-                                                double x, double y, int level,
-                                                flat_hash_map<int, double> &maxLevelSize) {
-  Coord tmpCoord;
-
-  if (!compactLayout) {
-    tmpCoord.set(float(x + (*p)[n]), -float(y), 0);
-  } else {
-    tmpCoord.set(float(x + (*p)[n]), -float(y + maxLevelSize[level] / 2.f), 0);
-  }
-
-  (*result)[n] = tmpCoord;
-
-  if (useLength) {
-    for (auto ite : tree->getOutEdges(n)) {
-      node itn = tree->target(ite);
-      double decalY = y;
-      int decalLevel = level;
-      int tmp = (*lengthMetric)[ite];
+void TreeReingoldAndTilfordExtended::calcLayout(flat_hash_map<int, double> &maxLevelSize) {
+  // the nodes are placed from the root, each one relatively to its father
+  const vector<node> &treeNodes = subtrees->treeNodes();
+  uint nbNodes = treeNodes.size();
+  vector<double> xs(nbNodes, 0), ys(nbNodes, 0);
+  vector<int> levels(nbNodes, 0);
+  vector<Coord> coords(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    node n = treeNodes[i];
+
+    if (i > 0) {
+      uint father = subtrees->father(i);
+      xs[i] = xs[father] + (*subtrees)[n].pos;
+      ys[i] = ys[father];
+      levels[i] = levels[father];
+      int tmp = useLength ? (*lengthMetric)[subtrees->parentEdge(n)] : 1;
 
       while (tmp > 0) {
         if (!compactLayout) {
-          decalY += spacing;
+          ys[i] += spacing;
         } else {
-          decalY += maxLevelSize[decalLevel] + spacing;
+          ys[i] += maxLevelSize[levels[i]] + spacing;
         }
 
-        decalLevel++;
+        levels[i]++;
         tmp--;
       }
+    }
 
-      calcLayout(itn, p, x + (*p)[n], decalY, decalLevel, maxLevelSize);
+    if (!compactLayout) {
+      coords[i].set(float(xs[i]), -float(ys[i]), 0);
+    } else {
+      coords[i].set(float(xs[i]), -float(ys[i] + maxLevelSize[levels[i]] / 2.f), 0);
     }
-  } else {
-    for (auto itn : tree->getOutNodes(n)) {
-      if (!compactLayout) {
-        calcLayout(itn, p, x + (*p)[n], y + spacing, level + 1, maxLevelSize);
-      } else {
-        calcLayout(itn, p, x + (*p)[n], y + maxLevelSize[level] + spacing, level + 1, maxLevelSize);
+  }
+
+  if (ortho) {
+    // Edge bends
+    for (uint i = 1; i < nbNodes; ++i) {
+      const Coord &srcPos = coords[subtrees->father(i)];
+      const Coord &tgtPos = coords[i];
+
+      if (srcPos[0] != tgtPos[0]) {
+        Coord coord;
+
+        if (orientation == "horizontal") {
+          coord[0] = -srcPos[1];
+          coord[1] = tgtPos[0];
+        } else {
+          coord[0] = tgtPos[0];
+          coord[1] = srcPos[1];
+        }
+
+        result->setEdgeValue(subtrees->parentEdge(treeNodes[i]), {coord});
       }
     }
   }
+
+  // rotate layout and size
+  bool rotate = orientation == "horizontal";
+  vector<Coord> nodesCoords(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    const Coord &c = coords[i];
+    nodesCoords[tree->nodePos(treeNodes[i])] = rotate ? Coord(-c[1], c[0], c[2]) : c;
+  }
+
+  result->setValues(nodesCoords, {}, tree);
 }
 //===============================================================
 bool TreeReingoldAndTilfordExtended::run() {
-  flat_hash_map<node, double> posRelative;
-
   result->setAllEdgeValue(vector<Coord>(0));
 
   if (!getNodeSizePropertyParameter(dataSet, sizes)) {
@@ -354,12 +413,14 @@ bool TreeReingoldAndTilfordExtended::run() {
   ortho = true;
   useLength = false;
   compactLayout = true;
+  incremental = false;
   bool boundingCircles = false;
 
   if (dataSet != nullptr) {
     useLength = dataSet->get("edge length", lengthMetric);
     dataSet->get("orthogonal", ortho);
     dataSet->get("bounding circles", boundingCircles);
+    dataSet->get("incremental", incremental);
     StringCollection tmp;
 
     if (dataSet->get("orientation", tmp)) {
@@ -371,6 +432,15 @@ bool TreeReingoldAndTilfordExtended::run() {
     }
   }
 
+  // the contours depend on the node sizes and on the edge lengths.
+  // The given node sizes are observed, as the bounding circles computed below
+  // are a new property at each run
+  vector<PropertyInterface *> contourProperties = {sizes};
+
+  if (useLength && lengthMetric) {
+    contourProperties.push_back(lengthMetric);
+  }
+
   bool deleteLenghtMetric = false;
 
   if (lengthMetric == nullptr) {
@@ -413,9 +483,17 @@ bool TreeReingoldAndTilfordExtended::run() {
   node startNode = tree->getSource();
   assert(startNode.isValid());
 
+  // the contours can only be kept when the graph is a tree,
+  // the spanning tree of another graph being deleted after each run
+  incremental = incremental && tree == graph;
+  SubtreeCache<SubtreeContour> localSubtrees;
+  subtrees = incremental ? &incrementalSubtrees : &localSubtrees;
+  subtrees->prepare(tree, startNode, contourProperties,
+                    to_string(nodeSpacing) + (useLength ? " length" : "") +
+                        (boundingCircles ? " circles" : ""));
+
   flat_hash_map<int, double> maxSizeLevel;
-  flat_hash_map<node, int> levels;
-  TreeLevelSizing(startNode, maxSizeLevel, 0, levels);
+  TreeLevelSizing(maxSizeLevel);
 
   // check if the specified layer spacing is greater
   // than the max of the minimum layer spacing of the tree
@@ -429,42 +507,12 @@ bool TreeReingoldAndTilfordExtended::run() {
     }
   }
 
-  list<LR> *tmpList = TreePlace(startNode, &posRelative);
+  list<LR> *tmpList = TreePlace(startNode);
   delete tmpList;
+  // the root may have been placed as a child in a previous incremental run
+  (*subtrees)[startNode].pos = 0;
 
-  calcLayout(startNode, &posRelative, 0, 0, 0, maxSizeLevel);
-
-  if (ortho) {
-    // Edge bends
-    for (auto e : tree->edges()) {
-      node src = tree->source(e);
-      node tgt = tree->target(e);
-      const Coord &srcPos = (*result)[src];
-      const Coord &tgtPos = (*result)[tgt];
-
-      LineType::RealType tmp;
-      Coord coord;
-      if (srcPos[0] != tgtPos[0]) {
-        if (orientation == "horizontal") {
-          coord[0] = -srcPos[1];
-          coord[1] = tgtPos[0];
-        } else {
-          coord[0] = tgtPos[0];
-          coord[1] = srcPos[1];
-        }
-        tmp.push_back(coord);
-      }
-      (*result)[e] = tmp;
-    }
-  }
-
-  // rotate layout and size
-  if (orientation == "horizontal") {
-    for (auto n : tree->nodes()) {
-      const Coord &tmpC = (*result)[n];
-      (*result)[n] = Coord(-tmpC[1], tmpC[0], tmpC[2]);
-    }
-  }
+  calcLayout(maxSizeLevel);
 
   TreeTest::cleanComputedTree(graph, tree);
 
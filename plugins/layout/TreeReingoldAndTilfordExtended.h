@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -19,12 +19,21 @@
 #include <talipot/hash.h>
 #include <talipot/PluginHeaders.h>
 
+#include "SubtreeCache.h"
+
 struct LR {
   double L;
   double R;
   int size;
 };
 
+struct SubtreeContour {
+  // the position of the node relatively to its father
+  double pos = 0;
+  // the contour of the subtree, only kept in incremental mode
+  std::vector<LR> contour;
+};
+
 /** This plugin is an implementation of the hierarchical tree layout
  *  algorithm first published as:
  *
@@ -40,7 +49,11 @@ struct LR {
  *  It extends the original Reingold and Tilford by providing management
  *  of different node size and different edge length. \n \n
  *  The algorithm use the (Size)"viewSize" property for element size and the
- *  (int)"treeEdgeLength" for the edge length.
+ *  (int)"treeEdgeLength" for the edge length. \n \n
+ *  In incremental mode, the contours of the subtrees are kept between two runs
+ *  on the same tree, so that only the subtrees modified in between and their
+ *  ancestors are placed again. The kept contours are bounded by a few times
+ *  the number of nodes, the highest subtrees of deep trees being placed again.
  *
  */
 class TreeReingoldAndTilfordExtended : public tlp::LayoutAlgorithm {
@@ -56,15 +69,16 @@ public:
   bool run() override;
 
 private:
-  void calcLayout(tlp::node, flat_hash_map<tlp::node, double> *, double, double, int,
-                  flat_hash_map<int, double> &);
+  void calcLayout(flat_hash_map<int, double> &);
   double calcDecal(const std::list<LR> &, const std::list<LR> &) const;
   std::list<LR> *mergeLRList(std::list<LR> *, std::list<LR> *, double decal);
-  std::list<LR> *TreePlace(tlp::node, flat_hash_map<tlp::node, double> *);
-  void TreeLevelSizing(tlp::node, flat_hash_map<int, double> &, int,
-                       flat_hash_map<tlp::node, int> &levels);
+  std::list<LR> *TreePlace(tlp::node);
+  void keepContour(tlp::node, const std::list<LR> &);
+  void TreeLevelSizing(flat_hash_map<int, double> &);
 
   tlp::Graph *tree;
+  SubtreeCache<SubtreeContour> *subtrees;
+  bool incremental;
   tlp::SizeProperty *sizes;
   tlp::IntegerProperty *lengthMetric;
   bool ortho;
@@ -11,15 +11,30 @@
  *
  */
 
+#include <talipot/ParallelTools.h>
 #include <talipot/TriconnectedTest.h>
 #include "Tutte.h"
 
+#include <climits>
+
 PLUGIN(Tutte)
 
 using namespace std;
 using namespace tlp;
+
+static constexpr std::string_view paramHelp[] = {
+    // tolerance
+    "The conjugate gradient iterations stop when the norm of the residual of the barycentric "
+    "system becomes lower than this value times the norm of its right hand side.",
+
+    // max iterations
+    "The maximum number of conjugate gradient iterations used to solve each of the x and y "
+    "barycentric systems."};
 //====================================================
-Tutte::Tutte(const tlp::PluginContext *context) : LayoutAlgorithm(context) {}
+Tutte::Tutte(const tlp::PluginContext *context) : LayoutAlgorithm(context) {
+  addInParameter<double>("tolerance", paramHelp[0].data(), "1e-6");
+  addInParameter<uint>("max iterations", paramHelp[1].data(), "10000");
+}
 //====================================================
 Tutte::~Tutte() = default;
 //====================================================
@@ -91,6 +106,97 @@ list<node> findCycle(Graph *sg) {
   return result;
 }
 //====================================================
+namespace {
+// symmetric matrix stored as its diagonal and the row-wise
+// column indices of its off diagonal -1 entries
+struct LaplacianSystem {
+  vector<uint> rowStart;
+  vector<uint> columns;
+  vector<double> diagonal;
+};
+
+// size of the chunks of a vector summed by the same thread, it does not depend
+// on the number of threads so the results of the reductions are reproducible
+const uint CHUNK_SIZE = 4096;
+
+double dotProduct(const vector<double> &u, const vector<double> &v) {
+  uint size = u.size();
+  uint nbChunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  vector<double> chunksSums(nbChunks, 0);
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    double sum = 0;
+
+    for (uint i = c * CHUNK_SIZE; i < std::min(size, (c + 1) * CHUNK_SIZE); ++i) {
+      sum += u[i] * v[i];
+    }
+
+    chunksSums[c] = sum;
+  });
+
+  double sum = 0;
+
+  for (double chunkSum : chunksSums) {
+    sum += chunkSum;
+  }
+
+  return sum;
+}
+
+// result = system * v
+void multiply(const LaplacianSystem &system, const vector<double> &v, vector<double> &result) {
+  TLP_PARALLEL_MAP_INDICES(v.size(), [&](uint i) {
+    double sum = system.diagonal[i] * v[i];
+
+    for (uint j = system.rowStart[i]; j < system.rowStart[i + 1]; ++j) {
+      sum -= v[system.columns[j]];
+    }
+
+    result[i] = sum;
+  });
+}
+
+// Solves system * x = b using the conjugate gradient method
+// with a diagonal preconditioner, x being the initial guess.
+// Returns the number of iterations.
+uint solveConjugateGradient(const LaplacianSystem &system, const vector<double> &b,
+                            vector<double> &x, double tolerance, uint maxIterations) {
+  uint size = b.size();
+  vector<double> r(size), z(size), p(size), q(size);
+  multiply(system, x, q);
+
+  TLP_PARALLEL_MAP_INDICES(size, [&](uint i) {
+    r[i] = b[i] - q[i];
+    z[i] = r[i] / system.diagonal[i];
+    p[i] = z[i];
+  });
+
+  double threshold = tolerance * tolerance * dotProduct(b, b);
+  double rz = dotProduct(r, z);
+  uint iteration = 0;
+
+  while (iteration < maxIterations && dotProduct(r, r) > threshold) {
+    multiply(system, p, q);
+    double alpha = rz / dotProduct(p, q);
+
+    TLP_PARALLEL_MAP_INDICES(size, [&](uint i) {
+      x[i] += alpha * p[i];
+      r[i] -= alpha * q[i];
+      z[i] = r[i] / system.diagonal[i];
+    });
+
+    double newRz = dotProduct(r, z);
+    double beta = newRz / rz;
+    rz = newRz;
+
+    TLP_PARALLEL_MAP_INDICES(size, [&](uint i) { p[i] = z[i] + beta * p[i]; });
+    ++iteration;
+  }
+
+  return iteration;
+}
+}
+//====================================================
 bool Tutte::run() {
   if (pluginProgress) {
     // user cannot interact while computing
@@ -102,7 +208,6 @@ bool Tutte::run() {
   std::list<node> tmp;
   tmp = findCycle(graph);
   // We place the nodes on the outer face
-  Coord tmpCoord, tmpCoord2, baseCoord;
   float gamma;
   int i = 0;
   int rayon = 100;
@@ -114,42 +219,74 @@ bool Tutte::run() {
     i++;
   }
 
-  std::list<node> toMove;
-
-  for (auto n : graph->nodes()) {
-    toMove.push_front(n);
-  }
+  // the interior nodes are placed at the barycenter of their neighbours,
+  // which is the solution of a linear system whose matrix is the Laplacian
+  // of the graph restricted to the interior nodes
+  const vector<node> &nodes = graph->nodes();
+  vector<uint> interiorIndex(nodes.size(), 0);
 
   for (auto n : tmp) {
-    toMove.remove(n);
+    interiorIndex[graph->nodePos(n)] = UINT_MAX;
   }
 
-  bool ok = true;
-
-  while (ok) {
-    ok = false;
+  vector<node> interiorNodes;
 
-    for (auto n : toMove) {
-      tmpCoord.set(0, 0, 0);
-      Coord baseCoord = (*result)[n];
-      int i = 0;
+  for (uint i = 0; i < nodes.size(); ++i) {
+    if (interiorIndex[i] != UINT_MAX) {
+      interiorIndex[i] = interiorNodes.size();
+      interiorNodes.push_back(nodes[i]);
+    }
+  }
 
-      for (auto nn : graph->getInOutNodes(n)) {
-        const Coord &tmpCoord2 = (*result)[nn];
-        tmpCoord.set(tmpCoord.getX() + tmpCoord2.getX(), tmpCoord.getY() + tmpCoord2.getY(), 0);
-        ++i;
-      }
+  uint nbInteriorNodes = interiorNodes.size();
+  LaplacianSystem system;
+  system.rowStart.resize(nbInteriorNodes + 1);
+  system.diagonal.resize(nbInteriorNodes);
+  vector<double> bx(nbInteriorNodes, 0);
+  vector<double> by(nbInteriorNodes, 0);
+  system.rowStart[0] = 0;
 
-      (*result)[n] = Coord(tmpCoord.getX() / i, tmpCoord.getY() / i, 0);
+  for (uint i = 0; i < nbInteriorNodes; ++i) {
+    node n = interiorNodes[i];
+    double diagonal = 0;
 
-      if (fabs(baseCoord.getX() - tmpCoord.getX() / i) > 0.02) {
-        ok = true;
+    for (auto nn : graph->getInOutNodes(n)) {
+      if (nn == n) {
+        continue;
       }
 
-      if (fabs(baseCoord.getY() - tmpCoord.getY() / i) > 0.02) {
-        ok = true;
+      ++diagonal;
+      uint j = interiorIndex[graph->nodePos(nn)];
+
+      if (j == UINT_MAX) {
+        const Coord &coord = (*result)[nn];
+        bx[i] += coord.getX();
+        by[i] += coord.getY();
+      } else {
+        system.columns.push_back(j);
       }
     }
+
+    system.diagonal[i] = diagonal;
+    system.rowStart[i + 1] = system.columns.size();
+  }
+
+  double tolerance = 1e-6;
+  uint maxIterations = 10000;
+
+  if (dataSet != nullptr) {
+    dataSet->get("tolerance", tolerance);
+    dataSet->get("max iterations", maxIterations);
+  }
+
+  // start from the center of the outer cycle
+  vector<double> x(nbInteriorNodes, rayon * 2);
+  vector<double> y(nbInteriorNodes, rayon * 2);
+  solveConjugateGradient(system, bx, x, tolerance, maxIterations);
+  solveConjugateGradient(system, by, y, tolerance, maxIterations);
+
+  for (uint i = 0; i < nbInteriorNodes; ++i) {
+    result->setNodeValue(interiorNodes[i], Coord(x[i], y[i], 0));
   }
 
   return true;
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2022  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -11,6 +11,10 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "rectanglePackingFonctions.h"
 
 using namespace std;
@@ -102,3 +106,89 @@ bool RectanglePackingLimitPositions(vector<Rectangle<float>> &v, const char *qua
   return progress ? (progress->progress(counter, entrySize + 1) != ProgressState::TLP_CANCEL)
                   : true;
 }
+
+/* places the rectangles sorted by decreasing height on shelves of the given width, using a max
+ * tree of the free widths of the shelves to find the first one where a rectangle fits, and returns
+ * the height of the packing */
+static double packOnShelves(vector<Rectangle<float>> &v, const vector<uint> &order,
+                            double shelfWidth) {
+  uint nbRectangles = v.size();
+  uint treeSize = 1;
+
+  while (treeSize < nbRectangles) {
+    treeSize *= 2;
+  }
+
+  // the leaves hold the free widths of the shelves, a negative value for a shelf not yet opened
+  vector<double> freeWidths(2 * treeSize, -1);
+  vector<double> shelvesY;
+  double packingHeight = 0;
+
+  for (uint i : order) {
+    Rectangle<float> &rect = v[i];
+    double width = rect[1][0] - rect[0][0];
+    double height = rect[1][1] - rect[0][1];
+    uint shelf;
+
+    if (freeWidths[1] >= width) {
+      uint pos = 1;
+
+      while (pos < treeSize) {
+        pos = freeWidths[2 * pos] >= width ? 2 * pos : 2 * pos + 1;
+      }
+
+      shelf = pos - treeSize;
+    } else {
+      // the rectangles are sorted, so the first one of a shelf is the highest
+      shelf = shelvesY.size();
+      shelvesY.push_back(packingHeight);
+      packingHeight += height;
+      freeWidths[treeSize + shelf] = shelfWidth;
+    }
+
+    uint pos = treeSize + shelf;
+    double x = shelfWidth - freeWidths[pos];
+    rect[0][0] = x;
+    rect[0][1] = shelvesY[shelf];
+    rect[1][0] = x + width;
+    rect[1][1] = shelvesY[shelf] + height;
+    freeWidths[pos] -= width;
+
+    for (pos /= 2; pos > 0; pos /= 2) {
+      freeWidths[pos] = std::max(freeWidths[2 * pos], freeWidths[2 * pos + 1]);
+    }
+  }
+
+  return packingHeight;
+}
+
+void RectanglePackingShelves(vector<Rectangle<float>> &v) {
+  if (v.empty()) {
+    return;
+  }
+
+  vector<uint> order(v.size());
+  iota(order.begin(), order.end(), 0);
+  double area = 0;
+  double maxWidth = 0;
+
+  for (const auto &rect : v) {
+    double width = rect[1][0] - rect[0][0];
+    area += width * (rect[1][1] - rect[0][1]);
+    maxWidth = std::max(maxWidth, width);
+  }
+
+  stable_sort(order.begin(), order.end(), [&v](uint i, uint j) {
+    return v[i][1][1] - v[i][0][1] > v[j][1][1] - v[j][0][1];
+  });
+
+  double shelfWidth = std::max(maxWidth, sqrt(area));
+  double height = packOnShelves(v, order, shelfWidth);
+
+  // the lost space of the first packing is taken into account to get a square one
+  double squareWidth = std::max(maxWidth, sqrt(shelfWidth * height));
+
+  if (squareWidth != shelfWidth) {
+    packOnShelves(v, order, squareWidth);
+  }
+}
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -42,4 +42,14 @@ bool RectanglePackingLimitRectangles(std::vector<tlp::Rectangle<float>> &v, cons
 bool RectanglePackingLimitPositions(std::vector<tlp::Rectangle<float>> &v, const char *quality,
                                     tlp::PluginProgress *progress);
 
+/**
+ *This function is used for packing a large number of rectangles. The rectangles
+ *are sorted by decreasing height then placed on shelves, each one going to the
+ *first shelf with enough free width (First Fit Decreasing Height), so the
+ *packing is computed in O(n log n). The width of the shelves is chosen to get
+ *a packing looking like a square.
+ *@param v a vector including the rectangles to pack.
+ */
+void RectanglePackingShelves(std::vector<tlp::Rectangle<float>> &v);
+
 #endif
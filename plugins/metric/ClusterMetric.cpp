@@ -54,13 +54,10 @@ bool ClusterMetric::run() {
   clusteringCoefficient(graph, clusters, maxDepth);
   clusters.copyToProperty(result);
 
-  const std::vector<edge> &edges = graph->edges();
-  uint nbEdges = edges.size();
-
-  for (uint i = 0; i < nbEdges; ++i) {
-    edge e = edges[i];
-    (*result)[e] = clusterGetEdgeValue(graph, clusters, e);
-  }
+  tlp::EdgeVectorProperty<double> edgeValues(graph);
+  TLP_PARALLEL_MAP_EDGES(graph,
+                         [&](edge e) { edgeValues[e] = clusterGetEdgeValue(graph, clusters, e); });
+  edgeValues.copyToProperty(result);
 
   return true;
 }
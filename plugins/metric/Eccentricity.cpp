@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2025  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -15,6 +15,7 @@
 #include <atomic>
 
 #include <talipot/GraphMeasure.h>
+#include <talipot/MultiSourceBFS.h>
 #include <talipot/PropertyAlgorithm.h>
 
 #include "Eccentricity.h"
@@ -44,15 +45,23 @@ static constexpr std::string_view paramHelp[] = {
 
     // graph diameter
     "The computed graph diameter (the length of the shortest path between the most distanced "
-    "nodes)."};
+    "nodes). When the closeness centrality is estimated, it is the largest eccentricity of the "
+    "sampled nodes.",
+
+    // sample size
+    "If not 0 and if no weight is given, the closeness centrality of each node is estimated from "
+    "its distances to this number of randomly chosen nodes. With k sampled nodes, the error on "
+    "the average distances is lower than the diameter multiplied by sqrt(log(n) / k) with a high "
+    "probability, n being the number of nodes."};
 
 EccentricityMetric::EccentricityMetric(const tlp::PluginContext *context)
-    : DoubleAlgorithm(context), allPaths(false), norm(true), directed(false) {
+    : DoubleAlgorithm(context), allPaths(false), norm(true), directed(false), sampleSize(0) {
   addInParameter<bool>("closeness centrality", paramHelp[0].data(), "false");
   addInParameter<bool>("norm", paramHelp[1].data(), "true");
   addInParameter<bool>("directed", paramHelp[2].data(), "false");
   addInParameter<NumericProperty *>("weight", paramHelp[3].data(), "", false);
   addOutParameter<double>("graph diameter", paramHelp[4].data(), "-1");
+  addInParameter<uint>("sample size", paramHelp[5].data(), "0");
 }
 //====================================================================
 EccentricityMetric::~EccentricityMetric() = default;
@@ -102,17 +111,76 @@ double EccentricityMetric::compute(node n, NodeVectorProperty<double> &maxDistan
   return val;
 }
 //====================================================================
+// the unweighted distances from all the nodes are computed by a multi source BFS
+void EccentricityMetric::computeWithBFS(NodeVectorProperty<double> &res,
+                                        NodeVectorProperty<double> &maxDistance) {
+  MultiSourceBFS bfs(graph, directed ? EdgeType::DIRECTED : EdgeType::UNDIRECTED);
+  bfs.run({}, pluginProgress);
+
+  TLP_PARALLEL_MAP_INDICES(graph->numberOfNodes(), [&](uint i) {
+    maxDistance[i] = bfs.eccentricity(i);
+
+    if (!allPaths) {
+      res[i] = bfs.eccentricity(i);
+    } else if (bfs.nbReachedNodes(i) == 0) {
+      res[i] = 0;
+    } else if (norm) {
+      res[i] = 1.0 / bfs.sourceDistancesSum(i);
+    } else {
+      res[i] = double(bfs.sourceDistancesSum(i)) / bfs.nbReachedNodes(i);
+    }
+  });
+}
+//====================================================================
+// the distances from each node to the other ones are estimated from its distances
+// to a sample of them, which are the distances from the sample in the reversed graph
+void EccentricityMetric::estimateCloseness(NodeVectorProperty<double> &res,
+                                           NodeVectorProperty<double> &maxDistance) {
+  uint nbNodes = graph->numberOfNodes();
+  MultiSourceBFS bfs(graph, directed ? EdgeType::INV_DIRECTED : EdgeType::UNDIRECTED);
+  vector<uint> sources = MultiSourceBFS::randomSources(nbNodes, sampleSize);
+  NodeVectorProperty<bool> sampled(graph);
+  sampled.setAll(false);
+  maxDistance.setAll(0);
+
+  for (uint i = 0; i < sampleSize; ++i) {
+    sampled[sources[i]] = true;
+  }
+
+  bfs.run(sources, pluginProgress);
+
+  for (uint i = 0; i < sampleSize; ++i) {
+    maxDistance[sources[i]] = bfs.eccentricity(i);
+  }
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    double sum = bfs.targetDistancesSum(i);
+
+    if (bfs.nbReachingSources(i) == 0) {
+      res[i] = 0;
+    } else if (norm) {
+      // the sum of the distances is extrapolated from the sampled nodes to all the nodes
+      double nbOtherSources = sampleSize - (sampled[i] ? 1 : 0);
+      res[i] = nbOtherSources / (sum * (nbNodes - 1));
+    } else {
+      res[i] = sum / bfs.nbReachingSources(i);
+    }
+  });
+}
+//====================================================================
 bool EccentricityMetric::run() {
   allPaths = false;
   norm = true;
   directed = false;
   weight = nullptr;
+  sampleSize = 0;
 
   if (dataSet != nullptr) {
     dataSet->get("closeness centrality", allPaths);
     dataSet->get("norm", norm);
     dataSet->get("directed", directed);
     dataSet->get("weight", weight);
+    dataSet->get("sample size", sampleSize);
   }
 
   // Edges weights should be positive
@@ -125,23 +193,30 @@ bool EccentricityMetric::run() {
 
   NodeVectorProperty<double> maxDistance(graph);
   NodeVectorProperty<double> res(graph);
-  atomic_int nbTreatedNodes = 0;
-  atomic_bool stop = false;
 
-  TLP_PARALLEL_MAP_NODES(graph, [&](node n) {
-    if (stop.load()) {
-      return;
-    }
-    res[n] = compute(n, maxDistance);
-    ++nbTreatedNodes;
-    if (ThreadManager::getThreadNumber() == 0) {
-      if (pluginProgress &&
-          pluginProgress->progress(nbTreatedNodes.load(), graph->numberOfNodes()) !=
-              ProgressState::TLP_CONTINUE) {
-        stop = true;
+  if (weight) {
+    atomic_int nbTreatedNodes = 0;
+    atomic_bool stop = false;
+
+    TLP_PARALLEL_MAP_NODES(graph, [&](node n) {
+      if (stop.load()) {
+        return;
       }
-    }
-  });
+      res[n] = compute(n, maxDistance);
+      ++nbTreatedNodes;
+      if (ThreadManager::getThreadNumber() == 0) {
+        if (pluginProgress &&
+            pluginProgress->progress(nbTreatedNodes.load(), graph->numberOfNodes()) !=
+                ProgressState::TLP_CONTINUE) {
+          stop = true;
+        }
+      }
+    });
+  } else if (allPaths && sampleSize && sampleSize < graph->numberOfNodes()) {
+    estimateCloseness(res, maxDistance);
+  } else {
+    computeWithBFS(res, maxDistance);
+  }
 
   if (pluginProgress && pluginProgress->state() != ProgressState::TLP_CONTINUE) {
     return pluginProgress->state() != ProgressState::TLP_CANCEL;
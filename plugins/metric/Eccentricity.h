@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2023  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -57,17 +57,23 @@ public:
                     "<b>Closeness Centrality</b> is the mean of shortest-paths lengths from a node "
                     "to others. The normalized values are computed using the reciprocal of the sum "
                     "of these distances.",
-                    "2.2", "Graph")
+                    "2.3", "Graph")
   EccentricityMetric(const tlp::PluginContext *context);
   ~EccentricityMetric() override;
   bool run() override;
   double compute(tlp::node n, tlp::NodeVectorProperty<double> &maxDistance);
 
 private:
+  void computeWithBFS(tlp::NodeVectorProperty<double> &res,
+                      tlp::NodeVectorProperty<double> &maxDistance);
+  void estimateCloseness(tlp::NodeVectorProperty<double> &res,
+                         tlp::NodeVectorProperty<double> &maxDistance);
+
   bool allPaths;
   bool norm;
   bool directed;
   tlp::NumericProperty *weight;
+  uint sampleSize;
 };
 
 #endif // ECCENTRICITY_H
@@ -0,0 +1,98 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/LinkAnalysis.h>
+#include <talipot/PluginHeaders.h>
+
+using namespace std;
+using namespace tlp;
+
+static constexpr std::string_view paramHelp[] = {
+    // directed
+    "Indicates if the graph should be considered as directed or not. If directed, the "
+    "centrality of a node only depends on the nodes linking to it.",
+
+    // weight
+    "An existing edge weight metric property.",
+
+    // tolerance
+    "The iterations stop when the sum of the absolute changes of the centralities is lower "
+    "than this value.",
+
+    // maximum iterations
+    "The maximum number of iterations."};
+
+/** \file
+ *  \brief  An implementation of the eigenvector centrality
+ *
+ * The eigenvector centrality of a node is proportional to the sum of the centralities
+ * of its neighbours, so a node is central when it is linked to central nodes.
+ * It is computed by power iteration.
+ *
+ *  <b>HISTORY</b>
+ *
+ *  - 2026 Version 1.0: Initial release
+ *
+ */
+struct EigenvectorCentrality : public DoubleAlgorithm {
+
+  PLUGININFORMATION("Eigenvector Centrality", "The Talipot developers", "18/10/26",
+                    "Nodes measure used for links analysis.<br/>"
+                    "The eigenvector centrality of a node is proportional to the sum of the "
+                    "centralities of its neighbours, so a node is central when it is linked to "
+                    "central nodes. The centralities are the coordinates of the dominant "
+                    "eigenvector of the adjacency matrix, with a euclidean norm of 1.",
+                    "1.0", "Graph")
+
+  EigenvectorCentrality(const PluginContext *context) : DoubleAlgorithm(context) {
+    addInParameter<bool>("directed", paramHelp[0].data(), "false");
+    addInParameter<NumericProperty *>("weight", paramHelp[1].data(), "", false);
+    addInParameter<double>("tolerance", paramHelp[2].data(), "1e-9", false);
+    addInParameter<uint>("maximum iterations", paramHelp[3].data(), "1000", false);
+    addOutParameter<uint>("#iterations", "The number of iterations run");
+  }
+
+  bool run() override {
+    bool directed = false;
+    NumericProperty *weight = nullptr;
+    double tolerance = 1e-9;
+    uint maxIterations = 1000;
+
+    if (dataSet != nullptr) {
+      dataSet->get("directed", directed);
+      dataSet->get("weight", weight);
+      dataSet->get("tolerance", tolerance);
+      dataSet->get("maximum iterations", maxIterations);
+    }
+
+    LinkAnalysis linkAnalysis(graph, directed, weight);
+    vector<double> centralities;
+    uint nbIterations =
+        linkAnalysis.eigenvectorCentrality(centralities, tolerance, maxIterations, pluginProgress);
+
+    if (pluginProgress && pluginProgress->state() == ProgressState::TLP_CANCEL) {
+      return false;
+    }
+
+    TLP_MAP_NODES_AND_INDICES(
+        graph, [&](const node n, uint i) { result->setNodeValue(n, centralities[i]); });
+
+    if (dataSet != nullptr) {
+      dataSet->set("#iterations", nbIterations);
+    }
+
+    return true;
+  }
+};
+
+PLUGIN(EigenvectorCentrality)
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2023  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -11,10 +11,15 @@
  *
  */
 
+#include <atomic>
+#include <cfloat>
+#include <queue>
+
 #include <talipot/DoubleProperty.h>
 #include <talipot/StringCollection.h>
 #include <talipot/GraphMeasure.h>
 #include <talipot/PropertyAlgorithm.h>
+#include <talipot/ParallelTools.h>
 
 using namespace std;
 using namespace tlp;
@@ -50,6 +55,7 @@ using namespace tlp;
  *  - 2011 Version 2.0: Add In/Out and Weighted computation features
  *  by François Queyroi, LaBRI, University Bordeaux I, France
  *  - 2015 Performance optimization by Patrick Mary
+ *  - 2026 Bucket based and parallel peelings
  *
  *
  */
@@ -91,6 +97,196 @@ KCores::KCores(const PluginContext *context) : DoubleAlgorithm(context) {
 //========================================================================================
 KCores::~KCores() = default;
 //========================================================================================
+// under this number of nodes, the peeling is not worth being parallelized
+static const uint MIN_PARALLEL_NB_NODES = 50000;
+//========================================================================================
+// The nodes whose degree decreases when a node is removed are stored
+// in compressed sparse row format, with the weights of the corresponding edges.
+// Each peeling sets the K-Cores value of each node from its initial degree in nodeK.
+//
+// The algorithm of V. Batagelj and M. Zaversnik, for integer degrees:
+// the nodes are kept sorted by degree in buckets and are removed in that order,
+// the degree of a node being decreased by moving it to the previous bucket.
+static void bucketPeeling(const vector<uint> &start, const vector<uint> &dependents,
+                          NodeVectorProperty<double> &nodeK) {
+  uint nbNodes = nodeK.size();
+  vector<uint> deg(nbNodes);
+  uint maxDeg = 0;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    deg[i] = uint(nodeK[i]);
+    maxDeg = std::max(maxDeg, deg[i]);
+  }
+
+  vector<uint> binStart(maxDeg + 2, 0);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    ++binStart[deg[i] + 1];
+  }
+
+  for (uint d = 0; d <= maxDeg; ++d) {
+    binStart[d + 1] += binStart[d];
+  }
+
+  vector<uint> pos(nbNodes);
+  vector<uint> sorted(nbNodes);
+  vector<uint> next(binStart.begin(), binStart.end() - 1);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    pos[i] = next[deg[i]]++;
+    sorted[pos[i]] = i;
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    uint n = sorted[i];
+    uint k = deg[n];
+    nodeK[n] = k;
+
+    for (uint j = start[n]; j < start[n + 1]; ++j) {
+      uint m = dependents[j];
+      uint degM = deg[m];
+
+      if (degM > k) {
+        // swap m with the first node of its bucket, which then starts after m
+        uint firstPos = binStart[degM];
+        uint first = sorted[firstPos];
+
+        if (first != m) {
+          sorted[pos[m]] = first;
+          pos[first] = pos[m];
+          sorted[firstPos] = m;
+          pos[m] = firstPos;
+        }
+
+        ++binStart[degM];
+        --deg[m];
+      }
+    }
+  }
+}
+//========================================================================================
+// The same algorithm for large graphs, the nodes of degree at most k being removed in parallel
+// by waves, each wave only visiting the neighbours of the previous one. The nodes whose degree
+// decreases are moved to the bucket of their new degree at the end of each level,
+// the entries left in the previous buckets being skipped.
+static void parallelBucketPeeling(const vector<uint> &start, const vector<uint> &dependents,
+                                  NodeVectorProperty<double> &nodeK) {
+  uint nbNodes = nodeK.size();
+  vector<uint> deg(nbNodes);
+  uint maxDeg = 0;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    deg[i] = uint(nodeK[i]);
+    maxDeg = std::max(maxDeg, deg[i]);
+  }
+
+  vector<vector<uint>> buckets(maxDeg + 1);
+  // the degree of the last bucket in which a node has been put
+  vector<uint> bucket(deg);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    buckets[deg[i]].push_back(i);
+  }
+
+  // each chunk of a wave collects the nodes of the next one and the decreased degrees
+  uint nbChunks = TLP_NB_THREADS;
+  vector<vector<uint>> nextWaves(nbChunks);
+  vector<vector<uint>> decreased(nbChunks);
+  vector<uint> wave;
+
+  for (uint k = 0; k <= maxDeg; ++k) {
+    wave.clear();
+
+    for (uint n : buckets[k]) {
+      if (deg[n] == k) {
+        wave.push_back(n);
+      }
+    }
+
+    vector<uint>().swap(buckets[k]);
+
+    while (!wave.empty()) {
+      uint chunkSize = (wave.size() + nbChunks - 1) / nbChunks;
+
+      TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+        for (uint i = c * chunkSize; i < std::min(uint(wave.size()), (c + 1) * chunkSize); ++i) {
+          uint n = wave[i];
+          nodeK[n] = k;
+
+          for (uint j = start[n]; j < start[n + 1]; ++j) {
+            uint m = dependents[j];
+            uint degM = atomic_ref<uint>(deg[m]).fetch_sub(1, memory_order_relaxed);
+
+            // the degrees only decrease, so a single thread sees the one of m reach k
+            if (degM == k + 1) {
+              nextWaves[c].push_back(m);
+            } else if (degM > k + 1) {
+              decreased[c].push_back(m);
+            }
+          }
+        }
+      });
+
+      wave.clear();
+
+      for (auto &nextWave : nextWaves) {
+        wave.insert(wave.end(), nextWave.begin(), nextWave.end());
+        nextWave.clear();
+      }
+    }
+
+    for (auto &nodes : decreased) {
+      for (uint n : nodes) {
+        if (deg[n] > k && bucket[n] != deg[n]) {
+          bucket[n] = deg[n];
+          buckets[deg[n]].push_back(n);
+        }
+      }
+
+      nodes.clear();
+    }
+  }
+}
+//========================================================================================
+// The weighted degrees are not integers, so the node of minimum degree is found
+// in a priority queue, in which a node is pushed again each time its degree decreases,
+// its outdated entries being skipped.
+static void heapPeeling(const vector<uint> &start, const vector<uint> &dependents,
+                        const vector<double> &weights, NodeVectorProperty<double> &nodeK) {
+  uint nbNodes = nodeK.size();
+  vector<double> deg(nodeK.begin(), nodeK.end());
+  vector<bool> removed(nbNodes, false);
+  priority_queue<pair<double, uint>, vector<pair<double, uint>>, greater<>> queue;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    queue.emplace(deg[i], i);
+  }
+
+  double k = -DBL_MAX;
+
+  while (!queue.empty()) {
+    auto [d, n] = queue.top();
+    queue.pop();
+
+    if (removed[n] || d != deg[n]) {
+      continue;
+    }
+
+    removed[n] = true;
+    k = std::max(k, d);
+    nodeK[n] = k;
+
+    for (uint j = start[n]; j < start[n + 1]; ++j) {
+      uint m = dependents[j];
+
+      if (!removed[m]) {
+        deg[m] -= weights[j];
+        queue.emplace(deg[m], m);
+      }
+    }
+  }
+}
+//========================================================================================
 bool KCores::run() {
   NumericProperty *metric = nullptr;
   StringCollection degreeTypes(DEGREE_TYPES);
@@ -103,88 +299,74 @@ bool KCores::run() {
 
   auto degree_type = static_cast<EdgeType>(degreeTypes.getCurrent());
 
-  // the famous k
-  double k = DBL_MAX;
-  // use two NodeVectorProperty to hold the nodes infos
-  // because the more k increase the more nodes are "deleted"
-  NodeVectorProperty<bool> nodeDeleted(graph);
   NodeVectorProperty<double> nodeK(graph);
   degree(graph, nodeK, degree_type, metric, false);
-  const std::vector<node> &nodes = graph->nodes();
-  // the number of non deleted nodes
-  uint nbNodes = nodes.size();
-
-  for (uint i = 0; i < nbNodes; ++i) {
-    k = std::min(k, nodeK[i]);
-    nodeDeleted[i] = false;
-  }
-
-  // loop on remaining nodes
-  while (nbNodes) {
-    bool modify = true;
-    double next_k = DBL_MAX;
+  uint nbNodes = graph->numberOfNodes();
 
-    while (modify) {
-      modify = false;
+  // the removal of a node decreases the degree of its neighbours
+  // which are the targets of its out edges for In, and the sources of its in edges for Out
+  vector<uint> start(nbNodes + 1, 0);
+  vector<pair<uint, uint>> ends;
+  ends.reserve(graph->numberOfEdges());
 
-      // finally set the values
-      for (uint i = 0; i < nodes.size(); ++i) {
-        // nothing to do if the node
-        // is already deleted
-        if (nodeDeleted[i]) {
-          continue;
-        }
-
-        double &nK = nodeK[i];
-        double current_k = nK;
-        node n = nodes[i];
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+    uint srcPos = graph->nodePos(src);
+    uint tgtPos = graph->nodePos(tgt);
+    ends.emplace_back(srcPos, tgtPos);
 
-        if (current_k <= k) {
-          nK = k;
-          // decrease neighbours weighted degree
-          for (auto e : graph->incidence(n)) {
+    if (srcPos != tgtPos) {
+      if (degree_type != OUT_EDGE) {
+        ++start[srcPos + 1];
+      }
 
-            const auto &[src, tgt] = graph->ends(e);
-            node m;
+      if (degree_type != IN_EDGE) {
+        ++start[tgtPos + 1];
+      }
+    }
+  }
 
-            switch (degree_type) {
-            case IN_EDGE:
-              if ((m = tgt) == n) {
-                continue;
-              }
+  for (uint i = 0; i < nbNodes; ++i) {
+    start[i + 1] += start[i];
+  }
 
-              break;
+  vector<uint> dependents(start[nbNodes]);
+  vector<double> weights(metric ? start[nbNodes] : 0);
+  vector<uint> next(start.begin(), start.end() - 1);
+  uint i = 0;
 
-            case OUT_EDGE:
-              if ((m = src) == n) {
-                continue;
-              }
+  for (auto e : graph->edges()) {
+    const auto &[srcPos, tgtPos] = ends[i++];
 
-              break;
+    if (srcPos == tgtPos) {
+      continue;
+    }
 
-            default:
-              m = (src == n) ? tgt : src;
-            }
+    double weight = metric ? metric->getEdgeDoubleValue(e) : 1;
 
-            if (nodeDeleted[m]) {
-              continue;
-            }
+    if (degree_type != OUT_EDGE) {
+      if (metric) {
+        weights[next[srcPos]] = weight;
+      }
 
-            nodeK[m] -= metric ? metric->getEdgeDoubleValue(e) : 1;
-          }
+      dependents[next[srcPos]++] = tgtPos;
+    }
 
-          // mark node as deleted
-          nodeDeleted[i] = true;
-          --nbNodes;
-          modify = true;
-        } else if (current_k < next_k) {
-          // update next k value
-          next_k = current_k;
-        }
+    if (degree_type != IN_EDGE) {
+      if (metric) {
+        weights[next[tgtPos]] = weight;
       }
+
+      dependents[next[tgtPos]++] = srcPos;
     }
+  }
 
-    k = next_k;
+  if (metric) {
+    heapPeeling(start, dependents, weights, nodeK);
+  } else if (TLP_NB_THREADS > 1 && nbNodes >= MIN_PARALLEL_NB_NODES) {
+    parallelBucketPeeling(start, dependents, nodeK);
+  } else {
+    bucketPeeling(start, dependents, nodeK);
   }
 
   // finally set the result values
@@ -0,0 +1,312 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <atomic>
+
+#include <talipot/PluginHeaders.h>
+#include <talipot/ParallelTools.h>
+
+using namespace std;
+using namespace tlp;
+
+/** \file
+ * \brief  An implementation of the label propagation clustering algorithm
+ *
+ * This plugin is an implementation of the label propagation algorithm
+ * first published as:
+ *
+ * Raghavan, U.N. and Albert, R. and Kumara, S., \n
+ * "Near linear time algorithm to detect community structures in large-scale networks", \n
+ * "Physical Review E, 76(3):036106",\n
+ * 2007. \n
+ *
+ * Each node starts with its own label, then repeatedly takes the label carrying
+ * the largest weight among its neighbours, until few labels change. The nodes
+ * are updated in place, in parallel, over a snapshot of the graph adjacency.
+ *
+ * <b> HISTORY</b>
+ *
+ * - 2026 Version 1.0: Initial release
+ *
+ **/
+class LabelPropagation : public tlp::DoubleAlgorithm {
+public:
+  PLUGININFORMATION(
+      "Label Propagation", "The Talipot developers", "18/10/26",
+      "Nodes partitioning measure used for community detection.<br/>"
+      "Each node repeatedly takes the label carrying the largest weight among its neighbours, "
+      "the nodes sharing a label at the end forming a community. This is an implementation of the "
+      "algorithm first published as:<br/>"
+      "<b>Near linear time algorithm to detect community structures in large-scale networks</b>, "
+      "Raghavan, U.N. and Albert, R. and Kumara, S., Physical Review E, 76(3):036106 (2007).",
+      "1.0", "Clustering")
+  LabelPropagation(const tlp::PluginContext *);
+  bool run() override;
+
+private:
+  void buildAdjacency(NumericProperty *metric);
+  bool updateLabel(uint u, vector<double> &labelWeights, vector<uint> &touchedLabels);
+  double modularity() const;
+
+  // the undirected adjacency of the nodes in compressed sparse row format,
+  // without self loops and edges of non positive weight
+  vector<uint> adjStart;
+  vector<uint> adjNodes;
+  vector<double> adjWeights;
+
+  vector<uint> labels;
+  // the nodes having a neighbour whose label changed since their last update
+  vector<uint8_t> active;
+};
+
+//========================================================================================
+static constexpr std::string_view paramHelp[] = {
+    // metric
+    "An existing edge weight metric property. If it is not defined "
+    "all edges have a weight of 1.0. The edges of non positive weight are ignored.",
+
+    // maximum iterations
+    "The maximum number of passes over the nodes.",
+
+    // convergence
+    "The propagation stops when the proportion of nodes whose label changed during a pass "
+    "is lower or equal to this value. Default value is <b>0</b>."};
+//========================================================================================
+LabelPropagation::LabelPropagation(const tlp::PluginContext *context) : DoubleAlgorithm(context) {
+  addInParameter<NumericProperty *>("metric", paramHelp[0].data(), "", false);
+  addInParameter<uint>("maximum iterations", paramHelp[1].data(), "100", false);
+  addInParameter<double>("convergence", paramHelp[2].data(), "0", false);
+  addOutParameter<double>("modularity", "The modularity of the computed partition");
+  addOutParameter<uint>("#communities", "The number of communities found");
+}
+//========================================================================================
+void LabelPropagation::buildAdjacency(NumericProperty *metric) {
+  uint nbNodes = graph->numberOfNodes();
+  const vector<edge> &edges = graph->edges();
+  vector<double> weights(edges.size(), 1);
+
+  if (metric) {
+    TLP_PARALLEL_MAP_INDICES(edges.size(),
+                             [&](uint i) { weights[i] = metric->getEdgeDoubleValue(edges[i]); });
+  }
+
+  adjStart.assign(nbNodes + 1, 0);
+
+  for (uint i = 0; i < edges.size(); ++i) {
+    const auto &[src, tgt] = graph->ends(edges[i]);
+
+    if (src != tgt && weights[i] > 0) {
+      ++adjStart[graph->nodePos(src) + 1];
+      ++adjStart[graph->nodePos(tgt) + 1];
+    }
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    adjStart[i + 1] += adjStart[i];
+  }
+
+  adjNodes.resize(adjStart[nbNodes]);
+  adjWeights.resize(adjStart[nbNodes]);
+  vector<uint> next(adjStart.begin(), adjStart.end() - 1);
+
+  for (uint i = 0; i < edges.size(); ++i) {
+    const auto &[src, tgt] = graph->ends(edges[i]);
+
+    if (src != tgt && weights[i] > 0) {
+      uint srcPos = graph->nodePos(src);
+      uint tgtPos = graph->nodePos(tgt);
+      adjNodes[next[srcPos]] = tgtPos;
+      adjWeights[next[srcPos]++] = weights[i];
+      adjNodes[next[tgtPos]] = srcPos;
+      adjWeights[next[tgtPos]++] = weights[i];
+    }
+  }
+}
+//========================================================================================
+// gives to the node at position u the label of largest weight among its neighbours,
+// and returns true if its label changed.
+// The labels are counted in a dense table indexed by label, only the touched entries
+// being reset afterwards. A tie keeps the current label if it is among the best ones,
+// else the smallest label is taken.
+// As the other threads update the labels concurrently, they are read and written atomically.
+bool LabelPropagation::updateLabel(uint u, vector<double> &labelWeights,
+                                   vector<uint> &touchedLabels) {
+  atomic_ref<uint8_t>(active[u]).store(0, memory_order_relaxed);
+
+  if (adjStart[u] == adjStart[u + 1]) {
+    return false;
+  }
+
+  for (uint i = adjStart[u]; i < adjStart[u + 1]; ++i) {
+    uint label = atomic_ref<uint>(labels[adjNodes[i]]).load(memory_order_relaxed);
+
+    if (labelWeights[label] == 0) {
+      touchedLabels.push_back(label);
+    }
+
+    labelWeights[label] += adjWeights[i];
+  }
+
+  uint current = atomic_ref<uint>(labels[u]).load(memory_order_relaxed);
+  uint bestLabel = current;
+  double bestWeight = labelWeights[current];
+
+  for (auto label : touchedLabels) {
+    double weight = labelWeights[label];
+
+    if (weight > bestWeight || (weight == bestWeight && bestLabel != current && label < bestLabel)) {
+      bestLabel = label;
+      bestWeight = weight;
+    }
+
+    labelWeights[label] = 0;
+  }
+
+  touchedLabels.clear();
+
+  if (bestLabel == current) {
+    return false;
+  }
+
+  atomic_ref<uint>(labels[u]).store(bestLabel, memory_order_relaxed);
+
+  for (uint i = adjStart[u]; i < adjStart[u + 1]; ++i) {
+    atomic_ref<uint8_t>(active[adjNodes[i]]).store(1, memory_order_relaxed);
+  }
+
+  return true;
+}
+//========================================================================================
+double LabelPropagation::modularity() const {
+  uint nbNodes = labels.size();
+  // the weight of the edges inside each community and the total degree of each community
+  vector<double> inner(nbNodes, 0), total(nbNodes, 0);
+  double totalWeight = 0;
+
+  for (uint u = 0; u < nbNodes; ++u) {
+    for (uint i = adjStart[u]; i < adjStart[u + 1]; ++i) {
+      total[labels[u]] += adjWeights[i];
+      totalWeight += adjWeights[i];
+
+      if (labels[u] == labels[adjNodes[i]]) {
+        inner[labels[u]] += adjWeights[i];
+      }
+    }
+  }
+
+  if (totalWeight == 0) {
+    return 0;
+  }
+
+  double q = 0;
+
+  for (uint c = 0; c < nbNodes; ++c) {
+    q += inner[c] / totalWeight - (total[c] / totalWeight) * (total[c] / totalWeight);
+  }
+
+  return q;
+}
+//========================================================================================
+bool LabelPropagation::run() {
+  NumericProperty *metric = nullptr;
+  uint maxIterations = 100;
+  double convergence = 0;
+
+  if (dataSet != nullptr) {
+    dataSet->get("metric", metric);
+    dataSet->get("maximum iterations", maxIterations);
+    dataSet->get("convergence", convergence);
+  }
+
+  uint nbNodes = graph->numberOfNodes();
+  buildAdjacency(metric);
+
+  // initialize a random sequence according the given seed:
+  // the initial labels, which also break the ties, and the order
+  // of the updates are random permutations of the nodes
+  tlp::initRandomSequence();
+  labels.resize(nbNodes);
+  vector<uint> order(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    labels[i] = order[i] = i;
+  }
+
+  shuffle(labels.begin(), labels.end(), getRandomNumberGenerator());
+  shuffle(order.begin(), order.end(), getRandomNumberGenerator());
+  active.assign(nbNodes, 1);
+
+  // the dense label tables of each thread, allocated by their first update
+  vector<vector<double>> labelWeights(TLP_NB_THREADS);
+  vector<vector<uint>> touchedLabels(TLP_NB_THREADS);
+  bool cancelled = false;
+
+  for (uint iteration = 0; iteration < maxIterations; ++iteration) {
+    atomic_uint nbChanges = 0;
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      uint u = order[i];
+
+      if (!atomic_ref<uint8_t>(active[u]).load(memory_order_relaxed)) {
+        return;
+      }
+
+      uint threadNumber = ThreadManager::getThreadNumber();
+
+      if (labelWeights[threadNumber].empty()) {
+        labelWeights[threadNumber].resize(nbNodes, 0);
+      }
+
+      if (updateLabel(u, labelWeights[threadNumber], touchedLabels[threadNumber])) {
+        nbChanges.fetch_add(1, memory_order_relaxed);
+      }
+    });
+
+    if (nbChanges.load() <= convergence * nbNodes) {
+      break;
+    }
+
+    if (pluginProgress &&
+        pluginProgress->progress(iteration + 1, maxIterations) != ProgressState::TLP_CONTINUE) {
+      cancelled = pluginProgress->state() == ProgressState::TLP_CANCEL;
+      break;
+    }
+  }
+
+  if (cancelled) {
+    return false;
+  }
+
+  // renumber the communities in the order of the nodes
+  vector<int> renumber(nbNodes, -1);
+  int nbCommunities = 0;
+
+  for (auto label : labels) {
+    if (renumber[label] == -1) {
+      renumber[label] = nbCommunities++;
+    }
+  }
+
+  TLP_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) {
+    result->setNodeValue(n, renumber[labels[i]]);
+  });
+
+  if (dataSet != nullptr) {
+    dataSet->set("modularity", modularity());
+    dataSet->set("#communities", uint(nbCommunities));
+  }
+
+  return true;
+}
+//========================================================================================
+PLUGIN(LabelPropagation)
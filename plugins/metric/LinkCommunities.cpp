@@ -13,6 +13,7 @@
 
 #include <talipot/DoubleProperty.h>
 #include <talipot/PropertyAlgorithm.h>
+#include <talipot/UnionFind.h>
 #include <talipot/VectorProperty.h>
 
 using namespace std;
@@ -45,7 +46,7 @@ public:
       "It is an implementation of a fuzzy clustering procedure. First introduced in :<br>"
       " <b>Link communities reveal multiscale complexity in networks</b>, Ahn, Y.Y. and Bagrow, "
       "J.P. and Lehmann, S., Nature vol:466, 761--764 (2010)",
-      "1.0", "Clustering")
+      "1.1", "Clustering")
 
   LinkCommunities(const tlp::PluginContext *);
   ~LinkCommunities() override;
@@ -53,45 +54,61 @@ public:
 
 private:
   /**
-   * @brief Create the dual of the graph
-   * in order to store Similarity value between two edges
-   * Edges are represented by nodes linked according to edges' neighborhood.
+   * @brief A neighbour of a node, and the edges linking them
    **/
-  void createDualGraph(const std::vector<edge> &edges);
+  struct Neighbour {
+    uint pos;
+    // a self loop counts twice
+    uint nbEdges;
+    // the first edges to the neighbour, from the neighbour and in any direction
+    edge outEdge, inEdge, firstEdge;
+    // the sum of the weights of the edges
+    double weight;
+  };
+
   /**
-   * @brief Compute all similarities between all pairs of adjacent edges.
+   * @brief Store the neighbours of each node sorted by position
+   * in compressed sparse row format
    **/
-  void computeSimilarities(const std::vector<edge> &edges);
+  void buildNeighbourhoods();
   /**
-   * @brief Compute similarity (Jaccard) between graph->edges()[source(e).id] and
-   *graph->edges()[target(e).id]
+   * @brief Compute the similarities between all pairs of edges with a common end,
+   * the keystone, the pairs of edges of each keystone being processed in parallel.
    **/
-  double getSimilarity(tlp::edge e, const std::vector<edge> &edges);
+  void computeSimilarities();
   /**
-   * @brief Compute weighted (Tanimoto) similarity between graph->edges()[source(e).id] and
-   *graph->edges()[target(e).id]
+   * @brief Compute similarity (Jaccard) between the ends n1 and n2 of two edges
+   * other than their keystone, the neighbours of n1 being indexed in neighbourIndex
    **/
-  double getWeightedSimilarity(tlp::edge e, const std::vector<edge> &edges);
+  double getSimilarity(uint n1, uint n2, const std::vector<uint> &neighbourIndex) const;
   /**
-   * @brief Perform #(step) single linkage clustering in order to find the partition
-   * which maximise the average density
+   * @brief Compute weighted (Tanimoto) similarity between the ends n1 and n2 of two edges
+   * other than their keystone, the neighbours of n1 being indexed in neighbourIndex
    **/
-  double findBestThreshold(uint, const std::vector<edge> &edges);
+  double getWeightedSimilarity(uint n1, uint n2, const std::vector<uint> &neighbourIndex) const;
   /**
-   * @brief Compute the partition of dual node for the given threshold value
-   * and return average density of this edge partition
+   * @brief Perform #(step) single linkage clustering in order to find the partition
+   * which maximise the average density, in a single sweep of the pairs of edges
+   * from the most similar to the least similar.
+   * The pairs are sorted by similarity, and the position of the first pair whose edges
+   * are in the same group for the best threshold is returned
    **/
-  double computeAverageDensity(double, const std::vector<edge> &edges);
+  uint64_t findBestThreshold(uint numberOfSteps);
   /**
    * @brief set edge values according the partition corresponding
-   * to the best threshold
+   * to the best threshold, the pairs from the given position being grouped
    **/
-  void setEdgeValues(double, bool, const std::vector<edge> &edges);
-
-  std::unique_ptr<tlp::Graph> dual; // Dual Node -> Graph Edges; Dual Edge -> indicates that the
-                                    // linked Graph Edges have a same end.
-  tlp::EdgeVectorProperty<tlp::node> mapKeystone;
-  tlp::EdgeVectorProperty<double> similarity;
+  void setEdgeValues(uint64_t, bool, tlp::EdgeVectorProperty<double> &);
+
+  // the ends of the edges, by position
+  std::vector<std::pair<uint, uint>> ends;
+  std::vector<uint> neighboursStart;
+  std::vector<Neighbour> neighbours;
+  // the sum of the squared weights of the edges of each node, a self loop counting twice
+  std::vector<double> squaredWeights;
+  // the pairs of edges with a common end, the last edge of a pair having the greater position
+  std::vector<std::pair<uint, uint>> edgePairs;
+  std::vector<double> similarity;
 
   tlp::NumericProperty *metric;
 };
@@ -108,7 +125,7 @@ static constexpr std::string_view paramHelp[] = {
     "This parameter indicates the number of thresholds to be compared."};
 //==============================================================================================================
 LinkCommunities::LinkCommunities(const tlp::PluginContext *context)
-    : DoubleAlgorithm(context), dual(tlp::newGraph()), metric(nullptr) {
+    : DoubleAlgorithm(context), metric(nullptr) {
   addInParameter<NumericProperty *>("metric", paramHelp[0].data(), "", false);
   addInParameter<bool>("Group isthmus", paramHelp[1].data(), "true", true);
   addInParameter<uint>("Number of steps", paramHelp[2].data(), "200", true);
@@ -127,112 +144,242 @@ bool LinkCommunities::run() {
     dataSet->get("Number of steps", nb_steps);
   }
 
-  const std::vector<edge> &edges = graph->edges();
-  createDualGraph(edges);
-
-  computeSimilarities(edges);
-
   result->setAllNodeValue(0);
   result->setAllEdgeValue(0);
-  double th = findBestThreshold(nb_steps, edges);
 
-  setEdgeValues(th, group_isthmus, edges);
+  if (graph->isEmpty() || graph->numberOfEdges() == 0) {
+    return true;
+  }
+
+  buildNeighbourhoods();
+  computeSimilarities();
+
+  uint64_t firstGroupedPair = findBestThreshold(nb_steps);
 
-  dual->clear();
+  EdgeVectorProperty<double> edgeValues(graph);
+  setEdgeValues(firstGroupedPair, group_isthmus, edgeValues);
+
+  ends.clear();
+  neighboursStart.clear();
+  neighbours.clear();
+  squaredWeights.clear();
+  edgePairs.clear();
   similarity.clear();
 
-  for (auto n : graph->nodes()) {
-    std::set<double> around;
+  // the value of a node is the number of groups of its edges
+  NodeVectorProperty<double> nodeValues(graph);
+  TLP_PARALLEL_MAP_NODES(graph, [&](node n) {
+    vector<double> around;
+
     for (auto e : graph->incidence(n)) {
-      double val = (*result)[e];
+      double val = edgeValues[e];
 
       if (val) {
-        around.insert(val);
+        around.push_back(val);
       }
     }
-    (*result)[n] = around.size();
-  }
+
+    std::sort(around.begin(), around.end());
+    nodeValues[n] = std::unique(around.begin(), around.end()) - around.begin();
+  });
+
+  edgeValues.copyToProperty(result);
+  nodeValues.copyToProperty(result);
 
   return true;
 }
 //==============================================================================================================
-void LinkCommunities::createDualGraph(const std::vector<edge> &edges) {
+void LinkCommunities::buildNeighbourhoods() {
+  const vector<edge> &edges = graph->edges();
+  uint nbNodes = graph->numberOfNodes();
   uint nbEdges = edges.size();
-  dual->reserveNodes(nbEdges);
-  similarity.alloc(dual.get(), nbEdges);
-  mapKeystone.alloc(dual.get(), nbEdges);
+  ends.resize(nbEdges);
 
-  for (uint i = 0; i < nbEdges; ++i) {
-    node dn = dual->addNode();
+  TLP_PARALLEL_MAP_INDICES(nbEdges, [&](uint i) {
     const auto &[src, tgt] = graph->ends(edges[i]);
+    ends[i] = {graph->nodePos(src), graph->nodePos(tgt)};
+  });
 
-    for (auto ee : graph->incidence(src)) {
-      uint eePos = graph->edgePos(ee);
+  // a node has at most as many neighbours as incident edges
+  neighboursStart.resize(nbNodes + 1);
+  neighboursStart[0] = 0;
 
-      if (eePos < i) {
-        if (!dual->existEdge(dn, node(eePos), false).isValid()) {
-          edge de = dual->addEdge(dn, node(eePos));
-          mapKeystone[de] = src;
-        }
-      }
+  for (uint i = 0; i < nbNodes; ++i) {
+    neighboursStart[i + 1] = neighboursStart[i] + graph->deg(graph->nodes()[i]);
+  }
+
+  neighbours.resize(neighboursStart[nbNodes]);
+  squaredWeights.assign(nbNodes, 0);
+  vector<uint> nbNeighbours(nbNodes);
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    node n = graph->nodes()[i];
+    // the incident edges of the node, in their order of incidence, sorted by opposite node
+    vector<pair<uint, edge>> incidence;
+
+    for (auto e : graph->incidence(n)) {
+      incidence.emplace_back(graph->nodePos(graph->opposite(e, n)), e);
     }
-    for (auto ee : graph->incidence(tgt)) {
-      uint eePos = graph->edgePos(ee);
 
-      if (eePos < i) {
-        if (!dual->existEdge(dn, node(eePos), false).isValid()) {
-          edge de = dual->addEdge(dn, node(eePos));
-          mapKeystone[de] = tgt;
-        }
+    std::stable_sort(incidence.begin(), incidence.end(),
+                     [](const auto &p1, const auto &p2) { return p1.first < p2.first; });
+    uint nb = 0;
+
+    for (const auto &[opp, e] : incidence) {
+      if (nb == 0 || neighbours[neighboursStart[i] + nb - 1].pos != opp) {
+        neighbours[neighboursStart[i] + nb++] = {opp, 0, edge(), edge(), e, 0.0};
+      }
+
+      Neighbour *neighbour = &neighbours[neighboursStart[i] + nb - 1];
+
+      double weight = metric ? metric->getEdgeDoubleValue(e) : 1.0;
+      ++neighbour->nbEdges;
+      neighbour->weight += weight;
+      squaredWeights[i] += weight * weight;
+
+      if (graph->source(e) == n && !neighbour->outEdge.isValid()) {
+        neighbour->outEdge = e;
+      }
+
+      if (graph->target(e) == n && !neighbour->inEdge.isValid()) {
+        neighbour->inEdge = e;
       }
     }
+
+    nbNeighbours[i] = nb;
+  });
+
+  // remove the unused space
+  uint nbUsed = 0;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    uint first = neighboursStart[i];
+    neighboursStart[i] = nbUsed;
+    std::move(neighbours.begin() + first, neighbours.begin() + first + nbNeighbours[i],
+              neighbours.begin() + nbUsed);
+    nbUsed += nbNeighbours[i];
   }
+
+  neighboursStart[nbNodes] = nbUsed;
+  neighbours.resize(nbUsed);
 }
 //==============================================================================================================
-void LinkCommunities::computeSimilarities(const std::vector<edge> &edges) {
-  similarity.resize(dual->numberOfEdges());
-  if (metric == nullptr) {
-    TLP_PARALLEL_MAP_INDICES(dual->numberOfEdges(), [&](uint i) {
-      edge e = edge(i);
-      similarity[e] = getSimilarity(e, edges);
-    });
-  } else {
-    TLP_PARALLEL_MAP_INDICES(dual->numberOfEdges(), [&](uint i) {
-      edge e = edge(i);
-      similarity[e] = getWeightedSimilarity(e, edges);
-    });
+void LinkCommunities::computeSimilarities() {
+  uint nbNodes = graph->numberOfNodes();
+  uint nbEdges = ends.size();
+
+  // the distinct incident edges of each node, a self loop being incident once
+  vector<uint> incidentStart(nbNodes + 1, 0);
+
+  for (const auto &[src, tgt] : ends) {
+    ++incidentStart[src + 1];
+
+    if (src != tgt) {
+      ++incidentStart[tgt + 1];
+    }
   }
-}
-//==============================================================================================================
-double LinkCommunities::getSimilarity(edge ee, const std::vector<edge> &edges) {
-  node key = mapKeystone[ee];
-  auto [eeSrc, eeTgt] = dual->ends(ee);
-  edge e1 = edges[eeSrc.id];
-  edge e2 = edges[eeTgt.id];
-  const auto &[e1Src, e1Tgt] = graph->ends(e1);
-  node n1 = (e1Src != key) ? e1Src : e1Tgt;
-  const auto &[e2Src, e2Tgt] = graph->ends(e2);
-  node n2 = (e2Src != key) ? e2Src : e2Tgt;
-  uint wuv = 0, m = 0;
-  for (auto n : graph->getInOutNodes(n1)) {
-    if (graph->existEdge(n2, n, true).isValid()) {
-      wuv += 1;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    incidentStart[i + 1] += incidentStart[i];
+  }
+
+  vector<uint> incident(incidentStart[nbNodes]);
+  vector<uint> next(incidentStart.begin(), incidentStart.end() - 1);
+
+  for (uint i = 0; i < nbEdges; ++i) {
+    const auto &[src, tgt] = ends[i];
+    incident[next[src]++] = i;
+
+    if (src != tgt) {
+      incident[next[tgt]++] = i;
     }
+  }
 
-    if (graph->existEdge(n, n2, true).isValid()) {
-      wuv += 1;
+  // two edges i > j with two common ends are only paired once,
+  // the keystone being the source of i
+  auto isPaired = [&](uint key, uint i, uint j) {
+    uint srcI = ends[i].first;
+    return srcI == key || (ends[j].first != srcI && ends[j].second != srcI);
+  };
+
+  // count the pairs of each keystone in order to store them in parallel
+  vector<uint64_t> pairsStart(nbNodes + 1, 0);
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint key) {
+    uint64_t nbPairs = 0;
+
+    for (uint k1 = incidentStart[key]; k1 < incidentStart[key + 1]; ++k1) {
+      for (uint k2 = incidentStart[key]; k2 < k1; ++k2) {
+        if (isPaired(key, incident[k1], incident[k2])) {
+          ++nbPairs;
+        }
+      }
     }
 
-    m += 1.0;
+    pairsStart[key + 1] = nbPairs;
+  });
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    pairsStart[i + 1] += pairsStart[i];
   }
 
-  for (auto n : graph->getInOutNodes(n2)) {
-    if (!graph->existEdge(n1, n, false).isValid()) {
-      m += 1;
+  edgePairs.resize(pairsStart[nbNodes]);
+  similarity.resize(pairsStart[nbNodes]);
+  // the index of each neighbour of the end of the current edge, reused by each thread
+  vector<vector<uint>> neighbourIndices(TLP_NB_THREADS);
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint key) {
+    vector<uint> &neighbourIndex = neighbourIndices[ThreadManager::getThreadNumber()];
+
+    if (neighbourIndex.empty()) {
+      neighbourIndex.assign(nbNodes, UINT_MAX);
+    }
+
+    uint64_t pairPos = pairsStart[key];
+
+    for (uint k1 = incidentStart[key]; k1 < incidentStart[key + 1]; ++k1) {
+      uint i = incident[k1];
+      uint n1 = ends[i].first != key ? ends[i].first : ends[i].second;
+
+      for (uint k = neighboursStart[n1]; k < neighboursStart[n1 + 1]; ++k) {
+        neighbourIndex[neighbours[k].pos] = k;
+      }
+
+      // edges of smaller positions come first in the incident edges
+      for (uint k2 = incidentStart[key]; k2 < k1; ++k2) {
+        uint j = incident[k2];
+
+        if (isPaired(key, i, j)) {
+          uint n2 = ends[j].first != key ? ends[j].first : ends[j].second;
+          edgePairs[pairPos] = {i, j};
+          similarity[pairPos++] = metric ? getWeightedSimilarity(n1, n2, neighbourIndex)
+                                         : getSimilarity(n1, n2, neighbourIndex);
+        }
+      }
+
+      for (uint k = neighboursStart[n1]; k < neighboursStart[n1 + 1]; ++k) {
+        neighbourIndex[neighbours[k].pos] = UINT_MAX;
+      }
+    }
+  });
+}
+//==============================================================================================================
+double LinkCommunities::getSimilarity(uint n1, uint n2, const vector<uint> &neighbourIndex) const {
+  uint wuv = 0, m = graph->deg(graph->nodes()[n1]);
+
+  for (uint k = neighboursStart[n2]; k < neighboursStart[n2 + 1]; ++k) {
+    const Neighbour &neighbour = neighbours[k];
+    uint index = neighbourIndex[neighbour.pos];
+
+    if (index != UINT_MAX) {
+      wuv += neighbours[index].nbEdges *
+             (uint(neighbour.outEdge.isValid()) + uint(neighbour.inEdge.isValid()));
+    } else {
+      m += neighbour.nbEdges;
     }
   }
 
-  if (graph->existEdge(n1, n2, false).isValid()) {
+  if (neighbourIndex[n2] != UINT_MAX) {
     wuv += 2;
   }
 
@@ -243,74 +390,53 @@ double LinkCommunities::getSimilarity(edge ee, const std::vector<edge> &edges) {
   }
 }
 //==============================================================================================================
-double LinkCommunities::getWeightedSimilarity(tlp::edge ee, const std::vector<edge> &edges) {
-  node key = mapKeystone[ee];
-  auto [eeSrc, eeTgt] = dual->ends(ee);
-  edge e1 = edges[eeSrc.id];
-  edge e2 = edges[eeTgt.id];
-  const auto &[e1Src, e1Tgt] = graph->ends(e1);
-  node n1 = (e1Src != key) ? e1Src : e1Tgt;
-  const auto &[e2Src, e2Tgt] = graph->ends(e2);
-  node n2 = (e2Src != key) ? e2Src : e2Tgt;
-
-  if (graph->deg(n1) > graph->deg(n2)) {
-    node tmp = n1;
-    n1 = n2;
-    n2 = tmp;
+double LinkCommunities::getWeightedSimilarity(uint n1, uint n2,
+                                              const vector<uint> &neighbourIndex) const {
+  // n1 is the end of lowest degree, the neighbours of the end indexed in neighbourIndex
+  // being iterated through those of the other end
+  uint indexed = n1;
+  uint deg1 = graph->deg(graph->nodes()[n1]);
+  uint deg2 = graph->deg(graph->nodes()[n2]);
+
+  if (deg1 > deg2) {
+    std::swap(n1, n2);
+    std::swap(deg1, deg2);
   }
 
+  auto weight = [&](edge e) { return e.isValid() ? metric->getEdgeDoubleValue(e) : 0.0; };
+
   double a1a2 = 0.0;
   double a1 = 0.0, a2 = 0.0;
-  double a11 = 0.0, a22 = 0.0;
-  for (auto e : graph->getInEdges(n1)) {
-    double val = metric->getEdgeDoubleValue(e);
-    node n = graph->source(e);
-    edge me = graph->existEdge(n2, n, true);
-
-    if (me.isValid()) {
-      a1a2 += val * metric->getEdgeDoubleValue(me);
-    }
 
-    me = graph->existEdge(n, n2, true);
-
-    if (me.isValid()) {
-      a1a2 += val * metric->getEdgeDoubleValue(me);
-    }
-
-    a1 += val;
-    a11 += val * val;
+  for (uint k = neighboursStart[n1]; k < neighboursStart[n1 + 1]; ++k) {
+    a1 += neighbours[k].weight;
   }
 
-  for (auto e : graph->getOutEdges(n1)) {
-    double val = metric->getEdgeDoubleValue(e);
-    node n = graph->target(e);
-    edge me = graph->existEdge(n2, n, true);
+  for (uint k = neighboursStart[n2]; k < neighboursStart[n2 + 1]; ++k) {
+    a2 += neighbours[k].weight;
+  }
 
-    if (me.isValid()) {
-      a1a2 += val * metric->getEdgeDoubleValue(me);
-    }
+  uint other = indexed == n1 ? n2 : n1;
+  edge e;
 
-    me = graph->existEdge(n, n2, true);
+  for (uint k = neighboursStart[other]; k < neighboursStart[other + 1]; ++k) {
+    uint index = neighbourIndex[neighbours[k].pos];
 
-    if (me.isValid()) {
-      a1a2 += val * metric->getEdgeDoubleValue(me);
+    if (index != UINT_MAX) {
+      const Neighbour &neighbour1 = other == n1 ? neighbours[k] : neighbours[index];
+      const Neighbour &neighbour2 = other == n1 ? neighbours[index] : neighbours[k];
+      a1a2 += neighbour1.weight * (weight(neighbour2.outEdge) + weight(neighbour2.inEdge));
     }
-
-    a1 += val;
-    a11 += val * val;
   }
 
-  for (auto e : graph->incidence(n2)) {
-    double val = metric->getEdgeDoubleValue(e);
-    a2 += val;
-    a22 += val * val;
+  if (uint index = neighbourIndex[other]; index != UINT_MAX) {
+    e = neighbours[index].firstEdge;
   }
-  a1 /= graph->deg(n1);
-  a11 += a1 * a1;
-  a2 /= graph->deg(n2);
-  a22 += a2 * a2;
 
-  edge e = graph->existEdge(n1, n2, false);
+  a1 /= deg1;
+  double a11 = squaredWeights[n1] + a1 * a1;
+  a2 /= deg2;
+  double a22 = squaredWeights[n2] + a2 * a2;
 
   if (e.isValid()) {
     a1a2 += metric->getEdgeDoubleValue(e) * (a1 + a2);
@@ -325,158 +451,175 @@ double LinkCommunities::getWeightedSimilarity(tlp::edge ee, const std::vector<ed
   }
 }
 //==============================================================================================================
+void LinkCommunities::setEdgeValues(uint64_t firstGroupedPair, bool group_isthmus,
+                                    EdgeVectorProperty<double> &edgeValues) {
+  uint nbEdges = ends.size();
+  UnionFind groups(nbEdges);
 
-double LinkCommunities::computeAverageDensity(double threshold, const std::vector<edge> &edges) {
-  double d = 0.0;
-  NodeVectorProperty<bool> dn_visited(dual.get());
-  dn_visited.setAll(false);
-
-  uint sz = dual->numberOfNodes();
-
-  for (uint i = 0; i < sz; ++i) {
-    node dn = node(i);
+  for (uint64_t i = firstGroupedPair; i < edgePairs.size(); ++i) {
+    groups.merge(edgePairs[i].first, edgePairs[i].second);
+  }
 
-    if (!dn_visited[dn]) {
-      uint nbDNodes = 1;
-      dn_visited[dn] = true;
-      edge re = edges[dn.id];
-      MutableContainer<bool> visited;
-      uint nbNodes = 1;
-      const auto &[reSrc, reTgt] = graph->ends(re);
-      visited.set(reSrc.id, true);
+  // the groups are numbered in the order of their first edge
+  vector<double> groupValues(nbEdges, 0);
+  double val = 1;
 
-      if (reSrc != reTgt) {
-        visited.set(reTgt.id, true);
-        nbNodes = 2;
-      }
+  for (uint i = 0; i < nbEdges; ++i) {
+    uint group = groups.find(i);
 
-      list<node> dnToVisit;
-      dnToVisit.push_front(dn);
-
-      while (!dnToVisit.empty()) {
-        dn = dnToVisit.front();
-        dnToVisit.pop_front();
-
-        for (auto e : dual->incidence(dn)) {
-          if (similarity[e] > threshold) {
-            node neighbour = dual->opposite(e, dn);
-
-            if (!dn_visited[neighbour]) {
-              dn_visited[neighbour] = true;
-              dnToVisit.push_back(neighbour);
-              ++nbDNodes;
-              edge re = edges[neighbour.id];
-              const auto &[reSrc, reTgt] = graph->ends(re);
-
-              if (!visited.get(reSrc.id)) {
-                visited.set(reSrc.id, true);
-                ++nbNodes;
-              }
-
-              if (!visited.get(reTgt.id)) {
-                visited.set(reTgt.id, true);
-                ++nbNodes;
-              }
-            }
-          }
-        }
-      }
+    if (groupValues[group] == 0) {
+      groupValues[group] = val;
+      val += 1;
+    }
 
-      if (nbNodes >= 3) {
-        double mc = nbDNodes;
-        double nc = nbNodes;
-        double density = (mc - nc + 1) / (nc * (nc - 1) / 2.0 - nc + 1);
-        d += nbDNodes * density;
-      }
+    if (groups.setSize(group) >= 2 || !group_isthmus) {
+      edgeValues[i] = groupValues[group];
+    } else {
+      edgeValues[i] = 0;
     }
   }
+}
+//==============================================================================================================
+// the contribution of a group of edges to the partition density
+static double groupDensity(double mc, double nc) {
+  if (nc >= 3) {
+    double density = (mc - nc + 1) / (nc * (nc - 1) / 2.0 - nc + 1);
+    return mc * density;
+  }
 
-  return 2.0 * d / (graph->numberOfEdges());
+  return 0;
 }
 //==============================================================================================================
-void LinkCommunities::setEdgeValues(double threshold, bool group_isthmus,
-                                    const std::vector<edge> &edges) {
-  NodeVectorProperty<bool> dn_visited(dual.get());
-  dn_visited.setAll(false);
+uint64_t LinkCommunities::findBestThreshold(uint numberOfSteps) {
+  double min = 1.1;
+  double max = -1.0;
 
-  double val = 1;
-  uint sz = dual->numberOfNodes();
+  for (double value : similarity) {
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
 
-  for (uint i = 0; i < sz; ++i) {
-    node dn = node(i);
+  double deltaThreshold = numberOfSteps ? (max - min) / double(numberOfSteps) : 0;
 
-    if (!dn_visited[dn]) {
-      dn_visited[dn] = true;
-      vector<node> component;
-      component.push_back(dn);
+  // a pair of edges is in the same group for the thresholds lower than its similarity,
+  // so the pairs are sorted by number of such thresholds, the ones in no groups excepted.
+  // Without steps, the single threshold is 0
+  auto nbLowerThresholds = [&](double value) {
+    if (numberOfSteps == 0) {
+      return uint(value > 0);
+    }
 
-      list<node> dnToVisit;
-      dnToVisit.push_front(dn);
+    uint nb = 0;
 
-      while (!dnToVisit.empty()) {
-        dn = dnToVisit.front();
-        dnToVisit.pop_front();
+    if (deltaThreshold > 0) {
+      nb = std::clamp((value - min) / deltaThreshold, 0.0, double(numberOfSteps));
+    }
 
-        for (auto e : dual->incidence(dn)) {
+    while (nb > 0 && !(min + (nb - 1) * deltaThreshold < value)) {
+      --nb;
+    }
 
-          if (similarity[e] > threshold) {
-            node neighbour = dual->opposite(e, dn);
+    while (nb < numberOfSteps && min + nb * deltaThreshold < value) {
+      ++nb;
+    }
 
-            if (!dn_visited[neighbour]) {
-              dn_visited[neighbour] = true;
-              dnToVisit.push_back(neighbour);
-              component.push_back(neighbour);
-            }
-          }
-        }
-      }
+    return nb;
+  };
 
-      if (component.size() >= 2 || !group_isthmus) {
-        for (auto n : component) {
-          edge re = edges[n.id];
-          (*result)[re] = val;
-        }
-      }
+  // the similarities are replaced by their numbers of lower thresholds,
+  // in order to sort them in place with their pairs
+  TLP_PARALLEL_MAP_INDICES(similarity.size(),
+                           [&](size_t i) { similarity[i] = nbLowerThresholds(similarity[i]); });
+  const vector<double> &nbThresholds = similarity;
 
-      val += 1;
+  uint nbBuckets = std::max(numberOfSteps, 1u) + 1;
+  vector<uint64_t> stepStart(nbBuckets + 1, 0);
+
+  for (double nb : nbThresholds) {
+    ++stepStart[uint(nb) + 1];
+  }
+
+  for (uint i = 0; i < nbBuckets; ++i) {
+    stepStart[i + 1] += stepStart[i];
+  }
+
+  // each pair is swapped to the next free position of its bucket,
+  // until the current position of the bucket holds one of its own pairs
+  vector<uint64_t> next(stepStart.begin(), stepStart.end() - 1);
+
+  for (uint step = 0; step < nbBuckets; ++step) {
+    while (next[step] < stepStart[step + 1]) {
+      uint64_t k = next[step];
+      uint nb = uint(nbThresholds[k]);
+
+      if (nb != step) {
+        std::swap(edgePairs[k], edgePairs[next[nb]]);
+        std::swap(similarity[k], similarity[next[nb]]);
+        ++next[nb];
+      } else {
+        ++next[step];
+      }
     }
   }
-}
-//==============================================================================================================
-double LinkCommunities::findBestThreshold(uint numberOfSteps, const std::vector<edge> &edges) {
-  double maxD = -2;
-  double threshold = 0.0;
 
-  double min = 1.1;
-  double max = -1.0;
+  vector<double>().swap(similarity);
 
-  uint sz = dual->numberOfEdges();
+  if (numberOfSteps == 0) {
+    return stepStart[1];
+  }
 
-  for (uint i = 0; i < sz; ++i) {
-    double value = similarity[edge(i)];
+  // the groups are merged from the highest threshold to the lowest one,
+  // each group keeping its number of edges and its set of nodes
+  uint nbEdges = ends.size();
+  UnionFind groups(nbEdges);
+  vector<uint> groupNbEdges(nbEdges, 1);
+  vector<flat_hash_set<uint>> groupNodes(nbEdges);
 
-    if (value < min) {
-      min = value;
-    } else if (value > max) {
-      max = value;
-    }
+  for (uint i = 0; i < nbEdges; ++i) {
+    groupNodes[i].insert(ends[i].first);
+    groupNodes[i].insert(ends[i].second);
   }
 
-  double deltaThreshold = (max - min) / double(numberOfSteps);
+  long double d = 0.0;
+  double maxD = -2;
+  uint bestStep = 0;
+
+  for (uint step = numberOfSteps; step-- > 0;) {
+    for (uint64_t k = stepStart[step + 1]; k < stepStart[step + 2]; ++k) {
+      const auto &[i, j] = edgePairs[k];
+      uint group1 = groups.find(i);
+      uint group2 = groups.find(j);
+
+      if (group1 == group2) {
+        continue;
+      }
+
+      d -= groupDensity(groupNbEdges[group1], groupNodes[group1].size());
+      d -= groupDensity(groupNbEdges[group2], groupNodes[group2].size());
+      uint group = groups.merge(group1, group2);
+      uint merged = group == group1 ? group2 : group1;
 
-  TLP_PARALLEL_MAP_INDICES(numberOfSteps, [&](uint i) {
-    double step = min + i * deltaThreshold;
-    double d = computeAverageDensity(step, edges);
-    TLP_LOCK_SECTION(findBestThreshold) {
-      if (d > maxD) {
-        threshold = step;
-        maxD = d;
+      // insert the smallest set of nodes into the largest
+      if (groupNodes[group].size() < groupNodes[merged].size()) {
+        groupNodes[group].swap(groupNodes[merged]);
       }
+
+      groupNodes[group].insert(groupNodes[merged].begin(), groupNodes[merged].end());
+      flat_hash_set<uint>().swap(groupNodes[merged]);
+      groupNbEdges[group] += groupNbEdges[merged];
+      d += groupDensity(groupNbEdges[group], groupNodes[group].size());
     }
-    TLP_UNLOCK_SECTION(findBestThreshold);
-  });
 
-  return threshold;
+    // the lowest threshold is kept in case of equality
+    double density = 2.0 * double(d) / nbEdges;
+
+    if (density >= maxD) {
+      maxD = density;
+      bestStep = step;
+    }
+  }
+
+  return stepStart[bestStep + 1];
 }
 //==============================================================================================================
 PLUGIN(LinkCommunities)
@@ -11,6 +11,7 @@
  *
  */
 
+#include <talipot/LinkAnalysis.h>
 #include <talipot/PluginHeaders.h>
 
 using namespace std;
@@ -24,7 +25,19 @@ static constexpr std::string_view paramHelp[] = {
     "Indicates if the graph should be considered as directed or not.",
 
     // weight
-    "An existing edge weight metric property."};
+    "An existing edge weight metric property.",
+
+    // personalization
+    "An existing node metric property giving the probabilities, up to a factor, to restart "
+    "from each node. If it is not defined the restart is uniform, else it is a personalized "
+    "PageRank, biased toward the nodes with the highest values.",
+
+    // tolerance
+    "The iterations stop when the sum of the absolute changes of the ranks is lower than this "
+    "value.",
+
+    // maximum iterations
+    "The maximum number of iterations."};
 
 /** \file
  *  \brief  An implementation of the PageRank metric
@@ -45,6 +58,8 @@ static constexpr std::string_view paramHelp[] = {
  *  by François Queyroi, LaBRI, University Bordeaux I, France
  *  - 2019 Version 2.1: add edge weight as parameter
  *  by François Queyroi, LS2N, University of Nantes, France
+ *  - 2026 Version 2.2: pull based computation until convergence, add personalization
+ *  as parameter
  *
  *
  */
@@ -54,74 +69,65 @@ struct PageRank : public DoubleAlgorithm {
                     "Nodes measure used for links analysis.<br/>"
                     "First designed by Larry Page and Sergey Brin, it is a link analysis algorithm "
                     "that assigns a measure to each node of an 'hyperlinked' graph.",
-                    "2.1", "Graph")
+                    "2.2", "Graph")
 
   PageRank(const PluginContext *context) : DoubleAlgorithm(context) {
     addInParameter<double>("d", paramHelp[0].data(), "0.85");
     addInParameter<bool>("directed", paramHelp[1].data(), "true");
     addInParameter<NumericProperty *>("weight", paramHelp[2].data(), "", false);
+    addInParameter<NumericProperty *>("personalization", paramHelp[3].data(), "", false);
+    addInParameter<double>("tolerance", paramHelp[4].data(), "1e-9", false);
+    addInParameter<uint>("maximum iterations", paramHelp[5].data(), "1000", false);
+    addOutParameter<uint>("#iterations", "The number of iterations run");
   }
 
   bool run() override {
     double d = 0.85;
     bool directed = true;
     NumericProperty *weight = nullptr;
+    NumericProperty *personalization = nullptr;
+    double tolerance = 1e-9;
+    uint maxIterations = 1000;
 
     if (dataSet != nullptr) {
       dataSet->get("d", d);
       dataSet->get("directed", directed);
       dataSet->get("weight", weight);
+      dataSet->get("personalization", personalization);
+      dataSet->get("tolerance", tolerance);
+      dataSet->get("maximum iterations", maxIterations);
     }
 
     if (d <= 0 || d >= 1) {
       return false;
     }
 
-    // Initialize the PageRank
-    NodeVectorProperty<double> pr(graph);
-    NodeVectorProperty<double> next_pr(graph);
-    uint nbNodes = graph->numberOfNodes();
-
-    double oon = 1. / nbNodes;
-
-    pr.setAll(oon);
-
-    const double one_minus_d = (1 - d) / nbNodes;
-    const auto kMax = uint(15 * log(nbNodes));
-
-    NodeVectorProperty<double> deg(graph);
-    tlp::degree(graph, deg, directed ? EdgeType::DIRECTED : EdgeType::UNDIRECTED, weight, false);
-
-    for (uint k = 0; k < kMax + 1; ++k) {
-      if (!weight) {
-        TLP_PARALLEL_MAP_NODES(graph, [&](const node n) {
-          double n_sum = 0;
-          for (auto nin : getAdjacentNodesIterator(
-                   graph, n, directed ? EdgeType::INV_DIRECTED : EdgeType::UNDIRECTED)) {
-            n_sum += pr[nin] / deg[nin];
-          }
-          next_pr[n] = one_minus_d + d * n_sum;
-        });
-      } else {
-        TLP_PARALLEL_MAP_NODES(graph, [&](const node n) {
-          double n_sum = 0;
-          for (auto e : getIncidentEdgesIterator(
-                   graph, n, directed ? EdgeType::INV_DIRECTED : EdgeType::UNDIRECTED)) {
-            node nin = graph->opposite(e, n);
-            if (deg[nin] > 0) {
-              n_sum += weight->getEdgeDoubleValue(e) * pr[nin] / deg[nin];
-            }
-          }
-          next_pr[n] = one_minus_d + d * n_sum;
-        });
-      }
-
-      // swap pr and next_pr
-      pr.swap(next_pr);
+    // the teleport vector, uniform if empty
+    vector<double> teleport;
+
+    if (personalization) {
+      teleport.resize(graph->numberOfNodes());
+      TLP_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) {
+        teleport[i] = std::max(0.0, personalization->getNodeDoubleValue(n));
+      });
+    }
+
+    LinkAnalysis linkAnalysis(graph, directed, weight);
+    vector<vector<double>> ranks;
+    uint nbIterations =
+        linkAnalysis.pageRank({d}, {teleport}, ranks, tolerance, maxIterations, pluginProgress);
+
+    if (pluginProgress && pluginProgress->state() == ProgressState::TLP_CANCEL) {
+      return false;
     }
 
     // store the pr values
-    pr.copyToProperty(result);
+    TLP_MAP_NODES_AND_INDICES(graph,
+                              [&](const node n, uint i) { result->setNodeValue(n, ranks[0][i]); });
+
+    if (dataSet != nullptr) {
+      dataSet->set("#iterations", nbIterations);
+    }
 
     return true;
   }
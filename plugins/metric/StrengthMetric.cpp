@@ -11,6 +11,8 @@
  *
  */
 
+#include <talipot/ParallelTools.h>
+
 #include "StrengthMetric.h"
 
 PLUGIN(StrengthMetric)
@@ -164,41 +166,54 @@ double StrengthMetric::getNodeValue(const tlp::node n) {
 }
 //=============================================================
 bool StrengthMetric::run() {
-  uint steps = 0, maxSteps = graph->numberOfEdges();
-
-  if (maxSteps < 10) {
-    maxSteps = 10;
-  }
-
   pluginProgress->showPreview(false);
   pluginProgress->setComment("Computing Strength metric on edges...");
 
-  for (auto e : graph->edges()) {
-    (*result)[e] = getEdgeValue(e);
+  // the values of the edges are independent of each other
+  EdgeVectorProperty<double> edgeValues(graph);
+  atomic_uint nbTreatedEdges = 0;
+  atomic_bool stop = false;
+  const vector<edge> &edges = graph->edges();
+  uint nbEdges = edges.size();
+  // the edges are processed by chunks of one percent of them,
+  // the progress being reported by the first thread after each of its chunks
+  uint chunkSize = std::max(1u, nbEdges / 100);
+  uint nbChunks = (nbEdges + chunkSize - 1) / chunkSize;
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    if (stop.load()) {
+      return;
+    }
 
-    if ((++steps % (maxSteps / 10)) == 0) {
-      if (pluginProgress->progress(steps, maxSteps) != ProgressState::TLP_CONTINUE) {
-        return pluginProgress->state() != ProgressState::TLP_CANCEL;
-      }
+    uint end = std::min(nbEdges, (c + 1) * chunkSize);
+
+    for (uint i = c * chunkSize; i < end; ++i) {
+      edgeValues[edges[i]] = getEdgeValue(edges[i]);
     }
-  }
 
-  steps = 0;
-  maxSteps = graph->numberOfNodes();
+    uint nbDone = nbTreatedEdges += end - c * chunkSize;
 
-  if (maxSteps < 10) {
-    maxSteps = 10;
+    if (ThreadManager::getThreadNumber() == 0 &&
+        pluginProgress->progress(nbDone, nbEdges) != ProgressState::TLP_CONTINUE) {
+      stop = true;
+    }
+  });
+
+  if (pluginProgress->state() != ProgressState::TLP_CONTINUE) {
+    return pluginProgress->state() != ProgressState::TLP_CANCEL;
+  }
+
+  for (auto e : graph->edges()) {
+    (*result)[e] = edgeValues[e];
   }
 
   pluginProgress->setComment("Computing Strength metric on nodes...");
-  for (auto n : graph->nodes()) {
-    (*result)[n] = getNodeValue(n);
+  NodeVectorProperty<double> nodeValues(graph);
 
-    if ((++steps % (maxSteps / 10)) == 0) {
-      if (pluginProgress->progress(steps, maxSteps) != ProgressState::TLP_CONTINUE) {
-        return pluginProgress->state() != ProgressState::TLP_CANCEL;
-      }
-    }
+  TLP_PARALLEL_MAP_NODES(graph, [&](node n) { nodeValues[n] = getNodeValue(n); });
+
+  for (auto n : graph->nodes()) {
+    (*result)[n] = nodeValues[n];
   }
 
   return true;
@@ -18,65 +18,78 @@ PLUGIN(StrongComponents)
 using namespace std;
 using namespace tlp;
 
-int StrongComponents::attachNumerotation(tlp::node n, flat_hash_map<tlp::node, bool> &visited,
-                                         flat_hash_map<tlp::node, bool> &finished,
-                                         flat_hash_map<tlp::node, int> &minAttach, int &id,
-                                         std::stack<tlp::node> &renum, int &curComponent) {
-  if (visited[n]) {
-    return minAttach[n];
-  }
-
-  visited[n] = true;
-  int myId = id;
-  id++;
-  minAttach[n] = myId;
-  renum.push(n);
-  int res = myId;
-
-  for (auto tmpN : graph->getOutNodes(n)) {
-
-    if (!finished[tmpN]) {
-      int tmp = attachNumerotation(tmpN, visited, finished, minAttach, id, renum, curComponent);
-
-      if (res > tmp) {
-        res = tmp;
-      }
-    }
-  }
+StrongComponents::StrongComponents(const tlp::PluginContext *context) : DoubleAlgorithm(context) {}
 
-  minAttach[n] = res;
+// an implementation of the Tarjan algorithm, with an explicit dfs stack
+// so the depth of the search is not limited by the call stack
+bool StrongComponents::run() {
+  // the dfs numbers of the nodes, starting at 1, 0 for the unvisited ones,
+  // and the smallest dfs number of the nodes of the stack reachable from them
+  NodeVectorProperty<uint> dfsNumber(graph);
+  NodeVectorProperty<uint> low(graph);
+  NodeVectorProperty<bool> onStack(graph);
+  dfsNumber.setAll(0);
+  onStack.setAll(false);
+  // the visited nodes whose component is not yet known
+  vector<node> renum;
+  // the nodes of the current dfs path, with the position of their next incident edge
+  vector<pair<node, uint>> dfsStack;
+  uint id = 0;
+  int curComponent = 0;
 
-  if (res == myId) {
-    while (renum.top() != n) {
-      node tmp = renum.top();
-      renum.pop();
-      finished[tmp] = true;
-      minAttach[tmp] = res;
-      (*result)[tmp] = curComponent;
+  for (auto root : graph->nodes()) {
+    if (dfsNumber[root] != 0) {
+      continue;
     }
 
-    finished[n] = true;
-    (*result)[n] = curComponent;
-    curComponent++;
-    renum.pop();
-  }
+    dfsNumber[root] = low[root] = ++id;
+    onStack[root] = true;
+    renum.push_back(root);
+    dfsStack.emplace_back(root, 0);
 
-  return res;
-}
-
-StrongComponents::StrongComponents(const tlp::PluginContext *context) : DoubleAlgorithm(context) {}
+    while (!dfsStack.empty()) {
+      auto &[n, i] = dfsStack.back();
+      const vector<edge> &incidence = graph->incidence(n);
 
-bool StrongComponents::run() {
-  flat_hash_map<node, bool> visited(graph->numberOfNodes());
-  flat_hash_map<node, bool> finished(graph->numberOfNodes());
-  stack<node> renum;
-  flat_hash_map<node, int> cachedValues(graph->numberOfNodes());
-  int id = 1;
-  int curComponent = 0;
+      // only the out edges are followed
+      while (i < incidence.size() && graph->source(incidence[i]) != n) {
+        ++i;
+      }
 
-  for (auto n : graph->nodes()) {
-    if (!visited[n]) {
-      attachNumerotation(n, visited, finished, cachedValues, id, renum, curComponent);
+      if (i < incidence.size()) {
+        node m = graph->target(incidence[i++]);
+
+        if (dfsNumber[m] == 0) {
+          dfsNumber[m] = low[m] = ++id;
+          onStack[m] = true;
+          renum.push_back(m);
+          dfsStack.emplace_back(m, 0);
+        } else if (onStack[m]) {
+          low[n] = std::min(low[n], dfsNumber[m]);
+        }
+      } else {
+        node m = n;
+        dfsStack.pop_back();
+
+        // m is the first visited node of its component
+        if (low[m] == dfsNumber[m]) {
+          node tmp;
+
+          do {
+            tmp = renum.back();
+            renum.pop_back();
+            onStack[tmp] = false;
+            (*result)[tmp] = curComponent;
+          } while (tmp != m);
+
+          ++curComponent;
+        }
+
+        if (!dfsStack.empty()) {
+          node father = dfsStack.back().first;
+          low[father] = std::min(low[father], low[m]);
+        }
+      }
     }
   }
 
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -14,14 +14,7 @@
 #ifndef STRONG_COMPONENTS_H
 #define STRONG_COMPONENTS_H
 
-#include <stack>
-#include <talipot/hash.h>
 #include <talipot/PluginHeaders.h>
-struct NodeInfo {
-  NodeInfo(int stra = 0, int sta = 0) : prefixOrder(stra), minAttach(sta) {}
-  int prefixOrder;
-  int minAttach;
-};
 
 /** This plugin is an implementation of a strongly connected components decomposition.
  *
@@ -37,11 +30,6 @@ public:
                     "Implements a strongly connected components decomposition.", "1.0", "Component")
   StrongComponents(const tlp::PluginContext *context);
   bool run() override;
-
-private:
-  int attachNumerotation(tlp::node, flat_hash_map<tlp::node, bool> &,
-                         flat_hash_map<tlp::node, bool> &, flat_hash_map<tlp::node, int> &, int &,
-                         std::stack<tlp::node> &, int &);
 };
 
 #endif // STRONG_COMPONENTS_H
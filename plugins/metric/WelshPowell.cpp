@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2025  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -11,27 +11,17 @@
  *
  */
 
+#include <talipot/GraphColoring.h>
 #include <talipot/PluginHeaders.h>
 
 using namespace std;
 using namespace tlp;
 
-class CompNodes {
-
-public:
-  Graph *graph;
-  CompNodes(Graph *g) : graph(g) {}
-
-  bool operator()(const node u, const node v) const {
-    uint du = graph->deg(u), dv = graph->deg(v);
-
-    if (du == dv) {
-      return u.id > v.id;
-    }
-
-    return du > dv;
-  }
-};
+static constexpr std::string_view paramHelp[] = {
+    // parallel
+    "If true, the nodes are colored speculatively in parallel and the conflicts between adjacent "
+    "nodes are resolved in additional rounds. The coloring may then use a few more colors and "
+    "depend on the scheduling of the threads."};
 
 /** \file
  *  \brief  An implementation of the Welsh and Powell algorithm
@@ -47,107 +37,40 @@ public:
  *
  *  - 2005 Version 1.0: Initial release
  *  by David Auber, LaBRI, University Bordeaux I, France
+ *  - 2026 Version 2.0: greedy coloring of a compressed adjacency in the largest degree first
+ *  ordering, with a speculative parallel mode
  *
  *
  */
 class WelshPowell : public DoubleAlgorithm {
-  // to maximize the locality of reference we will use a vector
-  // holding the all the nodes needed info in the structure below
-  struct nodeInfo {
-    node n;
-    int val;
-  };
-
-  // a comparator used to sort the vector
-  struct nodesInfoCmp {
-    bool operator()(const nodeInfo &u, const nodeInfo &v) {
-      int du = u.val, dv = v.val;
-
-      if (du == dv) {
-        return u.n.id > v.n.id;
-      }
-
-      return du > dv;
-    }
-  };
-
 public:
   PLUGININFORMATION(
       "Welsh & Powell", "David Auber", "03/01/2005",
-      "Nodes coloring measure,<br/>values assigned to adjacent nodes are always different.", "1.0",
+      "Nodes coloring measure,<br/>values assigned to adjacent nodes are always different.", "2.0",
       "Graph")
 
-  WelshPowell(const tlp::PluginContext *context) : DoubleAlgorithm(context) {}
+  WelshPowell(const tlp::PluginContext *context) : DoubleAlgorithm(context) {
+    addInParameter<bool>("parallel", paramHelp[0].data(), "false");
+    addOutParameter<uint>("#colors", "The number of colors used");
+  }
 
   bool run() override {
-    const std::vector<node> nodes = graph->nodes();
-    uint nbNodes = nodes.size();
-    std::vector<nodeInfo> nodesInfo(nbNodes);
-
-    TLP_PARALLEL_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) {
-      nodeInfo nInfo;
-      nInfo.n = n, nInfo.val = graph->deg(n);
-      nodesInfo[i] = nInfo;
-    });
-
-    // sort the nodes in descending order of their degrees
-    sort(nodesInfo.begin(), nodesInfo.end(), nodesInfoCmp());
-    // build a map
-    NodeVectorProperty<uint> toNodesInfo(graph);
+    bool parallel = false;
 
-    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
-      nodeInfo &nInfo = nodesInfo[i];
-      // initialize the value
-      nInfo.val = -1;
-      toNodesInfo[nInfo.n] = i;
-    });
-
-    int currentColor = 0;
-    uint numberOfColoredNodes = 0;
-    uint minIndex = 0;
-    uint maxIndex = nbNodes;
-
-    while (numberOfColoredNodes != nbNodes) {
-#ifndef NDEBUG
-      cout << "nbColored :" << numberOfColoredNodes << endl;
-#endif
-      uint nextMaxIndex = minIndex;
-
-      for (uint i = minIndex; i < maxIndex; ++i) {
-#ifndef NDEBUG
-        cout << "i:" << i << endl;
-#endif
-        nodeInfo nInfo = nodesInfo[i];
-
-        if (nInfo.val == -1) {
-          bool sameColor = false;
-          for (auto u : graph->getInOutNodes(nInfo.n)) {
-            if (nodesInfo[toNodesInfo[u]].val == currentColor) {
-              sameColor = true;
-              break;
-            }
-          }
+    if (dataSet != nullptr) {
+      dataSet->get("parallel", parallel);
+    }
 
-          if (!sameColor) {
-#ifndef NDEBUG
-            cout << "new node found color : " << currentColor << endl;
-#endif
-            (*result)[nInfo.n] = nodesInfo[i].val = currentColor;
-            ++numberOfColoredNodes;
+    // each node, in descending order of the degrees, takes the smallest color
+    // not used by its neighbours colored before it
+    GraphColoring coloring(graph);
+    uint nbColors = coloring.run(coloring.largestDegreeFirstOrdering(), parallel);
 
-            if (i == minIndex) {
-              ++minIndex;
-            }
-          } else {
-            nextMaxIndex = i + 1;
-          }
-        } else if (i == minIndex) {
-          ++minIndex;
-        }
-      }
+    TLP_MAP_NODES_AND_INDICES(
+        graph, [&](const node n, uint i) { result->setNodeValue(n, coloring.color(i)); });
 
-      maxIndex = nextMaxIndex;
-      ++currentColor;
+    if (dataSet != nullptr) {
+      dataSet->set("#colors", nbColors);
     }
 
     return true;
@@ -52,7 +52,7 @@ int Histogram::overviewCpt(0);
 Histogram::Histogram(Graph *graph, Graph *edgeGraph, flat_hash_map<edge, node> &edgeMap,
                      const std::string &propertyName, const ElementType &dataLocation,
                      const Coord &blCorner, uint size, const Color &backgroundColor,
-                     const Color &textColor)
+                     const Color &textColor, HistogramBinsModel &binsModel)
     : graph(graph), propertyName(propertyName), blCorner(blCorner), size(size),
       nbHistogramBins(100), xAxis(nullptr), yAxis(nullptr), xAxisLogScale(false),
       yAxisLogScale(false), nbXGraduations(15), yAxisIncrementStep(0),
@@ -64,7 +64,7 @@ Histogram::Histogram(Graph *graph, Graph *edgeGraph, flat_hash_map<edge, node> &
       layoutUpdateNeeded(true), sizesUpdateNeeded(true), updateNeeded(true),
       xAxisScaleDefined(false), yAxisScaleDefined(false), xAxisScale(make_pair(0, 0)),
       yAxisScale(make_pair(0, 0)), initXAxisScale(make_pair(0, 0)),
-      initYAxisScale(make_pair(0, 0)) {
+      initYAxisScale(make_pair(0, 0)), binsModel(binsModel) {
 
   if (dataLocation == ElementType::NODE) {
     _glGraph = new GlGraph(graph);
@@ -121,11 +121,8 @@ static uint clamp(uint ui, uint minVal, uint maxVal) {
 
 void Histogram::computeHistogram() {
 
-  histogramBins.clear();
   binMinMaxMap.clear();
 
-  histogramBins.resize(nbHistogramBins);
-
   if (graph->getProperty(propertyName)->getTypename() == "double") {
     if (dataLocation == ElementType::NODE) {
       min = graph->getDoubleProperty(propertyName)->getNodeMin(graph);
@@ -187,6 +184,9 @@ void Histogram::computeHistogram() {
     }
 
     propertyCopy.uniformQuantification(nbHistogramBins);
+    auto uniformBins = make_shared<HistogramBins>();
+    vector<vector<uint>> &bins = uniformBins->bins;
+    bins.resize(nbHistogramBins);
 
     for (uint i = 0; i < nbHistogramBins; ++i) {
       binMinMaxMap[i].first = DBL_MAX;
@@ -197,10 +197,10 @@ void Histogram::computeHistogram() {
 
       for (auto n : graph->nodes()) {
         auto binId = uint(propertyCopy[n]);
-        histogramBins[binId].push_back(n.id);
+        bins[binId].push_back(n.id);
 
-        if (histogramBins[binId].size() > maxBinSize) {
-          maxBinSize = histogramBins[binId].size();
+        if (bins[binId].size() > maxBinSize) {
+          maxBinSize = bins[binId].size();
         }
 
         double val;
@@ -220,10 +220,10 @@ void Histogram::computeHistogram() {
 
       for (auto e : graph->edges()) {
         auto binId = uint(propertyCopy.getEdgeValue(e));
-        histogramBins[binId].push_back(e.id);
+        bins[binId].push_back(e.id);
 
-        if (histogramBins[binId].size() > maxBinSize) {
-          maxBinSize = histogramBins[binId].size();
+        if (bins[binId].size() > maxBinSize) {
+          maxBinSize = bins[binId].size();
         }
 
         double val;
@@ -247,10 +247,10 @@ void Histogram::computeHistogram() {
     uniformQuantificationAxisLabels.clear();
 
     for (uint i = 0; i < nbHistogramBins; ++i) {
-      if (histogramBins[i].size() > 0) {
+      if (bins[i].size() > 0) {
         uniformQuantificationAxisLabels.push_back(getStringFromNumber(binMinMaxMap[i].first));
       } else {
-        if (histogramBins[i - 1].size() > 0) {
+        if (bins[i - 1].size() > 0) {
           uniformQuantificationAxisLabels.push_back(
               getStringFromNumber(binMinMaxMap[i - 1].second));
         } else {
@@ -261,67 +261,13 @@ void Histogram::computeHistogram() {
 
     uniformQuantificationAxisLabels.push_back(
         getStringFromNumber(binMinMaxMap[nbHistogramBins - 1].second));
+    histogramBins = uniformBins;
   } else {
-    if (dataLocation == ElementType::NODE) {
-
-      for (auto n : graph->nodes()) {
-        double value;
-
-        if (graph->getProperty(propertyName)->getTypename() == "double") {
-          value = (*graph)[propertyName][n];
-          double intpart, fracpart;
-          fracpart = modf(value, &intpart);
-          integerScale = integerScale && (fracpart == 0);
-        } else {
-          value = (*graph)[propertyName][n];
-        }
-
-        if (value != max) {
-          uint nodeHistoBin = clamp(uint(floor((value - min) / binWidth)), 0, nbHistogramBins - 1);
-          histogramBins[nodeHistoBin].push_back(n.id);
-
-          if (histogramBins[nodeHistoBin].size() > maxBinSize) {
-            maxBinSize = histogramBins[nodeHistoBin].size();
-          }
-        } else {
-          histogramBins[nbHistogramBins - 1].push_back(n.id);
-
-          if (histogramBins[nbHistogramBins - 1].size() > maxBinSize) {
-            maxBinSize = histogramBins[nbHistogramBins - 1].size();
-          }
-        }
-      }
-
-    } else {
-
-      for (auto e : graph->edges()) {
-        double value;
-
-        if (graph->getProperty(propertyName)->getTypename() == "double") {
-          value = (*graph->getDoubleProperty(propertyName))[e];
-          double intpart, fracpart;
-          fracpart = modf(value, &intpart);
-          integerScale = integerScale && (fracpart == 0);
-        } else {
-          value = (*graph->getIntegerProperty(propertyName))[e];
-        }
-
-        if (value != max) {
-          auto nodeHistoBin = uint(floor((value - min) / binWidth));
-          histogramBins[nodeHistoBin].push_back(e.id);
-
-          if (histogramBins[nodeHistoBin].size() > maxBinSize) {
-            maxBinSize = histogramBins[nodeHistoBin].size();
-          }
-        } else {
-          histogramBins[nbHistogramBins - 1].push_back(e.id);
-
-          if (histogramBins[nbHistogramBins - 1].size() > maxBinSize) {
-            maxBinSize = histogramBins[nbHistogramBins - 1].size();
-          }
-        }
-      }
-    }
+    // the bins are shared with the cache of the view, without being copied, and only
+    // recomputed when the property values or the bins range have changed
+    histogramBins = binsModel.bins(propertyName, nbHistogramBins, min, max);
+    maxBinSize = histogramBins->maxBinSize;
+    integerScale = histogramBins->integerScale;
   }
 }
 
@@ -462,7 +408,7 @@ void Histogram::updateLayout() {
   uint cumulativeSize = 0;
 
   for (uint i = 0; i < nbHistogramBins; ++i) {
-    uint binSize = histogramBins[i].size();
+    uint binSize = histogramBins->bins[i].size();
     cumulativeSize += binSize;
     float binXCoord, binXCoordEnd;
 
@@ -493,14 +439,14 @@ void Histogram::updateLayout() {
       Coord nodeCoord = {nodeXCoord, nodeYCoord};
 
       if (dataLocation == ElementType::NODE) {
-        histogramLayout->setNodeValue(node(histogramBins[i][j]), nodeCoord);
+        histogramLayout->setNodeValue(node(histogramBins->bins[i][j]), nodeCoord);
       } else {
-        node n = edgeToNode[edge(histogramBins[i][j])];
+        node n = edgeToNode[edge(histogramBins->bins[i][j])];
         (*histogramEdgeLayout)[n] = nodeCoord;
 
         vector<Coord> edgeHistoPointCoord;
         edgeHistoPointCoord.push_back(nodeCoord);
-        (*histogramLayout)[edge(histogramBins[i][j])] = edgeHistoPointCoord;
+        (*histogramLayout)[edge(histogramBins->bins[i][j])] = edgeHistoPointCoord;
       }
     }
   }
@@ -533,7 +479,7 @@ void Histogram::updateSizes() {
 
   for (uint i = 0; i < nbHistogramBins; ++i) {
 
-    uint binSize = histogramBins[i].size();
+    uint binSize = histogramBins->bins[i].size();
 
     float binXCoord, binXCoordEnd;
 
@@ -547,7 +493,7 @@ void Histogram::updateSizes() {
 
     for (uint j = 0; j < binSize; ++j) {
       if (dataLocation == ElementType::NODE) {
-        const Size &currentNodeSize = (*viewSize)[node(histogramBins[i][j])];
+        const Size &currentNodeSize = (*viewSize)[node(histogramBins->bins[i][j])];
         Size newNodeSize;
 
         if (resize) {
@@ -563,7 +509,7 @@ void Histogram::updateSizes() {
         }
 
         newNodeSize[2] = currentNodeSize[2];
-        histogramSize->setNodeValue(node(histogramBins[i][j]), newNodeSize);
+        histogramSize->setNodeValue(node(histogramBins->bins[i][j]), newNodeSize);
       }
     }
   }
@@ -600,13 +546,13 @@ void Histogram::update() {
     Vec4i quadColorCumul;
     quadColorCumul.fill(0);
     Color quadColor;
-    uint binSize = histogramBins[i].size();
+    uint binSize = histogramBins->bins[i].size();
     cumulativeSize += binSize;
 
     for (uint j = 0; j < binSize; ++j) {
       if (dataLocation == ElementType::NODE) {
         for (uint k = 0; k < 4; ++k) {
-          quadColorCumul[k] += uint((*viewColor)[node(histogramBins[i][j])][k]);
+          quadColorCumul[k] += uint((*viewColor)[node(histogramBins->bins[i][j])][k]);
         }
       }
     }
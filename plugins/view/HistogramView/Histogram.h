@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -21,6 +21,8 @@
 #include <talipot/SizeProperty.h>
 #include <talipot/GlBoundingBoxSceneVisitor.h>
 
+#include "HistogramBinsModel.h"
+
 namespace tlp {
 
 const std::string BIN_RECT_TEXTURE = ":/histo_texture.png";
@@ -30,7 +32,8 @@ class Histogram : public GlComposite {
 public:
   Histogram(Graph *graph, Graph *edgeGraph, flat_hash_map<edge, node> &edgeMap,
             const std::string &propertyName, const ElementType &dataLocation, const Coord &blCorner,
-            uint size, const Color &backgroundColor, const Color &textColor);
+            uint size, const Color &backgroundColor, const Color &textColor,
+            HistogramBinsModel &binsModel);
   ~Histogram() override;
 
   const std::string &getPropertyName() const {
@@ -191,7 +194,7 @@ private:
   Coord blCorner;
   uint size;
   uint nbHistogramBins;
-  std::vector<std::vector<uint>> histogramBins;
+  std::shared_ptr<const HistogramBins> histogramBins;
   double binWidth;
   uint maxBinSize;
   GlQuantitativeAxis *xAxis, *yAxis;
@@ -224,6 +227,8 @@ private:
   std::pair<double, double> xAxisScale, yAxisScale;
   std::pair<double, double> initXAxisScale, initYAxisScale;
 
+  HistogramBinsModel &binsModel;
+
   int overviewId;
   static int overviewCpt;
 };
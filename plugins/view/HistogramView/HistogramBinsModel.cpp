@@ -0,0 +1,276 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/GraphParallelTools.h>
+#include <talipot/NumericProperty.h>
+
+#include "HistogramBinsModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace tlp {
+
+// minimum number of values handled by a thread when computing the bins
+static const uint MIN_VALUES_PER_THREAD = 4096;
+
+static bool isIntegerValue(double value) {
+  double intpart;
+  return modf(value, &intpart) == 0;
+}
+
+HistogramBinsModel::HistogramBinsModel() : graph(nullptr), dataLocation(ElementType::NODE) {}
+
+void HistogramBinsModel::setData(Graph *graph, ElementType dataLocation) {
+  if (graph != this->graph || dataLocation != this->dataLocation) {
+    clear();
+    this->graph = graph;
+    this->dataLocation = dataLocation;
+  }
+}
+
+void HistogramBinsModel::invalidate(const string &propertyName) {
+  entries.erase(propertyName);
+}
+
+void HistogramBinsModel::valueChanged(const string &propertyName, uint eltId) {
+  auto it = entries.find(propertyName);
+
+  if (it == entries.end() || !it->second.valid ||
+      (dataLocation == ElementType::NODE ? !graph->isElement(node(eltId))
+                                         : !graph->isElement(edge(eltId)))) {
+    return;
+  }
+
+  Entry &entry = it->second;
+
+  // recomputing the bins is cheaper than moving too many elements
+  if (entry.changedElts.size() > max(64u, nbElements() / 32)) {
+    entry.valid = false;
+    entry.changedElts.clear();
+  } else {
+    entry.changedElts.push_back(eltId);
+  }
+}
+
+void HistogramBinsModel::clear() {
+  entries.clear();
+}
+
+uint HistogramBinsModel::nbElements() const {
+  return dataLocation == ElementType::NODE ? graph->numberOfNodes() : graph->numberOfEdges();
+}
+
+uint HistogramBinsModel::binOf(const Entry &entry, double value) const {
+  if (value >= entry.max) {
+    return entry.nbBins - 1;
+  }
+
+  double binWidth = (entry.max - entry.min) / entry.nbBins;
+  return uint(std::clamp(floor((value - entry.min) / binWidth), 0., double(entry.nbBins - 1)));
+}
+
+shared_ptr<const HistogramBins> HistogramBinsModel::bins(const string &propertyName,
+                                                         uint nbBins, double min, double max) {
+  Entry &entry = entries[propertyName];
+  assert(dynamic_cast<NumericProperty *>(graph->getProperty(propertyName)));
+  auto *prop = static_cast<NumericProperty *>(graph->getProperty(propertyName));
+
+  if (!entry.valid || entry.nbBins != nbBins || entry.min != min || entry.max != max ||
+      entry.values.size() != nbElements()) {
+    entry.nbBins = nbBins;
+    entry.min = min;
+    entry.max = max;
+    computeBins(prop, entry);
+  } else if (!entry.changedElts.empty()) {
+    updateBins(prop, entry);
+  }
+
+  return entry.bins;
+}
+
+void HistogramBinsModel::computeBins(NumericProperty *prop, Entry &entry) {
+  uint nbElts = nbElements();
+  uint nbBins = entry.nbBins;
+  entry.values.resize(nbElts);
+  entry.eltBin.resize(nbElts);
+  entry.changedElts.clear();
+
+  if (dataLocation == ElementType::NODE) {
+    TLP_PARALLEL_MAP_NODES_AND_INDICES(
+        graph, [&](const node n, uint i) { entry.values[i] = prop->getNodeDoubleValue(n); });
+  } else {
+    TLP_PARALLEL_MAP_EDGES_AND_INDICES(
+        graph, [&](const edge e, uint i) { entry.values[i] = prop->getEdgeDoubleValue(e); });
+  }
+
+  // each thread counts the elements of a contiguous range of values
+  uint nbChunks = std::max(1u, std::min(uint(TLP_NB_THREADS), nbElts / MIN_VALUES_PER_THREAD));
+  uint chunkSize = (nbElts + nbChunks - 1) / nbChunks;
+  vector<vector<uint>> chunksCounts(nbChunks, vector<uint>(nbBins, 0));
+  vector<uint> chunksNonIntegerValues(nbChunks, 0);
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    vector<uint> &counts = chunksCounts[c];
+
+    for (uint i = c * chunkSize; i < std::min(nbElts, (c + 1) * chunkSize); ++i) {
+      double value = entry.values[i];
+      uint bin = binOf(entry, value);
+      entry.eltBin[i] = bin;
+      ++counts[bin];
+
+      if (!isIntegerValue(value)) {
+        ++chunksNonIntegerValues[c];
+      }
+    }
+  });
+
+  // turn the counts into the offsets where each thread writes in each bin,
+  // so the elements keep the graph order inside a bin
+  entry.bins->bins.resize(nbBins);
+  entry.bins->maxBinSize = 0;
+  entry.nbNonIntegerValues = 0;
+
+  for (uint b = 0; b < nbBins; ++b) {
+    uint binSize = 0;
+
+    for (uint c = 0; c < nbChunks; ++c) {
+      uint count = chunksCounts[c][b];
+      chunksCounts[c][b] = binSize;
+      binSize += count;
+    }
+
+    entry.bins->bins[b].resize(binSize);
+    entry.bins->maxBinSize = std::max(entry.bins->maxBinSize, binSize);
+  }
+
+  for (uint c = 0; c < nbChunks; ++c) {
+    entry.nbNonIntegerValues += chunksNonIntegerValues[c];
+  }
+
+  const vector<node> &nodes = graph->nodes();
+  const vector<edge> &edges = graph->edges();
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint c) {
+    vector<uint> &offsets = chunksCounts[c];
+
+    for (uint i = c * chunkSize; i < std::min(nbElts, (c + 1) * chunkSize); ++i) {
+      uint bin = entry.eltBin[i];
+      entry.bins->bins[bin][offsets[bin]++] =
+          dataLocation == ElementType::NODE ? nodes[i].id : edges[i].id;
+    }
+  });
+
+  entry.bins->integerScale = entry.nbNonIntegerValues == 0;
+  entry.valid = true;
+}
+
+void HistogramBinsModel::updateBins(NumericProperty *prop, Entry &entry) {
+  auto &bins = entry.bins->bins;
+  auto eltPos = [&](uint eltId) {
+    return dataLocation == ElementType::NODE ? graph->nodePos(node(eltId))
+                                             : graph->edgePos(edge(eltId));
+  };
+
+  // the new bin and the position of each moved element
+  vector<pair<uint, uint>> movedElts;
+  vector<bool> changedBins(bins.size(), false);
+
+  // an element whose value changed several times is moved once, to the bin of its last value
+  std::sort(entry.changedElts.begin(), entry.changedElts.end());
+  entry.changedElts.erase(std::unique(entry.changedElts.begin(), entry.changedElts.end()),
+                          entry.changedElts.end());
+
+  for (uint eltId : entry.changedElts) {
+    uint pos;
+    double value;
+
+    if (dataLocation == ElementType::NODE) {
+      pos = graph->nodePos(node(eltId));
+      value = prop->getNodeDoubleValue(node(eltId));
+    } else {
+      pos = graph->edgePos(edge(eltId));
+      value = prop->getEdgeDoubleValue(edge(eltId));
+    }
+
+    if (!isIntegerValue(entry.values[pos])) {
+      --entry.nbNonIntegerValues;
+    }
+
+    if (!isIntegerValue(value)) {
+      ++entry.nbNonIntegerValues;
+    }
+
+    entry.values[pos] = value;
+
+    uint oldBin = entry.eltBin[pos];
+    uint newBin = binOf(entry, value);
+
+    if (oldBin == newBin) {
+      continue;
+    }
+
+    entry.eltBin[pos] = newBin;
+    changedBins[oldBin] = changedBins[newBin] = true;
+    movedElts.emplace_back(newBin, pos);
+  }
+
+  // the elements of a bin are kept in the graph order: the ones remaining in a changed bin
+  // are merged with the ones moved into it, sorted by position
+  std::sort(movedElts.begin(), movedElts.end());
+  auto movedIt = movedElts.begin();
+  vector<uint> remaining;
+
+  for (uint b = 0; b < bins.size(); ++b) {
+    if (!changedBins[b]) {
+      continue;
+    }
+
+    vector<uint> &bin = bins[b];
+    remaining.clear();
+
+    for (uint eltId : bin) {
+      if (entry.eltBin[eltPos(eltId)] == b) {
+        remaining.push_back(eltId);
+      }
+    }
+
+    bin.clear();
+    auto remainingIt = remaining.begin();
+
+    for (; movedIt != movedElts.end() && movedIt->first == b; ++movedIt) {
+      uint pos = movedIt->second;
+
+      while (remainingIt != remaining.end() && eltPos(*remainingIt) < pos) {
+        bin.push_back(*remainingIt++);
+      }
+
+      bin.push_back(dataLocation == ElementType::NODE ? graph->nodes()[pos].id
+                                                      : graph->edges()[pos].id);
+    }
+
+    bin.insert(bin.end(), remainingIt, remaining.end());
+  }
+
+  entry.changedElts.clear();
+  entry.bins->maxBinSize = 0;
+
+  for (const auto &bin : bins) {
+    entry.bins->maxBinSize = std::max(entry.bins->maxBinSize, uint(bin.size()));
+  }
+
+  entry.bins->integerScale = entry.nbNonIntegerValues == 0;
+}
+}
@@ -0,0 +1,107 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef HISTOGRAM_BINS_MODEL_H
+#define HISTOGRAM_BINS_MODEL_H
+
+#include <talipot/Graph.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tlp {
+
+class NumericProperty;
+
+/**
+ * Ids of the graph elements falling in each bin of a histogram.
+ */
+struct HistogramBins {
+  std::vector<std::vector<uint>> bins;
+  uint maxBinSize = 0;
+  // true if all the values are integers
+  bool integerScale = true;
+};
+
+/**
+ * Cache of the bins of the histograms of a graph, shared by all the
+ * histograms of the view.
+ *
+ * The bins of a property are computed in a single parallel pass over
+ * its values, each thread counting the elements of a contiguous range
+ * before filling its part of the bins, and are kept until the property
+ * is invalidated or the bins number or range changes. When only a few
+ * values of a property are modified, only the bins of the concerned
+ * elements are updated, the elements of each bin staying in the graph order.
+ */
+class HistogramBinsModel {
+public:
+  HistogramBinsModel();
+
+  /**
+   * Sets the graph and the type of elements the values are read from,
+   * the cached bins are dropped if one of them changes.
+   */
+  void setData(Graph *graph, ElementType dataLocation);
+
+  /**
+   * Drops the cached bins of the given property.
+   */
+  void invalidate(const std::string &propertyName);
+
+  /**
+   * Records that the value of an element has changed for the given property,
+   * it will be moved to its new bin the next time the bins are requested.
+   */
+  void valueChanged(const std::string &propertyName, uint eltId);
+
+  /**
+   * Drops all the cached bins.
+   */
+  void clear();
+
+  /**
+   * Returns the bins of the given property for the [min, max] range,
+   * computing them if needed. They are shared with the cache, so they
+   * stay valid after being dropped from it.
+   */
+  std::shared_ptr<const HistogramBins> bins(const std::string &propertyName, uint nbBins,
+                                            double min, double max);
+
+private:
+  struct Entry {
+    std::shared_ptr<HistogramBins> bins = std::make_shared<HistogramBins>();
+    uint nbBins = 0;
+    double min = 0, max = 0;
+    bool valid = false;
+    // values and bin of each element, by element position
+    std::vector<double> values;
+    std::vector<uint> eltBin;
+    uint nbNonIntegerValues = 0;
+    std::vector<uint> changedElts;
+  };
+
+  uint nbElements() const;
+  uint binOf(const Entry &entry, double value) const;
+  void computeBins(NumericProperty *prop, Entry &entry);
+  void updateBins(NumericProperty *prop, Entry &entry);
+
+  Graph *graph;
+  ElementType dataLocation;
+  std::map<std::string, Entry> entries;
+};
+}
+
+#endif // HISTOGRAM_BINS_MODEL_H
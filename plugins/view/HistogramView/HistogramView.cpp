@@ -170,6 +170,7 @@ void HistogramView::setState(const DataSet &dataSet) {
       lastGraph->getProperty("viewShape")->removeListener(this);
       lastGraph->getProperty("viewSelection")->removeListener(this);
       lastGraph->getProperty("viewTexture")->removeListener(this);
+      unlistenHistogramsProperties(lastGraph);
     }
 
     initGlWidget(graph());
@@ -607,6 +608,8 @@ void HistogramView::buildHistograms() {
 
   selectedProperties = propertiesSelectionWidget->getSelectedGraphProperties();
   dataLocation = propertiesSelectionWidget->getDataLocation();
+  binsModel.setData(_histoGraph, dataLocation);
+  listenHistogramsProperties();
 
   if (selectedProperties.empty()) {
     return;
@@ -650,9 +653,9 @@ void HistogramView::buildHistograms() {
     oss << "histogram overview for property " << selectedProperties[i];
 
     if (!histogramsMap.contains(selectedProperties[i])) {
-      auto *histoOverview = new Histogram(_histoGraph, edgeAsNodeGraph, edgeToNode,
-                                          selectedProperties[i], dataLocation, overviewBLCorner,
-                                          OVERVIEW_SIZE, backgroundColor, foregroundColor);
+      auto *histoOverview = new Histogram(
+          _histoGraph, edgeAsNodeGraph, edgeToNode, selectedProperties[i], dataLocation,
+          overviewBLCorner, OVERVIEW_SIZE, backgroundColor, foregroundColor, binsModel);
       histogramsMap[selectedProperties[i]] = histoOverview;
     } else {
       histogramsMap[selectedProperties[i]]->setDataLocation(dataLocation);
@@ -712,6 +715,40 @@ void HistogramView::updateHistograms(Histogram *detailOverview) {
   }
 }
 
+void HistogramView::listenHistogramsProperties() {
+  unlistenHistogramsProperties(_histoGraph);
+
+  // the values of all the displayed properties are observed
+  // in order to keep their cached bins up to date
+  for (const auto &prop : selectedProperties) {
+    _histoGraph->getProperty(prop)->addListener(this);
+    listenedProperties.insert(prop);
+  }
+}
+
+void HistogramView::unlistenHistogramsProperties(Graph *graph) {
+  static const set<string> viewProperties = {"viewColor", "viewLabel",     "viewSize",
+                                             "viewShape", "viewSelection", "viewTexture"};
+
+  for (const auto &prop : listenedProperties) {
+    // the view properties have to be observed anyway
+    if (graph && graph->existProperty(prop) && !viewProperties.contains(prop)) {
+      graph->getProperty(prop)->removeListener(this);
+    }
+  }
+
+  listenedProperties.clear();
+}
+
+Histogram *HistogramView::propertyHistogram(PropertyInterface *p) const {
+  if (p->getGraph() == edgeAsNodeGraph || !listenedProperties.contains(p->getName())) {
+    return nullptr;
+  }
+
+  auto it = histogramsMap.find(p->getName());
+  return it != histogramsMap.end() ? it->second : nullptr;
+}
+
 vector<Histogram *> HistogramView::getHistograms() const {
   vector<Histogram *> ret;
 
@@ -764,13 +801,8 @@ void HistogramView::switchFromSmallMultiplesToDetailedView(Histogram *histogramT
   mainLayer->deleteGlEntity(histogramsComposite);
   mainLayer->deleteGlEntity(labelsComposite);
 
-  if (detailedHistogram) {
-    _histoGraph->getProperty(detailedHistogram->getPropertyName())->removeListener(this);
-  }
-
   detailedHistogram = histogramToDetail;
   detailedHistogramPropertyName = detailedHistogram->getPropertyName();
-  _histoGraph->getProperty(detailedHistogramPropertyName)->addListener(this);
 
   updateDetailedHistogramAxis();
 
@@ -996,6 +1028,16 @@ void HistogramView::afterSetNodeValue(PropertyInterface *p, const node n) {
     return;
   }
 
+  if (Histogram *histo = propertyHistogram(p)) {
+    binsModel.valueChanged(p->getName(), n.id);
+    histo->setLayoutUpdateNeeded();
+
+    // the changes of a displayed view property are also handled globally
+    if (!p->getName().starts_with("view")) {
+      return;
+    }
+  }
+
   afterSetAllNodeValue(p);
 }
 
@@ -1004,6 +1046,11 @@ void HistogramView::afterSetEdgeValue(PropertyInterface *p, const edge e) {
     return;
   }
 
+  if (Histogram *histo = propertyHistogram(p)) {
+    binsModel.valueChanged(p->getName(), e.id);
+    histo->setLayoutUpdateNeeded();
+  }
+
   if (p->getName() == "viewColor") {
     ColorProperty *edgeAsNodeGraphColors = edgeAsNodeGraph->getColorProperty("viewColor");
     auto *viewColor = static_cast<ColorProperty *>(p);
@@ -1029,9 +1076,12 @@ void HistogramView::afterSetEdgeValue(PropertyInterface *p, const edge e) {
 }
 
 void HistogramView::afterSetAllNodeValue(PropertyInterface *p) {
-  if (detailedHistogram && p->getName() == detailedHistogram->getPropertyName()) {
-    setLayoutUpdateNeeded();
-  } else if (p->getName() == "viewSize") {
+  if (Histogram *histo = propertyHistogram(p)) {
+    binsModel.invalidate(p->getName());
+    histo->setLayoutUpdateNeeded();
+  }
+
+  if (p->getName() == "viewSize") {
     setSizesUpdateNeeded();
   } else if (p->getName() == "viewSelection") {
     if (p->getGraph() == edgeAsNodeGraph) {
@@ -1049,8 +1099,9 @@ void HistogramView::afterSetAllNodeValue(PropertyInterface *p) {
 
 void HistogramView::afterSetAllEdgeValue(PropertyInterface *p) {
 
-  if (detailedHistogram && p->getName() == detailedHistogram->getPropertyName()) {
-    setLayoutUpdateNeeded();
+  if (Histogram *histo = propertyHistogram(p)) {
+    binsModel.invalidate(p->getName());
+    histo->setLayoutUpdateNeeded();
   }
 
   if (p->getName() == "viewColor") {
@@ -1077,17 +1128,20 @@ void HistogramView::afterSetAllEdgeValue(PropertyInterface *p) {
 }
 
 void HistogramView::addNode(Graph *, const node) {
+  binsModel.clear();
   setLayoutUpdateNeeded();
   setSizesUpdateNeeded();
 }
 
 void HistogramView::addEdge(Graph *, const edge e) {
   edgeToNode[e] = edgeAsNodeGraph->addNode();
+  binsModel.clear();
   setLayoutUpdateNeeded();
   setSizesUpdateNeeded();
 }
 
 void HistogramView::delNode(Graph *, const node) {
+  binsModel.clear();
   setLayoutUpdateNeeded();
   setSizesUpdateNeeded();
 }
@@ -1095,6 +1149,7 @@ void HistogramView::delNode(Graph *, const node) {
 void HistogramView::delEdge(Graph *, const edge e) {
   edgeAsNodeGraph->delNode(edgeToNode[e]);
   edgeToNode.erase(e);
+  binsModel.clear();
   setLayoutUpdateNeeded();
   setSizesUpdateNeeded();
 }
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -16,6 +16,7 @@
 
 #include <talipot/GlView.h>
 
+#include <set>
 #include <vector>
 #include <talipot/hash.h>
 
@@ -145,21 +146,25 @@ private:
   void addEmptyViewLabel();
   void removeEmptyViewLabel();
 
+  void listenHistogramsProperties();
+  void unlistenHistogramsProperties(Graph *graph);
+  Histogram *propertyHistogram(PropertyInterface *p) const;
+
   void setLayoutUpdateNeeded() {
-    if (detailedHistogram) {
-      detailedHistogram->setLayoutUpdateNeeded();
+    for (auto &[propertyName, histogram] : histogramsMap) {
+      histogram->setLayoutUpdateNeeded();
     }
   }
 
   void setSizesUpdateNeeded() {
-    if (detailedHistogram) {
-      detailedHistogram->setSizesUpdateNeeded();
+    for (auto &[propertyName, histogram] : histogramsMap) {
+      histogram->setSizesUpdateNeeded();
     }
   }
 
   void setUpdateNeeded() {
-    if (detailedHistogram) {
-      detailedHistogram->setUpdateNeeded();
+    for (auto &[propertyName, histogram] : histogramsMap) {
+      histogram->setUpdateNeeded();
     }
   }
 
@@ -172,6 +177,9 @@ private:
 
   GlComposite *histogramsComposite, *labelsComposite, *axisComposite;
   std::map<std::string, Histogram *> histogramsMap;
+  HistogramBinsModel binsModel;
+  // names of the histograms properties the view listens to
+  std::set<std::string> listenedProperties;
 
   bool smallMultiplesView;
   GlLayer *mainLayer;
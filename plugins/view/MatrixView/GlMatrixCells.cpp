@@ -0,0 +1,246 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include "GlMatrixCells.h"
+
+#include <talipot/Camera.h>
+#include <talipot/ColorProperty.h>
+#include <talipot/BooleanProperty.h>
+#include <talipot/GlTextureManager.h>
+#include <talipot/GlWidget.h>
+
+#include "MatrixView.h"
+
+#include <cmath>
+
+using namespace std;
+
+namespace tlp {
+
+// minimum size in pixels of a cell for the cells to be drawn one by one
+static const float MIN_ELEMENT_CELL_SIZE = 8;
+// maximum number of tile textures kept in memory
+static const uint MAX_TILE_TEXTURES = 256;
+
+GlMatrixCells::GlMatrixCells(MatrixView *view)
+    : _view(view), _texturesVersion(0), _texturesBlockSize(0), _texturesFunction(AGGREGATE_MAX) {}
+
+GlMatrixCells::~GlMatrixCells() {
+  deleteTileTextures();
+}
+
+BoundingBox GlMatrixCells::getBoundingBox() {
+  int N = _view->graph()->numberOfNodes();
+  BoundingBox result;
+  result.expand(Coord(0, 0, 0));
+  result.expand(Coord(1 + N, -1 - N, 0));
+  return result;
+}
+
+void GlMatrixCells::draw(float, Camera *camera) {
+  MatrixCells &cells = _view->matrixCells();
+  uint N = cells.dimension();
+
+  if (!cells.isValid() || N == 0) {
+    return;
+  }
+
+  const Vec4i &viewPort = camera->getViewport();
+  Coord p1 = camera->viewportTo3DWorld(Coord(viewPort[0] + viewPort[2], viewPort[1], 0)),
+        p2 = camera->viewportTo3DWorld(Coord(viewPort[0], viewPort[1] + viewPort[3], 0));
+  float xMin = min(p1[0], p2[0]), xMax = max(p1[0], p2[0]);
+  float yMin = min(p1[1], p2[1]), yMax = max(p1[1], p2[1]);
+
+  // cell (row, col) is a unit square centered on (col + 1, -(row + 1))
+  if (xMax < 0.5f || yMin > -0.5f || xMin > N + 0.5f || yMax < -0.5f - N) {
+    return;
+  }
+
+  uint firstCol = uint(max(0.f, floor(xMin - 0.5f)));
+  uint lastCol = min(N - 1, uint(max(0.f, ceil(xMax - 0.5f))));
+  uint firstRow = uint(max(0.f, floor(-yMax - 0.5f)));
+  uint lastRow = min(N - 1, uint(max(0.f, ceil(-yMin - 0.5f))));
+
+  float cellsPerPixel = (xMax - xMin) / max(1, viewPort[2]);
+  CellAggregationFunction function = _view->cellAggregationFunction();
+
+  // the state of the drawing of the other entities is restored at the end
+  GLboolean lighting = glIsEnabled(GL_LIGHTING);
+  GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+  glDisable(GL_LIGHTING);
+  glDisable(GL_CULL_FACE);
+
+  if (cellsPerPixel <= 1 / MIN_ELEMENT_CELL_SIZE) {
+    vector<edge> edges;
+    drawElements(cells.level(1, function), firstRow, lastRow, firstCol, lastCol, edges);
+    // the visible cells are also displayed as elements, to be picked and selected
+    _view->setElementCells(std::move(edges));
+  } else {
+    _view->setElementCells({});
+    // one block of cells per pixel at most
+    uint blockSize = 1;
+
+    while (blockSize < cellsPerPixel && blockSize < N) {
+      blockSize *= 2;
+    }
+
+    const AggregatedCellsLevel &level = cells.level(blockSize, function);
+
+    if (_texturesVersion != cells.version() || _texturesBlockSize != blockSize ||
+        _texturesFunction != function || _tileTextures.size() > MAX_TILE_TEXTURES) {
+      deleteTileTextures();
+      _texturesVersion = cells.version();
+      _texturesBlockSize = blockSize;
+      _texturesFunction = function;
+    }
+
+    uint64_t tileExtent = uint64_t(blockSize) * level.tileSize;
+
+    for (uint tileRow = firstRow / tileExtent; tileRow <= lastRow / tileExtent; ++tileRow) {
+      for (uint tileCol = firstCol / tileExtent; tileCol <= lastCol / tileExtent; ++tileCol) {
+        drawTile(level, tileRow, tileCol);
+      }
+    }
+  }
+
+  if (cullFace) {
+    glEnable(GL_CULL_FACE);
+  }
+
+  if (lighting) {
+    glEnable(GL_LIGHTING);
+  }
+}
+
+void GlMatrixCells::drawElements(const AggregatedCellsLevel &level, uint firstRow, uint lastRow,
+                                 uint firstCol, uint lastCol, vector<edge> &edges) {
+  Graph *graph = _view->graph();
+  ColorProperty *colors = graph->getColorProperty("viewColor");
+  BooleanProperty *selection = graph->getBooleanProperty("viewSelection");
+  Color selectionColor = _view->glWidget()->renderingParameters().getSelectionColor();
+
+  vector<Coord> vertices;
+  vector<Color> verticesColors;
+  uint tileSize = level.tileSize;
+
+  for (uint tileRow = firstRow / tileSize; tileRow <= lastRow / tileSize; ++tileRow) {
+    for (uint tileCol = firstCol / tileSize; tileCol <= lastCol / tileSize; ++tileCol) {
+      auto [cell, last] = level.tileCells(tileRow, tileCol);
+
+      for (; cell != last; ++cell) {
+        if (cell->row < firstRow || cell->row > lastRow || cell->col < firstCol ||
+            cell->col > lastCol) {
+          continue;
+        }
+
+        edge e(cell->edge);
+        edges.push_back(e);
+        const Color &color = selection->getEdgeValue(e) ? selectionColor : colors->getEdgeValue(e);
+        float x = cell->col + 0.5f, y = -(cell->row + 0.5f);
+        vertices.emplace_back(x, y, 0);
+        vertices.emplace_back(x + 1, y, 0);
+        vertices.emplace_back(x + 1, y - 1, 0);
+        vertices.emplace_back(x, y - 1, 0);
+        verticesColors.insert(verticesColors.end(), 4, color);
+      }
+    }
+  }
+
+  if (vertices.empty()) {
+    return;
+  }
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+  glVertexPointer(3, GL_FLOAT, 3 * sizeof(float), &vertices[0][0]);
+  glColorPointer(4, GL_UNSIGNED_BYTE, 4 * sizeof(uchar), &verticesColors[0][0]);
+  glDrawArrays(GL_QUADS, 0, vertices.size());
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void GlMatrixCells::drawTile(const AggregatedCellsLevel &level, uint tileRow, uint tileCol) {
+  auto [first, last] = level.tileCells(tileRow, tileCol);
+
+  if (first == last) {
+    return;
+  }
+
+  const string &textureName = tileTexture(level, tileRow, tileCol);
+  float tileExtent = float(level.blockSize) * level.tileSize;
+  float x = tileCol * tileExtent + 0.5f, y = -(tileRow * tileExtent + 0.5f);
+
+  // the first row of the texture is displayed at the top of the tile
+  const GLfloat vertices[] = {x, y, 0, x + tileExtent, y, 0, x + tileExtent, y - tileExtent, 0,
+                              x, y - tileExtent, 0};
+  const GLfloat texCoords[] = {0, 0, 1, 0, 1, 1, 0, 1};
+
+  GlTextureManager::activateTexture(textureName);
+  glColor4ub(255, 255, 255, 255);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glVertexPointer(3, GL_FLOAT, 3 * sizeof(GLfloat), vertices);
+  glTexCoordPointer(2, GL_FLOAT, 2 * sizeof(GLfloat), texCoords);
+  glDrawArrays(GL_QUADS, 0, 4);
+  glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  GlTextureManager::deactivateTexture();
+}
+
+const string &GlMatrixCells::tileTexture(const AggregatedCellsLevel &level, uint tileRow,
+                                         uint tileCol) {
+  uint64_t key = (uint64_t(tileRow) << 32) | tileCol;
+  auto it = _tileTextures.find(key);
+
+  if (it != _tileTextures.end()) {
+    return it->second;
+  }
+
+  // fill the texels of the non empty blocks of the tile,
+  // using a logarithmic scale to keep sparse blocks visible
+  uint tileSize = level.tileSize;
+  vector<Color> texels(tileSize * tileSize, Color(0, 0, 0, 0));
+  float maxValue = log1p(level.maxValue);
+  auto [cell, last] = level.tileCells(tileRow, tileCol);
+
+  for (; cell != last; ++cell) {
+    float pos = maxValue > 0 ? log1p(cell->value) / maxValue : 1;
+    texels[(cell->row % tileSize) * tileSize + (cell->col % tileSize)] =
+        _colorScale.getColorAtPos(pos);
+  }
+
+  GLuint textureId;
+  glGenTextures(1, &textureId);
+  glBindTexture(GL_TEXTURE_2D, textureId);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tileSize, tileSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+               texels.data());
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  string textureName = "MatrixView_cells_" + to_string(reinterpret_cast<uintptr_t>(this)) + "_" +
+                       to_string(tileRow) + "_" + to_string(tileCol);
+  GlTextureManager::registerExternalTexture(textureName, textureId);
+  return _tileTextures[key] = textureName;
+}
+
+void GlMatrixCells::deleteTileTextures() {
+  for (const auto &[key, textureName] : _tileTextures) {
+    GlTextureManager::deleteTexture(textureName);
+  }
+
+  _tileTextures.clear();
+}
+}
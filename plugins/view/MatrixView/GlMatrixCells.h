@@ -0,0 +1,62 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef GL_MATRIX_CELLS_H
+#define GL_MATRIX_CELLS_H
+
+#include <talipot/GlEntity.h>
+#include <talipot/ColorScale.h>
+#include <talipot/hash.h>
+
+#include "MatrixCells.h"
+
+namespace tlp {
+class MatrixView;
+
+/**
+ * Draws the cells of the adjacency matrix from the sparse cell list of a MatrixView.
+ *
+ * When the cells are smaller than a few pixels, the matrix is aggregated
+ * by blocks of cells (one block per pixel at most) and rendered as textured tiles
+ * of tileSize x tileSize blocks which are only generated when visible.
+ * When zoomed in far enough, each visible cell is drawn as a square
+ * filled with the color of its edge, and its edge is displayed by the view
+ * as in the elements rendering mode, so it can be picked and selected.
+ */
+class GlMatrixCells : public tlp::GlEntity {
+public:
+  GlMatrixCells(MatrixView *view);
+  ~GlMatrixCells() override;
+  tlp::BoundingBox getBoundingBox() override;
+  void draw(float lod, tlp::Camera *camera) override;
+
+  void getXML(std::string &) override {}
+  void setWithXML(const std::string &, uint &) override {}
+
+private:
+  void drawElements(const AggregatedCellsLevel &level, uint firstRow, uint lastRow, uint firstCol,
+                    uint lastCol, std::vector<tlp::edge> &edges);
+  void drawTile(const AggregatedCellsLevel &level, uint tileRow, uint tileCol);
+  const std::string &tileTexture(const AggregatedCellsLevel &level, uint tileRow, uint tileCol);
+  void deleteTileTextures();
+
+  MatrixView *_view;
+  ColorScale _colorScale;
+  // key of the aggregated level the cached tile textures have been generated from
+  uint _texturesVersion;
+  uint _texturesBlockSize;
+  CellAggregationFunction _texturesFunction;
+  flat_hash_map<uint64_t, std::string> _tileTextures;
+};
+}
+#endif // GL_MATRIX_CELLS_H
@@ -0,0 +1,159 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include "MatrixCells.h"
+
+#include <talipot/GraphParallelTools.h>
+
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+namespace tlp {
+
+pair<const AggregatedCell *, const AggregatedCell *>
+AggregatedCellsLevel::tileCells(uint tileRow, uint tileCol) const {
+  auto tileLess = [this](uint rowA, uint colA, uint rowB, uint colB) {
+    rowA /= tileSize;
+    rowB /= tileSize;
+    return rowA < rowB || (rowA == rowB && colA / tileSize < colB / tileSize);
+  };
+  uint row = tileRow * tileSize, col = tileCol * tileSize;
+  auto first = lower_bound(cells.begin(), cells.end(), pair<uint, uint>(row, col),
+                           [&](const AggregatedCell &c, const pair<uint, uint> &p) {
+                             return tileLess(c.row, c.col, p.first, p.second);
+                           });
+  auto last = upper_bound(first, cells.end(), pair<uint, uint>(row, col),
+                          [&](const pair<uint, uint> &p, const AggregatedCell &c) {
+                            return tileLess(p.first, p.second, c.row, c.col);
+                          });
+  return {cells.data() + (first - cells.begin()), cells.data() + (last - cells.begin())};
+}
+
+MatrixCells::MatrixCells(uint tileSize)
+    : _tileSize(tileSize), _valid(false), _oriented(false), _version(0) {}
+
+void MatrixCells::build(const Graph *graph, bool oriented) {
+  _oriented = oriented;
+  _cells.resize(graph->numberOfEdges());
+  TLP_PARALLEL_MAP_EDGES_AND_INDICES(graph, [&](const edge e, uint i) {
+    const auto &[src, tgt] = graph->ends(e);
+    _cells[i] = {graph->nodePos(src), graph->nodePos(tgt), e.id};
+  });
+  _levels.clear();
+  _valid = true;
+  ++_version;
+}
+
+void MatrixCells::setNodesOrder(const Graph *graph, const vector<node> &orderedNodes) {
+  _ranks.resize(orderedNodes.size());
+  TLP_PARALLEL_MAP_VECTOR_AND_INDICES(orderedNodes, [&](const node n, uint rank) {
+    _ranks[graph->nodePos(n)] = rank;
+  });
+  _levels.clear();
+  ++_version;
+}
+
+void MatrixCells::clear() {
+  _cells.clear();
+  _ranks.clear();
+  _levels.clear();
+  _valid = false;
+  ++_version;
+}
+
+const AggregatedCellsLevel &MatrixCells::level(uint blockSize, CellAggregationFunction function) {
+  AggregatedCellsLevel &level = _levels[{blockSize, function}];
+
+  if (level.blockSize == 0) {
+    level.blockSize = blockSize;
+    level.tileSize = _tileSize;
+    computeLevel(level, function);
+  }
+
+  return level;
+}
+
+void MatrixCells::computeLevel(AggregatedCellsLevel &level,
+                               CellAggregationFunction function) const {
+  struct Entry {
+    uint row;
+    uint col;
+    uint edge;
+  };
+
+  // get the display coordinates of the cells filled by each edge,
+  // an undirected edge also fills its symmetric cell unless it is a loop
+  uint nbCells = _cells.size();
+  vector<Entry> entries(_oriented ? nbCells : 2 * nbCells);
+  TLP_PARALLEL_MAP_INDICES(nbCells, [&](uint i) {
+    const Cell &cell = _cells[i];
+    uint row = _ranks[cell.src], col = _ranks[cell.tgt];
+    entries[i] = {row, col, cell.edge};
+
+    if (!_oriented) {
+      entries[nbCells + i] = {cell.src == cell.tgt ? UINT_MAX : col, row, cell.edge};
+    }
+  });
+
+  // sort them by tile, then by block and finally by cell
+  uint blockSize = level.blockSize;
+  uint64_t tileExtent = uint64_t(blockSize) * level.tileSize;
+  sort(entries.begin(), entries.end(), [&](const Entry &a, const Entry &b) {
+    if (a.row / tileExtent != b.row / tileExtent) {
+      return a.row / tileExtent < b.row / tileExtent;
+    }
+    if (a.col / tileExtent != b.col / tileExtent) {
+      return a.col / tileExtent < b.col / tileExtent;
+    }
+    if (a.row / blockSize != b.row / blockSize) {
+      return a.row / blockSize < b.row / blockSize;
+    }
+    if (a.col / blockSize != b.col / blockSize) {
+      return a.col / blockSize < b.col / blockSize;
+    }
+    return a.row < b.row || (a.row == b.row && a.col < b.col);
+  });
+
+  // then aggregate each run of entries falling in the same block
+  level.cells.clear();
+  level.maxValue = 0;
+  uint i = 0, nbEntries = entries.size();
+
+  while (i < nbEntries && entries[i].row != UINT_MAX) {
+    const Entry &first = entries[i];
+    uint blockRow = first.row / blockSize, blockCol = first.col / blockSize;
+    uint nbEdges = 0, nbDistinctCells = 0, maxMultiplicity = 0, multiplicity = 0;
+
+    for (; i < nbEntries && entries[i].row != UINT_MAX && entries[i].row / blockSize == blockRow &&
+           entries[i].col / blockSize == blockCol;
+         ++i) {
+      if (nbEdges == 0 || entries[i].row != entries[i - 1].row ||
+          entries[i].col != entries[i - 1].col) {
+        ++nbDistinctCells;
+        multiplicity = 0;
+      }
+
+      maxMultiplicity = max(maxMultiplicity, ++multiplicity);
+      ++nbEdges;
+    }
+
+    float value = function == AGGREGATE_SUM     ? nbEdges
+                  : function == AGGREGATE_COUNT ? nbDistinctCells
+                                                : maxMultiplicity;
+    level.cells.push_back({blockRow, blockCol, value, first.edge});
+    level.maxValue = max(level.maxValue, value);
+  }
+}
+}
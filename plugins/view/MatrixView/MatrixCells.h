@@ -0,0 +1,138 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef MATRIX_CELLS_H
+#define MATRIX_CELLS_H
+
+#include <talipot/Graph.h>
+
+#include <map>
+#include <vector>
+
+namespace tlp {
+
+enum CellAggregationFunction { AGGREGATE_MAX = 0, AGGREGATE_SUM = 1, AGGREGATE_COUNT = 2 };
+
+/**
+ * A block of blockSize x blockSize matrix cells aggregated into a single value.
+ * row and col are expressed in blocks, edge is one of the edges falling in the block.
+ */
+struct AggregatedCell {
+  uint row;
+  uint col;
+  float value;
+  uint edge;
+};
+
+/**
+ * All the non empty blocks of the matrix for a given block size, sorted by tile
+ * (tileSize x tileSize blocks) then by row and column inside each tile.
+ */
+struct AggregatedCellsLevel {
+  uint blockSize = 0;
+  uint tileSize = 0;
+  float maxValue = 0;
+  std::vector<AggregatedCell> cells;
+
+  /**
+   * Returns the range [first, last[ of the cells located in the given tile.
+   */
+  std::pair<const AggregatedCell *, const AggregatedCell *> tileCells(uint tileRow,
+                                                                      uint tileCol) const;
+};
+
+/**
+ * Sparse representation of the adjacency matrix of a graph.
+ *
+ * Each edge is stored once as a (source index, target index) pair; the display
+ * position of a node is given by a rank permutation so reordering the matrix
+ * does not require to rebuild the cell list, only the aggregated levels which
+ * are lazily computed and cached.
+ */
+class MatrixCells {
+public:
+  MatrixCells(uint tileSize = 256);
+
+  /**
+   * Rebuilds the cell list from the edges of the graph.
+   * When oriented is false, each edge also fills its symmetric cell.
+   * setNodesOrder must then be called before querying the aggregated levels.
+   */
+  void build(const Graph *graph, bool oriented);
+
+  /**
+   * Sets the display order of the graph nodes.
+   */
+  void setNodesOrder(const Graph *graph, const std::vector<node> &orderedNodes);
+
+  /**
+   * Drops the cell list, build must be called before using it again.
+   */
+  void clear();
+
+  bool isValid() const {
+    return _valid;
+  }
+
+  /**
+   * Returns the number of rows (and columns) of the matrix.
+   */
+  uint dimension() const {
+    return _ranks.size();
+  }
+
+  uint tileSize() const {
+    return _tileSize;
+  }
+
+  /**
+   * Returns the number of graph edges stored in the cell list.
+   */
+  uint numberOfEdges() const {
+    return _cells.size();
+  }
+
+  /**
+   * Returns the aggregation of the matrix by blocks of blockSize x blockSize cells,
+   * computing it if needed.
+   */
+  const AggregatedCellsLevel &level(uint blockSize, CellAggregationFunction function);
+
+  /**
+   * Incremented each time the cells or their ordering change.
+   */
+  uint version() const {
+    return _version;
+  }
+
+private:
+  struct Cell {
+    uint src;
+    uint tgt;
+    uint edge;
+  };
+
+  void computeLevel(AggregatedCellsLevel &level, CellAggregationFunction function) const;
+
+  uint _tileSize;
+  bool _valid;
+  bool _oriented;
+  uint _version;
+  std::vector<Cell> _cells;
+  // display position of each node, indexed by node position in the graph
+  std::vector<uint> _ranks;
+  std::map<std::pair<uint, CellAggregationFunction>, AggregatedCellsLevel> _levels;
+};
+}
+
+#endif // MATRIX_CELLS_H
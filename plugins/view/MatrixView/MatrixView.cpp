@@ -12,10 +12,12 @@
  */
 
 #include <QMenu>
+#include <QTimer>
 
 #include "MatrixView.h"
 #include "PropertyValuesDispatcher.h"
 #include "GlMatrixBackgroundGrid.h"
+#include "GlMatrixCells.h"
 #include "MatrixViewQuickAccessBar.h"
 
 #include <talipot/TlpQtTools.h>
@@ -28,12 +30,15 @@ using namespace std;
 
 namespace tlp {
 
+// number of edges above which the cells are aggregated in automatic rendering mode
+static const uint AGGREGATED_CELLS_MIN_NB_EDGES = 50000;
+
 MatrixView::MatrixView(const PluginContext *)
     : NodeLinkDiagramView(), _bar(nullptr), _matrixGraph(nullptr),
       _graphEntitiesToDisplayedNodes(nullptr), _displayedNodesToGraphEntities(nullptr),
       _displayedEdgesToGraphEdges(nullptr), _displayedNodesAreNodes(nullptr), _dispatcher(nullptr),
       _configurationWidget(nullptr), _mustUpdateSizes(false), _mustUpdateLayout(false),
-      _isOriented(false) {}
+      _isOriented(false), _aggregatedCells(false), _elementCellsUpdateQueued(false) {}
 
 MatrixView::~MatrixView() {
   deleteDisplayedGraph();
@@ -65,14 +70,32 @@ void MatrixView::setState(const DataSet &ds) {
             this, &MatrixView::enableEdgeColorInterpolation);
     connect(_configurationWidget, &MatrixViewConfigurationWidget::updateOriented, this,
             &MatrixView::setOriented);
+    connect(_configurationWidget, &MatrixViewConfigurationWidget::renderingModeChanged, this,
+            &MatrixView::setRenderingMode);
+    connect(_configurationWidget, &MatrixViewConfigurationWidget::cellAggregationFunctionChanged,
+            this, &MatrixView::setCellAggregationFunction);
   }
 
   _configurationWidget->setGraph(graph());
 
+  unsigned renderingMode = RENDER_AUTOMATIC;
+  ds.get("rendering mode", renderingMode);
+  _configurationWidget->setRenderingMode(renderingMode);
+
+  unsigned cellAggregation = AGGREGATE_MAX;
+  ds.get("cells aggregation", cellAggregation);
+  _configurationWidget->setCellAggregationFunction(cellAggregation);
+
+  // the number of displayed nodes per edge depends on the orientation
+  bool status = false;
+  ds.get("oriented", status);
+  _isOriented = status;
+  _configurationWidget->setOriented(status);
+
   initDisplayedGraph();
   registerTriggers();
 
-  bool status = true;
+  status = true;
   ds.get("show Edges", status);
   showEdges(status);
   _configurationWidget->setDisplayEdges(status);
@@ -92,10 +115,6 @@ void MatrixView::setState(const DataSet &ds) {
   ds.get("ordering", orderingindex);
   _configurationWidget->setOrderingProperty(orderingindex);
 
-  status = false;
-  ds.get("oriented", status);
-  _isOriented = status;
-  _configurationWidget->setOriented(status);
   status = false;
 
   ds.get("edge color interpolation", status);
@@ -123,7 +142,14 @@ void MatrixView::enableEdgeColorInterpolation(bool flag) {
 }
 
 void MatrixView::setOriented(bool flag) {
-  if (flag != _isOriented) {
+  if (flag != _isOriented && _aggregatedCells) {
+    // the cells displayed as elements have a displayed node per orientation
+    clearElementCells();
+    _isOriented = flag;
+    _cells.clear();
+    _mustUpdateLayout = true;
+    emit drawNeeded();
+  } else if (flag != _isOriented) {
     _isOriented = flag;
     Observable::holdObservers();
 
@@ -157,6 +183,16 @@ void MatrixView::setOriented(bool flag) {
   }
 }
 
+void MatrixView::setRenderingMode() {
+  // the displayed graph has to be rebuilt
+  setState(state());
+  emit drawNeeded();
+}
+
+void MatrixView::setCellAggregationFunction() {
+  emit drawNeeded();
+}
+
 void MatrixView::graphChanged(Graph *) {
   setState(DataSet());
 }
@@ -170,6 +206,8 @@ DataSet MatrixView::state() const {
   ds.set("Background Color", glWidget()->scene()->getBackgroundColor());
   ds.set("ordering", _configurationWidget->orderingProperty());
   ds.set("oriented", _isOriented);
+  ds.set("rendering mode", uint(_configurationWidget->renderingMode()));
+  ds.set("cells aggregation", uint(_configurationWidget->cellAggregationFunction()));
 
   if (needQuickAccessBar) {
     ds.set("quickAccessBarVisible", quickAccessBarVisible());
@@ -262,14 +300,28 @@ void MatrixView::initDisplayedGraph() {
   _mustUpdateSizes = true;
 
   deleteDisplayedGraph();
+  _elementCells.clear();
+  _nextElementCells.clear();
 
   if (graph() == nullptr) {
     return;
   }
 
+  MatrixRenderingMode renderingMode = _configurationWidget->renderingMode();
+  _aggregatedCells = renderingMode == RENDER_AGGREGATED_CELLS ||
+                     (renderingMode == RENDER_AUTOMATIC &&
+                      graph()->numberOfEdges() > AGGREGATED_CELLS_MIN_NB_EDGES);
+  _cells.clear();
+
   _matrixGraph = newGraph();
-  _matrixGraph->reserveNodes(2 * (graph()->numberOfNodes() + graph()->numberOfEdges()));
-  _matrixGraph->reserveEdges(graph()->numberOfEdges());
+
+  if (_aggregatedCells) {
+    // only the nodes are displayed, edges are drawn from the matrix cells
+    _matrixGraph->reserveNodes(2 * graph()->numberOfNodes());
+  } else {
+    _matrixGraph->reserveNodes(2 * (graph()->numberOfNodes() + graph()->numberOfEdges()));
+    _matrixGraph->reserveEdges(graph()->numberOfEdges());
+  }
 
   _graphEntitiesToDisplayedNodes = new IntegerVectorProperty(graph());
   _displayedNodesAreNodes = new BooleanProperty(_matrixGraph);
@@ -282,8 +334,10 @@ void MatrixView::initDisplayedGraph() {
     addNode(graph(), n);
   }
 
-  for (auto e : graph()->edges()) {
-    addEdge(graph(), e);
+  if (!_aggregatedCells) {
+    for (auto e : graph()->edges()) {
+      addEdge(graph(), e);
+    }
   }
   Observable::unholdObservers();
 
@@ -313,6 +367,7 @@ void MatrixView::initDisplayedGraph() {
   _configurationWidget->setBackgroundColor(
       colorToQColor(glWidget()->scene()->getBackgroundColor()));
   addGridBackground();
+  updateCellsEntity();
 
   if (_mustUpdateSizes) {
     normalizeSizes();
@@ -375,10 +430,20 @@ void MatrixView::addEdge(tlp::Graph *g, const tlp::edge e) {
   _mustUpdateLayout = true;
   _mustUpdateSizes = true;
 
+  if (_aggregatedCells) {
+    _cells.clear();
+    return;
+  }
+
+  addEdgeElements(g, e);
+}
+
+void MatrixView::addEdgeElements(tlp::Graph *g, const tlp::edge e) {
   vector<int> edgeToDisplayedNodes;
   edgeToDisplayedNodes.reserve(2);
 
-  for (int i = 0; i < 2; ++i) {
+  // the symmetric node is only displayed when the matrix is not oriented
+  for (int i = 0; i < (_isOriented ? 1 : 2); ++i) {
     node dispEdge = _matrixGraph->addNode();
     edgeToDisplayedNodes.push_back(dispEdge);
     (*_displayedNodesToGraphEntities)[dispEdge] = e.id;
@@ -426,6 +491,7 @@ void MatrixView::treatEvent(const Event &message) {
 void MatrixView::delNode(tlp::Graph *, const tlp::node n) {
   _mustUpdateLayout = true;
   _mustUpdateSizes = true;
+  _cells.clear();
 
   const vector<int> &vect = (*_graphEntitiesToDisplayedNodes)[n];
 
@@ -438,6 +504,22 @@ void MatrixView::delEdge(tlp::Graph *, const tlp::edge e) {
   _mustUpdateLayout = true;
   _mustUpdateSizes = true;
 
+  if (_aggregatedCells) {
+    _cells.clear();
+    auto it = lower_bound(_elementCells.begin(), _elementCells.end(), e);
+
+    if (it != _elementCells.end() && *it == e) {
+      delEdgeElements(e);
+      _elementCells.erase(it);
+    }
+
+    return;
+  }
+
+  delEdgeElements(e);
+}
+
+void MatrixView::delEdgeElements(const tlp::edge e) {
   const vector<int> &vect = (*_graphEntitiesToDisplayedNodes)[e];
 
   for (auto id : vect) {
@@ -448,6 +530,94 @@ void MatrixView::delEdge(tlp::Graph *, const tlp::edge e) {
   _edgesMap.remove(e);
 }
 
+void MatrixView::clearElementCells() {
+  Observable::holdObservers();
+
+  for (auto e : _elementCells) {
+    delEdgeElements(e);
+    _graphEntitiesToDisplayedNodes->setEdgeValue(e, vector<int>());
+  }
+
+  Observable::unholdObservers();
+  _elementCells.clear();
+}
+
+void MatrixView::setElementCells(vector<edge> &&edges) {
+  sort(edges.begin(), edges.end());
+
+  if (!_elementCellsUpdateQueued && edges == _elementCells) {
+    return;
+  }
+
+  _nextElementCells = std::move(edges);
+
+  if (!_elementCellsUpdateQueued) {
+    _elementCellsUpdateQueued = true;
+    // the displayed graph can not be modified while it is drawn
+    QTimer::singleShot(0, this, &MatrixView::updateElementCells);
+  }
+}
+
+void MatrixView::updateElementCells() {
+  _elementCellsUpdateQueued = false;
+
+  if (!_aggregatedCells || _matrixGraph == nullptr) {
+    return;
+  }
+
+  vector<edge> removed, added;
+  set_difference(_elementCells.begin(), _elementCells.end(), _nextElementCells.begin(),
+                 _nextElementCells.end(), back_inserter(removed));
+  set_difference(_nextElementCells.begin(), _nextElementCells.end(), _elementCells.begin(),
+                 _elementCells.end(), back_inserter(added));
+
+  if (removed.empty() && added.empty()) {
+    return;
+  }
+
+  Observable::holdObservers();
+
+  for (auto e : removed) {
+    delEdgeElements(e);
+    _graphEntitiesToDisplayedNodes->setEdgeValue(e, vector<int>());
+  }
+
+  for (auto e : added) {
+    // the edge may have been deleted since the cells were drawn
+    if (!graph()->isElement(e)) {
+      continue;
+    }
+
+    addEdgeElements(graph(), e);
+    vector<int> edgeNodes = (*_graphEntitiesToDisplayedNodes)[e];
+
+    // the view properties of the edge are not dispatched to nodes added afterwards
+    for (const string &strProp : _sourceToTargetProperties) {
+      string value = graph()->getProperty(strProp)->getEdgeStringValue(e);
+      PropertyInterface *prop = _matrixGraph->getProperty(strProp);
+
+      for (auto id : edgeNodes) {
+        prop->setNodeStringValue(node(id), value);
+      }
+    }
+
+    layoutEdgeElements(e);
+    layoutDisplayedEdge(_edgesMap[e]);
+  }
+
+  _elementCells.clear();
+
+  for (auto e : _nextElementCells) {
+    if (graph()->isElement(e)) {
+      _elementCells.push_back(e);
+    }
+  }
+
+  _nextElementCells.clear();
+  Observable::unholdObservers();
+  emit drawNeeded();
+}
+
 template <typename PROPTYPE>
 struct AscendingPropertySorter {
   PROPTYPE *prop;
@@ -536,50 +706,77 @@ void MatrixView::updateLayout() {
     vert[1] -= 1;
   }
 
-  IntegerProperty *shapes = glWidget()->inputData()->shapes();
-  int shape = GlyphManager::glyphId("2D - Square");
-  for (auto e : graph()->edges()) {
-    const auto &[src, tgt] = graph()->ends(e);
-    const vector<int> &srcNodes = (*_graphEntitiesToDisplayedNodes)[src],
-                      &tgtNodes = (*_graphEntitiesToDisplayedNodes)[tgt],
-                      &edgeNodes = (*_graphEntitiesToDisplayedNodes)[e];
-
-    // 0 => horizontal line, 1 => vertical line
-    Coord src0 = (*layout)[node(srcNodes[0])], tgt0 = (*layout)[node(tgtNodes[0])],
-          src1 = (*layout)[node(srcNodes[1])], tgt1 = (*layout)[node(tgtNodes[1])];
+  if (_aggregatedCells) {
+    // edges are drawn from the matrix cells, only their ordering has to be updated
+    if (!_cells.isValid()) {
+      _cells.build(graph(), _isOriented);
+    }
 
-    layout->setNodeValue(node(edgeNodes[0]), Coord(tgt0[0], src1[1], 0));
-    shapes->setNodeValue(node(edgeNodes[0]), shape);
+    _cells.setNodesOrder(graph(), _orderedNodes);
 
-    if (!_isOriented) {
-      layout->setNodeValue(node(edgeNodes[1]), Coord(src0[0], tgt1[1], 0));
-      shapes->setNodeValue(node(edgeNodes[1]), shape);
+    for (auto e : _elementCells) {
+      layoutEdgeElements(e);
+      layoutDisplayedEdge(_edgesMap[e]);
     }
+
+    unholdObservers();
+    return;
+  }
+
+  for (auto e : graph()->edges()) {
+    layoutEdgeElements(e);
   }
 
   for (auto e : _matrixGraph->edges()) {
-    const auto &[src, tgt] = _matrixGraph->ends(e);
-
-    auto srcPos = (*layout)[src];
-    auto tgtPos = (*layout)[tgt];
-    float xMax = max(srcPos[0], tgtPos[0]);
-    float xMin = min(srcPos[0], tgtPos[0]);
-    float dist = (xMax - xMin);
-    std::vector<Coord> bends(4);
-    bends[0] = srcPos;
-    bends[1] = srcPos;
-    bends[1][1] += dist / 3. + 1.;
-    bends[2] = tgtPos;
-    bends[2][1] += dist / 3. + 1.;
-    bends[3] = tgtPos;
-    vector<Coord> curvePoints;
-    computeBezierPoints(bends, curvePoints, 20);
-    (*layout)[e] = curvePoints;
+    layoutDisplayedEdge(e);
   }
 
   unholdObservers();
 }
 
+void MatrixView::layoutEdgeElements(const tlp::edge e) {
+  LayoutProperty *layout = glWidget()->inputData()->layout();
+  IntegerProperty *shapes = glWidget()->inputData()->shapes();
+  int shape = GlyphManager::glyphId("2D - Square");
+  const auto &[src, tgt] = graph()->ends(e);
+  const vector<int> &srcNodes = (*_graphEntitiesToDisplayedNodes)[src],
+                    &tgtNodes = (*_graphEntitiesToDisplayedNodes)[tgt],
+                    &edgeNodes = (*_graphEntitiesToDisplayedNodes)[e];
+
+  // 0 => horizontal line, 1 => vertical line
+  Coord src0 = (*layout)[node(srcNodes[0])], tgt0 = (*layout)[node(tgtNodes[0])],
+        src1 = (*layout)[node(srcNodes[1])], tgt1 = (*layout)[node(tgtNodes[1])];
+
+  layout->setNodeValue(node(edgeNodes[0]), Coord(tgt0[0], src1[1], 0));
+  shapes->setNodeValue(node(edgeNodes[0]), shape);
+
+  if (!_isOriented) {
+    layout->setNodeValue(node(edgeNodes[1]), Coord(src0[0], tgt1[1], 0));
+    shapes->setNodeValue(node(edgeNodes[1]), shape);
+  }
+}
+
+void MatrixView::layoutDisplayedEdge(const tlp::edge e) {
+  LayoutProperty *layout = glWidget()->inputData()->layout();
+  const auto &[src, tgt] = _matrixGraph->ends(e);
+
+  auto srcPos = (*layout)[src];
+  auto tgtPos = (*layout)[tgt];
+  float xMax = max(srcPos[0], tgtPos[0]);
+  float xMin = min(srcPos[0], tgtPos[0]);
+  float dist = (xMax - xMin);
+  std::vector<Coord> bends(4);
+  bends[0] = srcPos;
+  bends[1] = srcPos;
+  bends[1][1] += dist / 3. + 1.;
+  bends[2] = tgtPos;
+  bends[2][1] += dist / 3. + 1.;
+  bends[3] = tgtPos;
+  vector<Coord> curvePoints;
+  computeBezierPoints(bends, curvePoints, 20);
+  (*layout)[e] = curvePoints;
+}
+
 void MatrixView::setBackgroundColor(QColor c) {
   glWidget()->scene()->setBackgroundColor(QColorToColor(c));
   emit drawNeeded();
@@ -642,6 +839,15 @@ void MatrixView::removeGridBackground() {
   }
 }
 
+void MatrixView::updateCellsEntity() {
+  GlLayer *backgroundLayer = glWidget()->scene()->getLayer("MatrixView_Background");
+  delete backgroundLayer->findGlEntity("MatrixView_cells");
+
+  if (_aggregatedCells) {
+    backgroundLayer->addGlEntity(new GlMatrixCells(this), "MatrixView_cells");
+  }
+}
+
 void MatrixView::applySettings() {
   _mustUpdateLayout = true;
   emit drawNeeded();
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -17,6 +17,7 @@
 #include <talipot/NodeLinkDiagramView.h>
 #include <set>
 #include "MatrixViewConfigurationWidget.h"
+#include "MatrixCells.h"
 
 #include "../../utils/PluginNames.h"
 
@@ -92,6 +93,20 @@ public:
     return _configurationWidget->gridDisplayMode();
   }
 
+  CellAggregationFunction cellAggregationFunction() const {
+    return _configurationWidget->cellAggregationFunction();
+  }
+
+  MatrixCells &matrixCells() {
+    return _cells;
+  }
+
+  /**
+   * In aggregated cells mode, sets the edges of the cells drawn one by one. They are then
+   * displayed as in the elements mode, so they can be picked and selected.
+   */
+  void setElementCells(std::vector<tlp::edge> &&edges);
+
   void addNode(tlp::Graph *, const tlp::node);
   void addEdge(tlp::Graph *, const tlp::edge);
   void delNode(tlp::Graph *, const tlp::node);
@@ -108,6 +123,9 @@ private slots:
   void showEdges(bool);
   void enableEdgeColorInterpolation(bool);
   void setOriented(bool);
+  void setRenderingMode();
+  void setCellAggregationFunction();
+  void updateElementCells();
 
 private:
   void registerTriggers();
@@ -128,6 +146,16 @@ private:
   bool _mustUpdateLayout;
   bool _isOriented;
 
+  // when true, the edges are not mapped to displayed nodes
+  // but drawn from the sparse matrix cells
+  bool _aggregatedCells;
+  MatrixCells _cells;
+  // in aggregated cells mode, the sorted edges displayed as in the elements mode,
+  // and the ones to display at the next update
+  std::vector<tlp::edge> _elementCells;
+  std::vector<tlp::edge> _nextElementCells;
+  bool _elementCellsUpdateQueued;
+
   std::set<std::string> _sourceToTargetProperties;
   std::string _orderingMetricName;
   std::vector<node> _orderedNodes;
@@ -136,6 +164,12 @@ private:
   void initDisplayedGraph();
   void addGridBackground();
   void removeGridBackground();
+  void updateCellsEntity();
+  void addEdgeElements(tlp::Graph *, const tlp::edge);
+  void delEdgeElements(const tlp::edge);
+  void clearElementCells();
+  void layoutEdgeElements(const tlp::edge);
+  void layoutDisplayedEdge(const tlp::edge);
   void normalizeSizes(double max = 1);
   void updateNodesOrder();
   void updateLayout();
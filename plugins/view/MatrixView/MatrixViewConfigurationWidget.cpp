@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -35,6 +35,10 @@ MatrixViewConfigurationWidget::MatrixViewConfigurationWidget(QWidget *parent)
           &MatrixViewConfigurationWidget::updateOriented);
   connect(_ui->ascendingOrderCBox, &QAbstractButton::toggled, this,
           &MatrixViewConfigurationWidget::orderingDirectionChanged);
+  connect(_ui->renderingModeCombo, QOverload<int>::of(&QComboBox::activated), this,
+          &MatrixViewConfigurationWidget::renderingModeChanged);
+  connect(_ui->cellsAggregationCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &MatrixViewConfigurationWidget::cellAggregationFunctionChanged);
 }
 
 MatrixViewConfigurationWidget::~MatrixViewConfigurationWidget() {
@@ -144,4 +148,20 @@ void MatrixViewConfigurationWidget::setOrderingProperty(int index) {
 void MatrixViewConfigurationWidget::setgridmode(int index) {
   _ui->gridDisplayCombo->setCurrentIndex(index);
 }
+
+MatrixRenderingMode MatrixViewConfigurationWidget::renderingMode() const {
+  return static_cast<MatrixRenderingMode>(_ui->renderingModeCombo->currentIndex());
+}
+
+void MatrixViewConfigurationWidget::setRenderingMode(int index) {
+  _ui->renderingModeCombo->setCurrentIndex(index);
+}
+
+CellAggregationFunction MatrixViewConfigurationWidget::cellAggregationFunction() const {
+  return static_cast<CellAggregationFunction>(_ui->cellsAggregationCombo->currentIndex());
+}
+
+void MatrixViewConfigurationWidget::setCellAggregationFunction(int index) {
+  _ui->cellsAggregationCombo->setCurrentIndex(index);
+}
 }
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -18,6 +18,8 @@
 
 #include <talipot/Color.h>
 
+#include "MatrixCells.h"
+
 namespace Ui {
 class MatrixViewConfigurationWidget;
 }
@@ -27,6 +29,8 @@ class Graph;
 
 enum GridDisplayMode { SHOW_ALWAYS = 0, SHOW_NEVER = 1, SHOW_ON_ZOOM = 2 };
 
+enum MatrixRenderingMode { RENDER_AUTOMATIC = 0, RENDER_ELEMENTS = 1, RENDER_AGGREGATED_CELLS = 2 };
+
 class MatrixViewConfigurationWidget : public QWidget {
   Q_OBJECT
 
@@ -50,6 +54,10 @@ public:
   void setAscendingOrder(const bool state);
   bool ascendingOrder() const;
   void setOriented(const bool state);
+  MatrixRenderingMode renderingMode() const;
+  void setRenderingMode(int index);
+  CellAggregationFunction cellAggregationFunction() const;
+  void setCellAggregationFunction(int index);
 
 protected slots:
   void orderingMetricComboIndexChanged(int i);
@@ -62,6 +70,8 @@ signals:
   void showEdges(bool);
   void enableEdgeColorInterpolation(bool);
   void updateOriented(bool);
+  void renderingModeChanged();
+  void cellAggregationFunctionChanged();
 
 private:
   bool _modifyingMetricList;
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -26,6 +26,7 @@ class GlWidget;
 class GlProgressBar;
 class ParallelCoordinatesGraphProxy;
 class ParallelAxis;
+class ParallelCoordsGlLines;
 class LayoutProperty;
 class SizeProperty;
 class IntegerProperty;
@@ -42,6 +43,8 @@ public:
 
   enum LinesThickness { THICK = 0, THIN };
 
+  enum LinesRendering { ELEMENTS_RENDERING = 0, BUFFERS_RENDERING };
+
   enum HighlightedEltsSetOp { NONE = 0, INTERSECTION, UNION };
 
   ParallelCoordinatesDrawing(ParallelCoordinatesGraphProxy *graphProxy, Graph *axisPointsGraph);
@@ -90,6 +93,24 @@ public:
   void setLinesThickness(const LinesThickness linesThickness) {
     this->linesThickness = linesThickness;
   }
+  void setLinesRendering(const LinesRendering linesRendering) {
+    this->linesRendering = linesRendering;
+  }
+  void setDensityBlending(const bool densityBlending) {
+    this->densityBlending = densityBlending;
+  }
+  /**
+   * Returns true if the lines are currently drawn from vertex buffers,
+   * only straight lines can be rendered that way.
+   */
+  bool linesInBuffers() const {
+    return linesRendering == BUFFERS_RENDERING && linesType == STRAIGHT;
+  }
+  /**
+   * Inserts in dataIds the ids of the data whose line drawn
+   * from vertex buffers crosses the given region.
+   */
+  void getDataInRegion(const BoundingBox &region, std::set<uint> &dataIds) const;
   std::vector<ParallelAxis *> getAllAxis();
 
   void resetAxisLayoutNextUpdate() {
@@ -110,7 +131,10 @@ private:
   void createAxis(GlWidget *glWidget, GlProgressBar *progressBar);
   void destroyAxisIfNeeded();
   void plotAllData(GlWidget *glWidget, GlProgressBar *progressBar);
+  void plotAllDataInBuffers(GlWidget *glWidget, GlProgressBar *progressBar);
   void plotData(const uint dataIdx, const Color &color);
+  void addAxisPoint(const uint dataId, const Coord &pointCoord, const Size &pointSize);
+  void listenAxisProperties();
 
   void erase();
   void eraseDataPlot();
@@ -140,6 +164,9 @@ private:
 
   GlComposite *dataPlotComposite;
   GlComposite *axisPlotComposite;
+  ParallelCoordsGlLines *dataLinesPlot;
+  // the properties of the axis whose modifications invalidate the cached positions of the data
+  std::set<PropertyInterface *> listenedProperties;
 
   bool createAxisFlag;
   std::set<uint> lastHighlightedElements;
@@ -155,6 +182,8 @@ private:
   LayoutType layoutType;
   LinesType linesType;
   LinesThickness linesThickness;
+  LinesRendering linesRendering;
+  bool densityBlending;
 
   bool resetAxisLayout;
 };
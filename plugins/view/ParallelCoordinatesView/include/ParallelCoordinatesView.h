@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -136,6 +136,7 @@ public:
   ParallelCoordinatesDrawing::LayoutType getLayoutType() const;
   ParallelCoordinatesDrawing::LinesType getLinesType() const;
   ParallelCoordinatesDrawing::LinesThickness getLinesThickness() const;
+  ParallelCoordinatesDrawing::LinesRendering getLinesRendering() const;
 
   // uint getSpaceBetweenAxis() {return drawConfigWidget->getSpaceBetweenAxis();}
 
@@ -194,6 +195,9 @@ private:
   QAction *cubicBSplineInterpolationLinesType;
   QAction *thickLines;
   QAction *thinLines;
+  QAction *elementsLinesRendering;
+  QAction *buffersLinesRendering;
+  QAction *densityBlending;
   QAction *addRemoveDataFromSelection;
   QAction *selectData;
   QAction *deleteData;
@@ -0,0 +1,136 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef PARALLEL_COORDS_GL_LINES_H
+#define PARALLEL_COORDS_GL_LINES_H
+
+#include <talipot/GlEntity.h>
+#include <talipot/Color.h>
+#include <talipot/Graph.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace tlp {
+
+class ParallelAxis;
+
+/**
+ * Draws the polylines of the parallel coordinates from vertex arrays
+ * instead of creating one GlEntity per data.
+ *
+ * The position of each data along an axis is cached in a column of normalized
+ * offsets, which is only recomputed when the axis scale changes or when
+ * the associated property is invalidated. The vertices are stored by segment
+ * (the lines portions between two consecutive axes) so when an axis is moved
+ * only its two adjacent segments are regenerated, in parallel over the data.
+ */
+class ParallelCoordsGlLines : public GlEntity {
+
+public:
+  ParallelCoordsGlLines();
+
+  /**
+   * Sets the data to draw and the half width of their lines (only used for thick lines).
+   */
+  void setData(ElementType dataLocation, std::vector<uint> &&dataIds,
+               std::vector<float> &&linesHalfWidth);
+
+  /**
+   * Sets the color of the lines of each data and the order they must be drawn with,
+   * the data are drawn in their natural order if drawOrder is empty.
+   */
+  void setColors(std::vector<Color> &&colors, std::vector<uint> &&drawOrder);
+
+  void setAxis(const std::vector<ParallelAxis *> &axis, bool closedLines, bool thickLines);
+
+  void setDensityBlending(const bool densityBlending) {
+    this->densityBlending = densityBlending;
+  }
+
+  /**
+   * Regenerates the segments whose axis have changed since the last call.
+   */
+  void updateGeometry();
+
+  /**
+   * Invalidates the cached positions of the data on the axis of the given property.
+   */
+  void invalidateColumn(const std::string &axisName);
+
+  void clear();
+
+  bool isEmpty() const {
+    return vertices.empty();
+  }
+
+  /**
+   * Inserts in data the ids of the data whose line crosses the given region.
+   */
+  void getDataInRegion(const BoundingBox &region, std::set<uint> &data) const;
+
+  void draw(float lod, Camera *camera) override;
+  void getXML(std::string &) override {}
+  void setWithXML(const std::string &, uint &) override {}
+
+private:
+  struct Column {
+    std::vector<float> offsets;
+    size_t scaleKey = 0;
+    uint version = 0;
+  };
+
+  struct AxisFrame {
+    Coord baseCoord;
+    float height;
+    float rotationAngle;
+    uint columnVersion;
+
+    bool operator==(const AxisFrame &) const = default;
+  };
+
+  const Column &column(ParallelAxis *axis);
+  void computeSegment(uint segment, const std::vector<const Column *> &axisColumns,
+                      const std::vector<AxisFrame> &axisFrames);
+  uint verticesPerLine() const {
+    return thickLines ? 4 : 2;
+  }
+  uint nbSegments() const;
+
+  ElementType dataLocation;
+  std::vector<uint> dataIds;
+  std::vector<float> linesHalfWidth;
+  std::vector<Color> colors;
+  std::vector<uint> drawOrder;
+
+  std::vector<ParallelAxis *> axis;
+  bool closedLines;
+  bool thickLines;
+  bool densityBlending;
+
+  std::map<std::string, Column> columns;
+  uint columnsVersion;
+  // axis frames the current segments have been computed with
+  std::vector<AxisFrame> frames;
+  bool geometryValid;
+
+  // vertices of the lines, stored segment by segment then data by data
+  std::vector<Coord> vertices;
+  // colors and indices of the vertices of a segment, shared by all the segments
+  std::vector<Color> verticesColors;
+  std::vector<uint> verticesIndices;
+};
+}
+
+#endif // PARALLEL_COORDS_GL_LINES_H
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2025  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -22,12 +22,14 @@
 #include <talipot/GlWidget.h>
 #include <talipot/ViewSettings.h>
 #include <talipot/TlpQtTools.h>
+#include <talipot/ParallelTools.h>
 
 #include "ParallelCoordinatesDrawing.h"
 #include "NominalParallelAxis.h"
 #include "QuantitativeParallelAxis.h"
 #include "ParallelTools.h"
 #include "ParallelCoordinatesGraphProxy.h"
+#include "ParallelCoordsGlLines.h"
 
 using namespace std;
 
@@ -39,7 +41,8 @@ ParallelCoordinatesDrawing::ParallelCoordinatesDrawing(ParallelCoordinatesGraphP
       spaceBetweenAxis(height / 2), linesColorAlphaValue(DEFAULT_LINES_COLOR_ALPHA_VALUE),
       drawPointsOnAxis(true), graphProxy(graph), backgroundColor(Color(255, 255, 255)),
       createAxisFlag(true), axisPointsGraph(axisPointsGraph), layoutType(PARALLEL),
-      linesType(STRAIGHT), linesThickness(THICK), resetAxisLayout(false) {
+      linesType(STRAIGHT), linesThickness(THICK), linesRendering(ELEMENTS_RENDERING),
+      densityBlending(false), resetAxisLayout(false) {
   axisPointsGraphLayout = axisPointsGraph->getLayoutProperty("viewLayout");
   axisPointsGraphSize = axisPointsGraph->getSizeProperty("viewSize");
   axisPointsGraphShape = axisPointsGraph->getIntegerProperty("viewShape");
@@ -49,11 +52,17 @@ ParallelCoordinatesDrawing::ParallelCoordinatesDrawing(ParallelCoordinatesGraphP
 
   dataPlotComposite = new GlComposite();
   axisPlotComposite = new GlComposite();
+  dataLinesPlot = new ParallelCoordsGlLines();
+  addGlEntity(dataLinesPlot, "data lines plot");
   addGlEntity(dataPlotComposite, "data plot composite");
   addGlEntity(axisPlotComposite, "axis plot composite");
 }
 
-ParallelCoordinatesDrawing::~ParallelCoordinatesDrawing() = default;
+ParallelCoordinatesDrawing::~ParallelCoordinatesDrawing() {
+  for (auto *property : listenedProperties) {
+    property->removeListener(this);
+  }
+}
 
 void ParallelCoordinatesDrawing::createAxis(GlWidget *glWidget, GlProgressBar *progressBar) {
 
@@ -221,6 +230,7 @@ void ParallelCoordinatesDrawing::createAxis(GlWidget *glWidget, GlProgressBar *p
 void ParallelCoordinatesDrawing::destroyAxisIfNeeded() {
   for (const auto &it : parallelAxis) {
     if (!graphProxy->existProperty(it.first)) {
+      dataLinesPlot->clear();
       delete it.second;
       parallelAxis.erase(it.first);
     }
@@ -230,6 +240,7 @@ void ParallelCoordinatesDrawing::destroyAxisIfNeeded() {
 void ParallelCoordinatesDrawing::plotAllData(GlWidget *glWidget, GlProgressBar *progressBar) {
   Color color;
   computeResizeFactor();
+  dataLinesPlot->clear();
 
   int currentStep = 0;
   int maxStep = graphProxy->getDataCount();
@@ -270,6 +281,148 @@ void ParallelCoordinatesDrawing::plotAllData(GlWidget *glWidget, GlProgressBar *
   lastHighlightedElements = graphProxy->getHighlightedElts();
 }
 
+void ParallelCoordinatesDrawing::plotAllDataInBuffers(GlWidget *glWidget,
+                                                      GlProgressBar *progressBar) {
+  computeResizeFactor();
+
+  if (progressBar) {
+    progressBar->setComment("Updating parallel coordinates ...");
+    progressBar->progress(0, 1);
+    glWidget->draw();
+    // needed to display progressBar
+    QApplication::processEvents();
+  }
+
+  vector<uint> dataIds;
+  dataIds.reserve(graphProxy->getDataCount());
+
+  for (uint dataId : graphProxy->getDataIterator()) {
+    dataIds.push_back(dataId);
+  }
+
+  uint nbData = dataIds.size();
+  Size eltMinSize = graphProxy->getSizeProperty("viewSize")->getMin();
+  Color selectionColor = glWidget->renderingParameters().getSelectionColor();
+  bool highlightedEltsSet = graphProxy->highlightedEltsSet();
+  vector<float> linesHalfWidth(nbData);
+  vector<Color> colors(nbData);
+  // 0 for the default lines, 1 for the highlighted ones, 2 for the selected ones
+  vector<uchar> drawLevels(nbData);
+
+  TLP_PARALLEL_MAP_INDICES(nbData, [&](uint i) {
+    uint dataId = dataIds[i];
+    Size adjustedViewSize =
+        axisPointMinSize + resizeFactor * (graphProxy->getDataViewSize(dataId) - eltMinSize);
+    float pointRadius =
+        ((adjustedViewSize[0] + adjustedViewSize[1] + adjustedViewSize[2]) / 3.0f) / 2.0f;
+    linesHalfWidth[i] = pointRadius - (1.0f / 10.0f) * pointRadius;
+    bool highlighted = graphProxy->isDataHighlighted(dataId);
+
+    if (graphProxy->isDataSelected(dataId)) {
+      colors[i] = selectionColor;
+      drawLevels[i] = 2;
+    } else {
+      colors[i] = graphProxy->getDataColor(dataId);
+
+      if (linesColorAlphaValue <= 255 && (highlighted || !highlightedEltsSet)) {
+        colors[i].setA(linesColorAlphaValue);
+      }
+
+      drawLevels[i] = highlighted ? 1 : 0;
+    }
+  });
+
+  // selected and highlighted lines are drawn last to stay visible
+  vector<uint> drawOrder;
+  drawOrder.reserve(nbData);
+
+  for (uchar level = 0; level < 3; ++level) {
+    for (uint i = 0; i < nbData; ++i) {
+      if (drawLevels[i] == level) {
+        drawOrder.push_back(i);
+      }
+    }
+  }
+
+  vector<ParallelAxis *> axis;
+
+  for (const auto &axisName : axisOrder) {
+    axis.push_back(parallelAxis[axisName]);
+  }
+
+  listenAxisProperties();
+
+  dataLinesPlot->setData(graphProxy->getDataLocation(), std::move(dataIds),
+                         std::move(linesHalfWidth));
+  dataLinesPlot->setAxis(axis, layoutType == CIRCULAR, linesThickness == THICK);
+  dataLinesPlot->setColors(std::move(colors), std::move(drawOrder));
+  dataLinesPlot->setDensityBlending(densityBlending);
+  dataLinesPlot->updateGeometry();
+
+  // only the points of the selected data are drawn on the axis
+  // to avoid creating as many nodes as lines vertices
+  if (drawPointsOnAxis) {
+    for (uint dataId : graphProxy->getSelectedDataIterator()) {
+      Size adjustedViewSize =
+          axisPointMinSize + resizeFactor * (graphProxy->getDataViewSize(dataId) - eltMinSize);
+
+      for (auto *ax : axis) {
+        addAxisPoint(dataId, ax->getPointCoordOnAxisForData(dataId), adjustedViewSize);
+      }
+    }
+  }
+
+  lastHighlightedElements = graphProxy->getHighlightedElts();
+}
+
+// the cached positions of the data on an axis are invalidated when its property is modified,
+// so only the properties of the current axis are listened
+void ParallelCoordinatesDrawing::listenAxisProperties() {
+  set<PropertyInterface *> axisProperties;
+
+  for (const auto &axisName : axisOrder) {
+    axisProperties.insert(graphProxy->getProperty(axisName));
+  }
+
+  for (auto *property : listenedProperties) {
+    if (!axisProperties.contains(property)) {
+      property->removeListener(this);
+    }
+  }
+
+  for (auto *property : axisProperties) {
+    if (!listenedProperties.contains(property)) {
+      property->addListener(this);
+    }
+  }
+
+  listenedProperties = std::move(axisProperties);
+}
+
+void ParallelCoordinatesDrawing::addAxisPoint(const uint dataId, const Coord &pointCoord,
+                                              const Size &pointSize) {
+  node n = axisPointsGraph->addNode();
+  axisPointsDataMap[n] = dataId;
+  (*axisPointsGraphLayout)[n] = pointCoord;
+  (*axisPointsGraphSize)[n] = pointSize;
+
+  if (graphProxy->getDataLocation() == ElementType::NODE) {
+    (*axisPointsGraphShape)[n] =
+        graphProxy->getPropertyValueForData<IntegerProperty, IntegerType>("viewShape", dataId);
+  } else {
+    (*axisPointsGraphShape)[n] = NodeShape::Circle;
+  }
+
+  (*axisPointsGraphLabels)[n] =
+      graphProxy->getPropertyValueForData<StringProperty, StringType>("viewLabel", dataId);
+  (*axisPointsGraphColors)[n] =
+      graphProxy->getPropertyValueForData<ColorProperty, ColorType>("viewColor", dataId);
+
+  if (graphProxy->isDataSelected(dataId)) {
+    (*axisPointsGraphSelection)[n] = true;
+  }
+}
+
 void ParallelCoordinatesDrawing::plotData(const uint dataId, const Color &color) {
 
   Size eltMinSize = graphProxy->getSizeProperty("viewSize")->getMin();
@@ -289,31 +442,9 @@ void ParallelCoordinatesDrawing::plotData(const uint dataId, const Color &color)
     ostringstream oss;
     oss << "data " << dataId << " var " << axis;
 
-    if (drawPointsOnAxis) {
-
-      if (!graphProxy->highlightedEltsSet() || graphProxy->isDataSelected(dataId)) {
-        node n = axisPointsGraph->addNode();
-        axisPointsDataMap[n] = dataId;
-        (*axisPointsGraphLayout)[n] = pointCoord;
-        (*axisPointsGraphSize)[n] = adjustedViewSize;
-
-        if (graphProxy->getDataLocation() == ElementType::NODE) {
-          (*axisPointsGraphShape)[n] =
-              graphProxy->getPropertyValueForData<IntegerProperty, IntegerType>("viewShape",
-                                                                                dataId);
-        } else {
-          (*axisPointsGraphShape)[n] = NodeShape::Circle;
-        }
-
-        (*axisPointsGraphLabels)[n] =
-            graphProxy->getPropertyValueForData<StringProperty, StringType>("viewLabel", dataId);
-        (*axisPointsGraphColors)[n] =
-            graphProxy->getPropertyValueForData<ColorProperty, ColorType>("viewColor", dataId);
-
-        if (graphProxy->isDataSelected(dataId)) {
-          (*axisPointsGraphSelection)[n] = true;
-        }
-      }
+    if (drawPointsOnAxis &&
+        (!graphProxy->highlightedEltsSet() || graphProxy->isDataSelected(dataId))) {
+      addAxisPoint(dataId, pointCoord, adjustedViewSize);
     }
 
     if (linesType == STRAIGHT) {
@@ -474,6 +605,13 @@ bool ParallelCoordinatesDrawing::getDataIdFromGlEntity(GlEntity *glEntity, uint
   return dataMatch;
 }
 
+void ParallelCoordinatesDrawing::getDataInRegion(const BoundingBox &region,
+                                                 set<uint> &dataIds) const {
+  if (linesInBuffers()) {
+    dataLinesPlot->getDataInRegion(region, dataIds);
+  }
+}
+
 bool ParallelCoordinatesDrawing::getDataIdFromAxisPoint(node axisPoint, uint &dataId) {
 
   bool dataMatch = axisPointsDataMap.contains(axisPoint);
@@ -489,6 +627,7 @@ void ParallelCoordinatesDrawing::update(GlWidget *glWidget, bool updateWithoutPr
 
   deleteGlEntity(axisPlotComposite);
   deleteGlEntity(dataPlotComposite);
+  deleteGlEntity(dataLinesPlot);
 
   destroyAxisIfNeeded();
 
@@ -518,7 +657,12 @@ void ParallelCoordinatesDrawing::update(GlWidget *glWidget, bool updateWithoutPr
   }
 
   eraseDataPlot();
-  plotAllData(glWidget, progressBar);
+
+  if (linesInBuffers()) {
+    plotAllDataInBuffers(glWidget, progressBar);
+  } else {
+    plotAllData(glWidget, progressBar);
+  }
 
   if (progressBar != nullptr) {
     deleteGlEntity(progressBar);
@@ -529,6 +673,7 @@ void ParallelCoordinatesDrawing::update(GlWidget *glWidget, bool updateWithoutPr
 
   createAxisFlag = true;
 
+  addGlEntity(dataLinesPlot, "data lines plot");
   addGlEntity(dataPlotComposite, "data plot composite");
   addGlEntity(axisPlotComposite, "axis plot composite");
 }
@@ -541,6 +686,7 @@ void ParallelCoordinatesDrawing::eraseDataPlot() {
 }
 
 void ParallelCoordinatesDrawing::eraseAxisPlot() {
+  dataLinesPlot->clear();
   axisPlotComposite->reset(true);
   parallelAxis.clear();
 }
@@ -687,6 +833,16 @@ void ParallelCoordinatesDrawing::treatEvent(const tlp::Event &evt) {
       break;
     }
   }
+
+  const auto *pEvt = dynamic_cast<const PropertyEvent *>(&evt);
+
+  if (pEvt) {
+    dataLinesPlot->invalidateColumn(pEvt->getProperty()->getName());
+  }
+
+  if (evt.type() == EventType::TLP_DELETE) {
+    listenedProperties.erase(dynamic_cast<PropertyInterface *>(evt.sender()));
+  }
 }
 
 void ParallelCoordinatesDrawing::removeHighlightedElt(const uint dataId) {
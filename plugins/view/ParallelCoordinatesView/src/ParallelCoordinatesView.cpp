@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2022  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -50,6 +50,7 @@ ParallelCoordinatesView::ParallelCoordinatesView(const PluginContext *)
     : GlView(true), viewSetupMenu(nullptr), classicLayout(nullptr), circularLayout(nullptr),
       straightLinesType(nullptr), catmullRomSplineLinesType(nullptr),
       cubicBSplineInterpolationLinesType(nullptr), thickLines(nullptr), thinLines(nullptr),
+      elementsLinesRendering(nullptr), buffersLinesRendering(nullptr), densityBlending(nullptr),
       addRemoveDataFromSelection(nullptr), selectData(nullptr), deleteData(nullptr),
       showDataProperties(nullptr), axisMenuSeparator(nullptr), axisConfiguration(nullptr),
       removeAxisAction(nullptr), highlightMenuSeparator(nullptr),
@@ -279,6 +280,23 @@ void ParallelCoordinatesView::setState(const DataSet &dataSet) {
       }
     }
 
+    if (dataSet.exists("linesRendering")) {
+      int linesRendering = 0;
+      dataSet.get("linesRendering", linesRendering);
+
+      if (linesRendering == ParallelCoordinatesDrawing::ELEMENTS_RENDERING) {
+        elementsLinesRendering->setChecked(true);
+      } else {
+        buffersLinesRendering->setChecked(true);
+      }
+    }
+
+    if (dataSet.exists("densityBlending")) {
+      bool blending = false;
+      dataSet.get("densityBlending", blending);
+      densityBlending->setChecked(blending);
+    }
+
     if (dataSet.exists("layoutType")) {
       int layoutType = 0;
       dataSet.get("layoutType", layoutType);
@@ -355,6 +373,8 @@ DataSet ParallelCoordinatesView::state() const {
               drawConfigWidget->getUnhighlightedEltsColorsAlphaValue());
   dataSet.set("layoutType", int(getLayoutType()));
   dataSet.set("linesType", int(getLinesType()));
+  dataSet.set("linesRendering", int(getLinesRendering()));
+  dataSet.set("densityBlending", densityBlending->isChecked());
   dataSet.set("lastViewWindowWidth", glWidget()->width());
   dataSet.set("lastViewWindowHeight", glWidget()->height());
 
@@ -593,6 +613,28 @@ void ParallelCoordinatesView::buildContextMenu() {
       "The thickness is thin and the same for all the  curves representing the graph elements");
   thinLines->setCheckable(true);
   lineActionGroup->addAction(thinLines);
+  viewSetupMenu->addSeparator();
+
+  viewSetupMenu->addAction("Lines rendering")->setEnabled(false);
+  auto *renderingActionGroup = new QActionGroup(this);
+  elementsLinesRendering = viewSetupMenu->addAction("Graphic elements", this,
+                                                    &ParallelCoordinatesView::setupAndDrawView);
+  elementsLinesRendering->setToolTip("Draw each line as a separate graphic element");
+  elementsLinesRendering->setCheckable(true);
+  elementsLinesRendering->setChecked(true);
+  renderingActionGroup->addAction(elementsLinesRendering);
+  buffersLinesRendering =
+      viewSetupMenu->addAction("Vertex buffers", this, &ParallelCoordinatesView::setupAndDrawView);
+  buffersLinesRendering->setToolTip(
+      "Draw all the polylines from shared vertex buffers computed in parallel, "
+      "which scales to a large number of graph elements (only available for polylines)");
+  buffersLinesRendering->setCheckable(true);
+  renderingActionGroup->addAction(buffersLinesRendering);
+  densityBlending = viewSetupMenu->addAction("Density blending", this,
+                                             &ParallelCoordinatesView::setupAndDrawView);
+  densityBlending->setToolTip("When drawing from vertex buffers, the lines colors are added "
+                              "to reveal the most crossed areas");
+  densityBlending->setCheckable(true);
   axisMenuSeparator = new QAction(nullptr);
   axisMenuSeparator->setSeparator(true);
   axisConfiguration = new QAction("Axis configuration", nullptr);
@@ -714,6 +756,8 @@ void ParallelCoordinatesView::setupAndDrawView() {
     parallelCoordsDrawing->setLayoutType(getLayoutType());
     parallelCoordsDrawing->setLinesType(getLinesType());
     parallelCoordsDrawing->setLinesThickness(getLinesThickness());
+    parallelCoordsDrawing->setLinesRendering(getLinesRendering());
+    parallelCoordsDrawing->setDensityBlending(densityBlending->isChecked());
     scene->glGraph()->renderingParameters().setViewNodeLabel(drawConfigWidget->displayNodeLabels());
 
     if (graphProxy->getUnhighlightedEltsColorAlphaValue() !=
@@ -752,6 +796,11 @@ ParallelCoordinatesDrawing::LinesThickness ParallelCoordinatesView::getLinesThic
                                    : ParallelCoordinatesDrawing::THIN;
 }
 
+ParallelCoordinatesDrawing::LinesRendering ParallelCoordinatesView::getLinesRendering() const {
+  return (elementsLinesRendering->isChecked()) ? ParallelCoordinatesDrawing::ELEMENTS_RENDERING
+                                               : ParallelCoordinatesDrawing::BUFFERS_RENDERING;
+}
+
 bool ParallelCoordinatesView::mapGlEntitiesInRegionToData(std::set<uint> &mappedData, const int x,
                                                           const int y, const uint width,
                                                           const uint height) const {
@@ -775,6 +824,31 @@ bool ParallelCoordinatesView::mapGlEntitiesInRegionToData(std::set<uint> &mapped
     }
   }
 
+  if (parallelCoordsDrawing->linesInBuffers()) {
+    // the lines drawn from vertex buffers are picked geometrically
+    // in a region of a few pixels at least around the pointer
+    const int minSize = 5;
+    int regionX = x, regionY = y, regionWidth = width, regionHeight = height;
+
+    if (regionWidth < minSize) {
+      regionX -= (minSize - regionWidth) / 2;
+      regionWidth = minSize;
+    }
+
+    if (regionHeight < minSize) {
+      regionY -= (minSize - regionHeight) / 2;
+      regionHeight = minSize;
+    }
+
+    Camera &camera = mainLayer->getCamera();
+    BoundingBox region;
+    region.expand(camera.viewportTo3DWorld(
+        glWidget()->screenToViewport(Coord(glWidget()->width() - regionX, regionY))));
+    region.expand(camera.viewportTo3DWorld(glWidget()->screenToViewport(
+        Coord(glWidget()->width() - (regionX + regionWidth), regionY + regionHeight))));
+    parallelCoordsDrawing->getDataInRegion(region, mappedData);
+  }
+
   glWidget()->pickNodesEdges(x, y, width, height, selectedAxisPoints, dummy, mainLayer);
 
   for (const auto &entity : selectedAxisPoints) {
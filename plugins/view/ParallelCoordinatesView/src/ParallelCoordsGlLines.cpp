@@ -0,0 +1,359 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/OpenGlIncludes.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/hash.h>
+
+#include "ParallelCoordsGlLines.h"
+#include "NominalParallelAxis.h"
+#include "QuantitativeParallelAxis.h"
+#include "ParallelTools.h"
+
+using namespace std;
+
+namespace tlp {
+
+// returns a key which changes each time the mapping between
+// the values of the axis property and the axis coordinates changes
+static size_t axisScaleKey(ParallelAxis *axis) {
+  size_t key = 0;
+
+  if (auto *quantitativeAxis = dynamic_cast<QuantitativeParallelAxis *>(axis)) {
+    tlp_hash_combine(key, quantitativeAxis->getAxisMinValue());
+    tlp_hash_combine(key, quantitativeAxis->getAxisMaxValue());
+    tlp_hash_combine(key, quantitativeAxis->hasLog10Scale());
+    tlp_hash_combine(key, quantitativeAxis->hasAscendingOrder());
+  } else if (auto *nominalAxis = dynamic_cast<NominalParallelAxis *>(axis)) {
+    for (const auto &label : nominalAxis->getLabelsOrder()) {
+      tlp_hash_combine(key, label);
+    }
+  }
+
+  return key;
+}
+
+// Liang-Barsky clipping of the [p1, p2] segment against a 2D box
+static bool segmentIntersectsBox(const Coord &p1, const Coord &p2, const BoundingBox &box) {
+  float t0 = 0, t1 = 1;
+  float dx = p2[0] - p1[0], dy = p2[1] - p1[1];
+  const float p[4] = {-dx, dx, -dy, dy};
+  const float q[4] = {p1[0] - box[0][0], box[1][0] - p1[0], p1[1] - box[0][1],
+                      box[1][1] - p1[1]};
+
+  for (uint i = 0; i < 4; ++i) {
+    if (p[i] == 0) {
+      if (q[i] < 0) {
+        return false;
+      }
+    } else {
+      float t = q[i] / p[i];
+
+      if (p[i] < 0) {
+        t0 = max(t0, t);
+      } else {
+        t1 = min(t1, t);
+      }
+
+      if (t0 > t1) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+ParallelCoordsGlLines::ParallelCoordsGlLines()
+    : dataLocation(ElementType::NODE), closedLines(false), thickLines(true),
+      densityBlending(false), columnsVersion(0), geometryValid(false) {}
+
+void ParallelCoordsGlLines::setData(ElementType dataLocation, vector<uint> &&dataIds,
+                                    vector<float> &&linesHalfWidth) {
+  if (dataLocation != this->dataLocation || dataIds != this->dataIds) {
+    columns.clear();
+    geometryValid = false;
+    this->dataLocation = dataLocation;
+    this->dataIds = std::move(dataIds);
+  }
+
+  if (linesHalfWidth != this->linesHalfWidth) {
+    geometryValid = geometryValid && !thickLines;
+    this->linesHalfWidth = std::move(linesHalfWidth);
+  }
+}
+
+void ParallelCoordsGlLines::setColors(vector<Color> &&colors, vector<uint> &&drawOrder) {
+  this->colors = std::move(colors);
+  this->drawOrder = std::move(drawOrder);
+
+  uint nbRows = dataIds.size();
+  uint vpl = verticesPerLine();
+  verticesColors.resize(nbRows * vpl);
+  verticesIndices.resize(nbRows * vpl);
+
+  TLP_PARALLEL_MAP_INDICES(nbRows, [&](uint i) {
+    uint row = this->drawOrder.empty() ? i : this->drawOrder[i];
+
+    for (uint j = 0; j < vpl; ++j) {
+      verticesColors[i * vpl + j] = this->colors[i];
+      // the i-th drawn line is the one of the row-th data
+      verticesIndices[i * vpl + j] = row * vpl + j;
+    }
+  });
+}
+
+void ParallelCoordsGlLines::setAxis(const vector<ParallelAxis *> &axis, bool closedLines,
+                                    bool thickLines) {
+  if (axis != this->axis || closedLines != this->closedLines ||
+      thickLines != this->thickLines) {
+    geometryValid = false;
+    this->axis = axis;
+    this->closedLines = closedLines;
+    this->thickLines = thickLines;
+  }
+}
+
+uint ParallelCoordsGlLines::nbSegments() const {
+  if (axis.size() < 2) {
+    return 0;
+  }
+
+  return closedLines && axis.size() > 2 ? axis.size() : axis.size() - 1;
+}
+
+void ParallelCoordsGlLines::invalidateColumn(const string &axisName) {
+  columns.erase(axisName);
+}
+
+void ParallelCoordsGlLines::clear() {
+  dataIds.clear();
+  linesHalfWidth.clear();
+  colors.clear();
+  drawOrder.clear();
+  axis.clear();
+  columns.clear();
+  frames.clear();
+  vertices.clear();
+  verticesColors.clear();
+  verticesIndices.clear();
+  geometryValid = false;
+  boundingBox = BoundingBox();
+}
+
+const ParallelCoordsGlLines::Column &ParallelCoordsGlLines::column(ParallelAxis *axis) {
+  Column &column = columns[axis->getAxisName()];
+  size_t scaleKey = axisScaleKey(axis);
+
+  if (column.version != 0 && column.scaleKey == scaleKey) {
+    return column;
+  }
+
+  column.scaleKey = scaleKey;
+  column.version = ++columnsVersion;
+  column.offsets.resize(dataIds.size());
+
+  // store the offsets of the data along the unrotated axis,
+  // as a fraction of its height
+  Coord baseCoord = axis->getBaseCoord();
+  float height = axis->getAxisHeight();
+  float rotationAngle = axis->getRotationAngle();
+
+  TLP_PARALLEL_MAP_INDICES(dataIds.size(), [&](uint i) {
+    Coord pointCoord = axis->getPointCoordOnAxisForData(dataIds[i]);
+
+    if (rotationAngle != 0.0f) {
+      rotateVector(pointCoord, -rotationAngle, Z_ROT);
+    }
+
+    column.offsets[i] = height != 0.0f ? (pointCoord[1] - baseCoord[1]) / height : 0.0f;
+  });
+
+  return column;
+}
+
+void ParallelCoordsGlLines::updateGeometry() {
+  uint nbAxis = axis.size();
+  uint nbSegs = nbSegments();
+
+  if (nbSegs == 0 || dataIds.empty()) {
+    vertices.clear();
+    frames.clear();
+    return;
+  }
+
+  vector<const Column *> axisColumns;
+  vector<AxisFrame> newFrames;
+  boundingBox = BoundingBox();
+
+  for (auto *ax : axis) {
+    const Column &axisColumn = column(ax);
+    axisColumns.push_back(&axisColumn);
+    newFrames.push_back(
+        {ax->getBaseCoord(), ax->getAxisHeight(), ax->getRotationAngle(), axisColumn.version});
+    BoundingBox axisBB = ax->getBoundingBox();
+    boundingBox.expand(axisBB[0]);
+    boundingBox.expand(axisBB[1]);
+  }
+
+  size_t nbVertices = size_t(nbSegs) * dataIds.size() * verticesPerLine();
+
+  if (!geometryValid || vertices.size() != nbVertices || frames.size() != nbAxis) {
+    vertices.resize(nbVertices);
+    frames.clear();
+  }
+
+  // only the segments adjacent to a moved, rescaled or invalidated axis
+  // have to be computed again
+  for (uint i = 0; i < nbSegs; ++i) {
+    uint next = (i + 1) % nbAxis;
+
+    if (frames.empty() || !(frames[i] == newFrames[i]) || !(frames[next] == newFrames[next])) {
+      computeSegment(i, axisColumns, newFrames);
+    }
+  }
+
+  frames = std::move(newFrames);
+  geometryValid = true;
+}
+
+void ParallelCoordsGlLines::computeSegment(uint segment,
+                                           const vector<const Column *> &axisColumns,
+                                           const vector<AxisFrame> &axisFrames) {
+  uint nbRows = dataIds.size();
+  uint vpl = verticesPerLine();
+  uint next = (segment + 1) % axis.size();
+  const AxisFrame &frame1 = axisFrames[segment];
+  const AxisFrame &frame2 = axisFrames[next];
+  const Column &column1 = *axisColumns[segment];
+  const Column &column2 = *axisColumns[next];
+  Coord *segmentVertices = &vertices[size_t(segment) * nbRows * vpl];
+
+  auto axisPoint = [](const AxisFrame &frame, float offset, float halfWidth) {
+    Coord p(frame.baseCoord[0], frame.baseCoord[1] + offset * frame.height + halfWidth,
+            frame.baseCoord[2]);
+
+    if (frame.rotationAngle != 0.0f) {
+      rotateVector(p, frame.rotationAngle, Z_ROT);
+    }
+
+    return p;
+  };
+
+  TLP_PARALLEL_MAP_INDICES(nbRows, [&](uint i) {
+    Coord *v = segmentVertices + size_t(i) * vpl;
+
+    if (thickLines) {
+      float halfWidth = linesHalfWidth[i];
+      v[0] = axisPoint(frame1, column1.offsets[i], -halfWidth);
+      v[1] = axisPoint(frame1, column1.offsets[i], halfWidth);
+      v[2] = axisPoint(frame2, column2.offsets[i], halfWidth);
+      v[3] = axisPoint(frame2, column2.offsets[i], -halfWidth);
+    } else {
+      v[0] = axisPoint(frame1, column1.offsets[i], 0);
+      v[1] = axisPoint(frame2, column2.offsets[i], 0);
+    }
+  });
+}
+
+void ParallelCoordsGlLines::getDataInRegion(const BoundingBox &region, set<uint> &data) const {
+  uint nbRows = dataIds.size();
+  uint vpl = verticesPerLine();
+  uint nbSegs = vertices.size() / max(1u, nbRows * vpl);
+  // vector<bool> cannot be written concurrently
+  vector<uchar> inRegion(nbRows, false);
+
+  TLP_PARALLEL_MAP_INDICES(nbRows, [&](uint i) {
+    bool found = false;
+
+    for (uint s = 0; s < nbSegs && !found; ++s) {
+      const Coord *v = &vertices[(size_t(s) * nbRows + i) * vpl];
+
+      if (thickLines) {
+        found = segmentIntersectsBox((v[0] + v[1]) / 2.f, (v[2] + v[3]) / 2.f, region);
+      } else {
+        found = segmentIntersectsBox(v[0], v[1], region);
+      }
+    }
+
+    if (found) {
+      inRegion[i] = true;
+    }
+  });
+
+  for (uint i = 0; i < nbRows; ++i) {
+    if (inRegion[i]) {
+      data.insert(dataIds[i]);
+    }
+  }
+}
+
+void ParallelCoordsGlLines::draw(float, Camera *) {
+  uint nbRows = dataIds.size();
+  uint vpl = verticesPerLine();
+
+  if (vertices.empty() || verticesColors.size() != nbRows * vpl) {
+    return;
+  }
+  uint nbSegs = vertices.size() / (nbRows * vpl);
+
+  // the state of the drawing of the other entities is restored at the end
+  GLboolean lighting = glIsEnabled(GL_LIGHTING);
+  GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+  GLboolean blend = glIsEnabled(GL_BLEND);
+  GLboolean depthMask;
+  GLint blendSrc, blendDst;
+  glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+  glGetIntegerv(GL_BLEND_SRC, &blendSrc);
+  glGetIntegerv(GL_BLEND_DST, &blendDst);
+  glDisable(GL_LIGHTING);
+  glDisable(GL_CULL_FACE);
+
+  if (densityBlending) {
+    // additive blending makes the areas crossed by many lines brighter
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+  }
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+  glColorPointer(4, GL_UNSIGNED_BYTE, 4 * sizeof(uchar), &verticesColors[0][0]);
+
+  for (uint s = 0; s < nbSegs; ++s) {
+    glVertexPointer(3, GL_FLOAT, 3 * sizeof(float), &vertices[size_t(s) * nbRows * vpl][0]);
+    glDrawElements(thickLines ? GL_QUADS : GL_LINES, verticesIndices.size(), GL_UNSIGNED_INT,
+                   verticesIndices.data());
+  }
+
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+
+  if (densityBlending) {
+    glDepthMask(depthMask);
+    glBlendFunc(blendSrc, blendDst);
+
+    if (!blend) {
+      glDisable(GL_BLEND);
+    }
+  }
+
+  if (cullFace) {
+    glEnable(GL_CULL_FACE);
+  }
+
+  if (lighting) {
+    glEnable(GL_LIGHTING);
+  }
+}
+}
@@ -12,6 +12,7 @@
  */
 
 #include <talipot/GlOffscreenRenderer.h>
+#include <talipot/ColorScale.h>
 #include <talipot/Gl2DRect.h>
 #include <talipot/GlOffscreenRenderer.h>
 #include <talipot/GlGraph.h>
@@ -19,8 +20,10 @@
 #include <talipot/GlQuantitativeAxis.h>
 #include <talipot/GlWidget.h>
 #include <talipot/GlTextureManager.h>
+#include <talipot/ParallelTools.h>
 
 #include "ScatterPlot2D.h"
+#include "ScatterPlotDensityModel.h"
 
 using namespace std;
 
@@ -61,12 +64,12 @@ ScatterPlot2D::ScatterPlot2D(Graph *graph, Graph *edgeGraph, flat_hash_map<node,
                              const Color &backgroundColor, const Color &foregroundColor)
     : xDim(xDim), yDim(yDim), blCorner(blCorner), size(size), graph(graph),
       scatterLayout(new LayoutProperty(graph)), scatterEdgeLayout(new LayoutProperty(graph)),
-      xAxis(nullptr), yAxis(nullptr), overviewGen(false), backgroundColor(backgroundColor),
-      foregroundColor(foregroundColor), mapBackgroundColorToCoeff(false),
-      edgeAsNodeGraph(edgeGraph), nodeToEdge(nodeMap), dataLocation(dataLocation),
-      xAxisScaleDefined(false), yAxisScaleDefined(false), xAxisScale(make_pair(0, 0)),
-      yAxisScale(make_pair(0, 0)), initXAxisScale(make_pair(0, 0)), initYAxisScale(make_pair(0, 0)),
-      displayEdges(false), displaylabels(true), scale(true) {
+      xAxis(nullptr), yAxis(nullptr), overviewGen(false), densityOverviewGen(false),
+      backgroundColor(backgroundColor), foregroundColor(foregroundColor),
+      mapBackgroundColorToCoeff(false), edgeAsNodeGraph(edgeGraph), nodeToEdge(nodeMap),
+      dataLocation(dataLocation), xAxisScaleDefined(false), yAxisScaleDefined(false),
+      xAxisScale(make_pair(0, 0)), yAxisScale(make_pair(0, 0)), initXAxisScale(make_pair(0, 0)),
+      initYAxisScale(make_pair(0, 0)), displayEdges(false), displaylabels(true), scale(true) {
 
   if (dataLocation == ElementType::NODE) {
     _glGraph = new GlGraph(graph);
@@ -142,30 +145,7 @@ void ScatterPlot2D::generateOverview(GlWidget *glWidget, LayoutProperty *reverse
   glProgressBar->setComment("Generating overview ...");
   addGlEntity(glProgressBar, "progress bar");
   computeScatterPlotLayout(glWidget, reverseLayout);
-
-  if (mapBackgroundColorToCoeff) {
-    Color startColor = zeroColor, endColor;
-
-    if (correlationCoeff < 0) {
-      endColor = minusOneColor;
-    } else {
-      endColor = oneColor;
-    }
-
-    for (uint i = 0; i < 4; ++i) {
-      backgroundColor[i] =
-          uchar((double(startColor[i]) +
-                 (double(endColor[i]) - double(startColor[i])) * abs(correlationCoeff)));
-    }
-
-    int bgV = backgroundColor.getV();
-
-    if (bgV < 128) {
-      foregroundColor = Color(255, 255, 255);
-    } else {
-      foregroundColor = Color(0, 0, 0);
-    }
-  }
+  mapBackgroundColor();
 
   GlOffscreenRenderer &glOffscreenRenderer = GlOffscreenRenderer::instance();
   glOffscreenRenderer.setViewPortSize(size, size);
@@ -200,6 +180,75 @@ void ScatterPlot2D::generateOverview(GlWidget *glWidget, LayoutProperty *reverse
   addGlEntity(rectTextured, textureName + " overview");
   computeBoundingBox();
   overviewGen = true;
+  densityOverviewGen = false;
+}
+
+void ScatterPlot2D::generateDensityOverview(const ScatterPlotDensityHistogram &histogram) {
+  clean();
+  clickLabel = nullptr;
+  backgroundRect = nullptr;
+  correlationCoeff = histogram.correlationCoeff;
+  mapBackgroundColor();
+
+  // empty bins are filled with the background color and the others
+  // with a logarithmic scale of the bin counts to keep sparse areas visible
+  ColorScale densityColorScale;
+  uint nbBins = histogram.nbBins;
+  vector<Color> colors(nbBins * nbBins, backgroundColor);
+  float maxCount = log1p(float(histogram.maxCount));
+  TLP_PARALLEL_MAP_INDICES(nbBins * nbBins, [&](uint i) {
+    if (histogram.counts[i] != 0) {
+      colors[i] = densityColorScale.getColorAtPos(log1p(float(histogram.counts[i])) / maxCount);
+    }
+  });
+
+  GLuint textureId;
+  glGenTextures(1, &textureId);
+  glBindTexture(GL_TEXTURE_2D, textureId);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, nbBins, nbBins, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+               colors.data());
+  glBindTexture(GL_TEXTURE_2D, 0);
+  GlTextureManager::deleteTexture(textureName);
+  GlTextureManager::registerExternalTexture(textureName, textureId);
+
+  // as for the offscreen rendered overviews, the first row of the texture
+  // (the lowest y values) is displayed at the bottom of the rectangle
+  auto *rectTextured = new Gl2DRect(blCorner.getY() + size, blCorner.getY(), blCorner.getX(),
+                                    blCorner.getX() + size, textureName);
+  addGlEntity(rectTextured, textureName + " overview");
+  computeBoundingBox();
+  overviewGen = false;
+  densityOverviewGen = true;
+}
+
+void ScatterPlot2D::mapBackgroundColor() {
+  if (mapBackgroundColorToCoeff) {
+    Color startColor = zeroColor, endColor;
+
+    if (correlationCoeff < 0) {
+      endColor = minusOneColor;
+    } else {
+      endColor = oneColor;
+    }
+
+    for (uint i = 0; i < 4; ++i) {
+      backgroundColor[i] =
+          uchar((double(startColor[i]) +
+                 (double(endColor[i]) - double(startColor[i])) * abs(correlationCoeff)));
+    }
+
+    int bgV = backgroundColor.getV();
+
+    if (bgV < 128) {
+      foregroundColor = Color(255, 255, 255);
+    } else {
+      foregroundColor = Color(0, 0, 0);
+    }
+  }
 }
 
 void ScatterPlot2D::clean() {
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -29,6 +29,7 @@ class GlRect;
 class GlLabel;
 class GlProgressBar;
 class Graph;
+struct ScatterPlotDensityHistogram;
 
 const std::string backgroundTextureId = ":/background_texture.png";
 
@@ -56,6 +57,15 @@ public:
     return overviewGen;
   }
 
+  /**
+   * Renders the overview as a heatmap of the given histogram
+   * instead of drawing each graph element.
+   */
+  void generateDensityOverview(const ScatterPlotDensityHistogram &histogram);
+  bool densityOverviewGenerated() const {
+    return densityOverviewGen;
+  }
+
   const std::string &getXDim() const {
     return xDim;
   }
@@ -143,6 +153,7 @@ private:
   }
 
   void createAxis();
+  void mapBackgroundColor();
   void computeScatterPlotLayout(GlWidget *glWidget, LayoutProperty *reverseLayout);
   void clean();
 
@@ -160,6 +171,7 @@ private:
   int maxStep;
   int drawStep;
   bool overviewGen;
+  bool densityOverviewGen;
   Color backgroundColor, foregroundColor;
   GlLabel *clickLabel;
   GlRect *backgroundRect;
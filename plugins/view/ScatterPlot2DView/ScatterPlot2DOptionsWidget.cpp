@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -204,6 +204,14 @@ void ScatterPlot2DOptionsWidget::setDisplayScaleLabels(const bool scaleLabels) {
   _ui->scaleLabels->setChecked(scaleLabels);
 }
 
+bool ScatterPlot2DOptionsWidget::densityOverviews() const {
+  return _ui->densityOverviewsCB->isChecked();
+}
+
+void ScatterPlot2DOptionsWidget::setDensityOverviews(const bool densityOverviews) {
+  _ui->densityOverviewsCB->setChecked(densityOverviews);
+}
+
 bool ScatterPlot2DOptionsWidget::displayGraphEdges() const {
   return _ui->showEdgesCB->isChecked();
 }
@@ -244,6 +252,7 @@ bool ScatterPlot2DOptionsWidget::configurationChanged() {
         oldOneColor != getOneColor() || oldMinSizeMapping != getMinSizeMapping() ||
         oldMaxSizeMapping != getMaxSizeMapping() || oldDisplayGraphEdges != displayGraphEdges() ||
         oldDisplayNodeLabels != displayNodeLabels() || oldlabelscaled != displayScaleLabels() ||
+        oldDensityOverviews != densityOverviews() ||
         oldUseCustomXAxisScale != useCustomXAxisScale() ||
         oldUseCustomYAxisScale != useCustomYAxisScale()) {
       confChanged = true;
@@ -264,6 +273,7 @@ bool ScatterPlot2DOptionsWidget::configurationChanged() {
     oldDisplayGraphEdges = displayGraphEdges();
     oldDisplayNodeLabels = displayNodeLabels();
     oldlabelscaled = displayScaleLabels();
+    oldDensityOverviews = densityOverviews();
     oldUseCustomXAxisScale = useCustomXAxisScale();
     oldUseCustomYAxisScale = useCustomYAxisScale();
     oldXAxisScale = getXAxisScale();
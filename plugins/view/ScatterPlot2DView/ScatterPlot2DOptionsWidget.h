@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2020  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -75,6 +75,9 @@ public:
   bool displayScaleLabels() const;
   void setDisplayScaleLabels(const bool scaleLabels);
 
+  bool densityOverviews() const;
+  void setDensityOverviews(const bool densityOverviews);
+
   bool configurationChanged();
 
 protected:
@@ -100,6 +103,7 @@ private:
   bool oldDisplayGraphEdges;
   bool oldDisplayNodeLabels;
   bool oldlabelscaled;
+  bool oldDensityOverviews;
   bool oldUseCustomXAxisScale;
   bool oldUseCustomYAxisScale;
   std::pair<double, double> oldXAxisScale, oldYAxisScale; //<min, max>
@@ -67,6 +67,7 @@ ScatterPlot2DView::ScatterPlot2DView(const PluginContext *)
       edgeAsNodeGraph(nullptr) {}
 
 ScatterPlot2DView::~ScatterPlot2DView() {
+  unlistenDensityProperties();
   delete propertiesSelectionWidget;
   delete optionsWidget;
   delete glGraph;
@@ -162,6 +163,8 @@ void ScatterPlot2DView::setState(const DataSet &dataSet) {
     }
 
     delete edgeAsNodeGraph;
+    unlistenDensityProperties();
+    densityModel.clear();
 
     if (scatterPlotGraph) {
       edgeAsNodeGraph = tlp::newGraph();
@@ -232,6 +235,12 @@ void ScatterPlot2DView::setState(const DataSet &dataSet) {
     optionsWidget->setDisplayScaleLabels(scalelabels);
   }
 
+  bool densityOverviews = false;
+
+  if (dataSet.get("density overviews", densityOverviews)) {
+    optionsWidget->setDensityOverviews(densityOverviews);
+  }
+
   Color backgroundColor;
 
   if (dataSet.get("background color", backgroundColor)) {
@@ -354,6 +363,7 @@ DataSet ScatterPlot2DView::state() const {
   dataSet.set("display graph edges", optionsWidget->displayGraphEdges());
   dataSet.set("display node labels", optionsWidget->displayNodeLabels());
   dataSet.set("scale labels", optionsWidget->displayScaleLabels());
+  dataSet.set("density overviews", optionsWidget->densityOverviews());
   dataSet.set("lastViewWindowWidth", glWidget()->width());
   dataSet.set("lastViewWindowHeight", glWidget()->height());
   dataSet.set("detailed scatterplot x dim", detailedScatterPlotPropertyName.first);
@@ -826,6 +836,33 @@ void ScatterPlot2DView::generateScatterPlots() {
   // disable user input
   tlp::disableQtUserInput();
 
+  bool densityOverviews = optionsWidget->densityOverviews();
+
+  if (densityOverviews) {
+    // compute in parallel the histograms of all the matrix cells
+    // whose properties have been modified since the last update
+    densityModel.setData(scatterPlotGraph, dataLocation);
+
+    for (auto *property : modifiedDensityProperties) {
+      densityModel.invalidate(property->getName());
+    }
+
+    modifiedDensityProperties.clear();
+    vector<pair<string, string>> densityPairs;
+
+    for (const auto &[dims, overview] : scatterPlotsMap) {
+      if (overview) {
+        densityPairs.push_back(dims);
+      }
+    }
+
+    densityModel.computeHistograms(densityPairs);
+    listenDensityProperties();
+  } else {
+    unlistenDensityProperties();
+    densityModel.clear();
+  }
+
   for (size_t i = 0; i < selectedGraphProperties.size() - 1; ++i) {
     for (size_t j = 0; j < selectedGraphProperties.size(); ++j) {
       ScatterPlot2D *overview =
@@ -835,7 +872,14 @@ void ScatterPlot2DView::generateScatterPlots() {
         continue;
       }
 
-      overview->generateOverview();
+      // the elements of the detailed scatter plot are always drawn
+      if (densityOverviews && overview != detailedScatterPlot) {
+        overview->generateDensityOverview(
+            densityModel.histogram(selectedGraphProperties[i], selectedGraphProperties[j]));
+      } else {
+        overview->generateOverview();
+      }
+
       scatterPlotsGenMap[make_pair(selectedGraphProperties[i], selectedGraphProperties[j])] = true;
 
       currentStep += 1;
@@ -883,6 +927,13 @@ void ScatterPlot2DView::generateScatterPlot(ScatterPlot2D *scatterPlot, GlWidget
 
 void ScatterPlot2DView::switchFromMatrixToDetailView(ScatterPlot2D *scatterPlot, bool recenter) {
 
+  // the layout of the scatter plot elements is not computed
+  // when its overview is drawn as a density heatmap
+  if (!scatterPlot->overviewGenerated()) {
+    glWidget()->makeCurrent();
+    generateScatterPlot(scatterPlot);
+  }
+
   sceneRadiusBak = glWidget()->scene()->graphCamera().getSceneRadius();
   zoomFactorBak = glWidget()->scene()->graphCamera().getZoomFactor();
   eyesBak = glWidget()->scene()->graphCamera().getEyes();
@@ -1028,10 +1079,58 @@ void ScatterPlot2DView::registerTriggers() {
   }
 }
 
+// the properties of the scatter plot graph listened by the view in setState
+static bool isListenedByView(const string &propertyName) {
+  return propertyName == "viewColor" || propertyName == "viewLabel" ||
+         propertyName == "viewSelection" || propertyName == "viewSize" ||
+         propertyName == "viewShape" || propertyName == "viewTexture";
+}
+
+void ScatterPlot2DView::listenDensityProperties() {
+  for (const auto &propertyName : selectedGraphProperties) {
+    PropertyInterface *property = scatterPlotGraph->getProperty(propertyName);
+
+    if (densityProperties.insert(property).second && !isListenedByView(propertyName)) {
+      property->addListener(this);
+      densityListenedProperties.insert(property);
+    }
+  }
+}
+
+void ScatterPlot2DView::unlistenDensityProperties() {
+  for (auto *property : densityListenedProperties) {
+    property->removeListener(this);
+  }
+
+  densityProperties.clear();
+  densityListenedProperties.clear();
+  modifiedDensityProperties.clear();
+}
+
 void ScatterPlot2DView::treatEvent(const Event &message) {
+  if (message.type() == EventType::TLP_DELETE) {
+    auto *property = dynamic_cast<PropertyInterface *>(message.sender());
+    densityProperties.erase(property);
+    densityListenedProperties.erase(property);
+    modifiedDensityProperties.erase(property);
+    return;
+  }
+
   const auto *graphEvent = dynamic_cast<const GraphEvent *>(&message);
 
   if (graphEvent) {
+    switch (graphEvent->getType()) {
+    case GraphEventType::TLP_ADD_NODE:
+    case GraphEventType::TLP_DEL_NODE:
+    case GraphEventType::TLP_ADD_EDGE:
+    case GraphEventType::TLP_DEL_EDGE:
+      densityModel.clear();
+      break;
+
+    default:
+      break;
+    }
+
     if (graphEvent->getType() == GraphEventType::TLP_ADD_EDGE) {
       addEdge(graphEvent->getGraph(), graphEvent->getEdge());
     }
@@ -1048,6 +1147,11 @@ void ScatterPlot2DView::treatEvent(const Event &message) {
   const auto *propertyEvent = dynamic_cast<const PropertyEvent *>(&message);
 
   if (propertyEvent) {
+    // the histograms are invalidated once, when the matrix is updated
+    if (densityProperties.contains(propertyEvent->getProperty())) {
+      modifiedDensityProperties.insert(propertyEvent->getProperty());
+    }
+
     if (propertyEvent->getType() == PropertyEventType::TLP_AFTER_SET_NODE_VALUE) {
       afterSetNodeValue(propertyEvent->getProperty(), propertyEvent->getNode());
     }
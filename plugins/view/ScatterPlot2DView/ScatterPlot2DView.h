@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -16,6 +16,8 @@
 
 #include <talipot/hash.h>
 
+#include <set>
+
 #include <talipot/Graph.h>
 #include <talipot/GlView.h>
 #include <talipot/BoundingBox.h>
@@ -24,6 +26,7 @@
 #include <talipot/OpenGlIncludes.h>
 
 #include "../../utils/PluginNames.h"
+#include "ScatterPlotDensityModel.h"
 
 namespace tlp {
 
@@ -158,6 +161,8 @@ private:
   void destroyOverviewsIfNeeded();
   void destroyOverviews();
   void cleanupGlScene();
+  void listenDensityProperties();
+  void unlistenDensityProperties();
   void addEmptyViewLabel();
   void removeEmptyViewLabel();
 
@@ -192,6 +197,16 @@ private:
   Graph *edgeAsNodeGraph;
   flat_hash_map<edge, node> edgeToNode;
   flat_hash_map<node, edge> nodeToEdge;
+
+  // histograms of the property pairs used when the matrix
+  // overviews are drawn as density heatmaps
+  ScatterPlotDensityModel densityModel;
+  std::set<PropertyInterface *> densityProperties;
+  // the density properties listened only for the histograms,
+  // the other ones being already listened by the view
+  std::set<PropertyInterface *> densityListenedProperties;
+  // the density properties modified since the last update of the histograms
+  std::set<PropertyInterface *> modifiedDensityProperties;
 };
 }
 
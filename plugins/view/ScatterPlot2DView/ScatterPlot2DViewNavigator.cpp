@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2022  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -56,7 +56,8 @@ bool ScatterPlot2DViewNavigator::eventFilter(QObject *widget, QEvent *e) {
       return true;
     } else if (e->type() == QEvent::MouseButtonDblClick) {
       if (selectedScatterPlotOverview != nullptr &&
-          !selectedScatterPlotOverview->overviewGenerated()) {
+          !selectedScatterPlotOverview->overviewGenerated() &&
+          !selectedScatterPlotOverview->densityOverviewGenerated()) {
         scatterPlot2dView->generateScatterPlot(selectedScatterPlotOverview, glWidget);
         glWidget->draw();
       } else if (selectedScatterPlotOverview != nullptr && scatterPlot2dView->matrixViewSet()) {
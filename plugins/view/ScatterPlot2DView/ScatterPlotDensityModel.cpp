@@ -0,0 +1,148 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/GraphParallelTools.h>
+#include <talipot/NumericProperty.h>
+
+#include "ScatterPlotDensityModel.h"
+
+#include <cmath>
+
+using namespace std;
+
+namespace tlp {
+
+ScatterPlotDensityModel::ScatterPlotDensityModel(uint nbBins)
+    : graph(nullptr), dataLocation(ElementType::NODE), nbBins(nbBins) {}
+
+void ScatterPlotDensityModel::setData(const Graph *graph, ElementType dataLocation) {
+  if (graph != this->graph || dataLocation != this->dataLocation) {
+    clear();
+    this->graph = graph;
+    this->dataLocation = dataLocation;
+  }
+}
+
+void ScatterPlotDensityModel::invalidate(const string &propertyName) {
+  columns.erase(propertyName);
+
+  for (auto it = histograms.begin(); it != histograms.end();) {
+    if (it->first.first == propertyName || it->first.second == propertyName) {
+      it = histograms.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ScatterPlotDensityModel::clear() {
+  columns.clear();
+  histograms.clear();
+}
+
+const ScatterPlotDensityModel::Column &ScatterPlotDensityModel::column(const string &propertyName) {
+  auto it = columns.find(propertyName);
+
+  if (it != columns.end()) {
+    return it->second;
+  }
+
+  Column &column = columns[propertyName];
+  assert(dynamic_cast<NumericProperty *>(graph->getProperty(propertyName)));
+  auto *prop = static_cast<NumericProperty *>(graph->getProperty(propertyName));
+
+  if (dataLocation == ElementType::NODE) {
+    column.values.resize(graph->numberOfNodes());
+    TLP_PARALLEL_MAP_NODES_AND_INDICES(
+        graph, [&](const node n, uint i) { column.values[i] = prop->getNodeDoubleValue(n); });
+    column.min = prop->getNodeDoubleMin(graph);
+    column.max = prop->getNodeDoubleMax(graph);
+  } else {
+    column.values.resize(graph->numberOfEdges());
+    TLP_PARALLEL_MAP_EDGES_AND_INDICES(
+        graph, [&](const edge e, uint i) { column.values[i] = prop->getEdgeDoubleValue(e); });
+    column.min = prop->getEdgeDoubleMin(graph);
+    column.max = prop->getEdgeDoubleMax(graph);
+  }
+
+  return column;
+}
+
+void ScatterPlotDensityModel::computeHistograms(const vector<pair<string, string>> &pairs) {
+  vector<const Column *> xColumns, yColumns;
+  vector<ScatterPlotDensityHistogram *> toCompute;
+
+  // columns extraction and histograms allocation must be done sequentially
+  // as they modify the cache maps
+  for (const auto &dims : pairs) {
+    ScatterPlotDensityHistogram &histogram = histograms[dims];
+
+    if (!histogram.isValid()) {
+      xColumns.push_back(&column(dims.first));
+      yColumns.push_back(&column(dims.second));
+      toCompute.push_back(&histogram);
+    }
+  }
+
+  TLP_PARALLEL_MAP_INDICES(toCompute.size(), [&](uint i) {
+    computeHistogram(*xColumns[i], *yColumns[i], *toCompute[i]);
+  });
+}
+
+const ScatterPlotDensityHistogram &ScatterPlotDensityModel::histogram(const string &xDim,
+                                                                      const string &yDim) {
+  computeHistograms({{xDim, yDim}});
+  return histograms[{xDim, yDim}];
+}
+
+void ScatterPlotDensityModel::computeHistogram(const Column &xColumn, const Column &yColumn,
+                                               ScatterPlotDensityHistogram &histogram) const {
+  histogram.nbBins = nbBins;
+  histogram.counts.assign(nbBins * nbBins, 0);
+  histogram.maxCount = 0;
+  // same ranges as the axis of the detailed scatter plot
+  histogram.xRange = {xColumn.min, xColumn.max == xColumn.min ? xColumn.max + 1 : xColumn.max};
+  histogram.yRange = {yColumn.min, yColumn.max == yColumn.min ? yColumn.max + 1 : yColumn.max};
+
+  double xScale = nbBins / (histogram.xRange.second - histogram.xRange.first);
+  double yScale = nbBins / (histogram.yRange.second - histogram.yRange.first);
+  double sumxiyi = 0.0, sumxi = 0.0, sumyi = 0.0, sumxi2 = 0.0, sumyi2 = 0.0;
+  uint nbValues = xColumn.values.size();
+
+  for (uint i = 0; i < nbValues; ++i) {
+    double xValue = xColumn.values[i];
+    double yValue = yColumn.values[i];
+
+    sumxi += xValue;
+    sumxi2 += (xValue * xValue);
+    sumyi += yValue;
+    sumyi2 += (yValue * yValue);
+    sumxiyi += (xValue * yValue);
+
+    uint xBin = min(nbBins - 1, uint(max(0.0, (xValue - histogram.xRange.first) * xScale)));
+    uint yBin = min(nbBins - 1, uint(max(0.0, (yValue - histogram.yRange.first) * yScale)));
+    uint &count = histogram.counts[yBin * nbBins + xBin];
+    histogram.maxCount = max(histogram.maxCount, ++count);
+  }
+
+  double numerator = sumxiyi - (1. / nbValues) * sumxi * sumyi;
+  double denominator = sqrt(sumxi2 - (1. / nbValues) * (sumxi * sumxi)) *
+                       sqrt(sumyi2 - (1. / nbValues) * (sumyi * sumyi));
+
+  if (nbValues == 0 || denominator == 0) {
+    histogram.correlationCoeff = 0;
+  } else {
+    histogram.correlationCoeff = numerator / denominator;
+  }
+}
+}
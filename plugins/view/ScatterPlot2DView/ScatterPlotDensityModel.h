@@ -0,0 +1,99 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef SCATTER_PLOT_DENSITY_MODEL_H
+#define SCATTER_PLOT_DENSITY_MODEL_H
+
+#include <talipot/Graph.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tlp {
+
+/**
+ * 2D histogram of the values of a pair of properties.
+ * Bins are stored row by row, the first row holding the lowest y values.
+ */
+struct ScatterPlotDensityHistogram {
+  uint nbBins = 0;
+  std::vector<uint> counts;
+  uint maxCount = 0;
+  std::pair<double, double> xRange, yRange;
+  double correlationCoeff = 0;
+
+  bool isValid() const {
+    return nbBins != 0;
+  }
+};
+
+/**
+ * Data model shared by the overviews of the scatter plot matrix
+ * when they are rendered as density heatmaps.
+ *
+ * The values of each selected property are extracted once in a column,
+ * then the histograms of the property pairs are computed in parallel
+ * (one pass over the columns per pair) and cached until one of their
+ * properties is invalidated.
+ */
+class ScatterPlotDensityModel {
+public:
+  ScatterPlotDensityModel(uint nbBins = 256);
+
+  /**
+   * Sets the graph and the type of elements the values are read from,
+   * the cached data are dropped if one of them changes.
+   */
+  void setData(const Graph *graph, ElementType dataLocation);
+
+  /**
+   * Drops the cached data related to the given property.
+   */
+  void invalidate(const std::string &propertyName);
+
+  /**
+   * Drops all the cached data.
+   */
+  void clear();
+
+  /**
+   * Computes in parallel the histograms of the given property pairs
+   * which are not already cached.
+   */
+  void computeHistograms(const std::vector<std::pair<std::string, std::string>> &pairs);
+
+  /**
+   * Returns the histogram of the given property pair, computing it if needed.
+   */
+  const ScatterPlotDensityHistogram &histogram(const std::string &xDim, const std::string &yDim);
+
+private:
+  struct Column {
+    std::vector<double> values;
+    double min = 0, max = 0;
+  };
+
+  const Column &column(const std::string &propertyName);
+  void computeHistogram(const Column &xColumn, const Column &yColumn,
+                        ScatterPlotDensityHistogram &histogram) const;
+
+  const Graph *graph;
+  ElementType dataLocation;
+  uint nbBins;
+  std::map<std::string, Column> columns;
+  std::map<std::pair<std::string, std::string>, ScatterPlotDensityHistogram> histograms;
+};
+}
+
+#endif // SCATTER_PLOT_DENSITY_MODEL_H
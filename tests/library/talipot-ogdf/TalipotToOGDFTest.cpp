@@ -0,0 +1,118 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/TalipotToOGDF.h>
+#include <talipot/LayoutProperty.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class TalipotToOGDFTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TalipotToOGDFTest);
+  CPPUNIT_TEST(testConversion);
+  CPPUNIT_TEST(testReuse);
+  CPPUNIT_TEST(testInvalidation);
+  CPPUNIT_TEST(testSortElts);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    graph = newGraph();
+    nodes = graph->addNodes(4);
+    graph->addEdge(nodes[0], nodes[1]);
+    graph->addEdge(nodes[1], nodes[2]);
+    graph->addEdge(nodes[2], nodes[3]);
+    layout = graph->getLayoutProperty("viewLayout");
+  }
+
+  void tearDown() override {
+    delete graph;
+  }
+
+  void testConversion() {
+    layout->setNodeValue(nodes[2], Coord(5, 6, 7));
+    layout->setEdgeValue(graph->edges()[1], {Coord(1, 1, 0)});
+    auto conversion = TalipotToOGDF::getConversion(graph);
+    CPPUNIT_ASSERT_EQUAL(4, conversion->getOGDFGraph().numberOfNodes());
+    CPPUNIT_ASSERT_EQUAL(3, conversion->getOGDFGraph().numberOfEdges());
+    CPPUNIT_ASSERT_EQUAL(Coord(5, 6, 7), conversion->getNodeCoordFromOGDFGraphAttr(nodes[2]));
+    CPPUNIT_ASSERT_EQUAL(size_t(1),
+                         conversion->getEdgeCoordFromOGDFGraphAttr(graph->edges()[1]).size());
+
+    // the layout computed in OGDF is copied back
+    auto &attributes = conversion->getOGDFGraphAttr();
+    attributes.x(conversion->getOGDFGraphNode(nodes[0])) = 42;
+    conversion->copyOGDFLayoutToTlp(layout);
+    CPPUNIT_ASSERT_EQUAL(42.f, layout->getNodeValue(nodes[0]).getX());
+  }
+
+  void testReuse() {
+    // a conversion in use is not shared
+    auto conversion = TalipotToOGDF::getConversion(graph);
+    auto other = TalipotToOGDF::getConversion(graph);
+    CPPUNIT_ASSERT(other != conversion);
+    weak_ptr<TalipotToOGDF> kept = other;
+    other.reset();
+    conversion.reset();
+
+    // the last conversion is kept, then reused and its attributes synchronized again
+    CPPUNIT_ASSERT(!kept.expired());
+    layout->setNodeValue(nodes[1], Coord(3, 2, 1));
+    conversion = TalipotToOGDF::getConversion(graph);
+    CPPUNIT_ASSERT(conversion == kept.lock());
+    CPPUNIT_ASSERT_EQUAL(Coord(3, 2, 1), conversion->getNodeCoordFromOGDFGraphAttr(nodes[1]));
+  }
+
+  void testInvalidation() {
+    weak_ptr<TalipotToOGDF> kept = TalipotToOGDF::getConversion(graph);
+    CPPUNIT_ASSERT(!kept.expired());
+
+    // the conversion is dropped as soon as the topology changes
+    graph->addEdge(nodes[3], nodes[0]);
+    CPPUNIT_ASSERT(kept.expired());
+    auto conversion = TalipotToOGDF::getConversion(graph);
+    CPPUNIT_ASSERT_EQUAL(4, conversion->getOGDFGraph().numberOfEdges());
+    kept = conversion;
+    conversion.reset();
+
+    graph->delNode(nodes[3]);
+    CPPUNIT_ASSERT(kept.expired());
+    CPPUNIT_ASSERT_EQUAL(3, TalipotToOGDF::getConversion(graph)->getOGDFGraph().numberOfNodes());
+  }
+
+  void testSortElts() {
+    for (uint i = 0; i < 4; ++i) {
+      layout->setNodeValue(nodes[i], Coord(i, 0, 0));
+    }
+
+    Graph *sg = graph->addSubGraph();
+    sg->addNode(nodes[2]);
+    sg->addNode(nodes[0]);
+    TalipotToOGDF::getConversion(sg);
+
+    // sortElts reorders the elements without any event, the conversion must not be reused
+    sg->sortElts();
+    auto conversion = TalipotToOGDF::getConversion(sg);
+    CPPUNIT_ASSERT_EQUAL(Coord(0, 0, 0), conversion->getNodeCoordFromOGDFGraphAttr(nodes[0]));
+    CPPUNIT_ASSERT_EQUAL(Coord(2, 0, 0), conversion->getNodeCoordFromOGDFGraphAttr(nodes[2]));
+  }
+
+private:
+  Graph *graph;
+  vector<node> nodes;
+  LayoutProperty *layout;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TalipotToOGDFTest);
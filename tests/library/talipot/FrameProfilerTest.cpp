@@ -0,0 +1,145 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <sstream>
+
+#include <talipot/FrameProfiler.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class FrameProfilerTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(FrameProfilerTest);
+  CPPUNIT_TEST(testDisabled);
+  CPPUNIT_TEST(testStages);
+  CPPUNIT_TEST(testNestedFrames);
+  CPPUNIT_TEST(testRingBuffer);
+  CPPUNIT_TEST(testChromeTrace);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    FrameProfiler::clear();
+    FrameProfiler::setCapacity(256);
+    FrameProfiler::setEnabled(true);
+  }
+
+  void tearDown() override {
+    FrameProfiler::setEnabled(false);
+    FrameProfiler::clear();
+  }
+
+  void testDisabled() {
+    FrameProfiler::setEnabled(false);
+    FrameProfiler::beginFrame("frame");
+    { FrameProfiler::StageTimer timer("stage"); }
+    FrameProfiler::endFrame();
+    CPPUNIT_ASSERT_EQUAL(0u, FrameProfiler::numberOfFrames());
+  }
+
+  void testStages() {
+    // stages timed outside of a frame are ignored
+    { FrameProfiler::StageTimer timer("ignored"); }
+
+    FrameProfiler::beginFrame("frame");
+    {
+      FrameProfiler::StageTimer timer("first");
+      timer.setNbElements(10);
+      timer.addElements(5);
+    }
+    {
+      FrameProfiler::StageTimer timer("second");
+      // a stopped stage is not recorded again on destruction
+      timer.stop();
+    }
+    FrameProfiler::endFrame();
+
+    vector<ProfiledFrame> frames = FrameProfiler::frames();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), frames.size());
+    CPPUNIT_ASSERT_EQUAL(string("frame"), frames[0].name);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), frames[0].stages.size());
+    CPPUNIT_ASSERT_EQUAL(string("first"), frames[0].stages[0].name);
+    CPPUNIT_ASSERT_EQUAL(15u, frames[0].stages[0].nbElements);
+    CPPUNIT_ASSERT_EQUAL(string("second"), frames[0].stages[1].name);
+    CPPUNIT_ASSERT(frames[0].stages[1].start >= frames[0].stages[0].start);
+    CPPUNIT_ASSERT(frames[0].duration >=
+                   frames[0].stages[1].start + frames[0].stages[1].duration);
+  }
+
+  void testNestedFrames() {
+    FrameProfiler::beginFrame("outer");
+    FrameProfiler::beginFrame("inner");
+    { FrameProfiler::StageTimer timer("inner stage"); }
+    FrameProfiler::endFrame();
+    { FrameProfiler::StageTimer timer("outer stage"); }
+    FrameProfiler::endFrame();
+
+    vector<ProfiledFrame> frames = FrameProfiler::frames();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), frames.size());
+    CPPUNIT_ASSERT_EQUAL(string("inner"), frames[0].name);
+    CPPUNIT_ASSERT_EQUAL(string("inner stage"), frames[0].stages[0].name);
+    CPPUNIT_ASSERT_EQUAL(string("outer"), frames[1].name);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), frames[1].stages.size());
+    CPPUNIT_ASSERT_EQUAL(string("outer stage"), frames[1].stages[0].name);
+  }
+
+  void testRingBuffer() {
+    FrameProfiler::setCapacity(4);
+
+    for (uint i = 0; i < 10; ++i) {
+      FrameProfiler::beginFrame(to_string(i));
+      FrameProfiler::endFrame();
+    }
+
+    vector<ProfiledFrame> frames = FrameProfiler::frames();
+    CPPUNIT_ASSERT_EQUAL(size_t(4), frames.size());
+
+    for (uint i = 0; i < 4; ++i) {
+      CPPUNIT_ASSERT_EQUAL(to_string(i + 6), frames[i].name);
+    }
+
+    // reducing the capacity keeps the newest frames
+    FrameProfiler::setCapacity(2);
+    frames = FrameProfiler::frames();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), frames.size());
+    CPPUNIT_ASSERT_EQUAL(string("8"), frames[0].name);
+    CPPUNIT_ASSERT_EQUAL(string("9"), frames[1].name);
+  }
+
+  void testChromeTrace() {
+    FrameProfiler::beginFrame("a \"quoted\" frame");
+    {
+      FrameProfiler::StageTimer timer("stage");
+      timer.setNbElements(3);
+    }
+    FrameProfiler::endFrame();
+
+    stringstream ss;
+    FrameProfiler::writeChromeTrace(ss);
+    string trace = ss.str();
+    CPPUNIT_ASSERT(trace.starts_with("{\"traceEvents\":["));
+    CPPUNIT_ASSERT(trace.find("\"name\":\"a \\\"quoted\\\" frame\"") != string::npos);
+    CPPUNIT_ASSERT(trace.find("\"name\":\"stage\"") != string::npos);
+    CPPUNIT_ASSERT(trace.find("\"elements\":3") != string::npos);
+
+    // the times are written in fixed notation with three decimals
+    size_t tsPos = trace.find("\"ts\":") + 5;
+    string ts = trace.substr(tsPos, trace.find(',', tsPos) - tsPos);
+    CPPUNIT_ASSERT(ts.find('e') == string::npos);
+    CPPUNIT_ASSERT_EQUAL(ts.size() - 4, ts.find('.'));
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FrameProfilerTest);
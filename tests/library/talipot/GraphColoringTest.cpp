@@ -0,0 +1,141 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/GraphColoring.h>
+#include <talipot/Graph.h>
+#include <talipot/ParallelTools.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class GraphColoringTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(GraphColoringTest);
+  CPPUNIT_TEST(testCycles);
+  CPPUNIT_TEST(testLargestDegreeFirst);
+  CPPUNIT_TEST(testParallel);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    graph = newGraph();
+  }
+
+  void tearDown() override {
+    delete graph;
+  }
+
+  void testCycles() {
+    // an even cycle has 2 colors, an odd one 3, and the loops are ignored
+    vector<node> nodes = graph->addNodes(6);
+
+    for (uint i = 0; i < 6; ++i) {
+      graph->addEdge(nodes[i], nodes[(i + 1) % 6]);
+    }
+
+    graph->addEdge(nodes[0], nodes[0]);
+    GraphColoring coloring(graph);
+    CPPUNIT_ASSERT_EQUAL(2u, coloring.run({}, false));
+    checkColoring(coloring);
+
+    node n = graph->addNode();
+    graph->delEdge(graph->existEdge(nodes[5], nodes[0]));
+    graph->addEdge(nodes[5], n);
+    graph->addEdge(n, nodes[0]);
+    GraphColoring coloring2(graph);
+    CPPUNIT_ASSERT_EQUAL(3u, coloring2.run({}, false));
+    checkColoring(coloring2);
+  }
+
+  void testLargestDegreeFirst() {
+    // a star
+    node center = graph->addNode();
+
+    for (uint i = 0; i < 5; ++i) {
+      graph->addEdge(graph->addNode(), center);
+    }
+
+    // the loops are counted in the degrees, as in the ordering of Welsh and Powell,
+    // so a leaf with enough loops comes before the center
+    node leaf = graph->nodes()[1];
+
+    for (uint i = 0; i < 5; ++i) {
+      graph->addEdge(leaf, leaf);
+    }
+
+    GraphColoring coloring(graph);
+    vector<uint> ordering = coloring.largestDegreeFirstOrdering();
+    CPPUNIT_ASSERT_EQUAL(graph->nodePos(leaf), ordering[0]);
+    CPPUNIT_ASSERT_EQUAL(graph->nodePos(center), ordering[1]);
+    CPPUNIT_ASSERT_EQUAL(2u, coloring.run(ordering, false));
+    CPPUNIT_ASSERT_EQUAL(1u, coloring.color(graph->nodePos(center)));
+
+    // the center is alone in its color
+    vector<vector<uint>> independentSets = coloring.independentSets();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), independentSets.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(5), independentSets[0].size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), independentSets[1].size());
+  }
+
+  void testParallel() {
+    vector<node> nodes = graph->addNodes(2000);
+
+    for (uint i = 0; i < 2000; ++i) {
+      for (uint j = 1; j < 6; ++j) {
+        graph->addEdge(nodes[i], nodes[(i * j * 7 + j * 13) % 2000]);
+      }
+    }
+
+    GraphColoring coloring(graph);
+    vector<uint> ordering = coloring.largestDegreeFirstOrdering();
+    coloring.run(ordering, false);
+    vector<uint> sequentialColors = coloring.getColors();
+    CPPUNIT_ASSERT_EQUAL(1u, coloring.numberOfRounds());
+
+    // with one thread, the speculative coloring has no conflicts
+    uint nbThreads = ThreadManager::getNumberOfThreads();
+    ThreadManager::setNumberOfThreads(1);
+    coloring.run(ordering);
+    CPPUNIT_ASSERT_EQUAL(1u, coloring.numberOfRounds());
+    CPPUNIT_ASSERT(sequentialColors == coloring.getColors());
+
+    ThreadManager::setNumberOfThreads(4);
+    coloring.run(ordering);
+    ThreadManager::setNumberOfThreads(nbThreads);
+    checkColoring(coloring);
+  }
+
+private:
+  Graph *graph;
+
+  void checkColoring(const GraphColoring &coloring) {
+    uint nbNodes = 0;
+
+    for (const auto &independentSet : coloring.independentSets()) {
+      nbNodes += independentSet.size();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(graph->numberOfNodes(), nbNodes);
+
+    for (auto e : graph->edges()) {
+      const auto &[src, tgt] = graph->ends(e);
+
+      if (src != tgt) {
+        CPPUNIT_ASSERT(coloring.color(graph->nodePos(src)) != coloring.color(graph->nodePos(tgt)));
+      }
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GraphColoringTest);
@@ -0,0 +1,111 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/GraphMeasure.h>
+#include <talipot/Graph.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class GraphMeasureTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(GraphMeasureTest);
+  CPPUNIT_TEST(testCountTriangles);
+  CPPUNIT_TEST(testClusteringCoefficient);
+  CPPUNIT_TEST(testTransitivity);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    graph = newGraph();
+  }
+
+  void tearDown() override {
+    delete graph;
+  }
+
+  void testCountTriangles() {
+    buildGraph();
+    NodeVectorProperty<uint64_t> nodeTriangles(graph);
+    EdgeVectorProperty<uint> edgeTriangles(graph);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), countTriangles(graph, &nodeTriangles, &edgeTriangles));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), countTriangles(graph));
+
+    for (uint i = 0; i < 4; ++i) {
+      CPPUNIT_ASSERT_EQUAL(uint64_t(3), nodeTriangles[nodes[i]]);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), nodeTriangles[nodes[4]]);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), nodeTriangles[nodes[5]]);
+
+    // the edges of the clique, the multiple one included, are in two triangles
+    for (auto e : graph->edges()) {
+      const auto &[src, tgt] = graph->ends(e);
+      bool inClique = src != tgt && graph->nodePos(src) < 4 && graph->nodePos(tgt) < 4;
+      CPPUNIT_ASSERT_EQUAL(inClique ? 2u : 0u, edgeTriangles[e]);
+    }
+  }
+
+  void testClusteringCoefficient() {
+    buildGraph();
+    NodeVectorProperty<double> clusters(graph);
+    clusteringCoefficient(graph, clusters);
+
+    for (uint i = 0; i < 3; ++i) {
+      CPPUNIT_ASSERT_EQUAL(1.0, clusters[nodes[i]]);
+    }
+
+    // 3 of the 6 pairs of neighbours of the fourth node are linked
+    CPPUNIT_ASSERT_EQUAL(0.5, clusters[nodes[3]]);
+    CPPUNIT_ASSERT_EQUAL(0.0, clusters[nodes[4]]);
+    CPPUNIT_ASSERT_EQUAL(0.0, clusters[nodes[5]]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5 / 6, averageClusteringCoefficient(graph), 1e-9);
+
+    // at a distance of 2, the neighbourhood of the first node is made of the four other
+    // connected nodes, 4 of their 6 pairs being linked
+    clusteringCoefficient(graph, clusters, 2);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0 / 6, clusters[nodes[0]], 1e-9);
+    // the multiple edge of the clique reached from the fifth node is counted once
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, clusters[nodes[4]], 1e-9);
+  }
+
+  void testTransitivity() {
+    CPPUNIT_ASSERT_EQUAL(0.0, transitivity(graph));
+    buildGraph();
+    // 4 triangles and 3 * 3 + 6 connected triples centered on the clique nodes
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0 / 15, transitivity(graph), 1e-9);
+  }
+
+private:
+  Graph *graph;
+  vector<node> nodes;
+
+  // a clique of four nodes with a multiple edge and a self loop,
+  // a node linked to the fourth one and an isolated node
+  void buildGraph() {
+    nodes = graph->addNodes(6);
+
+    for (uint i = 0; i < 4; ++i) {
+      for (uint j = i + 1; j < 4; ++j) {
+        graph->addEdge(nodes[i], nodes[j]);
+      }
+    }
+
+    graph->addEdge(nodes[1], nodes[0]);
+    graph->addEdge(nodes[2], nodes[2]);
+    graph->addEdge(nodes[3], nodes[4]);
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GraphMeasureTest);
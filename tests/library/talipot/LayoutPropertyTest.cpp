@@ -0,0 +1,94 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/Graph.h>
+#include <talipot/LayoutProperty.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class LayoutPropertyTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(LayoutPropertyTest);
+  CPPUNIT_TEST(testSetValues);
+  CPPUNIT_TEST(testSetValuesReverseEdge);
+  CPPUNIT_TEST(testSetValuesSubgraph);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    graph = newGraph();
+    nodes = graph->addNodes(3);
+    edges.push_back(graph->addEdge(nodes[0], nodes[1]));
+    edges.push_back(graph->addEdge(nodes[1], nodes[2]));
+    layout = graph->getLayoutProperty("viewLayout");
+  }
+
+  void tearDown() override {
+    delete graph;
+  }
+
+  void testSetValues() {
+    // the bounding box computed before is invalidated
+    layout->setNodeValue(nodes[0], Coord(-5, -5, -5));
+    CPPUNIT_ASSERT_EQUAL(Coord(-5, -5, -5), layout->getMin());
+
+    layout->setValues({Coord(0, 0, 0), Coord(1, 2, 0), Coord(3, 1, 0)},
+                      {{Coord(0, 4, 0)}, {}});
+    CPPUNIT_ASSERT_EQUAL(Coord(1, 2, 0), layout->getNodeValue(nodes[1]));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), layout->getEdgeValue(edges[0]).size());
+    CPPUNIT_ASSERT(layout->getEdgeValue(edges[1]).empty());
+    CPPUNIT_ASSERT_EQUAL(Coord(0, 0, 0), layout->getMin());
+    CPPUNIT_ASSERT_EQUAL(Coord(3, 4, 0), layout->getMax());
+
+    // the bends are kept when none are given
+    layout->setValues({Coord(1, 1, 1), Coord(1, 2, 0), Coord(3, 1, 0)}, {});
+    CPPUNIT_ASSERT_EQUAL(Coord(1, 1, 1), layout->getNodeValue(nodes[0]));
+    CPPUNIT_ASSERT_EQUAL(Coord(0, 4, 0), layout->getEdgeValue(edges[0])[0]);
+  }
+
+  void testSetValuesReverseEdge() {
+    // the bends set at once are reversed with their edge
+    layout->setValues({Coord(0, 0, 0), Coord(1, 0, 0), Coord(2, 0, 0)},
+                      {{Coord(0, 1, 0), Coord(1, 1, 0)}, {}});
+    graph->reverse(edges[0]);
+    const vector<Coord> &bends = layout->getEdgeValue(edges[0]);
+    CPPUNIT_ASSERT_EQUAL(Coord(1, 1, 0), bends[0]);
+    CPPUNIT_ASSERT_EQUAL(Coord(0, 1, 0), bends[1]);
+  }
+
+  void testSetValuesSubgraph() {
+    // only the elements of the subgraph are set, in its own order
+    Graph *sg = graph->addSubGraph();
+    sg->addNode(nodes[2]);
+    sg->addNode(nodes[1]);
+    sg->addEdge(edges[1]);
+    layout->setAllNodeValue(Coord(7, 7, 7));
+    layout->setValues({Coord(2, 0, 0), Coord(1, 0, 0)}, {{Coord(5, 5, 0)}}, sg);
+    CPPUNIT_ASSERT_EQUAL(Coord(7, 7, 7), layout->getNodeValue(nodes[0]));
+    CPPUNIT_ASSERT_EQUAL(Coord(1, 0, 0), layout->getNodeValue(nodes[1]));
+    CPPUNIT_ASSERT_EQUAL(Coord(2, 0, 0), layout->getNodeValue(nodes[2]));
+    CPPUNIT_ASSERT(layout->getEdgeValue(edges[0]).empty());
+    CPPUNIT_ASSERT_EQUAL(Coord(5, 5, 0), layout->getEdgeValue(edges[1])[0]);
+    CPPUNIT_ASSERT_EQUAL(Coord(5, 5, 0), layout->getMax(sg));
+  }
+
+private:
+  Graph *graph;
+  vector<node> nodes;
+  vector<edge> edges;
+  LayoutProperty *layout;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LayoutPropertyTest);
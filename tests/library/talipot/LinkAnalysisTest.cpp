@@ -0,0 +1,153 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <cmath>
+#include <numeric>
+
+#include <talipot/LinkAnalysis.h>
+#include <talipot/Graph.h>
+#include <talipot/DoubleProperty.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class LinkAnalysisTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(LinkAnalysisTest);
+  CPPUNIT_TEST(testPageRank);
+  CPPUNIT_TEST(testBatch);
+  CPPUNIT_TEST(testPersonalization);
+  CPPUNIT_TEST(testEigenvectorCentrality);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    graph = newGraph();
+  }
+
+  void tearDown() override {
+    delete graph;
+  }
+
+  void testPageRank() {
+    // all the nodes of a directed cycle have the same rank
+    vector<node> nodes = graph->addNodes(5);
+
+    for (uint i = 0; i < 5; ++i) {
+      graph->addEdge(nodes[i], nodes[(i + 1) % 5]);
+    }
+
+    LinkAnalysis linkAnalysis(graph);
+    vector<vector<double>> ranks;
+    uint nbIterations = linkAnalysis.pageRank({0.85}, {{}}, ranks);
+    CPPUNIT_ASSERT(nbIterations < 1000);
+
+    for (uint i = 0; i < 5; ++i) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, ranks[0][i], 1e-9);
+    }
+
+    // a node linked by all the others gets the highest rank
+    graph->addEdge(nodes[2], nodes[0]);
+    graph->addEdge(nodes[3], nodes[0]);
+    LinkAnalysis linkAnalysis2(graph);
+    linkAnalysis2.pageRank({0.85}, {{}}, ranks);
+
+    for (uint i = 1; i < 5; ++i) {
+      CPPUNIT_ASSERT(ranks[0][0] > ranks[0][i]);
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, accumulate(ranks[0].begin(), ranks[0].end(), 0.0), 1e-8);
+  }
+
+  void testBatch() {
+    buildGraph();
+    DoubleProperty weight(graph);
+
+    for (auto e : graph->edges()) {
+      weight[e] = 1 + e.id % 3;
+    }
+
+    LinkAnalysis linkAnalysis(graph, false, &weight);
+    vector<double> seeds(graph->numberOfNodes(), 0);
+    seeds[3] = 1;
+    vector<vector<double>> ranks, singleRanks;
+    linkAnalysis.pageRank({0.85, 0.5, 0.85}, {{}, {}, seeds}, ranks, 1e-12);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), ranks.size());
+
+    // the computations of a batch are the same as the separate ones
+    for (uint j = 0; j < 3; ++j) {
+      linkAnalysis.pageRank({j == 1 ? 0.5 : 0.85}, {j == 2 ? seeds : vector<double>()},
+                            singleRanks, 1e-12);
+
+      for (uint i = 0; i < graph->numberOfNodes(); ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(singleRanks[0][i], ranks[j][i], 1e-10);
+      }
+    }
+  }
+
+  void testPersonalization() {
+    // a path with a seed at one end: the ranks increase toward the seed
+    vector<node> nodes = graph->addNodes(6);
+
+    for (uint i = 0; i + 1 < 6; ++i) {
+      graph->addEdge(nodes[i], nodes[i + 1]);
+    }
+
+    LinkAnalysis linkAnalysis(graph, false);
+    vector<vector<double>> ranks;
+    linkAnalysis.pageRank({0.85}, {{0, 0, 0, 0, 0, 2}}, ranks);
+
+    for (uint i = 0; i + 2 < 6; ++i) {
+      CPPUNIT_ASSERT(ranks[0][i] < ranks[0][i + 1]);
+    }
+
+    // the neighbour of the seed also gets the ranks flowing from the other nodes
+    CPPUNIT_ASSERT(ranks[0][5] > 0.15);
+    CPPUNIT_ASSERT(ranks[0][4] > ranks[0][5]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, accumulate(ranks[0].begin(), ranks[0].end(), 0.0), 1e-8);
+  }
+
+  void testEigenvectorCentrality() {
+    // a star, which is bipartite: the center is twice as central as the leaves
+    node center = graph->addNode();
+
+    for (uint i = 0; i < 4; ++i) {
+      graph->addEdge(center, graph->addNode());
+    }
+
+    LinkAnalysis linkAnalysis(graph, false);
+    vector<double> centralities;
+    uint nbIterations = linkAnalysis.eigenvectorCentrality(centralities, 1e-12);
+    CPPUNIT_ASSERT(nbIterations < 1000);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1 / sqrt(2.0), centralities[0], 1e-9);
+
+    for (uint i = 1; i < 5; ++i) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(centralities[0] / 2, centralities[i], 1e-9);
+    }
+  }
+
+private:
+  Graph *graph;
+
+  void buildGraph() {
+    vector<node> nodes = graph->addNodes(30);
+
+    for (uint i = 0; i < 30; ++i) {
+      graph->addEdge(nodes[i], nodes[(i * 7 + 3) % 30]);
+      graph->addEdge(nodes[i], nodes[(i * i + 1) % 30]);
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LinkAnalysisTest);
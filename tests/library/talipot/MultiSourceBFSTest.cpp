@@ -0,0 +1,183 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/MultiSourceBFS.h>
+#include <talipot/Graph.h>
+#include <talipot/GraphMeasure.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class MultiSourceBFSTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(MultiSourceBFSTest);
+  CPPUNIT_TEST(testAllSources);
+  CPPUNIT_TEST(testDirected);
+  CPPUNIT_TEST(testLongPath);
+  CPPUNIT_TEST(testSampledSources);
+  CPPUNIT_TEST(testAveragePathLength);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    graph = newGraph();
+  }
+
+  void tearDown() override {
+    delete graph;
+  }
+
+  // more nodes than the sources of a batch, compared to the distances of single searches
+  void testAllSources() {
+    buildGraph(150);
+    MultiSourceBFS bfs(graph);
+    CPPUNIT_ASSERT(bfs.run());
+    CPPUNIT_ASSERT_EQUAL(150u, bfs.numberOfSources());
+    NodeVectorProperty<uint> distance(graph);
+
+    for (uint i = 0; i < 150; ++i) {
+      CPPUNIT_ASSERT_EQUAL(i, bfs.source(i));
+      uint eccentricity = maxDistance(graph, graph->nodes()[i], distance);
+      uint64_t sum = 0;
+      uint nbReached = 0;
+
+      for (uint d : distance) {
+        if (d != UINT_MAX && d != 0) {
+          sum += d;
+          ++nbReached;
+        }
+      }
+
+      CPPUNIT_ASSERT_EQUAL(eccentricity, bfs.eccentricity(i));
+      CPPUNIT_ASSERT_EQUAL(sum, bfs.sourceDistancesSum(i));
+      CPPUNIT_ASSERT_EQUAL(nbReached, bfs.nbReachedNodes(i));
+      // the distances are symmetric
+      CPPUNIT_ASSERT_EQUAL(sum, bfs.targetDistancesSum(i));
+      CPPUNIT_ASSERT_EQUAL(nbReached, bfs.nbReachingSources(i));
+    }
+
+    // the isolated node
+    CPPUNIT_ASSERT_EQUAL(0u, bfs.eccentricity(149));
+    CPPUNIT_ASSERT_EQUAL(0u, bfs.nbReachedNodes(149));
+  }
+
+  void testDirected() {
+    vector<node> nodes = graph->addNodes(4);
+    graph->addEdge(nodes[0], nodes[1]);
+    graph->addEdge(nodes[1], nodes[2]);
+    graph->addEdge(nodes[2], nodes[3]);
+    graph->addEdge(nodes[0], nodes[3]);
+
+    MultiSourceBFS bfs(graph, EdgeType::DIRECTED);
+    bfs.run();
+    CPPUNIT_ASSERT_EQUAL(2u, bfs.eccentricity(0));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), bfs.sourceDistancesSum(0));
+    CPPUNIT_ASSERT_EQUAL(0u, bfs.nbReachedNodes(3));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1 + 2 + 1), bfs.targetDistancesSum(3));
+    CPPUNIT_ASSERT_EQUAL(3u, bfs.nbReachingSources(3));
+
+    MultiSourceBFS inverseBfs(graph, EdgeType::INV_DIRECTED);
+    inverseBfs.run();
+    CPPUNIT_ASSERT_EQUAL(3u, inverseBfs.nbReachedNodes(3));
+    CPPUNIT_ASSERT_EQUAL(0u, inverseBfs.nbReachedNodes(0));
+  }
+
+  void testLongPath() {
+    // the frontiers are small compared to the graph, so the reached nodes are listed
+    vector<node> nodes = graph->addNodes(1000);
+
+    for (uint i = 0; i + 1 < 1000; ++i) {
+      graph->addEdge(nodes[i], nodes[i + 1]);
+    }
+
+    MultiSourceBFS bfs(graph);
+    bfs.run();
+
+    for (uint i = 0; i < 1000; ++i) {
+      uint64_t before = i, after = 999 - i;
+      uint64_t sum = (before * (before + 1) + after * (after + 1)) / 2;
+      CPPUNIT_ASSERT_EQUAL(uint(std::max(before, after)), bfs.eccentricity(i));
+      CPPUNIT_ASSERT_EQUAL(sum, bfs.sourceDistancesSum(i));
+      CPPUNIT_ASSERT_EQUAL(999u, bfs.nbReachedNodes(i));
+      CPPUNIT_ASSERT_EQUAL(sum, bfs.targetDistancesSum(i));
+      CPPUNIT_ASSERT_EQUAL(999u, bfs.nbReachingSources(i));
+    }
+  }
+
+  void testSampledSources() {
+    buildGraph(100);
+    vector<uint> sources = MultiSourceBFS::randomSources(100, 10);
+    CPPUNIT_ASSERT_EQUAL(size_t(10), sources.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(10), set<uint>(sources.begin(), sources.end()).size());
+
+    MultiSourceBFS bfs(graph);
+    bfs.run(sources);
+    MultiSourceBFS allBfs(graph);
+    allBfs.run();
+    uint64_t sourcesSum = 0, targetsSum = 0;
+
+    for (uint i = 0; i < 10; ++i) {
+      CPPUNIT_ASSERT_EQUAL(sources[i], bfs.source(i));
+      CPPUNIT_ASSERT_EQUAL(allBfs.eccentricity(sources[i]), bfs.eccentricity(i));
+      sourcesSum += bfs.sourceDistancesSum(i);
+    }
+
+    for (uint n = 0; n < 100; ++n) {
+      targetsSum += bfs.targetDistancesSum(n);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(sourcesSum, targetsSum);
+  }
+
+  void testAveragePathLength() {
+    // the average distance in a path of n nodes is (n + 1) / 3
+    vector<node> nodes = graph->addNodes(100);
+
+    for (uint i = 0; i + 1 < 100; ++i) {
+      graph->addEdge(nodes[i], nodes[i + 1]);
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(101.0 / 3, averagePathLength(graph), 1e-9);
+    double errorBound = -1;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(101.0 / 3, averagePathLength(graph, 100, &errorBound), 1e-9);
+    CPPUNIT_ASSERT_EQUAL(0.0, errorBound);
+    double estimation = averagePathLength(graph, 50, &errorBound);
+    CPPUNIT_ASSERT(errorBound > 0);
+    CPPUNIT_ASSERT(fabs(estimation - 101.0 / 3) < 3 * errorBound);
+  }
+
+private:
+  Graph *graph;
+
+  // a grid with some diagonals, and an isolated node
+  void buildGraph(uint nbNodes) {
+    vector<node> nodes = graph->addNodes(nbNodes);
+
+    for (uint i = 0; i + 1 < nbNodes; ++i) {
+      if ((i + 1) % 10 && i + 2 < nbNodes) {
+        graph->addEdge(nodes[i], nodes[i + 1]);
+      }
+
+      if (i + 10 < nbNodes - 1) {
+        graph->addEdge(nodes[i + 10], nodes[i]);
+      }
+
+      if (i % 7 == 0 && i + 11 < nbNodes - 1) {
+        graph->addEdge(nodes[i], nodes[i + 11]);
+      }
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MultiSourceBFSTest);
@@ -0,0 +1,202 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/MultilevelCoarsening.h>
+#include <talipot/Graph.h>
+#include <talipot/LayoutProperty.h>
+#include <talipot/BooleanProperty.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace std;
+using namespace tlp;
+
+class MultilevelCoarseningTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(MultilevelCoarseningTest);
+  CPPUNIT_TEST(testFinestLevel);
+  CPPUNIT_TEST(testCoarsening);
+  CPPUNIT_TEST(testFixedNodes);
+  CPPUNIT_TEST(testProlongation);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() override {
+    graph = newGraph();
+  }
+
+  void tearDown() override {
+    delete graph;
+  }
+
+  void testFinestLevel() {
+    vector<node> nodes = graph->addNodes(3);
+    edge e0 = graph->addEdge(nodes[0], nodes[1]);
+    edge e1 = graph->addEdge(nodes[1], nodes[2]);
+    // self loops are ignored
+    graph->addEdge(nodes[2], nodes[2]);
+
+    MultilevelCoarsening coarsening(graph);
+    const MultilevelCoarsening::Level &level = coarsening.level(0);
+    CPPUNIT_ASSERT_EQUAL(1u, coarsening.numberOfLevels());
+    CPPUNIT_ASSERT_EQUAL(3u, level.numberOfNodes());
+    CPPUNIT_ASSERT_EQUAL(1u, level.degree(0));
+    CPPUNIT_ASSERT_EQUAL(2u, level.degree(1));
+    CPPUNIT_ASSERT_EQUAL(1u, level.degree(2));
+    CPPUNIT_ASSERT_EQUAL(1u, level.adjNodes[level.adjStart[0]]);
+    CPPUNIT_ASSERT_EQUAL(e0, level.adjEdges[level.adjStart[0]]);
+    CPPUNIT_ASSERT_EQUAL(1u, level.adjNodes[level.adjStart[2]]);
+    CPPUNIT_ASSERT_EQUAL(e1, level.adjEdges[level.adjStart[2]]);
+
+    for (uint u = 0; u < 3; ++u) {
+      CPPUNIT_ASSERT_EQUAL(1.0, level.weights[u]);
+      CPPUNIT_ASSERT(!level.fixed[u]);
+    }
+  }
+
+  void testCoarsening() {
+    buildGrid(10);
+
+    MultilevelCoarsening coarsening(graph);
+    uint nbLevels = coarsening.coarsen(8);
+    CPPUNIT_ASSERT_EQUAL(nbLevels, coarsening.numberOfLevels());
+    CPPUNIT_ASSERT(nbLevels > 1);
+    CPPUNIT_ASSERT(coarsening.level(nbLevels - 1).numberOfNodes() <= 8);
+
+    for (uint l = 0; l + 1 < nbLevels; ++l) {
+      const MultilevelCoarsening::Level &fine = coarsening.level(l);
+      const MultilevelCoarsening::Level &coarse = coarsening.level(l + 1);
+      CPPUNIT_ASSERT(coarse.numberOfNodes() <= 0.8 * fine.numberOfNodes());
+      CPPUNIT_ASSERT(coarse.adjEdges.empty());
+
+      // the weights of the nodes and of the edges between distinct coarse nodes are kept
+      double fineWeight = 0, coarseWeight = 0;
+      double fineEdgesWeight = 0, coarseEdgesWeight = 0;
+
+      for (uint u = 0; u < fine.numberOfNodes(); ++u) {
+        fineWeight += fine.weights[u];
+
+        for (uint i = fine.adjStart[u]; i < fine.adjStart[u + 1]; ++i) {
+          if (fine.coarseNodes[u] != fine.coarseNodes[fine.adjNodes[i]]) {
+            fineEdgesWeight += fine.adjWeights[i];
+          }
+        }
+      }
+
+      for (uint u = 0; u < coarse.numberOfNodes(); ++u) {
+        coarseWeight += coarse.weights[u];
+
+        for (uint i = coarse.adjStart[u]; i < coarse.adjStart[u + 1]; ++i) {
+          CPPUNIT_ASSERT(coarse.adjNodes[i] != u);
+          coarseEdgesWeight += coarse.adjWeights[i];
+        }
+      }
+
+      CPPUNIT_ASSERT_EQUAL(100.0, fineWeight);
+      CPPUNIT_ASSERT_EQUAL(fineWeight, coarseWeight);
+      CPPUNIT_ASSERT_EQUAL(fineEdgesWeight, coarseEdgesWeight);
+    }
+  }
+
+  void testFixedNodes() {
+    buildGrid(6);
+    BooleanProperty fixed(graph);
+
+    for (uint i = 0; i < 6; ++i) {
+      fixed.setNodeValue(graph->nodes()[i], true);
+    }
+
+    MultilevelCoarsening coarsening(graph, nullptr, nullptr, &fixed);
+    coarsening.coarsen(4);
+    CPPUNIT_ASSERT(coarsening.numberOfLevels() > 1);
+    const MultilevelCoarsening::Level &fine = coarsening.level(0);
+
+    // a fixed node is alone in its coarse node
+    for (uint u = 0; u < fine.numberOfNodes(); ++u) {
+      for (uint v = u + 1; v < fine.numberOfNodes(); ++v) {
+        if (fine.coarseNodes[u] == fine.coarseNodes[v]) {
+          CPPUNIT_ASSERT(!fine.fixed[u] && !fine.fixed[v]);
+        }
+      }
+    }
+
+    CPPUNIT_ASSERT(coarsening.level(1).fixed[fine.coarseNodes[0]]);
+  }
+
+  void testProlongation() {
+    buildGrid(6);
+    LayoutProperty layout(graph);
+    BooleanProperty fixed(graph);
+    const vector<node> &nodes = graph->nodes();
+
+    for (uint i = 0; i < nodes.size(); ++i) {
+      layout.setNodeValue(nodes[i], Coord(i % 6, i / 6, 0));
+    }
+
+    fixed.setNodeValue(nodes[0], true);
+
+    MultilevelCoarsening coarsening(graph, &layout, nullptr, &fixed);
+    coarsening.coarsen(4);
+    CPPUNIT_ASSERT(coarsening.numberOfLevels() > 1);
+    MultilevelCoarsening::Level &fine = coarsening.level(0);
+    MultilevelCoarsening::Level &coarse = coarsening.level(1);
+
+    // the coarse nodes are at the barycenter of their fine nodes
+    for (uint u = 0; u < fine.numberOfNodes(); ++u) {
+      CPPUNIT_ASSERT(fine.positions[u].dist(coarse.positions[fine.coarseNodes[u]]) <= 0.5f);
+    }
+
+    // move the coarse level, the fine nodes follow it
+    for (auto &pos : coarse.positions) {
+      pos *= 10.f;
+    }
+
+    coarsening.prolong(0);
+
+    double edgeLength = 0;
+
+    for (uint u = 0; u < coarse.numberOfNodes(); ++u) {
+      for (uint i = coarse.adjStart[u]; i < coarse.adjStart[u + 1]; ++i) {
+        edgeLength += coarse.positions[u].dist(coarse.positions[coarse.adjNodes[i]]);
+      }
+    }
+
+    edgeLength /= coarse.adjNodes.size();
+    CPPUNIT_ASSERT_EQUAL(Coord(0, 0, 0), fine.positions[0]);
+
+    for (uint u = 1; u < fine.numberOfNodes(); ++u) {
+      float dist = fine.positions[u].dist(coarse.positions[fine.coarseNodes[u]]);
+      CPPUNIT_ASSERT(dist <= edgeLength / 10 + 1e-3);
+    }
+  }
+
+private:
+  Graph *graph;
+
+  void buildGrid(uint side) {
+    vector<node> nodes = graph->addNodes(side * side);
+
+    for (uint i = 0; i < side; ++i) {
+      for (uint j = 0; j < side; ++j) {
+        if (i + 1 < side) {
+          graph->addEdge(nodes[i * side + j], nodes[(i + 1) * side + j]);
+        }
+
+        if (j + 1 < side) {
+          graph->addEdge(nodes[i * side + j], nodes[i * side + j + 1]);
+        }
+      }
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MultilevelCoarseningTest);
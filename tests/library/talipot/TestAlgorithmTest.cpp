@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -18,6 +18,7 @@
 #include <talipot/AcyclicTest.h>
 #include <talipot/ConnectedTest.h>
 #include <talipot/BiconnectedTest.h>
+#include <talipot/ParallelTools.h>
 
 #include "TestAlgorithmTest.h"
 
@@ -225,6 +226,63 @@ void TestAlgorithmTest::testConnected() {
   graph->addEdge(n3, n4);
   CPPUNIT_ASSERT(!ConnectedTest::isConnected(graph));
   CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(graph));
+
+  // the components are updated by the insertions
+  vector<node> nodes = graph->addNodes(2);
+  CPPUNIT_ASSERT_EQUAL(4u, ConnectedTest::numberOfConnectedComponents(graph));
+  graph->addEdges({{nodes[0], nodes[1]}, {nodes[1], n4}});
+  CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(graph));
+  graph->addEdge(n2, nodes[0]);
+  CPPUNIT_ASSERT(ConnectedTest::isConnected(graph));
+  graph->delNode(n4);
+  CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(graph));
+
+  // sortElts reorders the nodes without any event, the cached components must still be valid
+  Graph *sg = graph->addSubGraph();
+  nodes = graph->addNodes(4);
+  sg->addNodes({nodes[3], nodes[2], nodes[1], nodes[0]});
+  sg->addEdge(graph->addEdge(nodes[3], nodes[2]));
+  CPPUNIT_ASSERT_EQUAL(3u, ConnectedTest::numberOfConnectedComponents(sg));
+  sg->sortElts();
+  sg->addEdge(graph->addEdge(nodes[0], nodes[1]));
+  CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(sg));
+}
+//==========================================================
+void TestAlgorithmTest::testConnectedSmallSubgraphs() {
+  // many small subgraphs of a large graph, whose nodes have sparse ids,
+  // as the ones induced by the components in the layout plugins
+  const uint nbNodes = 100000;
+  const uint nbSubGraphs = 1000;
+  vector<node> nodes = graph->addNodes(nbNodes);
+
+  for (uint i = 0; i < nbSubGraphs; ++i) {
+    // a path of 3 nodes spread over the whole graph, and a node alone
+    uint step = nbNodes / nbSubGraphs;
+    node n1 = nodes[i];
+    node n2 = nodes[i + step * (nbSubGraphs / 2)];
+    node n3 = nodes[nbNodes - 1 - i];
+    node n4 = nodes[i + step / 2];
+    Graph *sg = graph->addSubGraph();
+    sg->addNodes({n3, n1, n4, n2});
+    sg->addEdge(graph->addEdge(n1, n2));
+    sg->addEdge(graph->addEdge(n2, n3));
+    CPPUNIT_ASSERT(!ConnectedTest::isConnected(sg));
+    CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(sg));
+    sg->addEdge(graph->addEdge(n4, n1));
+    CPPUNIT_ASSERT(ConnectedTest::isConnected(sg));
+  }
+
+  // a node with a large id added to a subgraph whose ids are dense
+  Graph *sg = graph->addSubGraph();
+  sg->addNodes({nodes[0], nodes[1], nodes[2]});
+  sg->addEdge(graph->addEdge(nodes[0], nodes[1]));
+  CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(sg));
+  sg->addNode(nodes.back());
+  CPPUNIT_ASSERT_EQUAL(3u, ConnectedTest::numberOfConnectedComponents(sg));
+  sg->addEdge(graph->addEdge(nodes[2], nodes.back()));
+  CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(sg));
+  sg->addEdge(graph->addEdge(nodes[1], nodes.back()));
+  CPPUNIT_ASSERT(ConnectedTest::isConnected(sg));
 }
 //==========================================================
 const std::string GRAPHPATH = "./DATA/graphs/";
@@ -331,3 +389,45 @@ void TestAlgorithmTest::testBridges() {
   sort(bridges.begin(), bridges.end());
   CPPUNIT_ASSERT_EQUAL(edges, bridges);
 }
+//==========================================================
+void TestAlgorithmTest::testLargeComponents() {
+  // a long path, which cannot be searched recursively, and isolated edges
+  uint nbNodes = 100000;
+  vector<node> nodes = graph->addNodes(nbNodes);
+
+  for (uint i = 0; i + 1 < nbNodes; i += 2) {
+    graph->addEdge(nodes[i], nodes[i + 1]);
+  }
+
+  for (uint i = 1; i + 1 < nbNodes / 2; i += 2) {
+    graph->addEdge(nodes[i], nodes[i + 1]);
+  }
+
+  // the parallel computation gives the same components
+  auto components = ConnectedTest::computeConnectedComponents(graph);
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+  ThreadManager::setNumberOfThreads(4);
+  auto parallelComponents = ConnectedTest::computeConnectedComponents(graph);
+  ThreadManager::setNumberOfThreads(nbThreads);
+  CPPUNIT_ASSERT_EQUAL(size_t(nbNodes / 4 + 1), components.size());
+  CPPUNIT_ASSERT_EQUAL(components.size(), parallelComponents.size());
+
+  for (uint i = 0; i < components.size(); ++i) {
+    CPPUNIT_ASSERT_EQUAL(components[i][0], parallelComponents[i][0]);
+    sort(components[i].begin(), components[i].end());
+    CPPUNIT_ASSERT_EQUAL(components[i], parallelComponents[i]);
+  }
+
+  CPPUNIT_ASSERT_EQUAL(uint(components.size()), ConnectedTest::numberOfConnectedComponents(graph));
+  CPPUNIT_ASSERT_EQUAL(size_t(graph->numberOfEdges()), ConnectedTest::computeBridges(graph).size());
+  CPPUNIT_ASSERT(!BiconnectedTest::isBiconnected(graph));
+
+  // link the nodes in a cycle
+  for (uint i = nbNodes / 2 - 1; i < nbNodes; i += 2) {
+    graph->addEdge(nodes[i], nodes[(i + 1) % nbNodes]);
+  }
+
+  CPPUNIT_ASSERT(ConnectedTest::isConnected(graph));
+  CPPUNIT_ASSERT(ConnectedTest::computeBridges(graph).empty());
+  CPPUNIT_ASSERT(BiconnectedTest::isBiconnected(graph));
+}
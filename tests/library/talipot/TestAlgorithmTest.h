@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -27,8 +27,10 @@ class TestAlgorithmTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testTree);
   CPPUNIT_TEST(testAcyclic);
   CPPUNIT_TEST(testConnected);
+  CPPUNIT_TEST(testConnectedSmallSubgraphs);
   CPPUNIT_TEST(testBiconnected);
   CPPUNIT_TEST(testBridges);
+  CPPUNIT_TEST(testLargeComponents);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -42,8 +44,10 @@ public:
   void testTree();
   void testAcyclic();
   void testConnected();
+  void testConnectedSmallSubgraphs();
   void testBiconnected();
   void testBridges();
+  void testLargeComponents();
 };
 
 #endif // TEST_ALGORITHM_TEST_H
@@ -0,0 +1,74 @@
+/**
+ *
+ * Copyright (C) 2026  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/UnionFind.h>
+
+#include "CppUnitIncludes.h"
+
+using namespace tlp;
+
+class UnionFindTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(UnionFindTest);
+  CPPUNIT_TEST(testMerge);
+  CPPUNIT_TEST(testAddElement);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testMerge() {
+    UnionFind sets(10);
+    CPPUNIT_ASSERT_EQUAL(10u, sets.numberOfSets());
+
+    for (uint i = 0; i < 10; ++i) {
+      CPPUNIT_ASSERT_EQUAL(i, sets.find(i));
+    }
+
+    // the even and the odd elements
+    for (uint i = 2; i < 10; ++i) {
+      sets.merge(i - 2, i);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(2u, sets.numberOfSets());
+    CPPUNIT_ASSERT(sets.sameSet(0, 8));
+    CPPUNIT_ASSERT(sets.sameSet(1, 9));
+    CPPUNIT_ASSERT(!sets.sameSet(0, 9));
+    CPPUNIT_ASSERT_EQUAL(5u, sets.setSize(3));
+
+    // the representative of the largest set is kept
+    sets.reset(4);
+    sets.merge(1, 2);
+    uint root = sets.find(1);
+    CPPUNIT_ASSERT_EQUAL(root, sets.merge(3, 2));
+    CPPUNIT_ASSERT_EQUAL(2u, sets.numberOfSets());
+    CPPUNIT_ASSERT_EQUAL(3u, sets.setSize(3));
+    CPPUNIT_ASSERT_EQUAL(1u, sets.setSize(0));
+
+    // merging elements of the same set changes nothing
+    CPPUNIT_ASSERT_EQUAL(root, sets.merge(1, 3));
+    CPPUNIT_ASSERT_EQUAL(2u, sets.numberOfSets());
+  }
+
+  void testAddElement() {
+    UnionFind sets;
+    CPPUNIT_ASSERT_EQUAL(0u, sets.numberOfElements());
+    CPPUNIT_ASSERT_EQUAL(0u, sets.addElement());
+    CPPUNIT_ASSERT_EQUAL(1u, sets.addElement());
+    CPPUNIT_ASSERT_EQUAL(2u, sets.numberOfSets());
+    sets.merge(0, 1);
+    CPPUNIT_ASSERT_EQUAL(2u, sets.addElement());
+    CPPUNIT_ASSERT_EQUAL(3u, sets.numberOfElements());
+    CPPUNIT_ASSERT_EQUAL(2u, sets.numberOfSets());
+    CPPUNIT_ASSERT(!sets.sameSet(0, 2));
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(UnionFindTest);
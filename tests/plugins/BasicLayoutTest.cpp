@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2024  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -17,6 +17,11 @@
 #include <talipot/SizeProperty.h>
 #include <talipot/BooleanProperty.h>
 #include <talipot/DoubleProperty.h>
+#include <talipot/ConnectedTest.h>
+#include <talipot/StringCollection.h>
+#include <talipot/BoundingBox.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/TlpTools.h>
 
 using namespace std;
 using namespace tlp;
@@ -64,6 +69,46 @@ void BasicLayoutTest::testBubbleTree() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testBubbleTreeIncremental() {
+  initializeGraph("Random General Tree");
+  SizeProperty *viewSize = graph->getSizeProperty("viewSize");
+  LayoutProperty layout(graph), expected(graph);
+  string errorMsg;
+  DataSet ds;
+  ds.set("incremental", true);
+
+  // each modification of the tree is followed by an incremental run
+  // whose result must be the one of a full run
+  for (uint i = 0; i < 4; ++i) {
+    const vector<node> &nodes = graph->nodes();
+    node n = nodes[(7 * i + 3) % nodes.size()];
+
+    if (i == 1) {
+      graph->addEdge(n, graph->addNode());
+    } else if (i == 2) {
+      viewSize->setNodeValue(n, Size(3, 2, 1));
+    } else if (i == 3 && graph->indeg(n) != 0) {
+      // remove the subtree rooted in n
+      vector<node> subtree = {n};
+
+      for (uint j = 0; j < subtree.size(); ++j) {
+        for (auto child : graph->getOutNodes(subtree[j])) {
+          subtree.push_back(child);
+        }
+      }
+
+      graph->delNodes(subtree);
+    }
+
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Bubble Tree", &layout, errorMsg, &ds));
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Bubble Tree", &expected, errorMsg));
+
+    for (auto m : graph->nodes()) {
+      CPPUNIT_ASSERT_EQUAL(expected.getNodeValue(m), layout.getNodeValue(m));
+    }
+  }
+}
+//==========================================================
 void BasicLayoutTest::testCircular() {
   bool result = computeProperty<LayoutProperty>("Circular");
   CPPUNIT_ASSERT(result);
@@ -79,6 +124,56 @@ void BasicLayoutTest::testConnectedComponentPacking() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testConnectedComponentPackingShelves() {
+  const uint nbComponents = 500;
+  LayoutProperty *layout = graph->getLayoutProperty("viewLayout");
+  SizeProperty *size = graph->getSizeProperty("viewSize");
+
+  for (uint i = 0; i < nbComponents; ++i) {
+    node n1 = graph->addNode();
+    node n2 = graph->addNode();
+    graph->addEdge(n1, n2);
+    // all the components overlap before the packing
+    layout->setNodeValue(n1, Coord(i % 7, i % 5, 0));
+    layout->setNodeValue(n2, Coord(i % 7 + 1 + i % 3, i % 5 + 2, 0));
+    size->setNodeValue(n1, Size(1 + i % 4, 1, 1));
+    size->setNodeValue(n2, Size(1, 1 + i % 2, 1));
+  }
+
+  DataSet ds;
+  StringCollection complexity("auto;n;shelves;");
+  complexity.setCurrent("shelves");
+  ds.set("complexity", complexity);
+  LayoutProperty result(graph);
+  string errorMsg;
+  CPPUNIT_ASSERT(
+      graph->applyPropertyAlgorithm("Connected Components Packing", &result, errorMsg, &ds));
+
+  vector<BoundingBox> boxes;
+
+  for (const auto &component : ConnectedTest::computeConnectedComponents(graph)) {
+    BoundingBox box;
+
+    for (auto n : component) {
+      box.expand(result.getNodeValue(n) - size->getNodeValue(n) / 2.f);
+      box.expand(result.getNodeValue(n) + size->getNodeValue(n) / 2.f);
+    }
+
+    boxes.push_back(box);
+  }
+
+  CPPUNIT_ASSERT_EQUAL(size_t(nbComponents), boxes.size());
+
+  for (uint i = 0; i < nbComponents; ++i) {
+    for (uint j = i + 1; j < nbComponents; ++j) {
+      bool overlap =
+          boxes[i][0][0] < boxes[j][1][0] - 1e-3 && boxes[j][0][0] < boxes[i][1][0] - 1e-3 &&
+          boxes[i][0][1] < boxes[j][1][1] - 1e-3 && boxes[j][0][1] < boxes[i][1][1] - 1e-3;
+      CPPUNIT_ASSERT(!overlap);
+    }
+  }
+}
+//==========================================================
 void BasicLayoutTest::testDendrogram() {
   initializeGraph("Planar Graph");
   DataSet ds;
@@ -100,16 +195,257 @@ void BasicLayoutTest::testGEMLayout() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testGEMLayoutMultilevel() {
+  const uint side = 12;
+  vector<node> nodes = graph->addNodes(side * side);
+
+  for (uint i = 0; i < side; ++i) {
+    for (uint j = 0; j + 1 < side; ++j) {
+      graph->addEdge(nodes[i * side + j], nodes[i * side + j + 1]);
+      graph->addEdge(nodes[j * side + i], nodes[(j + 1) * side + i]);
+    }
+  }
+
+  DataSet ds;
+  ds.set("multilevel", true);
+  LayoutProperty prop(graph);
+  string errorMsg;
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("GEM (Frick)", &prop, errorMsg, &ds));
+
+  // the nodes of the finest level are all placed, apart from each other
+  BoundingBox box;
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+    CPPUNIT_ASSERT(prop.getNodeValue(src).dist(prop.getNodeValue(tgt)) > 0.f);
+    box.expand(prop.getNodeValue(src));
+  }
+
+  CPPUNIT_ASSERT(box.width() > 0.f && box.height() > 0.f);
+}
+//==========================================================
+void BasicLayoutTest::testGRIP() {
+  const uint side = 12;
+  vector<node> nodes = graph->addNodes(side * side);
+
+  for (uint i = 0; i < side; ++i) {
+    for (uint j = 0; j + 1 < side; ++j) {
+      graph->addEdge(nodes[i * side + j], nodes[i * side + j + 1]);
+      graph->addEdge(nodes[j * side + i], nodes[(j + 1) * side + i]);
+    }
+  }
+
+  uint seed = tlp::getSeedOfRandomSequence();
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+
+  auto runGRIP = [&](bool parallel, uint nbThreads) {
+    tlp::setSeedOfRandomSequence(7);
+    ThreadManager::setNumberOfThreads(nbThreads);
+    DataSet ds;
+    ds.set("parallel", parallel);
+    LayoutProperty prop(graph);
+    string errorMsg;
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("GRIP", &prop, errorMsg, &ds));
+    vector<Coord> coords;
+
+    for (auto n : nodes) {
+      const Coord &c = prop.getNodeValue(n);
+      CPPUNIT_ASSERT(isfinite(c[0]) && isfinite(c[1]) && isfinite(c[2]));
+      coords.push_back(c);
+    }
+
+    return coords;
+  };
+
+  // for a fixed seed, the sequential layout is reproducible
+  // and the parallel one does not depend on the number of threads
+  vector<Coord> sequential = runGRIP(false, 1);
+  CPPUNIT_ASSERT(sequential == runGRIP(false, 1));
+  vector<Coord> parallel = runGRIP(true, 1);
+  CPPUNIT_ASSERT(parallel == runGRIP(true, 4));
+
+  tlp::setSeedOfRandomSequence(seed);
+  ThreadManager::setNumberOfThreads(nbThreads);
+}
+//==========================================================
 void BasicLayoutTest::testHierarchicalGraph() {
   bool result = computeProperty<LayoutProperty>("Hierarchical Graph");
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testHierarchicalGraphCrossings() {
+  // four layers of 6 nodes, the root excepted, whose edges between consecutive layers
+  // all cross each other in the order of creation of the nodes,
+  // and long edges which are replaced by dummy nodes during the crossing reduction
+  const uint layerSize = 6;
+  vector<vector<node>> layers = {{graph->addNode()}};
+
+  for (uint i = 1; i < 4; ++i) {
+    layers.push_back(graph->addNodes(layerSize));
+  }
+
+  for (auto n : layers[1]) {
+    graph->addEdge(layers[0][0], n);
+  }
+
+  for (uint i = 1; i < 3; ++i) {
+    for (uint j = 0; j < layerSize; ++j) {
+      graph->addEdge(layers[i][j], layers[i + 1][layerSize - 1 - j]);
+    }
+  }
+
+  graph->addEdge(layers[0][0], layers[3][0]);
+  graph->addEdge(layers[1][0], layers[3][layerSize - 1]);
+
+  // the number of crossings of the edges between consecutive layers,
+  // with the nodes of each layer in the given order
+  auto nbCrossings = [&](const vector<vector<node>> &orderedLayers) {
+    uint nbCrossings = 0;
+
+    for (uint i = 0; i + 1 < orderedLayers.size(); ++i) {
+      flat_hash_map<node, uint> ranks;
+
+      for (uint j = 0; j < orderedLayers[i + 1].size(); ++j) {
+        ranks[orderedLayers[i + 1][j]] = j;
+      }
+
+      // the ranks of the targets of the edges, by rank of their source
+      vector<uint> tgtRanks;
+
+      for (auto n : orderedLayers[i]) {
+        for (auto m : graph->getOutNodes(n)) {
+          if (ranks.contains(m)) {
+            tgtRanks.push_back(ranks[m]);
+          }
+        }
+      }
+
+      for (uint j = 0; j < tgtRanks.size(); ++j) {
+        for (uint k = j + 1; k < tgtRanks.size(); ++k) {
+          nbCrossings += tgtRanks[j] > tgtRanks[k];
+        }
+      }
+    }
+
+    return nbCrossings;
+  };
+
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+
+  auto runHierarchicalGraph = [&](uint nbThreads) {
+    ThreadManager::setNumberOfThreads(nbThreads);
+    DataSet ds;
+    StringCollection orientation("horizontal;vertical;");
+    orientation.setCurrent("vertical");
+    ds.set("orientation", orientation);
+    LayoutProperty layout(graph);
+    string errorMsg;
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Hierarchical Graph", &layout, errorMsg, &ds));
+    vector<Coord> coords;
+
+    for (auto n : graph->nodes()) {
+      coords.push_back(layout.getNodeValue(n));
+    }
+
+    // the nodes of each layer from left to right
+    vector<vector<node>> orderedLayers = layers;
+
+    for (auto &layer : orderedLayers) {
+      stable_sort(layer.begin(), layer.end(), [&](node n1, node n2) {
+        return layout.getNodeValue(n1)[0] < layout.getNodeValue(n2)[0];
+      });
+    }
+
+    return make_pair(coords, nbCrossings(orderedLayers));
+  };
+
+  // the crossings are reduced, in the same way whatever the number of threads
+  auto [coords, crossings] = runHierarchicalGraph(1);
+  CPPUNIT_ASSERT_EQUAL(2 * layerSize * (layerSize - 1) / 2, nbCrossings(layers));
+  CPPUNIT_ASSERT(crossings < nbCrossings(layers));
+  auto [parallelCoords, parallelCrossings] = runHierarchicalGraph(4);
+  CPPUNIT_ASSERT(coords == parallelCoords);
+  CPPUNIT_ASSERT_EQUAL(crossings, parallelCrossings);
+
+  ThreadManager::setNumberOfThreads(nbThreads);
+}
+//==========================================================
 void BasicLayoutTest::testImprovedWalker() {
   bool result = computeProperty<LayoutProperty>("Improved Walker");
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testLinLog() {
+  const uint side = 12;
+  vector<node> nodes = graph->addNodes(side * side);
+
+  for (uint i = 0; i < side; ++i) {
+    for (uint j = 0; j + 1 < side; ++j) {
+      graph->addEdge(nodes[i * side + j], nodes[i * side + j + 1]);
+      graph->addEdge(nodes[j * side + i], nodes[(j + 1) * side + i]);
+    }
+  }
+
+  uint seed = tlp::getSeedOfRandomSequence();
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+
+  auto runLinLog = [&](bool parallel, bool multilevel, uint nbThreads) {
+    tlp::setSeedOfRandomSequence(7);
+    ThreadManager::setNumberOfThreads(nbThreads);
+    DataSet ds;
+    ds.set("parallel", parallel);
+    ds.set("multilevel", multilevel);
+    LayoutProperty prop(graph);
+    string errorMsg;
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("LinLog", &prop, errorMsg, &ds));
+    vector<Coord> coords;
+
+    for (auto n : nodes) {
+      const Coord &c = prop.getNodeValue(n);
+      CPPUNIT_ASSERT(isfinite(c[0]) && isfinite(c[1]) && isfinite(c[2]));
+      coords.push_back(c);
+    }
+
+    return coords;
+  };
+
+  // the average length of the edges relatively to the average distance between two nodes,
+  // which is about 0.15 for a grid drawn as a square
+  auto edgeLengthRatio = [&](const vector<Coord> &coords) {
+    double edgesLength = 0, pairsDistance = 0;
+
+    for (auto e : graph->edges()) {
+      const auto &[src, tgt] = graph->ends(e);
+      edgesLength += coords[graph->nodePos(src)].dist(coords[graph->nodePos(tgt)]);
+    }
+
+    for (uint i = 0; i < coords.size(); ++i) {
+      for (uint j = i + 1; j < coords.size(); ++j) {
+        pairsDistance += coords[i].dist(coords[j]);
+      }
+    }
+
+    return (edgesLength / graph->numberOfEdges()) /
+           (pairsDistance / (coords.size() * (coords.size() - 1) / 2));
+  };
+
+  // for a fixed seed, the Jacobi and multilevel layouts are reproducible with 1 thread.
+  // The sums of the octtree depend on the number of threads, so the layouts computed
+  // with several ones may differ, but they must unfold the grid as well
+  for (bool multilevel : {false, true}) {
+    vector<Coord> coords = runLinLog(true, multilevel, 1);
+    CPPUNIT_ASSERT(coords == runLinLog(true, multilevel, 1));
+    double ratio = edgeLengthRatio(coords);
+    CPPUNIT_ASSERT(ratio < 0.5);
+    double parallelRatio = edgeLengthRatio(runLinLog(true, multilevel, 4));
+    CPPUNIT_ASSERT(parallelRatio < 0.5);
+    CPPUNIT_ASSERT(parallelRatio < 2 * ratio);
+  }
+
+  tlp::setSeedOfRandomSequence(seed);
+  ThreadManager::setNumberOfThreads(nbThreads);
+}
+//==========================================================
 void BasicLayoutTest::testMixedModel() {
   initializeGraph("Planar Graph");
   DataSet ds;
@@ -140,6 +476,43 @@ void BasicLayoutTest::testSquarifiedTreeMap() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testSquarifiedTreeMapParallel() {
+  // a tree large enough for its subtrees to be laid out in parallel
+  const uint nbNodes = 12000;
+  vector<node> nodes = graph->addNodes(nbNodes);
+  DoubleProperty metric(graph);
+
+  for (uint i = 1; i < nbNodes; ++i) {
+    graph->addEdge(nodes[(i - 1) / (2 + i % 5)], nodes[i]);
+    metric[nodes[i]] = 1 + i % 7;
+  }
+
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+
+  auto runTreeMap = [&](uint nbThreads) {
+    ThreadManager::setNumberOfThreads(nbThreads);
+    DataSet ds;
+    ds.set("metric", &metric);
+    LayoutProperty layout(graph);
+    SizeProperty size(graph);
+    ds.set("Node Size", &size);
+    string errorMsg;
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Squarified Tree Map", &layout, errorMsg, &ds));
+    vector<pair<Coord, Size>> rectangles;
+
+    for (auto n : nodes) {
+      rectangles.emplace_back(layout.getNodeValue(n), size.getNodeValue(n));
+    }
+
+    return rectangles;
+  };
+
+  // the rectangles do not depend on the number of threads
+  CPPUNIT_ASSERT(runTreeMap(1) == runTreeMap(4));
+
+  ThreadManager::setNumberOfThreads(nbThreads);
+}
+//==========================================================
 void BasicLayoutTest::testTreeLeaf() {
   initializeGraph("Planar Graph");
   DataSet ds;
@@ -163,11 +536,109 @@ void BasicLayoutTest::testTreeReingoldAndTilfordExtended() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testTreeReingoldAndTilfordExtendedIncremental() {
+  initializeGraph("Random General Tree");
+  SizeProperty *viewSize = graph->getSizeProperty("viewSize");
+  LayoutProperty layout(graph), expected(graph);
+  string errorMsg;
+
+  // each modification of the tree is followed by an incremental run
+  // whose result must be the one of a full run, with node boxes or bounding circles
+  for (bool boundingCircles : {false, true}) {
+    DataSet ds, fullDs;
+    ds.set("incremental", true);
+    ds.set("bounding circles", boundingCircles);
+    fullDs.set("bounding circles", boundingCircles);
+
+    for (uint i = 0; i < 4; ++i) {
+      const vector<node> &nodes = graph->nodes();
+      node n = nodes[(7 * i + 3) % nodes.size()];
+
+      if (i == 1) {
+        graph->addEdge(n, graph->addNode());
+      } else if (i == 2) {
+        viewSize->setNodeValue(n, Size(3, 2, 1));
+      } else if (i == 3 && graph->indeg(n) != 0) {
+        // remove the subtree rooted in n
+        vector<node> subtree = {n};
+
+        for (uint j = 0; j < subtree.size(); ++j) {
+          for (auto child : graph->getOutNodes(subtree[j])) {
+            subtree.push_back(child);
+          }
+        }
+
+        graph->delNodes(subtree);
+      }
+
+      CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Hierarchical Tree (R-T Extended)", &layout,
+                                                   errorMsg, &ds));
+      CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Hierarchical Tree (R-T Extended)", &expected,
+                                                   errorMsg, &fullDs));
+
+      for (auto m : graph->nodes()) {
+        CPPUNIT_ASSERT_EQUAL(expected.getNodeValue(m), layout.getNodeValue(m));
+      }
+    }
+  }
+
+  // a long chain, whose contours are too large to be all kept
+  graph->clear();
+  vector<node> chain = graph->addNodes(2000);
+
+  for (uint i = 0; i + 1 < chain.size(); ++i) {
+    graph->addEdge(chain[i], chain[i + 1]);
+  }
+
+  DataSet ds;
+  ds.set("incremental", true);
+
+  for (uint i : {0, 500, 1500}) {
+    if (i != 0) {
+      graph->addEdge(chain[i], graph->addNode());
+    }
+
+    CPPUNIT_ASSERT(
+        graph->applyPropertyAlgorithm("Hierarchical Tree (R-T Extended)", &layout, errorMsg, &ds));
+    CPPUNIT_ASSERT(
+        graph->applyPropertyAlgorithm("Hierarchical Tree (R-T Extended)", &expected, errorMsg));
+
+    for (auto m : graph->nodes()) {
+      CPPUNIT_ASSERT_EQUAL(expected.getNodeValue(m), layout.getNodeValue(m));
+    }
+  }
+}
+//==========================================================
 void BasicLayoutTest::testTutte() {
   bool result = computeProperty<LayoutProperty>("3-Connected (Tutte)", "Complete General Graph");
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testTuttePlanar() {
+  LayoutProperty layout(graph);
+  bool result = computeProperty<LayoutProperty>("3-Connected (Tutte)", "Planar Graph", &layout);
+  CPPUNIT_ASSERT(result);
+
+  // the nodes which are not on the outer cycle, placed on a circle of radius 100
+  // centered on (200, 200), must be at the barycenter of their neighbours
+  for (auto n : graph->nodes()) {
+    const Coord &coord = layout.getNodeValue(n);
+
+    if (fabs(coord.dist(Coord(200, 200, 0)) - 100) < 1e-3) {
+      continue;
+    }
+
+    Coord barycenter(0, 0, 0);
+
+    for (auto nn : graph->getInOutNodes(n)) {
+      barycenter += layout.getNodeValue(nn);
+    }
+
+    barycenter /= graph->deg(n);
+    CPPUNIT_ASSERT(coord.dist(barycenter) < 1e-3);
+  }
+}
+//==========================================================
 void BasicLayoutTest::testKruskal() {
   BooleanProperty selection(graph);
   bool result = computeProperty<BooleanProperty>("Kruskal", "Planar Graph", &selection);
@@ -186,3 +657,71 @@ void BasicLayoutTest::testFastOverlapRemoval() {
   bool result = graph->applyPropertyAlgorithm("Fast Overlap Removal", &layout, errorMsg, &ds);
   CPPUNIT_ASSERT(result);
 }
+//==========================================================
+void BasicLayoutTest::testFastOverlapRemovalClusters() {
+  // separated groups of overlapping nodes
+  vector<node> nodes = graph->addNodes(60);
+  LayoutProperty *viewLayout = graph->getLayoutProperty("viewLayout");
+  SizeProperty *viewSize = graph->getSizeProperty("viewSize");
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    viewLayout->setNodeValue(nodes[i], Coord((i / 6) * 20 + (i % 6) * 0.3f, (i % 3) * 0.4f, 0));
+    viewSize->setNodeValue(nodes[i], Size(1, 1, 1));
+  }
+
+  LayoutProperty layout(graph);
+  string errorMsg;
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Fast Overlap Removal", &layout, errorMsg));
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    const Coord &c1 = layout.getNodeValue(nodes[i]);
+
+    for (uint j = i + 1; j < nodes.size(); ++j) {
+      const Coord &c2 = layout.getNodeValue(nodes[j]);
+      CPPUNIT_ASSERT(fabs(c1[0] - c2[0]) >= 0.999f || fabs(c1[1] - c2[1]) >= 0.999f);
+    }
+  }
+}
+//==========================================================
+void BasicLayoutTest::testFastOverlapRemovalEmptyGraph() {
+  LayoutProperty layout(graph);
+  string errorMsg;
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Fast Overlap Removal", &layout, errorMsg));
+}
+//==========================================================
+void BasicLayoutTest::testFastOverlapRemovalSubgraph() {
+  vector<node> nodes = graph->addNodes(20);
+  LayoutProperty *viewLayout = graph->getLayoutProperty("viewLayout");
+  SizeProperty *viewSize = graph->getSizeProperty("viewSize");
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    viewLayout->setNodeValue(nodes[i], Coord(i * 0.2f, 0, 0));
+    viewSize->setNodeValue(nodes[i], Size(1, 1, 1));
+  }
+
+  // a subgraph inheriting the layout, whose nodes are not in the order of the root graph
+  Graph *sg = graph->addSubGraph();
+
+  for (uint i = nodes.size() - 1; i >= 10; --i) {
+    sg->addNode(nodes[i]);
+  }
+
+  LayoutProperty layout(graph);
+  layout.copy(viewLayout);
+  string errorMsg;
+  CPPUNIT_ASSERT(sg->applyPropertyAlgorithm("Fast Overlap Removal", &layout, errorMsg));
+
+  // only the nodes of the subgraph are moved
+  for (uint i = 0; i < 10; ++i) {
+    CPPUNIT_ASSERT_EQUAL(viewLayout->getNodeValue(nodes[i]), layout.getNodeValue(nodes[i]));
+  }
+
+  for (uint i = 10; i < nodes.size(); ++i) {
+    const Coord &c1 = layout.getNodeValue(nodes[i]);
+
+    for (uint j = i + 1; j < nodes.size(); ++j) {
+      const Coord &c2 = layout.getNodeValue(nodes[j]);
+      CPPUNIT_ASSERT(fabs(c1[0] - c2[0]) >= 0.999f || fabs(c1[1] - c2[1]) >= 0.999f);
+    }
+  }
+}
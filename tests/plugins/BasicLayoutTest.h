@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -23,23 +23,35 @@ class Graph;
 class BasicLayoutTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(BasicLayoutTest);
   CPPUNIT_TEST(testBubbleTree);
+  CPPUNIT_TEST(testBubbleTreeIncremental);
   CPPUNIT_TEST(testCircular);
   CPPUNIT_TEST(testConeTreeExtended);
   CPPUNIT_TEST(testConnectedComponentPacking);
+  CPPUNIT_TEST(testConnectedComponentPackingShelves);
   CPPUNIT_TEST(testDendrogram);
   CPPUNIT_TEST(testGEMLayout);
+  CPPUNIT_TEST(testGEMLayoutMultilevel);
+  CPPUNIT_TEST(testGRIP);
   CPPUNIT_TEST(testHierarchicalGraph);
+  CPPUNIT_TEST(testHierarchicalGraphCrossings);
   CPPUNIT_TEST(testImprovedWalker);
+  CPPUNIT_TEST(testLinLog);
   CPPUNIT_TEST(testMixedModel);
   CPPUNIT_TEST(testRandomLayout);
   CPPUNIT_TEST(testSquarifiedTreeMap);
+  CPPUNIT_TEST(testSquarifiedTreeMapParallel);
   CPPUNIT_TEST(testTreeLeaf);
   CPPUNIT_TEST(testTreeMap);
   CPPUNIT_TEST(testTreeRadial);
   CPPUNIT_TEST(testTreeReingoldAndTilfordExtended);
+  CPPUNIT_TEST(testTreeReingoldAndTilfordExtendedIncremental);
   CPPUNIT_TEST(testTutte);
+  CPPUNIT_TEST(testTuttePlanar);
   CPPUNIT_TEST(testKruskal);
   CPPUNIT_TEST(testFastOverlapRemoval);
+  CPPUNIT_TEST(testFastOverlapRemovalClusters);
+  CPPUNIT_TEST(testFastOverlapRemovalEmptyGraph);
+  CPPUNIT_TEST(testFastOverlapRemovalSubgraph);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -54,23 +66,35 @@ public:
   void tearDown() override;
 
   void testBubbleTree();
+  void testBubbleTreeIncremental();
   void testCircular();
   void testConeTreeExtended();
   void testConnectedComponentPacking();
+  void testConnectedComponentPackingShelves();
   void testDendrogram();
   void testGEMLayout();
+  void testGEMLayoutMultilevel();
+  void testGRIP();
   void testHierarchicalGraph();
+  void testHierarchicalGraphCrossings();
   void testImprovedWalker();
+  void testLinLog();
   void testMixedModel();
   void testRandomLayout();
   void testSquarifiedTreeMap();
+  void testSquarifiedTreeMapParallel();
   void testTreeLeaf();
   void testTreeMap();
   void testTreeRadial();
   void testTreeReingoldAndTilfordExtended();
+  void testTreeReingoldAndTilfordExtendedIncremental();
   void testTutte();
+  void testTuttePlanar();
   void testKruskal();
   void testFastOverlapRemoval();
+  void testFastOverlapRemovalClusters();
+  void testFastOverlapRemovalEmptyGraph();
+  void testFastOverlapRemovalSubgraph();
 };
 
 #endif // BASIC_LAYOUT_TEST_H
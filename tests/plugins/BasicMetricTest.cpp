@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2021  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -13,6 +13,9 @@
 
 #include "BasicMetricTest.h"
 #include <talipot/DoubleProperty.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/StringCollection.h>
+#include <talipot/TlpTools.h>
 
 using namespace std;
 using namespace tlp;
@@ -102,6 +105,161 @@ void BasicMetricTest::testIdMetric() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicMetricTest::testKCores() {
+  bool result = computeProperty<DoubleProperty>("K-Cores");
+  CPPUNIT_ASSERT(result);
+  graph->clear();
+
+  // a symmetric 4-clique, a node linked from two of its nodes,
+  // a node linked from this one and an isolated node
+  vector<node> nodes = graph->addNodes(7);
+  DoubleProperty weights(graph);
+
+  for (uint i = 0; i < 4; ++i) {
+    for (uint j = 0; j < 4; ++j) {
+      if (i != j) {
+        weights[graph->addEdge(nodes[i], nodes[j])] = 2;
+      }
+    }
+  }
+
+  weights[graph->addEdge(nodes[0], nodes[4])] = 1;
+  weights[graph->addEdge(nodes[1], nodes[4])] = 0.5;
+  weights[graph->addEdge(nodes[4], nodes[5])] = 2.5;
+
+  auto checkKCores = [&](const string &type, NumericProperty *metric,
+                         const vector<double> &expected) {
+    DoubleProperty kCores(graph);
+    string errorMsg;
+    DataSet ds;
+    StringCollection types("InOut;In;Out;");
+    types.setCurrent(type);
+    ds.set("type", types);
+
+    if (metric) {
+      ds.set("metric", metric);
+    }
+
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("K-Cores", &kCores, errorMsg, &ds));
+
+    for (uint i = 0; i < nodes.size(); ++i) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], kCores[nodes[i]], 1e-9);
+    }
+  };
+
+  checkKCores("InOut", nullptr, {6, 6, 6, 6, 2, 1, 0});
+  checkKCores("In", nullptr, {3, 3, 3, 3, 2, 1, 0});
+  checkKCores("Out", nullptr, {3, 3, 3, 3, 0, 0, 0});
+  checkKCores("InOut", &weights, {12, 12, 12, 12, 2.5, 2.5, 0});
+  checkKCores("In", &weights, {6, 6, 6, 6, 1.5, 1.5, 0});
+  checkKCores("Out", &weights, {6, 6, 6, 6, 0, 0, 0});
+
+  // a self loop increases the degree of its node but never lowers its value under its core level
+  graph->addEdge(nodes[2], nodes[2]);
+  checkKCores("InOut", nullptr, {6, 6, 6, 6, 2, 1, 0});
+}
+//==========================================================
+void BasicMetricTest::testKCoresParallel() {
+  // enough nodes for the unweighted peeling to run in parallel with several threads:
+  // a dense core of 300 nodes in a sparse random graph, with a few loops
+  const uint nbNodes = 60000, coreSize = 300;
+  vector<node> nodes = graph->addNodes(nbNodes);
+  uint seed = 12345;
+
+  auto nextRandom = [&seed](uint max) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % max;
+  };
+
+  for (uint i = 0; i < coreSize; ++i) {
+    for (uint j = 1; j <= 40; ++j) {
+      graph->addEdge(nodes[i], nodes[(i + j) % coreSize]);
+    }
+  }
+
+  for (uint i = 0; i < 4 * nbNodes; ++i) {
+    graph->addEdge(nodes[nextRandom(nbNodes)], nodes[nextRandom(nbNodes)]);
+  }
+
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+
+  for (const string type : {"InOut", "In", "Out"}) {
+    DataSet ds;
+    StringCollection types("InOut;In;Out;");
+    types.setCurrent(type);
+    ds.set("type", types);
+    DoubleProperty sequential(graph), parallel(graph);
+    string errorMsg;
+    ThreadManager::setNumberOfThreads(1);
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("K-Cores", &sequential, errorMsg, &ds));
+    ThreadManager::setNumberOfThreads(4);
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("K-Cores", &parallel, errorMsg, &ds));
+
+    for (auto n : nodes) {
+      CPPUNIT_ASSERT_EQUAL(sequential[n], parallel[n]);
+    }
+
+    // the nodes of the core have at least 40 neighbours in it
+    CPPUNIT_ASSERT(sequential[nodes[0]] >= (type == "InOut" ? 80 : 40));
+  }
+
+  ThreadManager::setNumberOfThreads(nbThreads);
+}
+//==========================================================
+void BasicMetricTest::testLabelPropagation() {
+  bool result = computeProperty<DoubleProperty>("Label Propagation");
+  CPPUNIT_ASSERT(result);
+  graph->clear();
+
+  // two cliques of 6 nodes linked by a single edge of low weight: a node never takes
+  // the label of a neighbour in the other clique, as the weight of this label is lower
+  // than the one of any label of its own clique, so the cliques are the communities
+  // whatever the random order of the updates and the scheduling of the threads
+  const uint cliqueSize = 6;
+  vector<node> nodes = graph->addNodes(2 * cliqueSize);
+  DoubleProperty weights(graph);
+  weights.setAllEdgeValue(1);
+
+  for (uint i = 0; i < cliqueSize; ++i) {
+    for (uint j = i + 1; j < cliqueSize; ++j) {
+      graph->addEdge(nodes[i], nodes[j]);
+      graph->addEdge(nodes[i + cliqueSize], nodes[j + cliqueSize]);
+    }
+  }
+
+  weights[graph->addEdge(nodes[0], nodes[cliqueSize])] = 0.1;
+
+  uint seed = tlp::getSeedOfRandomSequence();
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+
+  for (uint threads : {1, 4}) {
+    ThreadManager::setNumberOfThreads(threads);
+
+    for (uint s = 1; s <= 20; ++s) {
+      tlp::setSeedOfRandomSequence(s);
+      DoubleProperty communities(graph);
+      string errorMsg;
+      DataSet ds;
+      ds.set("metric", &weights);
+      CPPUNIT_ASSERT(
+          graph->applyPropertyAlgorithm("Label Propagation", &communities, errorMsg, &ds));
+      uint nbCommunities = 0;
+      CPPUNIT_ASSERT(ds.get("#communities", nbCommunities));
+      CPPUNIT_ASSERT_EQUAL(2u, nbCommunities);
+
+      for (uint i = 1; i < cliqueSize; ++i) {
+        CPPUNIT_ASSERT_EQUAL(communities[nodes[0]], communities[nodes[i]]);
+        CPPUNIT_ASSERT_EQUAL(communities[nodes[cliqueSize]], communities[nodes[i + cliqueSize]]);
+      }
+
+      CPPUNIT_ASSERT(communities[nodes[0]] != communities[nodes[cliqueSize]]);
+    }
+  }
+
+  tlp::setSeedOfRandomSequence(seed);
+  ThreadManager::setNumberOfThreads(nbThreads);
+}
+//==========================================================
 void BasicMetricTest::testLeafMetric() {
   bool result = computeProperty<DoubleProperty>("Leaf");
   CPPUNIT_ASSERT(result == false);
@@ -110,6 +268,54 @@ void BasicMetricTest::testLeafMetric() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicMetricTest::testLinkCommunities() {
+  bool result = computeProperty<DoubleProperty>("Link Communities");
+  CPPUNIT_ASSERT(result);
+  graph->clear();
+
+  // two triangles sharing a node, and a pendant edge on the second one
+  vector<node> nodes = graph->addNodes(6);
+  vector<edge> edges = {graph->addEdge(nodes[0], nodes[1]), graph->addEdge(nodes[1], nodes[2]),
+                        graph->addEdge(nodes[2], nodes[0]), graph->addEdge(nodes[0], nodes[3]),
+                        graph->addEdge(nodes[3], nodes[4]), graph->addEdge(nodes[4], nodes[0]),
+                        graph->addEdge(nodes[4], nodes[5])};
+  DoubleProperty weights(graph);
+  weights.setAllEdgeValue(1);
+  weights[edges[0]] = weights[edges[1]] = weights[edges[2]] = 2;
+  weights[edges[6]] = 3;
+
+  for (NumericProperty *metric : {static_cast<NumericProperty *>(nullptr),
+                                  static_cast<NumericProperty *>(&weights)}) {
+    DoubleProperty groups(graph);
+    string errorMsg;
+    DataSet ds;
+
+    if (metric) {
+      ds.set("metric", metric);
+    }
+
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Link Communities", &groups, errorMsg, &ds));
+
+    // each triangle is a group, the pendant edge being an isthmus in no group
+    CPPUNIT_ASSERT(groups[edges[0]] != 0);
+    CPPUNIT_ASSERT(groups[edges[3]] != 0);
+    CPPUNIT_ASSERT(groups[edges[0]] != groups[edges[3]]);
+
+    for (uint i = 1; i < 3; ++i) {
+      CPPUNIT_ASSERT_EQUAL(groups[edges[0]], groups[edges[i]]);
+      CPPUNIT_ASSERT_EQUAL(groups[edges[3]], groups[edges[i + 3]]);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0.0, groups[edges[6]]);
+
+    // the value of a node is its number of groups
+    CPPUNIT_ASSERT_EQUAL(2.0, groups[nodes[0]]);
+    CPPUNIT_ASSERT_EQUAL(1.0, groups[nodes[1]]);
+    CPPUNIT_ASSERT_EQUAL(1.0, groups[nodes[4]]);
+    CPPUNIT_ASSERT_EQUAL(0.0, groups[nodes[5]]);
+  }
+}
+//==========================================================
 void BasicMetricTest::testNodeMetric() {
   bool result = computeProperty<DoubleProperty>("Node");
   CPPUNIT_ASSERT(result == false);
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -31,7 +31,11 @@ class BasicMetricTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testDepthMetric);
   CPPUNIT_TEST(testEccentricity);
   CPPUNIT_TEST(testIdMetric);
+  CPPUNIT_TEST(testKCores);
+  CPPUNIT_TEST(testKCoresParallel);
+  CPPUNIT_TEST(testLabelPropagation);
   CPPUNIT_TEST(testLeafMetric);
+  CPPUNIT_TEST(testLinkCommunities);
   CPPUNIT_TEST(testNodeMetric);
   CPPUNIT_TEST(testPathLengthMetric);
   CPPUNIT_TEST(testRandomMetric);
@@ -59,7 +63,11 @@ public:
   void testDepthMetric();
   void testEccentricity();
   void testIdMetric();
+  void testKCores();
+  void testKCoresParallel();
+  void testLabelPropagation();
   void testLeafMetric();
+  void testLinkCommunities();
   void testNodeMetric();
   void testPathLengthMetric();
   void testRandomMetric();
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2025  The Talipot developers
+ * Copyright (C) 2019-2026  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -15,6 +15,7 @@
 #include <talipot/BooleanProperty.h>
 #include <talipot/ColorProperty.h>
 #include <talipot/DoubleProperty.h>
+#include <talipot/ParallelTools.h>
 #include <talipot/SizeProperty.h>
 #include <talipot/SimplePluginProgress.h>
 
@@ -412,6 +413,113 @@ void BasicPluginsTest::testStrengthClustering() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicPluginsTest::testStrengthClusteringPartition() {
+  // a ring of 4 cliques of 5 nodes, each one linked to the next one by a single edge
+  // which is in no triangle nor quadrangle, so the cliques are the clusters
+  const uint nbCliques = 4, cliqueSize = 5;
+  vector<node> nodes = graph->addNodes(nbCliques * cliqueSize);
+
+  for (uint c = 0; c < nbCliques; ++c) {
+    for (uint i = 0; i < cliqueSize; ++i) {
+      for (uint j = i + 1; j < cliqueSize; ++j) {
+        graph->addEdge(nodes[c * cliqueSize + i], nodes[c * cliqueSize + j]);
+      }
+    }
+
+    graph->addEdge(nodes[c * cliqueSize], nodes[((c + 1) % nbCliques) * cliqueSize + 1]);
+  }
+
+  DoubleProperty resultMetric(graph);
+  string errorMsg;
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Strength Clustering", &resultMetric, errorMsg));
+
+  // the clusters are numbered in the order of their first node
+  for (uint i = 0; i < nodes.size(); ++i) {
+    CPPUNIT_ASSERT_EQUAL(double(i / cliqueSize), resultMetric.getNodeValue(nodes[i]));
+  }
+}
+//==========================================================
+void BasicPluginsTest::testCliqueEnumeration() {
+  // a 4-clique sharing a node with a triangle, a pendant edge, an isolated node and a 4-cycle
+  vector<node> nodes = graph->addNodes(12);
+
+  for (uint i = 0; i < 4; ++i) {
+    for (uint j = i + 1; j < 4; ++j) {
+      graph->addEdge(nodes[i], nodes[j]);
+    }
+
+    graph->addEdge(nodes[i + 8], nodes[(i + 1) % 4 + 8]);
+  }
+
+  graph->addEdge(nodes[3], nodes[4]);
+  graph->addEdge(nodes[3], nodes[5]);
+  graph->addEdge(nodes[4], nodes[5]);
+  graph->addEdge(nodes[5], nodes[6]);
+
+  // the positions of the nodes of the cliques, in the order of the created subgraphs
+  auto getCliques = [&](uint minSize) {
+    while (graph->numberOfSubGraphs()) {
+      graph->delSubGraph(graph->getNthSubGraph(0));
+    }
+
+    string errorMsg;
+    DataSet ds;
+    ds.set("minimum size", minSize);
+    CPPUNIT_ASSERT(graph->applyAlgorithm("Maximal Cliques Enumeration", errorMsg, &ds));
+    uint nbCliques = 0;
+    CPPUNIT_ASSERT(ds.get("#cliques created", nbCliques));
+    CPPUNIT_ASSERT_EQUAL(nbCliques, graph->numberOfSubGraphs());
+    vector<set<uint>> cliques;
+
+    for (Graph *sg : graph->subGraphs()) {
+      set<uint> clique;
+
+      for (auto n : sg->nodes()) {
+        clique.insert(graph->nodePos(n));
+      }
+
+      cliques.push_back(clique);
+    }
+
+    return cliques;
+  };
+
+  vector<set<uint>> cliques = getCliques(0);
+  std::sort(cliques.begin(), cliques.end());
+  vector<set<uint>> expected = {{0, 1, 2, 3}, {3, 4, 5}, {5, 6},  {7},
+                                {8, 9},       {8, 11},   {9, 10}, {10, 11}};
+  std::sort(expected.begin(), expected.end());
+  CPPUNIT_ASSERT(cliques == expected);
+
+  cliques = getCliques(3);
+  std::sort(cliques.begin(), cliques.end());
+  expected = {{0, 1, 2, 3}, {3, 4, 5}};
+  CPPUNIT_ASSERT(cliques == expected);
+
+  // the cliques are created in the same order whatever the number of threads
+  graph->clear();
+  nodes = graph->addNodes(300);
+
+  for (uint i = 0; i < 300; ++i) {
+    for (uint j = 1; j < 6; ++j) {
+      node n = nodes[(i * j * 7 + j * 13) % 300];
+
+      if (n != nodes[i] && !graph->existEdge(nodes[i], n, false).isValid()) {
+        graph->addEdge(nodes[i], n);
+      }
+    }
+  }
+
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+  ThreadManager::setNumberOfThreads(1);
+  cliques = getCliques(0);
+  ThreadManager::setNumberOfThreads(4);
+  vector<set<uint>> parallelCliques = getCliques(0);
+  ThreadManager::setNumberOfThreads(nbThreads);
+  CPPUNIT_ASSERT(!cliques.empty());
+  CPPUNIT_ASSERT(cliques == parallelCliques);
+}
+//==========================================================
 #ifndef TALIPOT_BUILD_CORE_ONLY
 void BasicPluginsTest::testImportFileSystem() {
   DataSet ds;
@@ -57,6 +57,8 @@ class BasicPluginsTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testHierarchicalClustering);
   CPPUNIT_TEST(testQuotientClustering);
   CPPUNIT_TEST(testStrengthClustering);
+  CPPUNIT_TEST(testStrengthClusteringPartition);
+  CPPUNIT_TEST(testCliqueEnumeration);
 #ifndef TALIPOT_BUILD_CORE_ONLY
   CPPUNIT_TEST(testImportFileSystem);
   CPPUNIT_TEST(testImportGEXF);
@@ -107,6 +109,8 @@ public:
   void testHierarchicalClustering();
   void testQuotientClustering();
   void testStrengthClustering();
+  void testStrengthClusteringPartition();
+  void testCliqueEnumeration();
 
 #ifndef TALIPOT_BUILD_CORE_ONLY
   void testImportFileSystem();
@@ -237,7 +237,8 @@ PairNode<T> *PairingHeap<T>::combineSiblings(PairNode<T> *firstSibling) const {
     return firstSibling;
 
   // Allocate the array
-  static vector<PairNode<T> *> treeArray(5);
+  // thread local, so that several solvers can run concurrently
+  static thread_local vector<PairNode<T> *> treeArray(5);
 
   // Store the subtrees in an array
   int numSiblings = 0;
@@ -30,7 +30,8 @@ using std::vector;
 
 namespace vpsc {
 
-long blockTimeCtr;
+// thread local, so that several solvers can run concurrently
+thread_local long blockTimeCtr;
 
 Blocks::Blocks(const int n, Variable *const vs) : vs(vs), nvs(n) {
   blockTimeCtr = 0;